@@ -33,6 +33,7 @@
 #define KSPPIPECGRR 'pipecgrr'
 #define KSPPIPELCG 'pipelcg'
 #define KSPPIPECG2 'pipecg2'
+#define KSPCACG 'cacg'
 #define KSPCGNE 'cgne'
 #define KSPNASH 'nash'
 #define KSPSTCG 'stcg'
@@ -111,6 +111,15 @@
 #define MATAIJSELL         'aijsell'
 #define MATSEQAIJSELL      'seqaijsell'
 #define MATMPIAIJSELL      'mpiaijsell'
+#define MATAIJFLOAT        'aijfloat'
+#define MATSEQAIJFLOAT     'seqaijfloat'
+#define MATMPIAIJFLOAT     'mpiaijfloat'
+#define MATAIJDELTA        'aijdelta'
+#define MATSEQAIJDELTA     'seqaijdelta'
+#define MATMPIAIJDELTA     'mpiaijdelta'
+#define MATVBAIJ           'vbaij'
+#define MATSEQVBAIJ        'seqvbaij'
+#define MATMPIVBAIJ        'mpivbaij'
 #define MATAIJMKL          'aijmkl'
 #define MATSEQAIJMKL       'seqaijmkl'
 #define MATMPIAIJMKL       'mpiaijmkl'
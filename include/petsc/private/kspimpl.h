@@ -277,6 +277,16 @@ PETSC_INTERN PetscErrorCode KSPSetUpNorms_Private(KSP, PetscBool, KSPNormType *,
 
 PETSC_INTERN PetscErrorCode KSPPlotEigenContours_Private(KSP, PetscInt, const PetscReal *, const PetscReal *);
 
+PETSC_INTERN PetscErrorCode KSPMatDenseResize_Private(Mat, PetscInt, Mat *);
+PETSC_INTERN PetscErrorCode KSPMatDenseLocalGram_Private(Mat, PetscInt, PetscInt, Mat, PetscInt, PetscInt, PetscScalar *, PetscInt);
+PETSC_INTERN PetscErrorCode KSPMatDenseLocalColumnDots_Private(Mat, Mat, PetscInt, PetscScalar[]);
+PETSC_INTERN PetscErrorCode KSPMatDenseGEMM_Private(Mat, PetscInt, PetscInt, PetscScalar, PetscScalar, Mat, PetscInt, PetscInt, const PetscScalar *, PetscInt);
+PETSC_INTERN PetscErrorCode KSPMatDenseKeepColumns_Private(Mat *, PetscInt, const PetscInt[]);
+PETSC_INTERN PetscErrorCode KSPMatDenseCopyColumns_Private(Mat, PetscInt, const PetscInt[], const PetscBool[], Mat);
+PETSC_INTERN PetscErrorCode KSPBlockMatMult_Private(KSP, Mat, Mat, Mat *);
+PETSC_INTERN PetscErrorCode KSPBlockOrthonormalize_Private(PetscInt, PetscScalar *, const PetscReal[], PetscReal, PetscInt *, PetscScalar *, PetscScalar *, PetscInt);
+PETSC_INTERN PetscErrorCode KSPBlockConverged_Private(KSP, PetscInt, PetscInt, const PetscInt[], const PetscReal[], PetscReal[], PetscBool[]);
+
 typedef struct _p_DMKSP  *DMKSP;
 typedef struct _DMKSPOps *DMKSPOps;
 struct _DMKSPOps {
@@ -309,6 +319,20 @@ PETSC_EXTERN PetscErrorCode DMGetDMKSP(DM, DMKSP *);
 PETSC_EXTERN PetscErrorCode DMGetDMKSPWrite(DM, DMKSP *);
 PETSC_EXTERN PetscErrorCode DMCopyDMKSP(DM, DM);
 
+/*
+       Whether a split phase reduction is already in progress on the communicator of the KSP, for example one started
+   by an outer pipelined KSP that this one is nested in; a new one cannot be started until it is finished
+*/
+static inline PetscErrorCode KSPSplitReductionInUse_Private(KSP ksp, PetscBool *flg)
+{
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSplitReductionGet(PetscObjectComm((PetscObject)ksp), &sr));
+  *flg = sr->numopsbegin ? PETSC_TRUE : PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
        These allow the various Krylov methods to apply to either the linear system or its transpose.
 */
@@ -348,6 +372,17 @@ static inline PetscErrorCode KSP_MatMult(KSP ksp, Mat A, Vec x, Vec y)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* y = A x with dot = VecDot(w,y), fused into the product when not solving with the transpose */
+static inline PetscErrorCode KSP_MatMultDot(KSP ksp, Mat A, Vec x, Vec y, Vec w, PetscScalar *dot)
+{
+  PetscFunctionBegin;
+  if (ksp->transpose_solve) {
+    PetscCall(MatMultTranspose(A, x, y));
+    PetscCall(VecDot(w, y, dot));
+  } else PetscCall(MatMultDot(A, x, y, w, dot));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static inline PetscErrorCode KSP_MatMultTranspose(KSP ksp, Mat A, Vec x, Vec y)
 {
   PetscFunctionBegin;
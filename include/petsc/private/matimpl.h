@@ -3,6 +3,7 @@
 #include <petscmat.h>
 #include <petscmatcoarsen.h>
 #include <petsc/private/petscimpl.h>
+#include <petsc/private/hashmapijv.h>
 
 PETSC_EXTERN PetscBool      MatRegisterAllCalled;
 PETSC_EXTERN PetscBool      MatSeqAIJRegisterAllCalled;
@@ -217,6 +218,8 @@ struct _MatOps {
   /*150*/
   PetscErrorCode (*transposesymbolic)(Mat, Mat *);
   PetscErrorCode (*eliminatezeros)(Mat, PetscBool);
+  PetscErrorCode (*multdot)(Mat, Vec, Vec, Vec, PetscScalar *);
+  PetscErrorCode (*multaddnorm)(Mat, Vec, Vec, Vec, PetscReal *);
 };
 /*
     If you add MatOps entries above also add them to the MATOP enum
@@ -242,6 +245,34 @@ PETSC_INTERN PetscErrorCode MatConvert_Shell(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvertFrom_Shell(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatCopy_Basic(Mat, Mat, MatStructure);
 PETSC_INTERN PetscErrorCode MatDiagonalSet_Default(Mat, Vec, InsertMode);
+PETSC_INTERN PetscErrorCode MatMultDot_Basic(Mat, Vec, Vec, Vec, PetscScalar *);
+PETSC_INTERN PetscErrorCode MatMultAddNorm_Basic(Mat, Vec, Vec, Vec, PetscReal *);
+
+/*
+   Ghost region of depth k of the local rows of a matrix, used by MatMatrixPowers() to compute k products after a single halo
+   exchange. The entries of the region are ordered by their distance to the local rows in the graph of the matrix:
+   entries [nlevel[l-1], nlevel[l]) are at distance l, and the rows within distance l only use entries within distance l+1.
+*/
+typedef struct {
+  PetscInt         k;            /* depth of the region */
+  PetscInt        *nlevel;       /* number of entries within distance l, l = 0, ..., k; nlevel[0] is the number of local rows */
+  PetscInt        *i, *j;        /* CSR structure of the rows within distance k-1, columns numbered as the entries of the region */
+  MatScalar       *a;            /* values of these rows */
+  PetscScalar     *diag;         /* diagonal entries of these rows */
+  PetscScalar     *work[2];      /* work arrays of length nlevel[k] */
+  PetscSF          sf;           /* from the local rows to the ghost entries [nlevel[0], nlevel[k]) of the region */
+  PetscSF         *sfl;          /* sfl[l], 0 < l < k: sf restricted to the ghost entries within distance l, created on demand */
+  IS               isrow, iscol; /* the rows within distance k-1 and the columns within distance k, sorted, in global numbering */
+  Mat             *sub;          /* submatrix of these rows and columns, to update a[] and diag[] when the values change */
+  PetscInt        *rowperm;      /* row of sub[0] of each row of the region */
+  PetscInt        *colperm;      /* entry of the region of each column of sub[0] */
+  PetscObjectState state, nonzerostate;
+} Mat_MatrixPowers;
+
+PETSC_EXTERN PetscErrorCode MatGetMatrixPowers_Private(Mat, PetscInt, Mat_MatrixPowers **);
+PETSC_EXTERN PetscErrorCode MatMatrixPowersGetSF_Private(Mat_MatrixPowers *, PetscInt, PetscSF *);
+PETSC_EXTERN PetscErrorCode MatMatrixPowersMult_Private(Mat_MatrixPowers *, PetscInt, const PetscScalar *, PetscScalar *);
+PETSC_EXTERN PetscErrorCode MatMatrixPowersDestroy_Private(Mat_MatrixPowers **);
 #if defined(PETSC_HAVE_SCALAPACK)
 PETSC_INTERN PetscErrorCode MatConvert_Dense_ScaLAPACK(Mat, MatType, MatReuse, Mat *);
 #endif
@@ -334,6 +365,7 @@ struct _MatStash {
   PetscInt           bs;                /* block size of the stash */
   PetscInt           reallocs;          /* preserve the no of mallocs invoked */
   PetscMatStashSpace space_head, space; /* linked list to hold stashed global row/column numbers and matrix values */
+  PetscHMapIJV       ht;                /* with -matstash_combine, combines the values set at the same location before they are stashed */
 
   PetscErrorCode (*ScatterBegin)(Mat, MatStash *, PetscInt *);
   PetscErrorCode (*ScatterGetMesg)(MatStash *, PetscMPIInt *, PetscInt **, PetscInt **, PetscScalar **, PetscInt *);
@@ -395,6 +427,7 @@ PETSC_INTERN PetscErrorCode MatStashSetInitialSize_Private(MatStash *, PetscInt)
 PETSC_INTERN PetscErrorCode MatStashGetInfo_Private(MatStash *, PetscInt *, PetscInt *);
 PETSC_INTERN PetscErrorCode MatStashValuesRow_Private(MatStash *, PetscInt, PetscInt, const PetscInt[], const PetscScalar[], PetscBool);
 PETSC_INTERN PetscErrorCode MatStashValuesCol_Private(MatStash *, PetscInt, PetscInt, const PetscInt[], const PetscScalar[], PetscInt, PetscBool);
+PETSC_INTERN PetscErrorCode MatStashValuesCombine_Private(MatStash *, PetscInt, PetscInt, const PetscInt[], const PetscScalar[], PetscInt, PetscBool, InsertMode);
 PETSC_INTERN PetscErrorCode MatStashValuesRowBlocked_Private(MatStash *, PetscInt, PetscInt, const PetscInt[], const PetscScalar[], PetscInt, PetscInt, PetscInt);
 PETSC_INTERN PetscErrorCode MatStashValuesColBlocked_Private(MatStash *, PetscInt, PetscInt, const PetscInt[], const PetscScalar[], PetscInt, PetscInt, PetscInt);
 PETSC_INTERN PetscErrorCode MatStashScatterBegin_Private(Mat, MatStash *, PetscInt *);
@@ -1612,6 +1645,9 @@ PETSC_EXTERN PetscErrorCode MatFDColoringApply_AIJ(Mat, MatFDColoring, Vec, void
 
 PETSC_EXTERN PetscLogEvent MAT_Mult;
 PETSC_EXTERN PetscLogEvent MAT_MultAdd;
+PETSC_EXTERN PetscLogEvent MAT_MultDot;
+PETSC_EXTERN PetscLogEvent MAT_MultAddNorm;
+PETSC_EXTERN PetscLogEvent MAT_MatrixPowers;
 PETSC_EXTERN PetscLogEvent MAT_MultTranspose;
 PETSC_EXTERN PetscLogEvent MAT_MultHermitianTranspose;
 PETSC_EXTERN PetscLogEvent MAT_MultTransposeAdd;
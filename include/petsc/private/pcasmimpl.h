@@ -21,6 +21,7 @@ typedef struct {
   PetscBool       dm_subdomains; /* whether DM is allowed to define subdomains */
   PCCompositeType loctype;       /* the type of composition for local solves */
   MatType         sub_mat_type;  /* the type of Mat used for subdomain solves (can be MATSAME or NULL) */
+  PetscBool       single_prec;   /* send the values of the overlap in single precision, see PetscSFSetUseSinglePrecision() */
   /* For multiplicative solve */
   Mat *lmats; /* submatrices for overlapping multiplicative (process) subdomain */
 } PC_ASM;
@@ -9,6 +9,7 @@ struct _PCGAMGOps {
   PetscErrorCode (*coarsen)(PC, Mat *, PetscCoarsenData **);
   PetscErrorCode (*prolongator)(PC, Mat, Mat, PetscCoarsenData *, Mat *);
   PetscErrorCode (*optprolongator)(PC, Mat, Mat *);
+  PetscErrorCode (*optprolongatornumeric)(PC, PetscInt, Mat, Mat); /* recompute the values of the optimized prolongator of a level when the operator values change */
   PetscErrorCode (*createlevel)(PC, Mat, PetscInt, Mat *, Mat *, PetscMPIInt *, IS *, PetscBool);
   PetscErrorCode (*createdefaultdata)(PC, Mat); /* for data methods that have a default (SA) */
   PetscErrorCode (*setfromoptions)(PC, PetscOptionItems *);
@@ -48,6 +49,17 @@ typedef struct gamg_TAG {
   PetscBool use_sa_esteig;
   PetscReal emin, emax;
   PetscBool recompute_esteig;
+
+  /* numeric rebuild of the hierarchy with the aggregates of the last full setup, see PCGAMGSetReuseAggregates() */
+  PetscBool reuse_aggs;
+  PetscReal reuse_aggs_tol;
+  PetscBool reuse_aggs_ok;                  /* the hierarchy of the last full setup can be rebuilt numerically */
+  PetscReal cycle_rate;                     /* convergence factor of the cycle measured after the last full setup */
+  Mat       Prol0[PETSC_MG_MAXLEVELS];      /* tentative prolongators */
+  Mat       AProl0[PETSC_MG_MAXLEVELS];     /* products A P0, whose numeric phase is recomputed */
+  PetscReal prol_omega[PETSC_MG_MAXLEVELS]; /* damping used to smooth the tentative prolongators */
+  Mat       Prolred[PETSC_MG_MAXLEVELS];    /* prolongators before the reduction of the number of active processes */
+  IS        Prolperm[PETSC_MG_MAXLEVELS];   /* new numbering of the coarse unknowns after the reduction */
 } PC_GAMG;
 
 PetscErrorCode PCReset_MG(PC);
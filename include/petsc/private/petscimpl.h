@@ -1551,6 +1551,12 @@ PETSC_INTERN PetscErrorCode PetscKokkosFinalize_Private(void);
 PETSC_EXTERN PetscInt PetscNumOMPThreads;
 #endif
 
+/*
+   The sequential Vec and MATSEQAIJ kernels split their loops among the OpenMP threads, with a static schedule so that each
+   thread works on the entries it touched first at allocation, only for loops with more iterations than this
+*/
+#define PETSC_OMP_MIN_ITERATIONS 16384
+
 struct _n_PetscObjectList {
   char            name[256];
   PetscBool       skipdereference; /* when the PetscObjectList is destroyed do not call PetscObjectDereference() on this object */
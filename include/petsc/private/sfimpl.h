@@ -49,6 +49,9 @@ struct _PetscSFOps {
   PetscErrorCode (*Duplicate)(PetscSF, PetscSFDuplicateOption, PetscSF);
   PetscErrorCode (*BcastBegin)(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op);
   PetscErrorCode (*BcastEnd)(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
+  PetscErrorCode (*BcastEndSome)(PetscSF, MPI_Datatype, const void *, void *, MPI_Op, PetscInt *, PetscInt[]);
+  PetscErrorCode (*BcastMultiBegin)(PetscSF, MPI_Datatype, PetscInt, const void *const *, void *const *, MPI_Op);
+  PetscErrorCode (*BcastMultiEnd)(PetscSF, MPI_Datatype, PetscInt, const void *const *, void *const *, MPI_Op);
   PetscErrorCode (*ReduceBegin)(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op);
   PetscErrorCode (*ReduceEnd)(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
   PetscErrorCode (*FetchAndOpBegin)(PetscSF, MPI_Datatype, PetscMemType, void *, PetscMemType, const void *, void *, MPI_Op);
@@ -116,6 +119,8 @@ struct _p_PetscSF {
   PetscBool      setupcalled;          /* Type and communication structures have been set up */
   PetscSFPattern pattern;              /* Pattern of the graph */
   PetscBool      persistent;           /* Does this SF use MPI persistent requests for communication */
+  PetscBool      use_mpi_datatypes;    /* If true, SF may pass non-contiguous but regularly strided root/leafdata to MPI with derived datatypes instead of packing it */
+  PetscBool      use_single_precision; /* If true, SF may send PetscScalar root/leafdata rounded to single precision */
   PetscLayout    map;                  /* Layout of leaves over all processes when building a patterned graph */
   PetscBool      unknown_input_stream; /* If true, SF does not know which streams root/leafdata is on. Default is false, since we only use petsc default stream */
   PetscBool      use_gpu_aware_mpi;    /* If true, SF assumes it can pass GPU pointers to MPI */
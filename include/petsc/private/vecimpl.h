@@ -106,6 +106,8 @@ struct _VecOps {
   PetscErrorCode (*setvaluescoo)(Vec, const PetscScalar[], InsertMode);
   PetscErrorCode (*errorwnorm)(Vec, Vec, Vec, NormType, PetscReal, Vec, PetscReal, Vec, PetscReal, PetscReal *, PetscInt *, PetscReal *, PetscInt *, PetscReal *, PetscInt *);
   PetscErrorCode (*maxpby)(Vec, PetscInt, const PetscScalar *, PetscScalar, Vec *); /* y = beta y + alpha[j] x[j] */
+  /* y = y + alpha[j] x[j], then z[j] = y dot x[j] and, optionally, the 2-norm of y */
+  PetscErrorCode (*mdotandmaxpy)(Vec, PetscInt, const PetscScalar *, Vec *, PetscScalar *, PetscReal *);
 };
 
 #if defined(offsetof) && (defined(__cplusplus) || (PETSC_C_VERSION >= 23))
@@ -190,6 +192,7 @@ PETSC_EXTERN PetscLogEvent VEC_AXPY;
 PETSC_EXTERN PetscLogEvent VEC_AYPX;
 PETSC_EXTERN PetscLogEvent VEC_WAXPY;
 PETSC_EXTERN PetscLogEvent VEC_MAXPY;
+PETSC_EXTERN PetscLogEvent VEC_MDotAndMAXPY;
 PETSC_EXTERN PetscLogEvent VEC_AssemblyEnd;
 PETSC_EXTERN PetscLogEvent VEC_PointwiseMult;
 PETSC_EXTERN PetscLogEvent VEC_SetValues;
@@ -235,6 +238,7 @@ PETSC_EXTERN PetscErrorCode VecGetRootType_Private(Vec, VecType *);
 /* Default obtain and release vectors; can be used by any implementation */
 PETSC_INTERN PetscErrorCode VecDuplicateVecs_Default(Vec, PetscInt, Vec *[]);
 PETSC_INTERN PetscErrorCode VecDestroyVecs_Default(PetscInt, Vec[]);
+PETSC_INTERN PetscErrorCode VecDuplicateVecsComposeArray_Private(PetscInt, Vec[], PetscScalar *);
 PETSC_INTERN PetscErrorCode VecView_Binary(Vec, PetscViewer);
 
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecLoad_Default(Vec, PetscViewer);
@@ -41,6 +41,8 @@ typedef const char *KSPType;
 #define KSPPIPELCG    "pipelcg"
 #define KSPPIPEPRCG   "pipeprcg"
 #define KSPPIPECG2    "pipecg2"
+#define KSPCACG       "cacg"
+#define KSPRCG        "rcg"
 #define KSPCGNE       "cgne"
 #define KSPNASH       "nash"
 #define KSPSTCG       "stcg"
@@ -56,6 +58,7 @@ typedef const char *KSPType;
 #define KSPLGMRES     "lgmres"
 #define KSPDGMRES     "dgmres"
 #define KSPPGMRES     "pgmres"
+#define KSPGCRODR     "gcrodr"
 #define KSPTCQMR      "tcqmr"
 #define KSPBCGS       "bcgs"
 #define KSPIBCGS      "ibcgs"
@@ -175,6 +178,8 @@ PETSC_EXTERN PetscErrorCode KSPSetWorkVecs(KSP, PetscInt);
 
 PETSC_EXTERN PetscErrorCode PCKSPGetKSP(PC, KSP *);
 PETSC_EXTERN PetscErrorCode PCKSPSetKSP(PC, KSP);
+PETSC_EXTERN PetscErrorCode PCKSPSetMatType(PC, MatType);
+PETSC_EXTERN PetscErrorCode PCKSPGetMatType(PC, MatType *);
 PETSC_EXTERN PetscErrorCode PCBJacobiGetSubKSP(PC, PetscInt *, PetscInt *, KSP *[]);
 PETSC_EXTERN PetscErrorCode PCASMGetSubKSP(PC, PetscInt *, PetscInt *, KSP *[]);
 PETSC_EXTERN PetscErrorCode PCGASMGetSubKSP(PC, PetscInt *, PetscInt *, KSP *[]);
@@ -222,6 +227,7 @@ PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSet(KSP, PetscReal, PetscReal, Pet
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSetUseNoisy(KSP, PetscBool);
 PETSC_EXTERN PetscErrorCode KSPChebyshevSetKind(KSP, KSPChebyshevKind);
 PETSC_EXTERN PetscErrorCode KSPChebyshevGetKind(KSP, KSPChebyshevKind *);
+PETSC_EXTERN PetscErrorCode KSPChebyshevSetUseMatrixPowers(KSP, PetscBool);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigGetKSP(KSP, KSP *);
 PETSC_EXTERN PetscErrorCode KSPComputeExtremeSingularValues(KSP, PetscReal *, PetscReal *);
 PETSC_EXTERN PetscErrorCode KSPComputeEigenvalues(KSP, PetscInt, PetscReal[], PetscReal[], PetscInt *);
@@ -271,6 +277,7 @@ PETSC_EXTERN PetscErrorCode KSPPIPEGCRGetUnrollW(KSP, PetscBool *);
 PETSC_EXTERN PetscErrorCode KSPPIPEGCRSetModifyPC(KSP, PetscErrorCode (*)(KSP, PetscInt, PetscReal, void *), void *, PetscErrorCode (*)(void *));
 
 PETSC_EXTERN PetscErrorCode KSPGMRESSetRestart(KSP, PetscInt);
+PETSC_EXTERN PetscErrorCode KSPGMRESUseBlockMatSolve(KSP, PetscBool);
 PETSC_EXTERN PetscErrorCode KSPGMRESGetRestart(KSP, PetscInt *);
 PETSC_EXTERN PetscErrorCode KSPGMRESSetHapTol(KSP, PetscReal);
 PETSC_EXTERN PetscErrorCode KSPGMRESSetBreakdownTolerance(KSP, PetscReal);
@@ -284,6 +291,9 @@ PETSC_EXTERN PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP, P
 PETSC_EXTERN PetscErrorCode KSPLGMRESSetAugDim(KSP, PetscInt);
 PETSC_EXTERN PetscErrorCode KSPLGMRESSetConstant(KSP);
 
+PETSC_EXTERN PetscErrorCode KSPGCRODRSetRecycleDimension(KSP, PetscInt);
+PETSC_EXTERN PetscErrorCode KSPGCRODRResetRecycleSpace(KSP);
+
 PETSC_EXTERN PetscErrorCode KSPPIPEFGMRESSetShift(KSP, PetscScalar);
 
 PETSC_EXTERN PetscErrorCode KSPGCRSetRestart(KSP, PetscInt);
@@ -887,12 +897,22 @@ PETSC_EXTERN const char *const KSPCGTypes[];
 
 PETSC_EXTERN PetscErrorCode KSPCGSetType(KSP, KSPCGType);
 PETSC_EXTERN PetscErrorCode KSPCGUseSingleReduction(KSP, PetscBool);
+PETSC_EXTERN PetscErrorCode KSPCGUseBlockMatSolve(KSP, PetscBool);
 
 PETSC_EXTERN PetscErrorCode KSPCGSetRadius(KSP, PetscReal);
 PETSC_EXTERN PetscErrorCode KSPCGSetObjectiveTarget(KSP, PetscReal);
 PETSC_EXTERN PetscErrorCode KSPCGGetNormD(KSP, PetscReal *);
 PETSC_EXTERN PetscErrorCode KSPCGGetObjFcn(KSP, PetscReal *);
 
+PETSC_EXTERN PetscErrorCode KSPCACGSetStepSize(KSP, PetscInt);
+PETSC_EXTERN PetscErrorCode KSPCACGGetStepSize(KSP, PetscInt *);
+PETSC_EXTERN PetscErrorCode KSPCACGSetUseNewtonBasis(KSP, PetscBool);
+PETSC_EXTERN PetscErrorCode KSPCACGGetUseNewtonBasis(KSP, PetscBool *);
+
+PETSC_EXTERN PetscErrorCode KSPRCGSetRecycleDimension(KSP, PetscInt);
+PETSC_EXTERN PetscErrorCode KSPRCGSetDirections(KSP, PetscInt);
+PETSC_EXTERN PetscErrorCode KSPRCGResetRecycleSpace(KSP);
+
 PETSC_EXTERN PetscErrorCode KSPGLTRGetMinEig(KSP, PetscReal *);
 PETSC_EXTERN PetscErrorCode KSPGLTRGetLambda(KSP, PetscReal *);
 PETSC_DEPRECATED_FUNCTION(3, 12, 0, "KSPGLTRGetMinEig()", ) static inline PetscErrorCode KSPCGGLTRGetMinEig(KSP ksp, PetscReal *x)
@@ -63,6 +63,15 @@ typedef const char *MatType;
 #define MATAIJSELL                   "aijsell"
 #define MATSEQAIJSELL                "seqaijsell"
 #define MATMPIAIJSELL                "mpiaijsell"
+#define MATAIJFLOAT                  "aijfloat"
+#define MATSEQAIJFLOAT               "seqaijfloat"
+#define MATMPIAIJFLOAT               "mpiaijfloat"
+#define MATAIJDELTA                  "aijdelta"
+#define MATSEQAIJDELTA               "seqaijdelta"
+#define MATMPIAIJDELTA               "mpiaijdelta"
+#define MATVBAIJ                     "vbaij"
+#define MATSEQVBAIJ                  "seqvbaij"
+#define MATMPIVBAIJ                  "mpivbaij"
 #define MATAIJMKL                    "aijmkl"
 #define MATSEQAIJMKL                 "seqaijmkl"
 #define MATMPIAIJMKL                 "mpiaijmkl"
@@ -413,6 +422,12 @@ PETSC_EXTERN PetscErrorCode MatSeqSELLGetVarSliceSize(Mat, PetscReal *);
 
 PETSC_EXTERN PetscErrorCode MatCreateSeqAIJSELL(MPI_Comm, PetscInt, PetscInt, PetscInt, const PetscInt[], Mat *);
 PETSC_EXTERN PetscErrorCode MatCreateMPIAIJSELL(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscInt, const PetscInt[], PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateSeqAIJFloat(MPI_Comm, PetscInt, PetscInt, PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateMPIAIJFloat(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscInt, const PetscInt[], PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateSeqAIJDelta(MPI_Comm, PetscInt, PetscInt, PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateMPIAIJDelta(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscInt, const PetscInt[], PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateSeqVBAIJ(MPI_Comm, PetscInt, const PetscInt[], PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateMPIVBAIJ(MPI_Comm, PetscInt, const PetscInt[], PetscInt, PetscInt, const PetscInt[], PetscInt, const PetscInt[], Mat *);
 PETSC_EXTERN PetscErrorCode MatMPISELLGetLocalMatCondensed(Mat, MatReuse, IS *, IS *, Mat *);
 PETSC_EXTERN PetscErrorCode MatMPISELLGetSeqSELL(Mat, Mat *, Mat *, const PetscInt *[]);
 
@@ -686,6 +701,9 @@ PETSC_EXTERN PetscErrorCode MatDenseRestoreSubMatrix(Mat, Mat *);
 PETSC_EXTERN PetscErrorCode MatMult(Mat, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatMultDiagonalBlock(Mat, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatMultAdd(Mat, Vec, Vec, Vec);
+PETSC_EXTERN PetscErrorCode MatMultDot(Mat, Vec, Vec, Vec, PetscScalar *);
+PETSC_EXTERN PetscErrorCode MatMultAddNorm(Mat, Vec, Vec, Vec, PetscReal *);
+PETSC_EXTERN PetscErrorCode MatMatrixPowers(Mat, PetscInt, Vec, Vec[]);
 PETSC_EXTERN PetscErrorCode MatMultTranspose(Mat, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatMultHermitianTranspose(Mat, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatIsTranspose(Mat, Mat, PetscReal, PetscBool *);
@@ -1993,7 +2011,9 @@ typedef enum {
   MATOP_MPICONCATENATESEQ     = 144,
   MATOP_DESTROYSUBMATRICES    = 145,
   MATOP_TRANSPOSE_SOLVE       = 146,
-  MATOP_GET_VALUES_LOCAL      = 147
+  MATOP_GET_VALUES_LOCAL      = 147,
+  MATOP_MULT_DOT              = 152,
+  MATOP_MULT_ADD_NORM         = 153
 } MatOperation;
 PETSC_EXTERN PetscErrorCode MatSetOperation(Mat, MatOperation, void (*)(void));
 PETSC_EXTERN PetscErrorCode MatGetOperation(Mat, MatOperation, void (**)(void));
@@ -334,6 +334,8 @@ PETSC_EXTERN PetscErrorCode PCGAMGSetNlevels(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetNSmooths(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetAggressiveLevels(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetReuseInterpolation(PC, PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetReuseAggregates(PC, PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetReuseAggregatesTolerance(PC, PetscReal);
 PETSC_EXTERN PetscErrorCode PCGAMGFinalizePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGInitializePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGRegister(PCGAMGType, PetscErrorCode (*)(PC));
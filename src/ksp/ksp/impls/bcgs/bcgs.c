@@ -15,13 +15,83 @@ PetscErrorCode KSPSetUp_BCGS(KSP ksp)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   v <- K p with d1 <- (v,rp); with right preconditioning, or no preconditioner, the product with the operator is applied
+   last and computes the inner product with MatMultDot()
+*/
+static PetscErrorCode KSPBCGSApplyBAorABDot_Private(KSP ksp, Vec p, Vec v, Vec t, Vec rp, PetscScalar *d1)
+{
+  PC           pc   = ksp->pc;
+  PetscBool    fuse = PETSC_FALSE, none, shell, scale;
+  Mat          A;
+  MatNullSpace nullsp;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetOperators(pc, &A, NULL));
+  PetscCall(PCGetDiagonalScale(pc, &scale));
+  /* a PCSHELL may provide its own PCApplyBAorAB() with PCShellSetApplyBA() */
+  PetscCall(PetscObjectTypeCompare((PetscObject)pc, PCSHELL, &shell));
+  if (!ksp->transpose_solve && !scale && !shell) {
+    if (ksp->pc_side == PC_RIGHT) fuse = PETSC_TRUE;
+    else if (ksp->pc_side == PC_LEFT) {
+      PetscCall(PetscObjectTypeCompare((PetscObject)pc, PCNONE, &none));
+      PetscCall(MatGetNullSpace(A, &nullsp));
+      fuse = (PetscBool)(none && !nullsp);
+    }
+  }
+  if (fuse) {
+    if (ksp->pc_side == PC_RIGHT) {
+      PetscCall(PCApply(pc, p, t));
+      PetscCall(MatMultDot(A, t, v, rp, d1));
+    } else PetscCall(MatMultDot(A, p, v, rp, d1));
+    *d1 = PetscConj(*d1); /* MatMultDot() computes (rp,v) */
+  } else {
+    PetscCall(KSP_PCApplyBAorAB(ksp, p, v, t));
+    PetscCall(VecDot(v, rp, d1));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+     dp <- ||r|| and rho <- (r,rp) with a single split phase reduction; the caller can do work that does not depend on them,
+   such as the update of the solution, between KSPBCGSNormDotBegin_Private() and KSPBCGSNormDotEnd_Private()
+*/
+static PetscErrorCode KSPBCGSNormDotBegin_Private(KSP ksp, Vec r, Vec rp, PetscReal *dp, PetscScalar *rho, PetscBool *split)
+{
+  PetscBool inuse;
+
+  PetscFunctionBegin;
+  PetscCall(KSPSplitReductionInUse_Private(ksp, &inuse));
+  *split = inuse ? PETSC_FALSE : PETSC_TRUE;
+  if (inuse) {
+    PetscCall(VecNorm(r, NORM_2, dp));
+    PetscCall(VecDot(r, rp, rho));
+  } else {
+    PetscCall(VecNormBegin(r, NORM_2, dp));
+    PetscCall(VecDotBegin(r, rp, rho));
+    PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)r)));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPBCGSNormDotEnd_Private(Vec r, Vec rp, PetscReal *dp, PetscScalar *rho, PetscBool split)
+{
+  PetscFunctionBegin;
+  if (split) {
+    PetscCall(VecNormEnd(r, NORM_2, dp));
+    PetscCall(VecDotEnd(r, rp, rho));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode KSPSolve_BCGS(KSP ksp)
 {
   PetscInt    i;
-  PetscScalar rho, rhoold, alpha, beta, omega, omegaold, d1;
+  PetscScalar rho, rhonext, rhoold, alpha, beta, omega, omegaold, d1;
   Vec         X, B, V, P, R, RP, T, S;
   PetscReal   dp   = 0.0, d2;
   KSP_BCGS   *bcgs = (KSP_BCGS *)ksp->data;
+  PetscBool   split;
 
   PetscFunctionBegin;
   X  = ksp->vec_sol;
@@ -43,11 +113,12 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
     PetscCall(VecSet(X, 0.0));
   }
 
-  /* Test for nothing to do */
+  /* Test for nothing to do, the first rho <- (r,rp) with rp == r is computed in the same reduction */
   if (ksp->normtype != KSP_NORM_NONE) {
-    PetscCall(VecNorm(R, NORM_2, &dp));
+    PetscCall(KSPBCGSNormDotBegin_Private(ksp, R, R, &dp, &rhonext, &split));
+    PetscCall(KSPBCGSNormDotEnd_Private(R, R, &dp, &rhonext, split));
     KSPCheckNorm(ksp, dp);
-  }
+  } else PetscCall(VecDot(R, R, &rhonext));
   PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
   ksp->its   = 0;
   ksp->rnorm = dp;
@@ -71,11 +142,10 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
 
   i = 0;
   do {
-    PetscCall(VecDot(R, RP, &rho)); /*   rho <- (r,rp)      */
+    rho  = rhonext; /*   rho <- (r,rp)      */
     beta = (rho / rhoold) * (alpha / omegaold);
     PetscCall(VecAXPBYPCZ(P, 1.0, -omegaold * beta, beta, R, V)); /* p <- r - omega * beta* v + beta * p */
-    PetscCall(KSP_PCApplyBAorAB(ksp, P, V, T));                   /*   v <- K p           */
-    PetscCall(VecDot(V, RP, &d1));
+    PetscCall(KSPBCGSApplyBAorABDot_Private(ksp, P, V, T, RP, &d1)); /*   v <- K p, d1 <- (v,rp) */
     KSPCheckDot(ksp, d1);
     if (d1 == 0.0) {
       PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "KSPSolve breakdown due to zero inner product");
@@ -107,12 +177,17 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
       PetscCall(KSPMonitor(ksp, i + 1, 0.0));
       break;
     }
-    omega = d1 / d2;                                    /*   w <- (t's) / (t't) */
-    PetscCall(VecAXPBYPCZ(X, alpha, omega, 1.0, P, S)); /* x <- alpha * p + omega * s + x */
-    PetscCall(VecWAXPY(R, -omega, T, S));               /*   r <- s - w t       */
+    omega = d1 / d2;                      /*   w <- (t's) / (t't) */
+    PetscCall(VecWAXPY(R, -omega, T, S)); /*   r <- s - w t       */
+    /* the next rho <- (r,rp) is computed in the same reduction as the residual norm, the solution is updated meanwhile */
     if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i + 2) {
-      PetscCall(VecNorm(R, NORM_2, &dp));
+      PetscCall(KSPBCGSNormDotBegin_Private(ksp, R, RP, &dp, &rhonext, &split));
+      PetscCall(VecAXPBYPCZ(X, alpha, omega, 1.0, P, S)); /* x <- alpha * p + omega * s + x */
+      PetscCall(KSPBCGSNormDotEnd_Private(R, RP, &dp, &rhonext, split));
       KSPCheckNorm(ksp, dp);
+    } else {
+      PetscCall(VecAXPBYPCZ(X, alpha, omega, 1.0, P, S)); /* x <- alpha * p + omega * s + x */
+      PetscCall(VecDot(R, RP, &rhonext));
     }
 
     rhoold   = rho;
@@ -191,6 +266,9 @@ PetscErrorCode KSPDestroy_BCGS(KSP ksp)
 
    See `KSPFBCGS`, `KSPFBCGSR`, and `KSPPIPEBCGS` for flexible and pipelined versions of the algorithm
 
+   With right preconditioning, or `PCNONE`, the product with the operator and the following inner product are computed together
+   with `MatMultDot()`, so `-log_view` reports half the products of the iterations under `MatMultDot` instead of `MatMult`.
+
    Reference:
 .  * - van der Vorst, SIAM J. Sci. Stat. Comput., 1992.
 
@@ -0,0 +1,582 @@
+#include <petsc/private/kspimpl.h>
+#include <petscblaslapack.h>
+
+typedef struct {
+  PetscInt     s;                 /* number of CG iterations per block reduction */
+  PetscBool    newton;            /* use a Newton basis shifted by the Ritz values of the first block */
+  PetscInt     nb;                /* number of allocated basis vectors, 2s+1 */
+  Vec         *Y;                 /* preconditioned basis [p, (BA)p, ..., (BA)^s p, z, (BA)z, ..., (BA)^{s-1} z], in shifted form */
+  Vec         *Yt;                /* unpreconditioned counterpart of the basis, Y = B Yt; Yt[0] is never used */
+  PetscScalar *G;                 /* Gram matrix G[a*nb+b] = (Yt[a], Y[b]) */
+  PetscScalar *N;                 /* Gram matrix of the basis the residual norm is computed in */
+  PetscScalar *xc, *rc, *pc, *wc; /* coefficients of the iterates in the basis */
+  PetscReal   *theta, *sigma;     /* basis shifts and scalings, A Y[i] = sigma[i] Yt[i+1] + theta[i] Yt[i] */
+  PetscReal   *d, *e;             /* Lanczos tridiagonal matrix of the first block */
+} KSP_CACG;
+
+static PetscErrorCode KSPCACGAllocate_Private(KSP ksp)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+  PetscInt  nb   = 2 * cacg->s + 1;
+
+  PetscFunctionBegin;
+  if (cacg->nb == nb) PetscFunctionReturn(PETSC_SUCCESS);
+  if (cacg->nb) {
+    PetscCall(VecDestroyVecs(cacg->nb, &cacg->Y));
+    PetscCall(VecDestroyVecs(cacg->nb, &cacg->Yt));
+    PetscCall(PetscFree6(cacg->G, cacg->N, cacg->xc, cacg->rc, cacg->pc, cacg->wc));
+    PetscCall(PetscFree4(cacg->theta, cacg->sigma, cacg->d, cacg->e));
+  }
+  PetscCall(KSPCreateVecs(ksp, nb, &cacg->Y, 0, NULL));
+  PetscCall(KSPCreateVecs(ksp, nb, &cacg->Yt, 0, NULL));
+  PetscCall(PetscCalloc6(nb * nb, &cacg->G, nb * nb, &cacg->N, nb, &cacg->xc, nb, &cacg->rc, nb, &cacg->pc, nb, &cacg->wc));
+  PetscCall(PetscMalloc4(cacg->s, &cacg->theta, cacg->s, &cacg->sigma, cacg->s, &cacg->d, cacg->s, &cacg->e));
+  cacg->nb = nb;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetUp_CACG(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPCACGAllocate_Private(ksp));
+  PetscCall(KSPSetWorkVecs(ksp, 3));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPReset_CACG(KSP ksp)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+
+  PetscFunctionBegin;
+  if (cacg->nb) {
+    PetscCall(VecDestroyVecs(cacg->nb, &cacg->Y));
+    PetscCall(VecDestroyVecs(cacg->nb, &cacg->Yt));
+    PetscCall(PetscFree6(cacg->G, cacg->N, cacg->xc, cacg->rc, cacg->pc, cacg->wc));
+    PetscCall(PetscFree4(cacg->theta, cacg->sigma, cacg->d, cacg->e));
+  }
+  cacg->nb = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPDestroy_CACG(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPReset_CACG(ksp));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCACGSetStepSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCACGGetStepSize_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCACGSetUseNewtonBasis_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCACGGetUseNewtonBasis_C", NULL));
+  PetscCall(KSPDestroyDefault(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetFromOptions_CACG(KSP ksp, PetscOptionItems *PetscOptionsObject)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+  PetscInt  s    = cacg->s;
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "KSP CACG options");
+  PetscCall(PetscOptionsInt("-ksp_cacg_s", "Number of iterations per block reduction", "KSPCACGSetStepSize", s, &s, &flg));
+  if (flg) PetscCall(KSPCACGSetStepSize(ksp, s));
+  PetscCall(PetscOptionsBool("-ksp_cacg_newton_basis", "Use a Newton basis shifted by Ritz values", "KSPCACGSetUseNewtonBasis", cacg->newton, &cacg->newton, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPView_CACG(KSP ksp, PetscViewer viewer)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+  PetscBool iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  iterations per block reduction: %" PetscInt_FMT "\n", cacg->s));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  basis: %s\n", cacg->newton ? "Newton" : "monomial"));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Generates Y[a+1] = B Yt[a+1] with Yt[a+1] = (A Y[a] - theta[i] Yt[a]) / sigma[i], so that Y = B Yt holds column by column
+*/
+static PetscErrorCode KSPCACGPowerStep_Private(KSP ksp, Mat Amat, PetscInt a, PetscInt i)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCall(KSP_MatMult(ksp, Amat, cacg->Y[a], cacg->Yt[a + 1]));
+  if (cacg->theta[i] != 0.0) PetscCall(VecAXPBY(cacg->Yt[a + 1], -cacg->theta[i] / cacg->sigma[i], 1.0 / cacg->sigma[i], cacg->Yt[a]));
+  else if (cacg->sigma[i] != 1.0) PetscCall(VecScale(cacg->Yt[a + 1], 1.0 / cacg->sigma[i]));
+  PetscCall(KSP_PCApply(ksp, cacg->Yt[a + 1], cacg->Y[a + 1]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Computes all the inner products needed by the next s iterations with a single reduction
+*/
+static PetscErrorCode KSPCACGGram_Private(KSP ksp)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+  PetscInt  nb   = cacg->nb;
+  Vec      *V    = NULL;
+  PetscBool inuse;
+
+  PetscFunctionBegin;
+  if (ksp->normtype == KSP_NORM_PRECONDITIONED) V = cacg->Y;
+  else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) V = cacg->Yt;
+  PetscCall(KSPSplitReductionInUse_Private(ksp, &inuse));
+  if (inuse) {
+    for (PetscInt a = 1; a < nb; a++) {
+      PetscCall(VecMDot(cacg->Yt[a], nb, cacg->Y, cacg->G + a * nb));
+      if (V) PetscCall(VecMDot(V[a], nb - 1, V + 1, cacg->N + a * nb + 1));
+    }
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (PetscInt a = 1; a < nb; a++) {
+    PetscCall(VecMDotBegin(cacg->Yt[a], nb, cacg->Y, cacg->G + a * nb));
+    if (V) PetscCall(VecMDotBegin(V[a], nb - 1, V + 1, cacg->N + a * nb + 1));
+  }
+  PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)ksp)));
+  for (PetscInt a = 1; a < nb; a++) {
+    PetscCall(VecMDotEnd(cacg->Yt[a], nb, cacg->Y, cacg->G + a * nb));
+    if (V) PetscCall(VecMDotEnd(V[a], nb - 1, V + 1, cacg->N + a * nb + 1));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Returns (V v, Y u) = sum_{a,b} conj(u[b]) M[a*nb+b] v[a] for a Gram matrix M[a*nb+b] = (V[a], Y[b])
+*/
+static inline PetscScalar KSPCACGDot_Private(PetscInt nb, const PetscScalar *M, const PetscScalar *u, const PetscScalar *v)
+{
+  PetscScalar dot = 0.0;
+
+  for (PetscInt a = 1; a < nb; a++) {
+    PetscScalar sum = 0.0;
+
+    if (v[a] == 0.0) continue;
+    for (PetscInt b = 0; b < nb; b++) sum += PetscConj(u[b]) * M[a * nb + b];
+    dot += sum * v[a];
+  }
+  return dot;
+}
+
+/*
+  Computes the coefficients w in Yt of A Y p
+*/
+static inline void KSPCACGApplyT_Private(KSP_CACG *cacg, const PetscScalar *p, PetscScalar *w)
+{
+  const PetscInt s = cacg->s;
+
+  for (PetscInt a = 0; a < cacg->nb; a++) w[a] = 0.0;
+  for (PetscInt i = 0; i < s; i++) {
+    w[i + 1] += cacg->sigma[i] * p[i];
+    w[i] += cacg->theta[i] * p[i];
+  }
+  for (PetscInt i = 0; i < s - 1; i++) {
+    w[s + 2 + i] += cacg->sigma[i] * p[s + 1 + i];
+    w[s + 1 + i] += cacg->theta[i] * p[s + 1 + i];
+  }
+}
+
+/*
+  Uses the Ritz values of the first block to scale the basis and, optionally, to shift it into a Newton basis with the Ritz
+  values in Leja order; the first shift is always 0 since Yt[0] = B^{-1} p is not available
+*/
+static PetscErrorCode KSPCACGSetShifts_Private(KSP ksp)
+{
+  KSP_CACG    *cacg = (KSP_CACG *)ksp->data;
+  PetscInt     s    = cacg->s;
+  PetscReal   *ritz = cacg->d, emax = 0.0;
+  PetscBLASInt bn, lierr = 0, ldz = 1;
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(s, &bn));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+  PetscCallBLAS("LAPACKREALstev", LAPACKREALstev_("N", &bn, ritz, cacg->e, NULL, &ldz, NULL, &lierr));
+  PetscCall(PetscFPTrapPop());
+  if (lierr) {
+    PetscCall(PetscInfo(ksp, "Ritz value computation failed, keeping the monomial basis\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (PetscInt i = 0; i < s; i++) emax = PetscMax(emax, PetscAbsReal(ritz[i]));
+  if (emax == 0.0 || PetscIsInfOrNanReal(emax)) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt i = 0; i < s; i++) cacg->sigma[i] = emax;
+  if (cacg->newton) {
+    for (PetscInt i = 1; i < s; i++) {
+      PetscInt  k    = i;
+      PetscReal best = -1.0;
+
+      /* pick the remaining Ritz value farthest, in the product sense, from the previous shifts */
+      for (PetscInt j = i - 1; j < s; j++) {
+        PetscReal prod = 1.0;
+
+        for (PetscInt l = 0; l < i; l++) prod *= PetscAbsReal(ritz[j] - cacg->theta[l]) / emax;
+        if (prod > best) {
+          best = prod;
+          k    = j;
+        }
+      }
+      cacg->theta[i] = ritz[k];
+      ritz[k]        = ritz[i - 1];
+    }
+  }
+  PetscCall(PetscInfo(ksp, "Scaling the basis by %g, %s\n", (double)emax, cacg->newton ? "with Newton shifts" : "without shifts"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSolve_CACG(KSP ksp)
+{
+  KSP_CACG    *cacg = (KSP_CACG *)ksp->data;
+  PetscInt     s, nb, j;
+  PetscScalar  alpha = 1.0, alphaold, beta = 1.0, rz, rzold, pAp = 0.0, pApold = 0.0;
+  PetscScalar *xc, *rc, *pc, *wc;
+  PetscReal    dp = 0.0;
+  PetscBool    first = PETSC_TRUE, diagonalscale;
+  Vec          X, B, P, R, Z, *Y, *Yt;
+  Mat          Amat;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
+  PetscCheck(!diagonalscale, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Krylov method %s does not support diagonal scaling", ((PetscObject)ksp)->type_name);
+
+  PetscCall(KSPCACGAllocate_Private(ksp));
+  s  = cacg->s;
+  nb = cacg->nb;
+  Y  = cacg->Y;
+  Yt = cacg->Yt;
+  xc = cacg->xc;
+  rc = cacg->rc;
+  pc = cacg->pc;
+  wc = cacg->wc;
+  X  = ksp->vec_sol;
+  B  = ksp->vec_rhs;
+  P  = ksp->work[0];
+  R  = ksp->work[1];
+  Z  = ksp->work[2];
+
+  PetscCall(PCGetOperators(ksp->pc, &Amat, NULL));
+
+  /* the first block uses the monomial basis, it provides the Ritz values for the next ones */
+  for (PetscInt i = 0; i < s; i++) {
+    cacg->theta[i] = 0.0;
+    cacg->sigma[i] = 1.0;
+  }
+
+  ksp->its = 0;
+  if (!ksp->guess_zero) {
+    PetscCall(KSP_MatMult(ksp, Amat, X, Yt[s + 1])); /*    r <- b - Ax                       */
+    PetscCall(VecAYPX(Yt[s + 1], -1.0, B));
+  } else {
+    PetscCall(VecCopy(B, Yt[s + 1])); /*    r <- b (x is 0)                   */
+  }
+  PetscCall(KSP_PCApply(ksp, Yt[s + 1], Y[s + 1])); /*    z <- Br                           */
+  PetscCall(VecCopy(Y[s + 1], Y[0]));               /*    p <- z                            */
+
+  do {
+    for (PetscInt i = 0; i < s; i++) PetscCall(KSPCACGPowerStep_Private(ksp, Amat, i, i));
+    for (PetscInt i = 0; i < s - 1; i++) PetscCall(KSPCACGPowerStep_Private(ksp, Amat, s + 1 + i, i));
+    PetscCall(KSPCACGGram_Private(ksp));
+
+    PetscCall(PetscArrayzero(xc, nb));
+    PetscCall(PetscArrayzero(rc, nb));
+    PetscCall(PetscArrayzero(pc, nb));
+    pc[0]     = 1.0;
+    rc[s + 1] = 1.0;
+    rz        = KSPCACGDot_Private(nb, cacg->G, rc, rc);
+    KSPCheckDot(ksp, rz);
+    if (first) {
+      if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(rz));
+      else if (ksp->normtype != KSP_NORM_NONE) dp = PetscSqrtReal(PetscAbsScalar(cacg->N[(s + 1) * nb + s + 1]));
+      KSPCheckNorm(ksp, dp);
+      PetscCall(KSPLogResidualHistory(ksp, dp));
+      PetscCall(KSPMonitor(ksp, 0, dp));
+      ksp->rnorm = dp;
+      PetscCall((*ksp->converged)(ksp, 0, dp, &ksp->reason, ksp->cnvP));
+      if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
+    }
+
+    for (j = 0; j < s; j++) {
+      if (rz == 0.0) {
+        ksp->reason = KSP_CONVERGED_ATOL;
+        PetscCall(PetscInfo(ksp, "converged due to beta = 0\n"));
+        break;
+      }
+      KSPCACGApplyT_Private(cacg, pc, wc);
+      pApold = pAp;
+      pAp    = KSPCACGDot_Private(nb, cacg->G, pc, wc); /*    pAp <- p'Ap                       */
+      KSPCheckDot(ksp, pAp);
+      if (pAp == 0.0 || (ksp->its > 0 && PetscSign(PetscRealPart(pAp)) * PetscSign(PetscRealPart(pApold)) < 0.0)) {
+        PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Diverged due to indefinite matrix, pAp %g, pApold %g", (double)PetscRealPart(pAp), (double)PetscRealPart(pApold));
+        ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+        PetscCall(PetscInfo(ksp, "diverging due to indefinite matrix\n"));
+        break;
+      }
+      alphaold = alpha;
+      alpha    = rz / pAp; /*    alpha <- r'z / p'Ap               */
+      if (first) {
+        cacg->d[j] = PetscRealPart(1.0 / alpha);
+        if (j) {
+          cacg->d[j] += PetscRealPart(beta / alphaold);
+          cacg->e[j - 1] = PetscSqrtReal(PetscAbsScalar(beta)) / PetscRealPart(alphaold);
+        }
+      }
+      for (PetscInt a = 0; a < nb; a++) {
+        xc[a] += alpha * pc[a]; /*    x <- x + alpha p                  */
+        rc[a] -= alpha * wc[a]; /*    r <- r - alpha Ap                 */
+      }
+      ksp->its++;
+      rzold = rz;
+      rz    = KSPCACGDot_Private(nb, cacg->G, rc, rc); /*    rz <- r'z                         */
+      KSPCheckDot(ksp, rz);
+      if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(rz));
+      else if (ksp->normtype != KSP_NORM_NONE) dp = PetscSqrtReal(PetscAbsScalar(KSPCACGDot_Private(nb, cacg->N, rc, rc)));
+      else dp = 0.0;
+      KSPCheckNorm(ksp, dp);
+      PetscCall(KSPLogResidualHistory(ksp, dp));
+      PetscCall(KSPMonitor(ksp, ksp->its, dp));
+      ksp->rnorm = dp;
+      PetscCall((*ksp->converged)(ksp, ksp->its, dp, &ksp->reason, ksp->cnvP));
+      if (ksp->reason) break;
+      if (ksp->its >= ksp->max_it) {
+        ksp->reason = KSP_DIVERGED_ITS;
+        break;
+      }
+#if !defined(PETSC_USE_COMPLEX)
+      if (rz * rzold < 0.0) {
+        PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Diverged due to indefinite preconditioner, rz %g, rzold %g", (double)rz, (double)rzold);
+        ksp->reason = KSP_DIVERGED_INDEFINITE_PC;
+        PetscCall(PetscInfo(ksp, "diverging due to indefinite preconditioner\n"));
+        break;
+      }
+#endif
+      beta = rz / rzold; /*    beta <- r'z / r'z_old             */
+      for (PetscInt a = 0; a < nb; a++) pc[a] = rc[a] + beta * pc[a]; /*    p <- z + beta p         */
+    }
+
+    PetscCall(VecMAXPY(X, nb, xc, Y)); /*    x <- x + Y xc                     */
+    if (ksp->reason) break;
+
+    /* new starting vectors of the next block */
+    PetscCall(VecSet(P, 0.0));
+    PetscCall(VecMAXPY(P, nb, pc, Y));
+    PetscCall(VecSet(R, 0.0));
+    PetscCall(VecMAXPY(R, nb - 1, rc + 1, Yt + 1));
+    PetscCall(VecSet(Z, 0.0));
+    PetscCall(VecMAXPY(Z, nb - 1, rc + 1, Y + 1));
+    PetscCall(VecCopy(P, Y[0]));
+    PetscCall(VecCopy(R, Yt[s + 1]));
+    PetscCall(VecCopy(Z, Y[s + 1]));
+    if (first) PetscCall(KSPCACGSetShifts_Private(ksp));
+    first = PETSC_FALSE;
+  } while (PETSC_TRUE);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPCACGSetStepSize_CACG(KSP ksp, PetscInt s)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCheck(s > 0, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Step size %" PetscInt_FMT " must be positive", s);
+  cacg->s = s;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPCACGGetStepSize_CACG(KSP ksp, PetscInt *s)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+
+  PetscFunctionBegin;
+  *s = cacg->s;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPCACGSetUseNewtonBasis_CACG(KSP ksp, PetscBool flg)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+
+  PetscFunctionBegin;
+  cacg->newton = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPCACGGetUseNewtonBasis_CACG(KSP ksp, PetscBool *flg)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+
+  PetscFunctionBegin;
+  *flg = cacg->newton;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPCACGSetStepSize - Sets the number of iterations `KSPCACG` performs per global reduction
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the Krylov space context
+- s   - the number of iterations per block, default 4
+
+  Options Database Key:
+. -ksp_cacg_s <s> - number of iterations per block
+
+  Level: intermediate
+
+  Note:
+  Each block computes $2s-1$ matrix-vector products and preconditioner applications, and $O(s^2)$ local inner products for one
+  global reduction. Large values of `s` may lose accuracy in the residual norm estimates and slow down convergence.
+
+.seealso: [](ch_ksp), `KSPCACG`, `KSPCACGGetStepSize()`, `KSPCACGSetUseNewtonBasis()`
+@*/
+PetscErrorCode KSPCACGSetStepSize(KSP ksp, PetscInt s)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ksp, s, 2);
+  PetscTryMethod(ksp, "KSPCACGSetStepSize_C", (KSP, PetscInt), (ksp, s));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPCACGGetStepSize - Gets the number of iterations `KSPCACG` performs per global reduction
+
+  Not Collective
+
+  Input Parameter:
+. ksp - the Krylov space context
+
+  Output Parameter:
+. s - the number of iterations per block
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `KSPCACG`, `KSPCACGSetStepSize()`
+@*/
+PetscErrorCode KSPCACGGetStepSize(KSP ksp, PetscInt *s)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscAssertPointer(s, 2);
+  PetscUseMethod(ksp, "KSPCACGGetStepSize_C", (KSP, PetscInt *), (ksp, s));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPCACGSetUseNewtonBasis - Sets whether `KSPCACG` shifts its Krylov basis by Ritz values
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the Krylov space context
+- flg - `PETSC_TRUE` to use a Newton basis, `PETSC_FALSE` for a scaled monomial basis
+
+  Options Database Key:
+. -ksp_cacg_newton_basis <bool> - use a Newton basis, default true
+
+  Level: advanced
+
+  Note:
+  The first block of each solve uses the monomial basis; the Lanczos coefficients of its $s$ iterations give the Ritz values used,
+  in Leja order, as the shifts of the later blocks. The Newton basis is much better conditioned than the monomial one for $s > 4$.
+
+.seealso: [](ch_ksp), `KSPCACG`, `KSPCACGGetUseNewtonBasis()`, `KSPCACGSetStepSize()`
+@*/
+PetscErrorCode KSPCACGSetUseNewtonBasis(KSP ksp, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ksp, flg, 2);
+  PetscTryMethod(ksp, "KSPCACGSetUseNewtonBasis_C", (KSP, PetscBool), (ksp, flg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPCACGGetUseNewtonBasis - Gets whether `KSPCACG` shifts its Krylov basis by Ritz values
+
+  Not Collective
+
+  Input Parameter:
+. ksp - the Krylov space context
+
+  Output Parameter:
+. flg - `PETSC_TRUE` if a Newton basis is used
+
+  Level: advanced
+
+.seealso: [](ch_ksp), `KSPCACG`, `KSPCACGSetUseNewtonBasis()`
+@*/
+PetscErrorCode KSPCACGGetUseNewtonBasis(KSP ksp, PetscBool *flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscAssertPointer(flg, 2);
+  PetscUseMethod(ksp, "KSPCACGGetUseNewtonBasis_C", (KSP, PetscBool *), (ksp, flg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   KSPCACG - s-step, or communication-avoiding, preconditioned conjugate gradient method. [](sec_pipelineksp)
+
+   Options Database Keys:
++  -ksp_cacg_s <s>                - number of iterations per global reduction, default 4
+-  -ksp_cacg_newton_basis <bool>  - shift the basis by Ritz values, default true
+
+   Level: intermediate
+
+   Notes:
+   Every block of `s` iterations builds the $2s+1$ vectors $[p, BAp, \ldots, (BA)^s p, z, BAz, \ldots, (BA)^{s-1} z]$, together with
+   their unpreconditioned counterparts, and computes all their inner products with a single global reduction. The `s` conjugate
+   gradient iterations of the block are then carried out on coefficient vectors of length $2s+1$ without any communication.
+   `KSPCG` needs two reductions per iteration, and the pipelined methods such as `KSPPIPECG` need one, so this method reduces the
+   number of global synchronizations by a factor of $2s$, respectively $s$, at the price of about twice as many matrix-vector
+   products and preconditioner applications.
+
+   The residual norms of the iterations inside a block are computed from the Gram matrix. They are accurate only to about the
+   square root of the machine precision relative to the norm of the basis, so very tight tolerances may need a smaller `s`.
+
+   The solution vector is only updated at the end of each block, so monitors that call `KSPBuildSolution()` see the solution
+   of the last complete block.
+
+   References:
++  * - A. T. Chronopoulos and C. W. Gear, "s-step iterative methods for symmetric linear systems", Journal of Computational and
+       Applied Mathematics, 25(2):153--168, 1989.
+-  * - E. Carson, "Communication-avoiding Krylov subspace methods in theory and practice", PhD thesis, UC Berkeley, 2015.
+
+.seealso: [](ch_ksp), [](sec_pipelineksp), `KSPCreate()`, `KSPSetType()`, `KSPCG`, `KSPPIPECG`, `KSPPIPELCG`, `KSPCACGSetStepSize()`,
+          `KSPCACGSetUseNewtonBasis()`
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_CACG(KSP ksp)
+{
+  KSP_CACG *cacg;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&cacg));
+  cacg->s      = 4;
+  cacg->newton = PETSC_TRUE;
+  ksp->data    = (void *)cacg;
+
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_PRECONDITIONED, PC_LEFT, 3));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_UNPRECONDITIONED, PC_LEFT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NATURAL, PC_LEFT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_LEFT, 1));
+
+  ksp->ops->setup          = KSPSetUp_CACG;
+  ksp->ops->solve          = KSPSolve_CACG;
+  ksp->ops->reset          = KSPReset_CACG;
+  ksp->ops->destroy        = KSPDestroy_CACG;
+  ksp->ops->view           = KSPView_CACG;
+  ksp->ops->setfromoptions = KSPSetFromOptions_CACG;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCACGSetStepSize_C", KSPCACGSetStepSize_CACG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCACGGetStepSize_C", KSPCACGGetStepSize_CACG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCACGSetUseNewtonBasis_C", KSPCACGSetUseNewtonBasis_CACG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCACGGetUseNewtonBasis_C", KSPCACGGetUseNewtonBasis_CACG));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
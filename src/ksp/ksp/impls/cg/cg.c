@@ -95,7 +95,60 @@ static PetscErrorCode KSPSetUp_CG(KSP ksp)
 /*
      A macro used in the following KSPSolve_CG and KSPSolve_CG_SingleReduction routines
 */
-#define VecXDot(x, y, a) (((cg->type) == (KSP_CG_HERMITIAN)) ? VecDot(x, y, a) : VecTDot(x, y, a))
+#define VecXDot(x, y, a)      (((cg->type) == (KSP_CG_HERMITIAN)) ? VecDot(x, y, a) : VecTDot(x, y, a))
+#define VecXDotBegin(x, y, a) (((cg->type) == (KSP_CG_HERMITIAN)) ? VecDotBegin(x, y, a) : VecTDotBegin(x, y, a))
+#define VecXDotEnd(x, y, a)   (((cg->type) == (KSP_CG_HERMITIAN)) ? VecDotEnd(x, y, a) : VecTDotEnd(x, y, a))
+
+/*
+     y <- A x with a <- VecXDot(x, y), the inner product is computed within MatMultDot() when it is the Hermitian one
+*/
+static PetscErrorCode KSPCGMatMultXDot_Private(KSP ksp, Mat A, Vec x, Vec y, PetscScalar *a)
+{
+  KSP_CG *cg = (KSP_CG *)ksp->data;
+
+  PetscFunctionBegin;
+  if (!PetscDefined(USE_COMPLEX) || cg->type == KSP_CG_HERMITIAN) PetscCall(KSP_MatMultDot(ksp, A, x, y, x, a));
+  else {
+    PetscCall(KSP_MatMult(ksp, A, x, y));
+    PetscCall(VecTDot(x, y, a));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+     dp <- ||z|| and beta <- z'*r with a single split phase reduction; the caller can do work that does not depend on them,
+   such as the update of the solution, between KSPCGNormXDotBegin_Private() and KSPCGNormXDotEnd_Private()
+*/
+static PetscErrorCode KSPCGNormXDotBegin_Private(KSP ksp, Vec R, Vec Z, PetscReal *dp, PetscScalar *beta, PetscBool *split)
+{
+  KSP_CG   *cg = (KSP_CG *)ksp->data;
+  PetscBool inuse;
+
+  PetscFunctionBegin;
+  PetscCall(KSPSplitReductionInUse_Private(ksp, &inuse));
+  *split = inuse ? PETSC_FALSE : PETSC_TRUE;
+  if (inuse) {
+    PetscCall(VecNorm(Z, NORM_2, dp));
+    PetscCall(VecXDot(Z, R, beta));
+  } else {
+    PetscCall(VecNormBegin(Z, NORM_2, dp));
+    PetscCall(VecXDotBegin(Z, R, beta));
+    PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)Z)));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPCGNormXDotEnd_Private(KSP ksp, Vec R, Vec Z, PetscReal *dp, PetscScalar *beta, PetscBool split)
+{
+  KSP_CG *cg = (KSP_CG *)ksp->data;
+
+  PetscFunctionBegin;
+  if (split) {
+    PetscCall(VecNormEnd(Z, NORM_2, dp));
+    PetscCall(VecXDotEnd(Z, R, beta));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
 /*
      KSPSolve_CG - This routine actually applies the conjugate gradient method
@@ -116,7 +169,7 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   Vec         X, B, Z, R, P, W;
   KSP_CG     *cg;
   Mat         Amat, Pmat;
-  PetscBool   diagonalscale, testobj;
+  PetscBool   diagonalscale, testobj, split;
 
   PetscFunctionBegin;
   PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
@@ -158,8 +211,9 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
 
   switch (ksp->normtype) {
   case KSP_NORM_PRECONDITIONED:
-    PetscCall(KSP_PCApply(ksp, R, Z));  /*    z <- Br                           */
-    PetscCall(VecNorm(Z, NORM_2, &dp)); /*    dp <- z'*z = e'*A'*B'*B*A*e       */
+    PetscCall(KSP_PCApply(ksp, R, Z));                                  /*    z <- Br                           */
+    PetscCall(KSPCGNormXDotBegin_Private(ksp, R, Z, &dp, &beta, &split)); /*    dp <- z'*z = e'*A'*B'*B*A*e, beta <- z'*r */
+    PetscCall(KSPCGNormXDotEnd_Private(ksp, R, Z, &dp, &beta, split));
     KSPCheckNorm(ksp, dp);
     break;
   case KSP_NORM_UNPRECONDITIONED:
@@ -202,10 +256,8 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
 
   if (ksp->normtype != KSP_NORM_PRECONDITIONED && (ksp->normtype != KSP_NORM_NATURAL)) { PetscCall(KSP_PCApply(ksp, R, Z)); /*     z <- Br                           */ }
-  if (ksp->normtype != KSP_NORM_NATURAL) {
-    PetscCall(VecXDot(Z, R, &beta)); /*     beta <- z'*r                      */
-    KSPCheckDot(ksp, beta);
-  }
+  if (ksp->normtype != KSP_NORM_NATURAL && ksp->normtype != KSP_NORM_PRECONDITIONED) PetscCall(VecXDot(Z, R, &beta)); /*     beta <- z'*r                      */
+  if (ksp->normtype != KSP_NORM_NATURAL) KSPCheckDot(ksp, beta);
 
   i = 0;
   do {
@@ -245,8 +297,7 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
       }
     }
     dpiold = dpi;
-    PetscCall(KSP_MatMult(ksp, Amat, P, W)); /*     w <- Ap                          */
-    PetscCall(VecXDot(P, W, &dpi));          /*     dpi <- p'w                       */
+    PetscCall(KSPCGMatMultXDot_Private(ksp, Amat, P, W, &dpi)); /*     w <- Ap, dpi <- p'w              */
     KSPCheckDot(ksp, dpi);
     betaold = beta;
 
@@ -293,22 +344,27 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
         break;
       }
     }
-    PetscCall(VecAXPY(X, a, P));  /*     x <- x + ap                      */
-    PetscCall(VecAXPY(R, -a, W)); /*     r <- r - aw                      */
     if (ksp->normtype == KSP_NORM_PRECONDITIONED && ksp->chknorm < i + 2) {
-      PetscCall(KSP_PCApply(ksp, R, Z));  /*     z <- Br                          */
-      PetscCall(VecNorm(Z, NORM_2, &dp)); /*     dp <- z'*z                       */
-      KSPCheckNorm(ksp, dp);
-    } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i + 2) {
-      PetscCall(VecNorm(R, NORM_2, &dp)); /*     dp <- r'*r                       */
+      PetscCall(VecAXPY(R, -a, W));                                        /*     r <- r - aw                      */
+      PetscCall(KSP_PCApply(ksp, R, Z));                                   /*     z <- Br                          */
+      PetscCall(KSPCGNormXDotBegin_Private(ksp, R, Z, &dp, &beta, &split)); /*     dp <- z'*z, beta <- z'*r         */
+      PetscCall(VecAXPY(X, a, P));                                         /*     x <- x + ap, during the reduction */
+      PetscCall(KSPCGNormXDotEnd_Private(ksp, R, Z, &dp, &beta, split));
       KSPCheckNorm(ksp, dp);
-    } else if (ksp->normtype == KSP_NORM_NATURAL) {
-      PetscCall(KSP_PCApply(ksp, R, Z)); /*     z <- Br                          */
-      PetscCall(VecXDot(Z, R, &beta));   /*     beta <- r'*z                     */
-      KSPCheckDot(ksp, beta);
-      dp = PetscSqrtReal(PetscAbsScalar(beta));
     } else {
-      dp = 0.0;
+      PetscCall(VecAXPY(X, a, P));  /*     x <- x + ap                      */
+      PetscCall(VecAXPY(R, -a, W)); /*     r <- r - aw                      */
+      if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i + 2) {
+        PetscCall(VecNorm(R, NORM_2, &dp)); /*     dp <- r'*r                       */
+        KSPCheckNorm(ksp, dp);
+      } else if (ksp->normtype == KSP_NORM_NATURAL) {
+        PetscCall(KSP_PCApply(ksp, R, Z)); /*     z <- Br                          */
+        PetscCall(VecXDot(Z, R, &beta));   /*     beta <- r'*z                     */
+        KSPCheckDot(ksp, beta);
+        dp = PetscSqrtReal(PetscAbsScalar(beta));
+      } else {
+        dp = 0.0;
+      }
     }
     cg->obj -= PetscRealPart(0.5 * a * betaold);
     if (testobj) PetscCall(PetscInfo(ksp, "it %" PetscInt_FMT " obj %g\n", i + 1, (double)cg->obj));
@@ -331,10 +387,10 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
     }
 
     if ((ksp->normtype != KSP_NORM_PRECONDITIONED && (ksp->normtype != KSP_NORM_NATURAL)) || (ksp->chknorm >= i + 2)) { PetscCall(KSP_PCApply(ksp, R, Z)); /*     z <- Br                          */ }
-    if ((ksp->normtype != KSP_NORM_NATURAL) || (ksp->chknorm >= i + 2)) {
+    if ((ksp->normtype != KSP_NORM_NATURAL && ksp->normtype != KSP_NORM_PRECONDITIONED) || (ksp->chknorm >= i + 2)) {
       PetscCall(VecXDot(Z, R, &beta)); /*     beta <- z'*r                     */
       KSPCheckDot(ksp, beta);
-    }
+    } else if (ksp->normtype == KSP_NORM_PRECONDITIONED) KSPCheckDot(ksp, beta);
 
     i++;
   } while (i < ksp->max_it);
@@ -459,8 +515,7 @@ static PetscErrorCode KSPSolve_CG_SingleReduction(KSP ksp)
     }
     dpiold = dpi;
     if (!i) {
-      PetscCall(KSP_MatMult(ksp, Amat, P, W)); /*    w <- Ap                           */
-      PetscCall(VecXDot(P, W, &dpi));          /*    dpi <- p'w                        */
+      PetscCall(KSPCGMatMultXDot_Private(ksp, Amat, P, W, &dpi)); /*    w <- Ap, dpi <- p'w               */
     } else {
       PetscCall(VecAYPX(W, beta / betaold, S));                 /*    w <- Ap                           */
       dpi = delta - beta * beta * dpiold / (betaold * betaold); /*    dpi <- p'w                        */
@@ -541,6 +596,7 @@ PetscErrorCode KSPDestroy_CG(KSP ksp)
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCGSetRadius_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCGSetType_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCGUseSingleReduction_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCGUseBlockMatSolve_C", NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -561,6 +617,7 @@ PetscErrorCode KSPView_CG(KSP ksp, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer, "  variant %s\n", KSPCGTypes[cg->type]));
 #endif
     if (cg->singlereduction) PetscCall(PetscViewerASCIIPrintf(viewer, "  using single-reduction variant\n"));
+    if (cg->blockmatsolve) PetscCall(PetscViewerASCIIPrintf(viewer, "  using block CG in KSPMatSolve()\n"));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -571,8 +628,9 @@ PetscErrorCode KSPView_CG(KSP ksp, PetscViewer viewer)
 */
 PetscErrorCode KSPSetFromOptions_CG(KSP ksp, PetscOptionItems *PetscOptionsObject)
 {
+  PetscErrorCode (*f)(KSP, PetscBool);
   KSP_CG   *cg = (KSP_CG *)ksp->data;
-  PetscBool flg;
+  PetscBool flg, block;
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject, "KSP CG and CGNE options");
@@ -581,6 +639,12 @@ PetscErrorCode KSPSetFromOptions_CG(KSP ksp, PetscOptionItems *PetscOptionsObjec
 #endif
   PetscCall(PetscOptionsBool("-ksp_cg_single_reduction", "Merge inner products into single MPI_Allreduce()", "KSPCGUseSingleReduction", cg->singlereduction, &cg->singlereduction, &flg));
   if (flg) PetscCall(KSPCGUseSingleReduction(ksp, cg->singlereduction));
+  /* block CG solves A X = B, it is not available for KSPCGNE */
+  PetscCall(PetscObjectQueryFunction((PetscObject)ksp, "KSPCGUseBlockMatSolve_C", &f));
+  if (f) {
+    PetscCall(PetscOptionsBool("-ksp_cg_block_matsolve", "Use block CG with all the right-hand sides in KSPMatSolve()", "KSPCGUseBlockMatSolve", cg->blockmatsolve, &block, &flg));
+    if (flg) PetscCall(KSPCGUseBlockMatSolve(ksp, block));
+  }
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -620,6 +684,22 @@ static PetscErrorCode KSPCGUseSingleReduction_CG(KSP ksp, PetscBool flg)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+    KSPCGUseBlockMatSolve_CG
+
+    This routine sets a flag to solve all the right-hand sides of KSPMatSolve() with block CG, by setting
+    or removing the routine called when KSPMatSolve() is invoked.
+*/
+static PetscErrorCode KSPCGUseBlockMatSolve_CG(KSP ksp, PetscBool flg)
+{
+  KSP_CG *cg = (KSP_CG *)ksp->data;
+
+  PetscFunctionBegin;
+  cg->blockmatsolve  = flg;
+  ksp->ops->matsolve = flg ? KSPMatSolve_CG_Block : NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP ksp, Vec t, Vec v, Vec *V)
 {
   PetscFunctionBegin;
@@ -634,7 +714,8 @@ PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP ksp, Vec t, Vec v, Vec *V)
    Options Database Keys:
 +   -ksp_cg_type Hermitian - (for complex matrices only) indicates the matrix is Hermitian, see `KSPCGSetType()`
 .   -ksp_cg_type symmetric - (for complex matrices only) indicates the matrix is symmetric
--   -ksp_cg_single_reduction - performs both inner products needed in the algorithm with a single `MPI_Allreduce()` call, see `KSPCGUseSingleReduction()`
+.   -ksp_cg_single_reduction - performs both inner products needed in the algorithm with a single `MPI_Allreduce()` call, see `KSPCGUseSingleReduction()`
+-   -ksp_cg_block_matsolve - solves all the right-hand sides of `KSPMatSolve()` together with block CG, see `KSPCGUseBlockMatSolve()`
 
    Level: beginner
 
@@ -654,6 +735,9 @@ PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP ksp, Vec t, Vec v, Vec *V)
 
    One can use `KSPSetComputeEigenvalues()` and `KSPComputeEigenvalues()` to compute the eigenvalues of the (preconditioned) operator
 
+   The product with the operator and the following inner product are computed together with `MatMultDot()`, so `-log_view` reports
+   the products of the iterations under `MatMultDot` instead of `MatMult`.
+
    Developer Notes:
     KSPSolve_CG() should actually query the matrix to determine if it is Hermitian symmetric or not and NOT require the user to
    indicate it to the `KSP` object.
@@ -665,7 +749,7 @@ PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP ksp, Vec t, Vec v, Vec *V)
     SIAM, 2014.
 
 .seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPSetComputeEigenvalues()`, `KSPComputeEigenvalues()`
-          `KSPCGSetType()`, `KSPCGUseSingleReduction()`, `KSPPIPECG`, `KSPGROPPCG`
+          `KSPCGSetType()`, `KSPCGUseSingleReduction()`, `KSPCGUseBlockMatSolve()`, `KSPPIPECG`, `KSPGROPPCG`
 M*/
 
 /*
@@ -712,6 +796,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_CG(KSP ksp)
   */
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCGSetType_C", KSPCGSetType_CG));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCGUseSingleReduction_C", KSPCGUseSingleReduction_CG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCGUseBlockMatSolve_C", KSPCGUseBlockMatSolve_CG));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCGSetRadius_C", KSPCGSetRadius_CG));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPCGSetObjectiveTarget_C", KSPCGSetObjectiveTarget_CG));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -0,0 +1,226 @@
+/*
+    Block conjugate gradient for KSPMatSolve() with KSPCG, see KSPCGUseBlockMatSolve()
+*/
+#include <../src/ksp/ksp/impls/cg/cgimpl.h> /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
+
+/*
+   Computes the local inner products needed for the residual norms of the a active columns, see KSPSetNormType()
+*/
+static PetscErrorCode KSPCGBlockLocalNormDots_Private(KSP ksp, PetscInt a, Mat R, Mat Z, PetscScalar *d)
+{
+  PetscFunctionBegin;
+  if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) PetscCall(KSPMatDenseLocalColumnDots_Private(R, R, a, d));
+  else if (ksp->normtype == KSP_NORM_NATURAL) PetscCall(KSPMatDenseLocalColumnDots_Private(R, Z, a, d));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static void KSPCGBlockNorms_Private(KSP ksp, PetscInt a, const PetscScalar *zz, const PetscScalar *d, PetscReal rnorm[])
+{
+  if (ksp->normtype == KSP_NORM_NONE) return;
+  for (PetscInt i = 0; i < a; i++) rnorm[i] = PetscSqrtReal(PetscAbsScalar(ksp->normtype == KSP_NORM_PRECONDITIONED ? zz[i * a + i] : d[i]));
+}
+
+/*
+   Removes the converged columns from the a active columns after copying their solution to X, the products GW, WAW and WR of the
+   next search directions W, the coefficients beta (k x a) used to compute them and the norms zref are compacted accordingly
+*/
+static PetscErrorCode KSPCGBlockDeflate_Private(PetscInt *a, PetscInt k, PetscInt idx[], const PetscBool conv[], Mat X, Mat *Xa, Mat *R, Mat *Z, Mat *AZ, PetscScalar *GW, PetscScalar *WAW, PetscScalar *WR, PetscScalar *beta, PetscReal zref[])
+{
+  PetscInt *keep, n = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(*a, &keep));
+  for (PetscInt i = 0; i < *a; i++) {
+    if (!conv[idx[i]]) keep[n++] = i;
+  }
+  if (n < *a) {
+    PetscCall(KSPMatDenseCopyColumns_Private(*Xa, *a, idx, conv, X));
+    PetscCall(KSPMatDenseKeepColumns_Private(Xa, n, keep));
+    PetscCall(KSPMatDenseKeepColumns_Private(R, n, keep));
+    PetscCall(KSPMatDenseKeepColumns_Private(Z, n, keep));
+    PetscCall(KSPMatDenseKeepColumns_Private(AZ, n, keep));
+    /* in place, since keep[j] >= j */
+    for (PetscInt j = 0; j < n; j++) {
+      for (PetscInt i = 0; i < n; i++) {
+        GW[j * n + i]  = GW[keep[j] * *a + keep[i]];
+        WAW[j * n + i] = WAW[keep[j] * *a + keep[i]];
+        WR[j * n + i]  = WR[keep[j] * *a + keep[i]];
+      }
+      for (PetscInt i = 0; i < k; i++) beta[j * k + i] = beta[keep[j] * k + i];
+      idx[j]  = idx[keep[j]];
+      zref[j] = zref[keep[j]];
+    }
+    *a = n;
+  }
+  PetscCall(PetscFree(keep));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   KSPMatSolve_CG_Block - Solves A X = B with the breakdown-free block conjugate gradient method
+
+   The search directions of all the active columns are orthonormalized together, which removes the rank-deficient directions,
+   and a column is deflated as soon as it has converged. The operator is applied to the preconditioned residuals Z instead of
+   the search directions P, and A P is updated with the same recurrence as P, so that all the inner products of a block iteration
+   are computed after the PCMatApply() and the MatMatMult() and summed with a single MPI_Allreduce(). With a = number of active
+   columns and k = rank of the search directions, each block iteration does one MatMatMult() and one PCMatApply() with a columns,
+   dense GEMM on the local rows, and one MPI_Allreduce() of 3 k a + 3 a^2 + 2 k^2 + a scalars
+
+   References:
++  * - Dianne P. O'Leary, The block conjugate gradient algorithm and related methods, Linear Algebra and its Applications, 1980.
+-  * - Hao Ji and Yaohang Li, A breakdown-free block conjugate gradient method, BIT Numerical Mathematics, 2017.
+*/
+PetscErrorCode KSPMatSolve_CG_Block(KSP ksp, Mat B, Mat X)
+{
+  Mat          A, Xa = NULL, R = NULL, Z = NULL, AZ = NULL, P = NULL, Q = NULL;
+  MPI_Comm     comm;
+  PetscInt     N, a, k = 0, *idx;
+  PetscBool   *conv;
+  PetscReal   *rnorm, *rnorm0, *zref;
+  PetscScalar *buf, *PQ, *beta, *tmp, *T, *S, *GW, *WAW, *WR, *alpha, one = 1.0, zero = 0.0;
+  PetscBLASInt bk, ba, info;
+
+  PetscFunctionBegin;
+#if defined(PETSC_USE_COMPLEX)
+  PetscCheck(((KSP_CG *)ksp->data)->type == KSP_CG_HERMITIAN, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Block KSPCG is only for Hermitian matrices, see KSPCGSetType()");
+#endif
+  PetscCall(PetscObjectGetComm((PetscObject)ksp, &comm));
+  PetscCall(PCGetOperators(ksp->pc, &A, NULL));
+  PetscCall(MatGetSize(B, NULL, &N));
+  PetscCall(PetscMalloc5(N, &idx, N, &conv, N, &rnorm, N, &rnorm0, N, &zref));
+  PetscCall(PetscMalloc7(8 * N * N + N, &buf, N * N, &PQ, N * N, &beta, 2 * N * N, &tmp, N * N, &T, N * N, &S, 3 * N * N, &GW));
+  WAW   = GW + N * N;
+  WR    = WAW + N * N;
+  alpha = tmp + N * N;
+  for (PetscInt i = 0; i < N; i++) {
+    idx[i]    = i;
+    conv[i]   = PETSC_FALSE;
+    rnorm0[i] = 0.0;
+  }
+  a = N;
+
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->its    = 0;
+  ksp->rnorm  = 0.0;
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+  PetscCall(KSPMatDenseResize_Private(B, N, &Xa));
+  PetscCall(KSPMatDenseResize_Private(B, N, &R));
+  PetscCall(KSPMatDenseResize_Private(B, N, &Z));
+  PetscCall(MatCopy(X, Xa, SAME_NONZERO_PATTERN));
+  PetscCall(MatCopy(B, R, SAME_NONZERO_PATTERN));
+  if (!ksp->guess_zero) {
+    PetscCall(KSPBlockMatMult_Private(ksp, A, X, &Q));
+    PetscCall(MatAXPY(R, -1.0, Q, SAME_NONZERO_PATTERN));
+    PetscCall(MatDestroy(&Q));
+  }
+  PetscCall(KSP_PCMatApply(ksp, R, Z));
+  PetscCall(KSPBlockMatMult_Private(ksp, A, Z, &AZ));
+  {
+    PetscScalar *ZZ = buf, *ZAZ = ZZ + a * a, *ZR = ZAZ + a * a, *d = ZR + a * a;
+
+    PetscCall(KSPMatDenseLocalGram_Private(Z, 0, a, Z, 0, a, ZZ, a));
+    PetscCall(KSPMatDenseLocalGram_Private(Z, 0, a, AZ, 0, a, ZAZ, a));
+    PetscCall(KSPMatDenseLocalGram_Private(Z, 0, a, R, 0, a, ZR, a));
+    PetscCall(KSPCGBlockLocalNormDots_Private(ksp, a, R, Z, d));
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, buf, 3 * a * a + a, MPIU_SCALAR, MPIU_SUM, comm));
+    PetscCall(PetscArraycpy(GW, ZZ, a * a));
+    PetscCall(PetscArraycpy(WAW, ZAZ, a * a));
+    PetscCall(PetscArraycpy(WR, ZR, a * a));
+    KSPCGBlockNorms_Private(ksp, a, ZZ, d, rnorm);
+  }
+  PetscCall(KSPBlockConverged_Private(ksp, N, a, idx, ksp->normtype != KSP_NORM_NONE ? rnorm : NULL, rnorm0, conv));
+
+  while (!ksp->reason) {
+    /* the new search directions W = Z + P beta, with beta = 0 in the first iteration, are stored in Z, and A W = A Z + Q beta in AZ */
+    PetscCall(KSPCGBlockDeflate_Private(&a, k, idx, conv, X, &Xa, &R, &Z, &AZ, GW, WAW, WR, beta, zref));
+    if (ksp->its) {
+      PetscCall(KSPMatDenseGEMM_Private(Z, 0, a, 1.0, 1.0, P, 0, k, beta, k));
+      PetscCall(KSPMatDenseGEMM_Private(AZ, 0, a, 1.0, 1.0, Q, 0, k, beta, k));
+    }
+    PetscCall(KSPBlockOrthonormalize_Private(a, GW, ksp->its ? zref : NULL, PETSC_SQRT_MACHINE_EPSILON, &k, T, S, a));
+    if (!k) {
+      PetscCall(PetscInfo(ksp, "Block search directions have vanished at iteration %" PetscInt_FMT "\n", ksp->its));
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      break;
+    }
+    PetscCall(KSPMatDenseResize_Private(B, k, &P));
+    PetscCall(KSPMatDenseResize_Private(B, k, &Q));
+    PetscCall(KSPMatDenseGEMM_Private(P, 0, k, 0.0, 1.0, Z, 0, a, T, a));
+    PetscCall(KSPMatDenseGEMM_Private(Q, 0, k, 0.0, 1.0, AZ, 0, a, T, a));
+
+    /* P = W T, so P^H A P = T^H W^H A W T and alpha = (P^H A P)^{-1} T^H W^H R */
+    PetscCall(PetscBLASIntCast(k, &bk));
+    PetscCall(PetscBLASIntCast(a, &ba));
+    PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &ba, &bk, &ba, &one, WAW, &ba, T, &ba, &zero, tmp, &ba));
+    PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &bk, &bk, &ba, &one, T, &ba, tmp, &ba, &zero, PQ, &bk));
+    PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &bk, &ba, &ba, &one, T, &ba, WR, &ba, &zero, alpha, &bk));
+    PetscCall(PetscLogFlops(2.0 * a * k * (2 * a + k)));
+    PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+    PetscCallBLAS("LAPACKpotrf", LAPACKpotrf_("L", &bk, PQ, &bk, &info));
+    PetscCall(PetscFPTrapPop());
+    if (info) {
+      PetscCall(PetscInfo(ksp, "Block P^H A P is not positive definite at iteration %" PetscInt_FMT "\n", ksp->its));
+      ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+      break;
+    }
+    PetscCallBLAS("LAPACKpotrs", LAPACKpotrs_("L", &bk, &ba, PQ, &bk, alpha, &bk, &info));
+    PetscCall(KSPMatDenseGEMM_Private(Xa, 0, a, 1.0, 1.0, P, 0, k, alpha, k));
+    PetscCall(KSPMatDenseGEMM_Private(R, 0, a, 1.0, -1.0, Q, 0, k, alpha, k));
+    PetscCall(KSP_PCMatApply(ksp, R, Z));
+    PetscCall(KSPBlockMatMult_Private(ksp, A, Z, &AZ));
+
+    /* Q^H Z, P^H Z, P^H R, Z^H Z, Z^H A Z, Z^H R, P^H P, P^H Q and the norms with a single reduction */
+    {
+      PetscScalar *QZ = buf, *PZ = QZ + k * a, *PR = PZ + k * a, *ZZ = PR + k * a, *ZAZ = ZZ + a * a, *ZR = ZAZ + a * a, *PP = ZR + a * a, *PQn = PP + k * k, *d = PQn + k * k;
+
+      PetscCall(KSPMatDenseLocalGram_Private(Q, 0, k, Z, 0, a, QZ, k));
+      PetscCall(KSPMatDenseLocalGram_Private(P, 0, k, Z, 0, a, PZ, k));
+      PetscCall(KSPMatDenseLocalGram_Private(P, 0, k, R, 0, a, PR, k));
+      PetscCall(KSPMatDenseLocalGram_Private(Z, 0, a, Z, 0, a, ZZ, a));
+      PetscCall(KSPMatDenseLocalGram_Private(Z, 0, a, AZ, 0, a, ZAZ, a));
+      PetscCall(KSPMatDenseLocalGram_Private(Z, 0, a, R, 0, a, ZR, a));
+      PetscCall(KSPMatDenseLocalGram_Private(P, 0, k, P, 0, k, PP, k));
+      PetscCall(KSPMatDenseLocalGram_Private(P, 0, k, Q, 0, k, PQn, k));
+      PetscCall(KSPCGBlockLocalNormDots_Private(ksp, a, R, Z, d));
+      PetscCall(MPIU_Allreduce(MPI_IN_PLACE, buf, 3 * k * a + 3 * a * a + 2 * k * k + a, MPIU_SCALAR, MPIU_SUM, comm));
+      PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+      ksp->its++;
+      PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+      KSPCGBlockNorms_Private(ksp, a, ZZ, d, rnorm);
+      PetscCall(KSPBlockConverged_Private(ksp, N, a, idx, ksp->normtype != KSP_NORM_NONE ? rnorm : NULL, rnorm0, conv));
+      if (ksp->reason) break;
+
+      /* beta = -(P^H A P)^{-1} Q^H Z, and the products of W = Z + P beta: GW = W^H W, WAW = W^H A W and WR = W^H R */
+      PetscCall(PetscArraycpy(beta, QZ, k * a));
+      PetscCallBLAS("LAPACKpotrs", LAPACKpotrs_("L", &bk, &ba, PQ, &bk, beta, &bk, &info));
+      for (PetscInt i = 0; i < k * a; i++) beta[i] = -beta[i];
+      PetscCall(PetscArraycpy(GW, ZZ, a * a));
+      PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bk, &ba, &bk, &one, PP, &bk, beta, &bk, &zero, tmp, &bk));
+      PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &ba, &ba, &bk, &one, PZ, &bk, beta, &bk, &one, GW, &ba));
+      PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &ba, &ba, &bk, &one, beta, &bk, PZ, &bk, &one, GW, &ba));
+      PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &ba, &ba, &bk, &one, beta, &bk, tmp, &bk, &one, GW, &ba));
+      PetscCall(PetscArraycpy(WAW, ZAZ, a * a));
+      PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bk, &ba, &bk, &one, PQn, &bk, beta, &bk, &zero, tmp, &bk));
+      PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &ba, &ba, &bk, &one, QZ, &bk, beta, &bk, &one, WAW, &ba));
+      PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &ba, &ba, &bk, &one, beta, &bk, QZ, &bk, &one, WAW, &ba));
+      PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &ba, &ba, &bk, &one, beta, &bk, tmp, &bk, &one, WAW, &ba));
+      PetscCall(PetscArraycpy(WR, ZR, a * a));
+      PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &ba, &ba, &bk, &one, beta, &bk, PR, &bk, &one, WR, &ba));
+      PetscCall(PetscLogFlops(2.0 * k * a * (2 * k + 7 * a)));
+      for (PetscInt i = 0; i < a; i++) zref[i] = PetscRealPart(ZZ[i * a + i]);
+    }
+  }
+  PetscCall(KSPMatDenseCopyColumns_Private(Xa, a, idx, NULL, X));
+
+  PetscCall(MatDestroy(&Q));
+  PetscCall(MatDestroy(&P));
+  PetscCall(MatDestroy(&AZ));
+  PetscCall(MatDestroy(&Z));
+  PetscCall(MatDestroy(&R));
+  PetscCall(MatDestroy(&Xa));
+  PetscCall(PetscFree7(buf, PQ, beta, tmp, T, S, GW));
+  PetscCall(PetscFree5(idx, conv, rnorm, rnorm0, zref));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -18,6 +18,7 @@ PETSC_INTERN PetscErrorCode KSPReset_CG(KSP);
 PETSC_INTERN PetscErrorCode KSPView_CG(KSP, PetscViewer);
 PETSC_INTERN PetscErrorCode KSPSetFromOptions_CG(KSP, PetscOptionItems *);
 PETSC_INTERN PetscErrorCode KSPCGSetType_CG(KSP, KSPCGType);
+PETSC_INTERN PetscErrorCode KSPMatSolve_CG_Block(KSP, Mat, Mat);
 
 /*
     This struct is shared by several KSP implementations
@@ -36,4 +37,5 @@ typedef struct {
   PetscReal obj_min;
 
   PetscBool singlereduction; /* use variant of CG that combines both inner products */
+  PetscBool blockmatsolve;   /* use block CG in KSPMatSolve() */
 } KSP_CG;
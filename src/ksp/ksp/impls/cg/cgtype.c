@@ -70,6 +70,50 @@ PetscErrorCode KSPCGUseSingleReduction(KSP ksp, PetscBool flg)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  KSPCGUseBlockMatSolve - Solves all the right-hand sides of `KSPMatSolve()` together with a block conjugate gradient method
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the iterative context
+- flg - turn on or off the block method
+
+  Options Database Key:
+. -ksp_cg_block_matsolve <bool> - Use block CG in `KSPMatSolve()`
+
+  Level: intermediate
+
+  Notes:
+  The search directions of all the right-hand sides are orthonormalized together with dense matrix-matrix products on the local
+  rows and a small eigenvalue problem, so that rank-deficient directions are dropped [2], and each column is removed from the
+  block as soon as it has converged. Each block iteration does one `MatMatMult()`, one `PCMatApply()`, and a single `MPI_Allreduce()`
+  whatever the number of right-hand sides, which pays off when solving for tens or hundreds of right-hand sides with the same operator.
+  The operator is applied to the preconditioned residuals of the columns that have not converged, and its product with the search
+  directions is obtained by a recurrence, so there is one more `MatMatMult()` than block iterations.
+
+  This option is not available for `KSPCGNE`.
+
+  The iteration count of the `KSP` is the number of block iterations, the monitored residual norm is the largest norm of the
+  columns that have not converged yet, and each column is tested for convergence relative to its own initial residual norm.
+
+  Without this option, or with `KSPSolve()`, the right-hand sides are solved one at a time with the usual `KSPCG`.
+
+  References:
++   [1] - Dianne P. O'Leary, The block conjugate gradient algorithm and related methods, Linear Algebra and its Applications, 1980.
+-   [2] - Hao Ji and Yaohang Li, A breakdown-free block conjugate gradient method, BIT Numerical Mathematics, 2017.
+
+.seealso: [](ch_ksp), `KSP`, `KSPCG`, `KSPMatSolve()`, `KSPSetMatSolveBatchSize()`, `KSPGMRESUseBlockMatSolve()`, `KSPHPDDM`
+@*/
+PetscErrorCode KSPCGUseBlockMatSolve(KSP ksp, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ksp, flg, 2);
+  PetscTryMethod(ksp, "KSPCGUseBlockMatSolve_C", (KSP, PetscBool), (ksp, flg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   KSPCGSetRadius - Sets the radius of the trust region
 
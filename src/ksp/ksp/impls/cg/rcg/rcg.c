@@ -0,0 +1,579 @@
+#include <petsc/private/kspimpl.h>
+#include <petscblaslapack.h>
+
+typedef struct {
+  PetscInt         recycle;              /* maximal dimension of the recycled subspace */
+  PetscInt         directions;           /* number of search directions of each solve kept to update it */
+  PetscInt         k;                    /* current dimension of the recycled subspace */
+  PetscInt         nl;                   /* number of search directions kept during the current solve */
+  Vec             *U, *AU, *MAU;         /* recycled subspace, with U^H A U = I, and its images by A and B A */
+  Vec             *Unew, *AUnew, *MAUnew; /* work vectors to compute the next ones */
+  Vec             *P, *AP, *Z;           /* first search directions of the solve, their images by A, and the preconditioned residuals */
+  Vec             *W, *AW, *MAW;         /* pointers to [U, P], [AU, AP], and [MAU, B AP] */
+  PetscScalar     *alpha, *mu, *G, *F, *work;
+  PetscReal       *theta, *rwork;
+  PetscObjectId    Aid, Pid; /* operators used to compute AU and MAU, a change triggers their recomputation */
+  PetscObjectState Astate, Pstate;
+} KSP_RCG;
+
+static PetscErrorCode KSPReset_RCG(KSP ksp)
+{
+  KSP_RCG *rcg = (KSP_RCG *)ksp->data;
+
+  PetscFunctionBegin;
+  if (rcg->U) {
+    PetscCall(VecDestroyVecs(rcg->recycle, &rcg->U));
+    PetscCall(VecDestroyVecs(rcg->recycle, &rcg->AU));
+    PetscCall(VecDestroyVecs(rcg->recycle, &rcg->MAU));
+    PetscCall(VecDestroyVecs(rcg->recycle, &rcg->Unew));
+    PetscCall(VecDestroyVecs(rcg->recycle, &rcg->AUnew));
+    PetscCall(VecDestroyVecs(rcg->recycle, &rcg->MAUnew));
+    PetscCall(VecDestroyVecs(rcg->directions, &rcg->P));
+    PetscCall(VecDestroyVecs(rcg->directions, &rcg->AP));
+    PetscCall(VecDestroyVecs(rcg->directions + 1, &rcg->Z));
+    PetscCall(PetscFree3(rcg->W, rcg->AW, rcg->MAW));
+    PetscCall(PetscFree5(rcg->alpha, rcg->mu, rcg->G, rcg->F, rcg->work));
+    PetscCall(PetscFree2(rcg->theta, rcg->rwork));
+  }
+  rcg->k = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetUp_RCG(KSP ksp)
+{
+  KSP_RCG *rcg = (KSP_RCG *)ksp->data;
+  PetscInt n   = rcg->recycle + rcg->directions;
+
+  PetscFunctionBegin;
+  PetscCall(KSPReset_RCG(ksp));
+  PetscCall(KSPSetWorkVecs(ksp, 4));
+  if (!rcg->recycle) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(KSPCreateVecs(ksp, rcg->recycle, &rcg->U, 0, NULL));
+  PetscCall(KSPCreateVecs(ksp, rcg->recycle, &rcg->AU, 0, NULL));
+  PetscCall(KSPCreateVecs(ksp, rcg->recycle, &rcg->MAU, 0, NULL));
+  PetscCall(KSPCreateVecs(ksp, rcg->recycle, &rcg->Unew, 0, NULL));
+  PetscCall(KSPCreateVecs(ksp, rcg->recycle, &rcg->AUnew, 0, NULL));
+  PetscCall(KSPCreateVecs(ksp, rcg->recycle, &rcg->MAUnew, 0, NULL));
+  PetscCall(KSPCreateVecs(ksp, rcg->directions, &rcg->P, 0, NULL));
+  PetscCall(KSPCreateVecs(ksp, rcg->directions, &rcg->AP, 0, NULL));
+  PetscCall(KSPCreateVecs(ksp, rcg->directions + 1, &rcg->Z, 0, NULL));
+  PetscCall(PetscMalloc3(n, &rcg->W, n, &rcg->AW, n, &rcg->MAW));
+  PetscCall(PetscMalloc5(rcg->directions, &rcg->alpha, rcg->recycle, &rcg->mu, n * n, &rcg->G, n * n, &rcg->F, 3 * n, &rcg->work));
+  PetscCall(PetscMalloc2(n, &rcg->theta, 3 * n, &rcg->rwork));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPDestroy_RCG(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPReset_RCG(ksp));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPRCGSetRecycleDimension_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPRCGSetDirections_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPRCGResetRecycleSpace_C", NULL));
+  PetscCall(KSPDestroyDefault(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetFromOptions_RCG(KSP ksp, PetscOptionItems *PetscOptionsObject)
+{
+  KSP_RCG  *rcg = (KSP_RCG *)ksp->data;
+  PetscInt  recycle = rcg->recycle, directions = rcg->directions;
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "KSP RCG options");
+  PetscCall(PetscOptionsInt("-ksp_rcg_recycle", "Dimension of the recycled subspace", "KSPRCGSetRecycleDimension", recycle, &recycle, &flg));
+  if (flg) PetscCall(KSPRCGSetRecycleDimension(ksp, recycle));
+  PetscCall(PetscOptionsInt("-ksp_rcg_directions", "Number of search directions kept to update the recycled subspace", "KSPRCGSetDirections", directions, &directions, &flg));
+  if (flg) PetscCall(KSPRCGSetDirections(ksp, directions));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPView_RCG(KSP ksp, PetscViewer viewer)
+{
+  KSP_RCG  *rcg = (KSP_RCG *)ksp->data;
+  PetscBool iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  dimension of the recycled subspace: %" PetscInt_FMT ", currently %" PetscInt_FMT "\n", rcg->recycle, rcg->k));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  search directions kept to update it: %" PetscInt_FMT "\n", rcg->directions));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Replaces [U, AU] by [U, AU] R^-1 with U^H A U = R^H R, so that U^H A U = I; the rank deficient case discards the recycled subspace
+*/
+static PetscErrorCode KSPRCGOrthonormalize_Private(KSP ksp)
+{
+  KSP_RCG     *rcg = (KSP_RCG *)ksp->data;
+  PetscInt     k   = rcg->k;
+  PetscBLASInt bk, info;
+  Vec         *swap;
+  PetscBool    inuse;
+
+  PetscFunctionBegin;
+  PetscCall(KSPSplitReductionInUse_Private(ksp, &inuse));
+  if (inuse) {
+    for (PetscInt j = 0; j < k; j++) PetscCall(VecMDot(rcg->AU[j], j + 1, rcg->U, rcg->G + j * k));
+  } else {
+    for (PetscInt j = 0; j < k; j++) PetscCall(VecMDotBegin(rcg->AU[j], j + 1, rcg->U, rcg->G + j * k));
+    PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)ksp)));
+    for (PetscInt j = 0; j < k; j++) PetscCall(VecMDotEnd(rcg->AU[j], j + 1, rcg->U, rcg->G + j * k));
+  }
+  PetscCall(PetscBLASIntCast(k, &bk));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+  PetscCallBLAS("LAPACKpotrf", LAPACKpotrf_("U", &bk, rcg->G, &bk, &info));
+  if (!info) PetscCallBLAS("LAPACKtrtri", LAPACKtrtri_("U", "N", &bk, rcg->G, &bk, &info));
+  PetscCall(PetscFPTrapPop());
+  if (info) {
+    PetscCall(PetscInfo(ksp, "U^H A U is not numerically positive definite, discarding the recycled subspace\n"));
+    rcg->k = 0;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (PetscInt j = 0; j < k; j++) {
+    PetscCall(VecMAXPBY(rcg->Unew[j], j + 1, rcg->G + j * k, 0.0, rcg->U));
+    PetscCall(VecMAXPBY(rcg->AUnew[j], j + 1, rcg->G + j * k, 0.0, rcg->AU));
+  }
+  swap       = rcg->U;
+  rcg->U     = rcg->Unew;
+  rcg->Unew  = swap;
+  swap       = rcg->AU;
+  rcg->AU    = rcg->AUnew;
+  rcg->AUnew = swap;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  When the operators have changed since AU and MAU were computed, recomputes them with k matrix-vector products and preconditioner applications
+*/
+static PetscErrorCode KSPRCGCheckOperators_Private(KSP ksp, Mat Amat, Mat Pmat)
+{
+  KSP_RCG         *rcg = (KSP_RCG *)ksp->data;
+  PetscObjectId    Aid, Pid;
+  PetscObjectState Astate, Pstate;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetId((PetscObject)Amat, &Aid));
+  PetscCall(PetscObjectGetId((PetscObject)Pmat, &Pid));
+  PetscCall(PetscObjectStateGet((PetscObject)Amat, &Astate));
+  PetscCall(PetscObjectStateGet((PetscObject)Pmat, &Pstate));
+  if (rcg->k && (Aid != rcg->Aid || Astate != rcg->Astate)) {
+    PetscCall(PetscInfo(ksp, "Operator has changed, recomputing the image of the recycled subspace of dimension %" PetscInt_FMT "\n", rcg->k));
+    for (PetscInt i = 0; i < rcg->k; i++) PetscCall(KSP_MatMult(ksp, Amat, rcg->U[i], rcg->AU[i]));
+    PetscCall(KSPRCGOrthonormalize_Private(ksp));
+    for (PetscInt i = 0; i < rcg->k; i++) PetscCall(KSP_PCApply(ksp, rcg->AU[i], rcg->MAU[i]));
+  } else if (rcg->k && (Pid != rcg->Pid || Pstate != rcg->Pstate)) {
+    for (PetscInt i = 0; i < rcg->k; i++) PetscCall(KSP_PCApply(ksp, rcg->AU[i], rcg->MAU[i]));
+  }
+  rcg->Aid    = Aid;
+  rcg->Pid    = Pid;
+  rcg->Astate = Astate;
+  rcg->Pstate = Pstate;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  z <- Br, then mu <- (AU)^H z, beta <- z^H r and the norm used by the convergence test, all with a single reduction
+*/
+static PetscErrorCode KSPRCGPCApplyDots_Private(KSP ksp, Vec R, Vec Z, PetscScalar *beta, PetscReal *dp)
+{
+  KSP_RCG  *rcg = (KSP_RCG *)ksp->data;
+  Vec       N   = NULL;
+  PetscBool inuse;
+
+  PetscFunctionBegin;
+  PetscCall(KSP_PCApply(ksp, R, Z));
+  if (ksp->normtype == KSP_NORM_PRECONDITIONED) N = Z;
+  else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) N = R;
+  PetscCall(KSPSplitReductionInUse_Private(ksp, &inuse));
+  if (inuse) {
+    if (rcg->k) PetscCall(VecMDot(Z, rcg->k, rcg->AU, rcg->mu));
+    PetscCall(VecDot(Z, R, beta));
+    if (N) PetscCall(VecNorm(N, NORM_2, dp));
+  } else {
+    if (rcg->k) PetscCall(VecMDotBegin(Z, rcg->k, rcg->AU, rcg->mu));
+    PetscCall(VecDotBegin(Z, R, beta));
+    if (N) PetscCall(VecNormBegin(N, NORM_2, dp));
+    PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)ksp)));
+    if (rcg->k) PetscCall(VecMDotEnd(Z, rcg->k, rcg->AU, rcg->mu));
+    PetscCall(VecDotEnd(Z, R, beta));
+    if (N) PetscCall(VecNormEnd(N, NORM_2, dp));
+  }
+  if (ksp->normtype == KSP_NORM_NATURAL) *dp = PetscSqrtReal(PetscAbsScalar(*beta));
+  else if (ksp->normtype == KSP_NORM_NONE) *dp = 0.0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Updates the recycled subspace with the Rayleigh-Ritz procedure of [1] on W = [U, P], the approximate eigenvectors of B A associated
+  with the smallest eigenvalues theta of
+
+    (AW)^H B (AW) y = theta W^H A W y
+
+  normalized so that the new U = W Y satisfies U^H A U = I. B A P is available without any preconditioner application since
+  B A p_j = (z_j - z_{j+1}) / alpha_j.
+*/
+static PetscErrorCode KSPRCGUpdateRecycleSpace_Private(KSP ksp)
+{
+  KSP_RCG     *rcg = (KSP_RCG *)ksp->data;
+  PetscInt     k = rcg->k, nl = rcg->nl, n = k + nl, kk;
+  PetscBLASInt bn, lwork, itype = 1, info;
+  Vec         *swap;
+  PetscBool    inuse;
+
+  PetscFunctionBegin;
+  if (!nl) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt j = 0; j < nl; j++) PetscCall(VecAXPBY(rcg->Z[j], -1.0 / rcg->alpha[j], 1.0 / rcg->alpha[j], rcg->Z[j + 1]));
+  for (PetscInt j = 0; j < k; j++) {
+    rcg->W[j]   = rcg->U[j];
+    rcg->AW[j]  = rcg->AU[j];
+    rcg->MAW[j] = rcg->MAU[j];
+  }
+  for (PetscInt j = 0; j < nl; j++) {
+    rcg->W[k + j]   = rcg->P[j];
+    rcg->AW[k + j]  = rcg->AP[j];
+    rcg->MAW[k + j] = rcg->Z[j];
+  }
+  /* G = W^H A W and F = (AW)^H B A W, only the upper triangular parts are needed */
+  PetscCall(KSPSplitReductionInUse_Private(ksp, &inuse));
+  if (inuse) {
+    for (PetscInt j = 0; j < n; j++) {
+      PetscCall(VecMDot(rcg->AW[j], j + 1, rcg->W, rcg->G + j * n));
+      PetscCall(VecMDot(rcg->MAW[j], j + 1, rcg->AW, rcg->F + j * n));
+    }
+  } else {
+    for (PetscInt j = 0; j < n; j++) {
+      PetscCall(VecMDotBegin(rcg->AW[j], j + 1, rcg->W, rcg->G + j * n));
+      PetscCall(VecMDotBegin(rcg->MAW[j], j + 1, rcg->AW, rcg->F + j * n));
+    }
+    PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)ksp)));
+    for (PetscInt j = 0; j < n; j++) {
+      PetscCall(VecMDotEnd(rcg->AW[j], j + 1, rcg->W, rcg->G + j * n));
+      PetscCall(VecMDotEnd(rcg->MAW[j], j + 1, rcg->AW, rcg->F + j * n));
+    }
+  }
+  PetscCall(PetscBLASIntCast(n, &bn));
+  PetscCall(PetscBLASIntCast(3 * n, &lwork));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKhegv", LAPACKsygv_(&itype, "V", "U", &bn, rcg->F, &bn, rcg->G, &bn, rcg->theta, rcg->work, &lwork, rcg->rwork, &info));
+#else
+  PetscCallBLAS("LAPACKsygv", LAPACKsygv_(&itype, "V", "U", &bn, rcg->F, &bn, rcg->G, &bn, rcg->theta, rcg->work, &lwork, &info));
+#endif
+  PetscCall(PetscFPTrapPop());
+  if (info) {
+    PetscCall(PetscInfo(ksp, "Error %d in LAPACK routine xSYGV, keeping the recycled subspace\n", (int)info));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  /* the eigenvalues are in ascending order, and the eigenvectors satisfy Y^H G Y = I */
+  kk = PetscMin(rcg->recycle, n);
+  for (PetscInt i = 0; i < kk; i++) {
+    PetscCall(VecMAXPBY(rcg->Unew[i], n, rcg->F + i * n, 0.0, rcg->W));
+    PetscCall(VecMAXPBY(rcg->AUnew[i], n, rcg->F + i * n, 0.0, rcg->AW));
+    PetscCall(VecMAXPBY(rcg->MAUnew[i], n, rcg->F + i * n, 0.0, rcg->MAW));
+  }
+  swap        = rcg->U;
+  rcg->U      = rcg->Unew;
+  rcg->Unew   = swap;
+  swap        = rcg->AU;
+  rcg->AU     = rcg->AUnew;
+  rcg->AUnew  = swap;
+  swap        = rcg->MAU;
+  rcg->MAU    = rcg->MAUnew;
+  rcg->MAUnew = swap;
+  rcg->k      = kk;
+  PetscCall(PetscInfo(ksp, "Recycled subspace of dimension %" PetscInt_FMT ", smallest Ritz value %g\n", kk, (double)rcg->theta[0]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSolve_RCG(KSP ksp)
+{
+  KSP_RCG    *rcg = (KSP_RCG *)ksp->data;
+  PetscScalar beta, betaold, dpi, a, b;
+  PetscReal   dp = 0.0;
+  Vec         X, B, R, Z, P, W;
+  Mat         Amat, Pmat;
+  PetscBool   diagonalscale, keep;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
+  PetscCheck(!diagonalscale, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Krylov method %s does not support diagonal scaling", ((PetscObject)ksp)->type_name);
+
+  X = ksp->vec_sol;
+  B = ksp->vec_rhs;
+  R = ksp->work[0];
+  Z = ksp->work[1];
+  P = ksp->work[2];
+  W = ksp->work[3];
+  PetscCall(PCGetOperators(ksp->pc, &Amat, &Pmat));
+  PetscCall(KSPRCGCheckOperators_Private(ksp, Amat, Pmat));
+
+  ksp->its = 0;
+  rcg->nl  = 0;
+  if (!ksp->guess_zero) {
+    PetscCall(KSP_MatMult(ksp, Amat, X, R)); /*    r <- b - Ax                       */
+    PetscCall(VecAYPX(R, -1.0, B));
+  } else {
+    PetscCall(VecCopy(B, R)); /*    r <- b (x is 0)                   */
+  }
+  /* A-orthogonal projection of the error onto the recycled subspace: x <- x + U U^H r, r <- r - AU U^H r */
+  if (rcg->k) {
+    PetscCall(VecMDot(R, rcg->k, rcg->U, rcg->mu));
+    PetscCall(VecMAXPY(X, rcg->k, rcg->mu, rcg->U));
+    for (PetscInt i = 0; i < rcg->k; i++) rcg->mu[i] = -rcg->mu[i];
+    PetscCall(VecMAXPY(R, rcg->k, rcg->mu, rcg->AU));
+  }
+  /* This may be true only on a subset of MPI ranks; setting it here so it will be detected by the first norm computation below */
+  if (ksp->reason == KSP_DIVERGED_PC_FAILED) PetscCall(VecSetInf(R));
+
+  PetscCall(KSPRCGPCApplyDots_Private(ksp, R, Z, &beta, &dp)); /*    z <- Br, mu <- (AU)'*z, beta <- z'*r */
+  KSPCheckNorm(ksp, dp);
+  KSPCheckDot(ksp, beta);
+  PetscCall(KSPLogResidualHistory(ksp, dp));
+  PetscCall(KSPMonitor(ksp, ksp->its, dp));
+  ksp->rnorm = dp;
+  PetscCall((*ksp->converged)(ksp, ksp->its, dp, &ksp->reason, ksp->cnvP)); /* test for convergence */
+  if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(VecCopy(Z, P)); /*     p <- z - U mu                    */
+  if (rcg->k) {
+    for (PetscInt i = 0; i < rcg->k; i++) rcg->mu[i] = -rcg->mu[i];
+    PetscCall(VecMAXPY(P, rcg->k, rcg->mu, rcg->U));
+  }
+  if (rcg->recycle && rcg->directions) PetscCall(VecCopy(Z, rcg->Z[0]));
+  do {
+    if (beta == 0.0) {
+      ksp->reason = KSP_CONVERGED_ATOL;
+      PetscCall(PetscInfo(ksp, "converged due to beta = 0\n"));
+      break;
+    } else if (PetscRealPart(beta) < 0.0) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Diverged due to indefinite preconditioner, beta %g", (double)PetscRealPart(beta));
+      ksp->reason = KSP_DIVERGED_INDEFINITE_PC;
+      PetscCall(PetscInfo(ksp, "diverging due to indefinite preconditioner\n"));
+      break;
+    }
+    PetscCall(KSP_MatMultDot(ksp, Amat, P, W, P, &dpi)); /*     w <- Ap, dpi <- p'w              */
+    KSPCheckDot(ksp, dpi);
+    if (PetscRealPart(dpi) <= 0.0) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Diverged due to indefinite matrix, dpi %g", (double)PetscRealPart(dpi));
+      ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+      PetscCall(PetscInfo(ksp, "diverging due to indefinite or negative definite matrix\n"));
+      break;
+    }
+    a = beta / dpi; /*     a = z'r/p'Ap                     */
+    keep = (PetscBool)(rcg->recycle && rcg->nl < rcg->directions);
+    if (keep) {
+      PetscCall(VecCopy(P, rcg->P[rcg->nl]));
+      PetscCall(VecCopy(W, rcg->AP[rcg->nl]));
+      rcg->alpha[rcg->nl++] = a;
+    }
+    PetscCall(VecAXPY(X, a, P));  /*     x <- x + ap                      */
+    PetscCall(VecAXPY(R, -a, W)); /*     r <- r - aw                      */
+    betaold = beta;
+    PetscCall(KSPRCGPCApplyDots_Private(ksp, R, Z, &beta, &dp)); /*     z <- Br, mu <- (AU)'*z, beta <- z'*r */
+    KSPCheckNorm(ksp, dp);
+    KSPCheckDot(ksp, beta);
+    if (keep) PetscCall(VecCopy(Z, rcg->Z[rcg->nl]));
+    PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+    ksp->its++;
+    ksp->rnorm = dp;
+    PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+    PetscCall(KSPLogResidualHistory(ksp, dp));
+    PetscCall(KSPMonitor(ksp, ksp->its, dp));
+    PetscCall((*ksp->converged)(ksp, ksp->its, dp, &ksp->reason, ksp->cnvP));
+    if (ksp->reason) break;
+
+    b = beta / betaold;
+    PetscCall(VecAYPX(P, b, Z)); /*     p <- z + b p - U mu              */
+    if (rcg->k) {
+      for (PetscInt i = 0; i < rcg->k; i++) rcg->mu[i] = -rcg->mu[i];
+      PetscCall(VecMAXPY(P, rcg->k, rcg->mu, rcg->U));
+    }
+  } while (ksp->its < ksp->max_it);
+  if (ksp->its >= ksp->max_it && !ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+  if (ksp->reason > 0 || ksp->reason == KSP_DIVERGED_ITS) PetscCall(KSPRCGUpdateRecycleSpace_Private(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPRCGSetRecycleDimension_RCG(KSP ksp, PetscInt recycle)
+{
+  KSP_RCG *rcg = (KSP_RCG *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCheck(recycle >= 0, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Dimension of the recycled subspace must be nonnegative");
+  if (recycle == rcg->recycle) PetscFunctionReturn(PETSC_SUCCESS);
+  if (ksp->setupstage) {
+    PetscCall(KSPReset_RCG(ksp));
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  rcg->recycle = recycle;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPRCGSetDirections_RCG(KSP ksp, PetscInt directions)
+{
+  KSP_RCG *rcg = (KSP_RCG *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCheck(directions >= 0, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Number of search directions must be nonnegative");
+  if (directions == rcg->directions) PetscFunctionReturn(PETSC_SUCCESS);
+  if (ksp->setupstage) {
+    PetscCall(KSPReset_RCG(ksp));
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  rcg->directions = directions;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPRCGResetRecycleSpace_RCG(KSP ksp)
+{
+  KSP_RCG *rcg = (KSP_RCG *)ksp->data;
+
+  PetscFunctionBegin;
+  rcg->k = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPRCGSetRecycleDimension - Sets the maximal dimension of the subspace that `KSPRCG` recycles from one `KSPSolve()` to the next
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the Krylov space context
+- k   - the dimension, 0 turns `KSPRCG` into `KSPCG`, default 10
+
+  Options Database Key:
+. -ksp_rcg_recycle <k> - the dimension of the recycled subspace
+
+  Level: intermediate
+
+.seealso: [](ch_ksp), `KSPRCG`, `KSPRCGSetDirections()`, `KSPRCGResetRecycleSpace()`
+@*/
+PetscErrorCode KSPRCGSetRecycleDimension(KSP ksp, PetscInt k)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ksp, k, 2);
+  PetscTryMethod(ksp, "KSPRCGSetRecycleDimension_C", (KSP, PetscInt), (ksp, k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPRCGSetDirections - Sets the number of search directions of each `KSPSolve()` that `KSPRCG` keeps to update the recycled subspace
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the Krylov space context
+- l   - the number of search directions, default 20
+
+  Options Database Key:
+. -ksp_rcg_directions <l> - the number of search directions
+
+  Level: advanced
+
+  Note:
+  The first `l` search directions of each solve are stored, together with their images by the operator and the preconditioned residuals,
+  i.e., $3l + 1$ additional vectors.
+
+.seealso: [](ch_ksp), `KSPRCG`, `KSPRCGSetRecycleDimension()`
+@*/
+PetscErrorCode KSPRCGSetDirections(KSP ksp, PetscInt l)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ksp, l, 2);
+  PetscTryMethod(ksp, "KSPRCGSetDirections_C", (KSP, PetscInt), (ksp, l));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPRCGResetRecycleSpace - Discards the subspace recycled by `KSPRCG`, so that the next `KSPSolve()` starts from scratch
+
+  Logically Collective
+
+  Input Parameter:
+. ksp - the Krylov space context
+
+  Level: intermediate
+
+  Note:
+  There is no need to call this when the operator changes, e.g., from one `SNES` iteration or one `TS` step to the next, the image of the
+  recycled subspace by the new operator is then recomputed at the beginning of the next `KSPSolve()`.
+
+.seealso: [](ch_ksp), `KSPRCG`, `KSPRCGSetRecycleDimension()`
+@*/
+PetscErrorCode KSPRCGResetRecycleSpace(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscTryMethod(ksp, "KSPRCGResetRecycleSpace_C", (KSP), (ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   KSPRCG - Deflated, or recycled, preconditioned conjugate gradient method, def-CG(k, l) of [1], which keeps an approximate invariant
+   subspace of the preconditioned operator from one `KSPSolve()` to the next, so that sequences of symmetric positive definite linear
+   systems with slowly changing operators, e.g., in `SNES` or `TS`, converge in fewer iterations.
+
+   Options Database Keys:
++  -ksp_rcg_recycle <k>    - dimension of the recycled subspace, default 10
+-  -ksp_rcg_directions <l> - number of search directions of each solve kept to update it, default 20
+
+   Level: intermediate
+
+   Notes:
+   The recycled subspace U, with $U^H A U = I$, is removed from the error at the beginning of each solve, and every search direction is
+   kept A-orthogonal to it, at the price of k inner products, which share the reduction of the iteration, and of a k-vector update per
+   iteration. At the end of each solve, U is replaced by the Ritz vectors of the preconditioned operator for its k smallest eigenvalues
+   computed from the span of U and of the first l search directions of the solve.
+
+   When the operator has changed since the previous `KSPSolve()`, which is detected with `PetscObjectStateGet()`, its image of U is
+   recomputed with k matrix-vector products and preconditioner applications. Use `KSPRCGResetRecycleSpace()` to discard U when the problem
+   changes too much for it to be useful.
+
+   This requires 6k + 3l + 1 vectors in addition to the ones of `KSPCG`.
+
+   References:
++  [1] - Y. Saad, M. Yeung, J. Erhel, and F. Guyomarc'h, A deflated version of the conjugate gradient algorithm, SIAM Journal on Scientific
+   Computing, 21 (2000).
+-  [2] - M. L. Parks, E. de Sturler, G. Mackey, D. D. Johnson and S. Maiti, Recycling Krylov subspaces for sequences of linear systems,
+   SIAM Journal on Scientific Computing, 28 (2006).
+
+.seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPCG`, `KSPGCRODR`, `KSPRCGSetRecycleDimension()`, `KSPRCGSetDirections()`,
+          `KSPRCGResetRecycleSpace()`
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_RCG(KSP ksp)
+{
+  KSP_RCG *rcg;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&rcg));
+  rcg->recycle    = 10;
+  rcg->directions = 20;
+  ksp->data       = (void *)rcg;
+
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_PRECONDITIONED, PC_LEFT, 3));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_UNPRECONDITIONED, PC_LEFT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NATURAL, PC_LEFT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_LEFT, 1));
+
+  ksp->ops->setup          = KSPSetUp_RCG;
+  ksp->ops->solve          = KSPSolve_RCG;
+  ksp->ops->reset          = KSPReset_RCG;
+  ksp->ops->destroy        = KSPDestroy_RCG;
+  ksp->ops->view           = KSPView_RCG;
+  ksp->ops->setfromoptions = KSPSetFromOptions_RCG;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPRCGSetRecycleDimension_C", KSPRCGSetRecycleDimension_RCG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPRCGSetDirections_C", KSPRCGSetDirections_RCG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPRCGResetRecycleSpace_C", KSPRCGResetRecycleSpace_RCG));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
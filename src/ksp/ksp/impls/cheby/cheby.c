@@ -1,5 +1,7 @@
 #include "chebyshevimpl.h"
 #include <../src/ksp/ksp/impls/cheby/chebyshevimpl.h> /*I "petscksp.h" I*/
+#include <petsc/private/matimpl.h>
+#include <petscsf.h>
 
 static const char *const KSPChebyshevKinds[] = {"FIRST", "FOURTH", "OPT_FOURTH", "KSPChebyshevKinds", "KSP_CHEBYSHEV_", NULL};
 
@@ -9,6 +11,8 @@ static PetscErrorCode KSPReset_Chebyshev(KSP ksp)
 
   PetscFunctionBegin;
   if (cheb->kspest) PetscCall(KSPReset(cheb->kspest));
+  PetscCall(PetscFree(cheb->mpkwork));
+  cheb->nmpkwork = 0;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -135,6 +139,15 @@ static PetscErrorCode KSPChebyshevGetKind_Chebyshev(KSP ksp, KSPChebyshevKind *k
   *kind = cheb->chebykind;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+static PetscErrorCode KSPChebyshevSetUseMatrixPowers_Chebyshev(KSP ksp, PetscBool flg)
+{
+  KSP_Chebyshev *cheb = (KSP_Chebyshev *)ksp->data;
+
+  PetscFunctionBegin;
+  cheb->matrixpowers = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 /*@
   KSPChebyshevSetEigenvalues - Sets estimates for the extreme eigenvalues of the preconditioned problem.
 
@@ -330,6 +343,40 @@ PetscErrorCode KSPChebyshevGetKind(KSP ksp, KSPChebyshevKind *kind)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  KSPChebyshevSetUseMatrixPowers - Applies the first kind Chebyshev iterations with a single halo exchange
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the Krylov space context
+- flg - `PETSC_TRUE` to use the ghost region of `MatMatrixPowers()`
+
+  Options Database Key:
+. -ksp_chebyshev_matrix_powers <bool> - use the matrix powers kernel
+
+  Level: advanced
+
+  Notes:
+  With a `MATMPIAIJ` operator, `KSP_NORM_NONE`, the same operator and preconditioning matrix, and `PCNONE` or the default
+  `PCJACOBI`, the `k` iterations of a first kind Chebyshev smoother, as in `PCMG` and `PCGAMG`, are computed redundantly on
+  the rows within distance `k` of the local rows, after exchanging the ghost entries of the solution and the right hand side
+  with a single message per neighbor process, instead of one exchange per iteration. In the other cases the flag is ignored.
+
+  This trades latency for redundant computation, and memory for the ghost region, so it pays off for low degree
+  smoothers when the messages dominate, typically on the coarser levels of the hierarchy or at large scale.
+
+.seealso: [](ch_ksp), `KSPCHEBYSHEV`, `MatMatrixPowers()`, `KSPChebyshevSetKind()`
+@*/
+PetscErrorCode KSPChebyshevSetUseMatrixPowers(KSP ksp, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ksp, flg, 2);
+  PetscTryMethod(ksp, "KSPChebyshevSetUseMatrixPowers_C", (KSP, PetscBool), (ksp, flg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode KSPChebyshevEstEigGetKSP_Chebyshev(KSP ksp, KSP *kspest)
 {
   KSP_Chebyshev *cheb = (KSP_Chebyshev *)ksp->data;
@@ -374,6 +421,7 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(KSP ksp, PetscOptionItems *Pet
 
   cheb->chebykind = KSP_CHEBYSHEV_FIRST; /* Default to 1st-kind Chebyshev polynomial */
   PetscCall(PetscOptionsEnum("-ksp_chebyshev_kind", "Type of Chebyshev polynomial", "KSPChebyshevKind", KSPChebyshevKinds, (PetscEnum)cheb->chebykind, (PetscEnum *)&cheb->chebykind, NULL));
+  PetscCall(PetscOptionsBool("-ksp_chebyshev_matrix_powers", "Apply the iterations with a single halo exchange", "KSPChebyshevSetUseMatrixPowers", cheb->matrixpowers, &cheb->matrixpowers, NULL));
 
   /* We need to estimate eigenvalues; need to set this here so that KSPSetFromOptions() is called on the estimator */
   if ((cheb->emin == 0. || cheb->emax == 0.) && !cheb->kspest) PetscCall(KSPChebyshevEstEigSet(ksp, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE, PETSC_DECIDE));
@@ -386,19 +434,154 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(KSP ksp, PetscOptionItems *Pet
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  Gets the ghost region used to apply the iterations with a single halo exchange, or NULL when it cannot be used; the
+  decision only depends on collective data so all the processes make the same
+*/
+static PetscErrorCode KSPChebyshevGetMatrixPowers_Private(KSP ksp, Mat_MatrixPowers **mpk, PetscBool *jacobi)
+{
+  KSP_Chebyshev *cheb = (KSP_Chebyshev *)ksp->data;
+  Mat            Amat, Pmat;
+  MatNullSpace   nullsp;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  *mpk    = NULL;
+  *jacobi = PETSC_FALSE;
+  if (!cheb->matrixpowers || ksp->normtype != KSP_NORM_NONE || ksp->transpose_solve || ksp->max_it < 1 || (ksp->guess_zero && ksp->max_it < 2)) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PCGetOperators(ksp->pc, &Amat, &Pmat));
+  if (Amat != Pmat) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatGetNullSpace(Amat, &nullsp));
+  if (nullsp) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectTypeCompare((PetscObject)ksp->pc, PCJACOBI, jacobi));
+  if (*jacobi) {
+    PCJacobiType type;
+    PetscBool    useabs, fixdiag;
+
+    PetscCall(PCJacobiGetType(ksp->pc, &type));
+    PetscCall(PCJacobiGetUseAbs(ksp->pc, &useabs));
+    PetscCall(PCJacobiGetFixDiagonal(ksp->pc, &fixdiag));
+    if (type != PC_JACOBI_DIAGONAL || useabs || !fixdiag) PetscFunctionReturn(PETSC_SUCCESS);
+  } else {
+    PetscCall(PetscObjectTypeCompare((PetscObject)ksp->pc, PCNONE, &flg));
+    if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  /* the diagonal is needed one level further than the products for a zero initial guess, so both cases use the same depth */
+  PetscCall(MatGetMatrixPowers_Private(Amat, ksp->max_it, mpk));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPSolve_Chebyshev_FirstKind_MatrixPowers - The iterations of KSPSolve_Chebyshev_FirstKind() without norms, computed on the
+  rows within distance max_it of the local rows after a single exchange of x and b; each iteration is valid one level less far
+*/
+static PetscErrorCode KSPSolve_Chebyshev_FirstKind_MatrixPowers(KSP ksp, Mat_MatrixPowers *mpk, PetscBool jacobi)
+{
+  KSP_Chebyshev     *cheb = (KSP_Chebyshev *)ksp->data;
+  PetscInt           km1 = 0, k = 1, kp1 = 2, ktmp, n = mpk->nlevel[0], nk = mpk->nlevel[mpk->k], lev, m;
+  PetscScalar        alpha, omegaprod, mu, omega, Gamma, c[3], scale, *p[3], *r, *b, *dinv, *xa;
+  const PetscScalar *ba;
+  PetscReal          emax, emin;
+  PetscSF            sf;
+
+  PetscFunctionBegin;
+  if (cheb->nmpkwork < 6 * nk) {
+    PetscCall(PetscFree(cheb->mpkwork));
+    PetscCall(PetscMalloc1(6 * nk, &cheb->mpkwork));
+    cheb->nmpkwork = 6 * nk;
+  }
+  p[0] = cheb->mpkwork;
+  p[1] = p[0] + nk;
+  p[2] = p[1] + nk;
+  r    = p[2] + nk;
+  b    = r + nk;
+  dinv = b + nk;
+
+  PetscCall(KSPChebyshevGetEigenvalues_Chebyshev(ksp, &emax, &emin));
+  scale     = 2.0 / (emax + emin);
+  alpha     = 1.0 - scale * emin;
+  Gamma     = 1.0;
+  mu        = 1.0 / alpha;
+  omegaprod = 2.0 / alpha;
+  c[km1]    = 1.0;
+  c[k]      = mu;
+
+  /* the inverse diagonal as PCJACOBI computes it, for the rows that are updated */
+  m = mpk->nlevel[mpk->k - 1];
+  for (PetscInt i = 0; i < m; i++) dinv[i] = jacobi ? (mpk->diag[i] == 0.0 ? 1.0 : 1.0 / mpk->diag[i]) : 1.0;
+
+  PetscCall(VecGetArray(ksp->vec_sol, &xa));
+  PetscCall(VecGetArrayRead(ksp->vec_rhs, &ba));
+  PetscCall(PetscArraycpy(b, ba, n));
+  if (!ksp->guess_zero) {
+    const void *roots[2]  = {xa, ba};
+    void       *leaves[2] = {p[km1], b};
+
+    PetscCall(MatMatrixPowersGetSF_Private(mpk, ksp->max_it, &sf));
+    PetscCall(PetscArraycpy(p[km1], xa, n));
+    PetscCall(PetscSFBcastMultiBegin(sf, MPIU_SCALAR, 2, roots, leaves, MPI_REPLACE));
+    PetscCall(PetscSFBcastMultiEnd(sf, MPIU_SCALAR, 2, roots, leaves, MPI_REPLACE));
+    lev = ksp->max_it;
+    PetscCall(MatMatrixPowersMult_Private(mpk, mpk->nlevel[lev - 1], p[km1], r)); /*  r = b - A*p[km1] */
+    lev--;
+    for (PetscInt i = 0; i < mpk->nlevel[lev]; i++) r[i] = b[i] - r[i];
+  } else {
+    /* b is only used within distance max_it-1 */
+    PetscCall(MatMatrixPowersGetSF_Private(mpk, ksp->max_it - 1, &sf));
+    PetscCall(PetscSFBcastBegin(sf, MPIU_SCALAR, ba, b, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_SCALAR, ba, b, MPI_REPLACE));
+    lev = ksp->max_it - 1;
+    PetscCall(PetscArrayzero(p[km1], mpk->nlevel[lev]));
+    PetscCall(PetscArraycpy(r, b, mpk->nlevel[lev]));
+  }
+  PetscCall(VecRestoreArrayRead(ksp->vec_rhs, &ba));
+  for (PetscInt i = 0; i < mpk->nlevel[lev]; i++) p[k][i] = scale * dinv[i] * r[i] + p[km1][i]; /* p[k] = scale B^{-1}r + p[km1] */
+
+  for (PetscInt it = 1; it < ksp->max_it; it++) {
+    PetscCall(MatMatrixPowersMult_Private(mpk, mpk->nlevel[lev - 1], p[k], r)); /*  r = A p[k]    */
+    lev--;
+    c[kp1] = 2.0 * mu * c[k] - c[km1];
+    omega  = omegaprod * c[k] / c[kp1];
+
+    /* y^{k+1} = omega(y^{k} - y^{k-1} + Gamma*r^{k}) + y^{k-1} */
+    for (PetscInt i = 0; i < mpk->nlevel[lev]; i++) p[kp1][i] = (1.0 - omega) * p[km1][i] + omega * p[k][i] + omega * Gamma * scale * dinv[i] * (b[i] - r[i]);
+    PetscCall(PetscLogFlops(9.0 * mpk->nlevel[lev]));
+
+    ktmp = km1;
+    km1  = k;
+    k    = kp1;
+    kp1  = ktmp;
+  }
+  PetscCheck(lev == 0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Iterations ended at level %" PetscInt_FMT, lev);
+  PetscCall(PetscArraycpy(xa, p[k], n));
+  PetscCall(VecRestoreArray(ksp->vec_sol, &xa));
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->its    = ksp->max_it;
+  ksp->reason = KSP_CONVERGED_ITS;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode KSPSolve_Chebyshev_FirstKind(KSP ksp)
 {
-  PetscInt    k, kp1, km1, ktmp, i;
-  PetscScalar alpha, omegaprod, mu, omega, Gamma, c[3], scale;
-  PetscReal   rnorm = 0.0, emax, emin;
-  Vec         sol_orig, b, p[3], r;
-  Mat         Amat, Pmat;
-  PetscBool   diagonalscale;
+  PetscInt          k, kp1, km1, ktmp, i;
+  PetscScalar       alpha, omegaprod, mu, omega, Gamma, c[3], scale;
+  PetscReal         rnorm = 0.0, emax, emin;
+  Vec               sol_orig, b, p[3], r;
+  Mat               Amat, Pmat;
+  PetscBool         diagonalscale, jacobi;
+  Mat_MatrixPowers *mpk;
 
   PetscFunctionBegin;
   PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
   PetscCheck(!diagonalscale, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Krylov method %s does not support diagonal scaling", ((PetscObject)ksp)->type_name);
 
+  PetscCall(KSPChebyshevGetMatrixPowers_Private(ksp, &mpk, &jacobi));
+  if (mpk) {
+    PetscCall(KSPSolve_Chebyshev_FirstKind_MatrixPowers(ksp, mpk, jacobi));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   PetscCall(PCGetOperators(ksp->pc, &Amat, &Pmat));
   PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
   ksp->its = 0;
@@ -727,6 +910,7 @@ static PetscErrorCode KSPView_Chebyshev(KSP ksp, PetscViewer viewer)
       PetscCall(PetscViewerASCIIPrintf(viewer, "  Chebyshev polynomial of opt. fourth kind\n"));
       break;
     }
+    if (cheb->matrixpowers && cheb->chebykind == KSP_CHEBYSHEV_FIRST) PetscCall(PetscViewerASCIIPrintf(viewer, "  using the matrix powers kernel when possible\n"));
     PetscReal emax, emin;
     PetscCall(KSPChebyshevGetEigenvalues_Chebyshev(ksp, &emax, &emin));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  eigenvalue targets used: min %g, max %g\n", (double)emin, (double)emax));
@@ -864,6 +1048,7 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 
   PetscFunctionBegin;
   PetscCall(PetscFree(cheb->betas));
+  PetscCall(PetscFree(cheb->mpkwork));
   PetscCall(KSPDestroy(&cheb->kspest));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetEigenvalues_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevEstEigSet_C", NULL));
@@ -871,6 +1056,7 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetKind_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevGetKind_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevEstEigGetKSP_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetUseMatrixPowers_C", NULL));
   PetscCall(KSPDestroyDefault(ksp));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -884,7 +1070,8 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 .   -ksp_chebyshev_esteig <a,b,c,d> - estimate eigenvalues using a Krylov method, then use this
                          transform for Chebyshev eigenvalue bounds (`KSPChebyshevEstEigSet()`)
 .   -ksp_chebyshev_esteig_steps - number of estimation steps
--   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+-   -ksp_chebyshev_matrix_powers - apply the iterations with a single halo exchange, `KSPChebyshevSetUseMatrixPowers()`
 
    Level: beginner
 
@@ -941,5 +1128,6 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetKind_C", KSPChebyshevSetKind_Chebyshev));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevGetKind_C", KSPChebyshevGetKind_Chebyshev));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevEstEigGetKSP_C", KSPChebyshevEstEigGetKSP_Chebyshev));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPChebyshevSetUseMatrixPowers_C", KSPChebyshevSetUseMatrixPowers_Chebyshev));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
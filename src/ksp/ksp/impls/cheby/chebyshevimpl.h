@@ -18,6 +18,11 @@ typedef struct {
   PetscInt         eststeps; /* number of kspest steps in KSP used to estimate eigenvalues */
   PetscBool        usenoisy; /* use noisy right hand side vector to estimate eigenvalues */
   KSPChebyshevKind chebykind;
+
+  PetscBool    matrixpowers; /* apply the first kind iterations on the ghost region of MatMatrixPowers() */
+  PetscScalar *mpkwork;      /* work arrays on the ghost region */
+  PetscInt     nmpkwork;
+
   /* For tracking when to update the eigenvalue estimates */
   PetscObjectId    amatid, pmatid;
   PetscObjectState amatstate, pmatstate;
@@ -89,22 +89,22 @@ static PetscErrorCode KSPSolve_CR(KSP ksp)
 
     PetscCall(VecAXPY(X, ai, P));               /*   X   <- X + ai*P     */
     PetscCall(VecAXPY(RT, -ai, Q));             /*   RT  <- RT - ai*Q    */
-    PetscCall(KSP_MatMult(ksp, Amat, RT, ART)); /*   ART <-   A*RT       */
     bbot = btop;
-    PetscCall(VecDotBegin(RT, ART, &btop));
-
-    if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+    if (ksp->normtype == KSP_NORM_NATURAL || ksp->normtype == KSP_NORM_NONE) {
+      /* (RT,ART) is the only reduction, so it is computed within the product */
+      PetscCall(KSP_MatMultDot(ksp, Amat, RT, ART, RT, &btop)); /*   ART <-   A*RT, (RT,ART) */
+      if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(btop)); /* dp = sqrt(R,AR)       */
+      else dp = 0.0; /* meaningless value that is passed to monitor and convergence test */
+    } else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
+      PetscCall(KSP_MatMult(ksp, Amat, RT, ART)); /*   ART <-   A*RT       */
+      PetscCall(VecDotBegin(RT, ART, &btop));
       PetscCall(VecNormBegin(RT, NORM_2, &dp)); /*   dp <- || RT ||      */
       PetscCall(VecDotEnd(RT, ART, &btop));
       PetscCall(VecNormEnd(RT, NORM_2, &dp)); /*   dp <- || RT ||      */
       KSPCheckNorm(ksp, dp);
-    } else if (ksp->normtype == KSP_NORM_NATURAL) {
-      PetscCall(VecDotEnd(RT, ART, &btop));
-      dp = PetscSqrtReal(PetscAbsScalar(btop)); /* dp = sqrt(R,AR)       */
-    } else if (ksp->normtype == KSP_NORM_NONE) {
-      PetscCall(VecDotEnd(RT, ART, &btop));
-      dp = 0.0; /* meaningless value that is passed to monitor and convergence test */
     } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
+      PetscCall(KSP_MatMult(ksp, Amat, RT, ART)); /*   ART <-   A*RT       */
+      PetscCall(VecDotBegin(RT, ART, &btop));
       PetscCall(VecAXPY(R, ai, AP));           /*   R   <- R - ai*AP    */
       PetscCall(VecNormBegin(R, NORM_2, &dp)); /*   dp <- R'*R          */
       PetscCall(VecDotEnd(RT, ART, &btop));
@@ -148,6 +148,9 @@ static PetscErrorCode KSPSolve_CR(KSP ksp)
 
    Support only for left preconditioning.
 
+   The product with the operator and the following inner product are computed together with `MatMultDot()`, so `-log_view` reports
+   the products of the iterations under `MatMultDot` instead of `MatMult`.
+
    References:
 .  * - Magnus R. Hestenes and Eduard Stiefel, Methods of Conjugate Gradients for Solving Linear Systems,
    Journal of Research of the National Bureau of Standards Vol. 49, No. 6, December 1952 Research Paper 2379
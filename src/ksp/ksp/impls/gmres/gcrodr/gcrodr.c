@@ -0,0 +1,799 @@
+/*
+    Implements GCRODR, GCRO with deflated restarting, which recycles a subspace from one restart and from one KSPSolve() to the next.
+*/
+
+#include <../src/ksp/ksp/impls/gmres/gcrodr/gcrodrimpl.h> /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
+
+static PetscErrorCode KSPGCRODRUpdateHessenberg(KSP, PetscInt, PetscBool, PetscReal *);
+static PetscErrorCode KSPGCRODRBuildSoln(Vec, Vec, KSP, PetscInt);
+
+/*@
+  KSPGCRODRSetRecycleDimension - Sets the maximal dimension of the subspace that `KSPGCRODR` recycles from one restart, and from one
+  `KSPSolve()`, to the next
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the `KSP` context
+- k   - the dimension, 0 turns `KSPGCRODR` into restarted `KSPGMRES`
+
+  Options Database Key:
+. -ksp_gcrodr_recycle <k> - the dimension of the recycled subspace
+
+  Level: intermediate
+
+  Note:
+  The dimension must be smaller than the restart, see `KSPGMRESSetRestart()`, which is the total dimension of the approximation space,
+  i.e., each cycle performs restart - k iterations
+
+.seealso: [](ch_ksp), `KSPGCRODR`, `KSPGCRODRResetRecycleSpace()`, `KSPGMRESSetRestart()`
+@*/
+PetscErrorCode KSPGCRODRSetRecycleDimension(KSP ksp, PetscInt k)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(ksp, k, 2);
+  PetscTryMethod(ksp, "KSPGCRODRSetRecycleDimension_C", (KSP, PetscInt), (ksp, k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  KSPGCRODRResetRecycleSpace - Discards the subspace recycled by `KSPGCRODR`, so that the next `KSPSolve()` starts from scratch
+
+  Logically Collective
+
+  Input Parameter:
+. ksp - the `KSP` context
+
+  Level: intermediate
+
+  Note:
+  There is no need to call this when the operators change, e.g., from one `SNES` iteration or one `TS` step to the next, the image of the recycled
+  subspace by the new operators is then recomputed at the beginning of the next `KSPSolve()`. This is for operators that changed so much that the
+  recycled subspace is no longer useful.
+
+.seealso: [](ch_ksp), `KSPGCRODR`, `KSPGCRODRSetRecycleDimension()`
+@*/
+PetscErrorCode KSPGCRODRResetRecycleSpace(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscTryMethod(ksp, "KSPGCRODRResetRecycleSpace_C", (KSP), (ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPGCRODRDestroyRecycleSpace_Private(KSP ksp)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  if (gcrodr->U) {
+    PetscCall(VecDestroyVecs(gcrodr->recycle, &gcrodr->U));
+    PetscCall(VecDestroyVecs(gcrodr->recycle, &gcrodr->C));
+    PetscCall(VecDestroyVecs(gcrodr->recycle, &gcrodr->Unew));
+    PetscCall(VecDestroyVecs(gcrodr->recycle, &gcrodr->Cnew));
+  }
+  PetscCall(PetscFree(gcrodr->W));
+  PetscCall(PetscFree4(gcrodr->unorm, gcrodr->cr, gcrodr->B, gcrodr->swork));
+  PetscCall(PetscFree2(gcrodr->rwork, gcrodr->iwork));
+  gcrodr->k  = 0;
+  gcrodr->kr = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetUp_GCRODR(KSP ksp)
+{
+  KSP_GCRODR *gcrodr  = (KSP_GCRODR *)ksp->data;
+  PetscInt    max_k   = gcrodr->max_k;
+  PetscInt    recycle = gcrodr->recycle;
+  PetscInt    nw;
+
+  PetscFunctionBegin;
+  PetscCheck(recycle < max_k, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "The dimension of the recycled subspace %" PetscInt_FMT " must be smaller than the restart %" PetscInt_FMT, recycle, max_k);
+  PetscCall(KSPGCRODRDestroyRecycleSpace_Private(ksp));
+  PetscCall(KSPSetUp_GMRES(ksp));
+  PetscCall(PetscMalloc1(max_k, &gcrodr->nrs));
+  PetscCall(PetscMalloc1(2 * (recycle + max_k + 2), &gcrodr->orthogwork));
+  if (recycle) {
+    PetscCall(KSPCreateVecs(ksp, recycle, &gcrodr->U, 0, NULL));
+    PetscCall(KSPCreateVecs(ksp, recycle, &gcrodr->C, 0, NULL));
+    PetscCall(KSPCreateVecs(ksp, recycle, &gcrodr->Unew, 0, NULL));
+    PetscCall(KSPCreateVecs(ksp, recycle, &gcrodr->Cnew, 0, NULL));
+  }
+  PetscCall(PetscMalloc1(recycle + max_k + 1, &gcrodr->W));
+  /* see KSPGCRODRUpdateRecycleSpace() for the layout of swork */
+  nw = 2 * (max_k + 1) * max_k + 3 * max_k * max_k + (2 * max_k + 1) * recycle + recycle * recycle + recycle + max_k + 8 * (max_k + 1);
+  PetscCall(PetscMalloc4(recycle, &gcrodr->unorm, 2 * recycle, &gcrodr->cr, recycle * max_k, &gcrodr->B, nw, &gcrodr->swork));
+  PetscCall(PetscMalloc2(4 * max_k, &gcrodr->rwork, 2 * max_k, &gcrodr->iwork));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPGCRODRComputeUNorms_Private(KSP ksp)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscInt    i;
+
+  PetscFunctionBegin;
+  if (!gcrodr->k) PetscFunctionReturn(PETSC_SUCCESS);
+  for (i = 0; i < gcrodr->k; i++) PetscCall(VecNormBegin(gcrodr->U[i], NORM_2, gcrodr->unorm + i));
+  PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)ksp)));
+  for (i = 0; i < gcrodr->k; i++) PetscCall(VecNormEnd(gcrodr->U[i], NORM_2, gcrodr->unorm + i));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   When the operators have changed since C was computed, recomputes C = op U and orthonormalizes it, C = Q R, with U = U R^-1 so that op U = C still holds
+*/
+static PetscErrorCode KSPGCRODRCheckOperators_Private(KSP ksp)
+{
+  KSP_GCRODR      *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscScalar     *R = gcrodr->swork, *t = gcrodr->cr, *r;
+  PetscInt         k = gcrodr->k, i, j, l;
+  PetscReal        nrm;
+  Mat              A, P;
+  PetscObjectId    Aid, Pid;
+  PetscObjectState Astate, Pstate;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetOperators(ksp->pc, &A, &P));
+  PetscCall(PetscObjectGetId((PetscObject)A, &Aid));
+  PetscCall(PetscObjectGetId((PetscObject)P, &Pid));
+  PetscCall(PetscObjectStateGet((PetscObject)A, &Astate));
+  PetscCall(PetscObjectStateGet((PetscObject)P, &Pstate));
+  if (k && (Aid != gcrodr->Aid || Pid != gcrodr->Pid || Astate != gcrodr->Astate || Pstate != gcrodr->Pstate || ksp->transpose_solve != gcrodr->transpose)) {
+    PetscCall(PetscInfo(ksp, "Operators have changed, recomputing the image of the recycled subspace of dimension %" PetscInt_FMT "\n", k));
+    for (i = 0; i < k; i++) PetscCall(KSP_PCApplyBAorAB(ksp, gcrodr->U[i], gcrodr->C[i], VEC_TEMP_MATOP));
+    /* classical Gram-Schmidt, performed twice */
+    for (i = 0; i < k; i++) {
+      r = R + i * k;
+      PetscCall(PetscArrayzero(r, k));
+      for (l = 0; l < 2 && i; l++) {
+        PetscCall(VecMDot(gcrodr->C[i], i, gcrodr->C, t));
+        for (j = 0; j < i; j++) {
+          r[j] += t[j];
+          t[j] = -t[j];
+        }
+        PetscCall(VecMAXPY(gcrodr->C[i], i, t, gcrodr->C));
+      }
+      PetscCall(VecNormalize(gcrodr->C[i], &nrm));
+      KSPCheckNorm(ksp, nrm);
+      if (nrm == 0.0) {
+        PetscCall(PetscInfo(ksp, "The recycled subspace is rank deficient, keeping %" PetscInt_FMT " vectors\n", i));
+        break;
+      }
+      r[i] = nrm;
+      /* the columns of U before i have already been updated */
+      for (j = 0; j < i; j++) t[j] = -r[j];
+      PetscCall(VecMAXPY(gcrodr->U[i], i, t, gcrodr->U));
+      PetscCall(VecScale(gcrodr->U[i], 1.0 / nrm));
+    }
+    gcrodr->k = i;
+    PetscCall(KSPGCRODRComputeUNorms_Private(ksp));
+  }
+  gcrodr->Aid       = Aid;
+  gcrodr->Pid       = Pid;
+  gcrodr->Astate    = Astate;
+  gcrodr->Pstate    = Pstate;
+  gcrodr->transpose = ksp->transpose_solve;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Classical Gram-Schmidt of VEC_VV(it + 1) against [C, VEC_VV(0), ..., VEC_VV(it)], which are orthonormal, with the same reductions for both;
+   the coefficients of C go into B and the other ones into the Hessenberg matrix. The caller sets gcrodr->W to [C, VEC_VV(0), ..., VEC_VV(it)].
+*/
+static PetscErrorCode KSPGCRODROrthogonalization(KSP ksp, PetscInt it)
+{
+  KSP_GCRODR  *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscInt     k = gcrodr->k, n = k + it + 1, j;
+  PetscScalar *lhh = gcrodr->orthogwork, *lhh2 = gcrodr->orthogwork + gcrodr->recycle + gcrodr->max_k + 2;
+  PetscReal    hnrm, wnrm;
+  PetscBool    refine = (PetscBool)(gcrodr->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS);
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+  PetscCall(VecMDot(VEC_VV(it + 1), n, gcrodr->W, lhh));
+  for (j = 0; j < n; j++) {
+    KSPCheckDot(ksp, lhh[j]);
+    if (ksp->reason) goto done;
+    lhh[j] = -lhh[j];
+  }
+  if (gcrodr->cgstype == KSP_GMRES_CGS_REFINE_NEVER) PetscCall(VecMAXPY(VEC_VV(it + 1), n, lhh, gcrodr->W));
+  else PetscCall(VecMDotAndMAXPY(VEC_VV(it + 1), n, lhh, gcrodr->W, lhh2, refine ? NULL : &wnrm));
+  if (gcrodr->cgstype == KSP_GMRES_CGS_REFINE_IFNEEDED) {
+    hnrm = 0.0;
+    for (j = 0; j < n; j++) hnrm += PetscRealPart(lhh[j] * PetscConj(lhh[j]));
+    hnrm = PetscSqrtReal(hnrm);
+    KSPCheckNorm(ksp, wnrm);
+    if (ksp->reason) goto done;
+    if (wnrm < hnrm) {
+      refine = PETSC_TRUE;
+      PetscCall(PetscInfo(ksp, "Performing iterative refinement wnorm %g hnorm %g\n", (double)wnrm, (double)hnrm));
+    }
+  }
+  if (refine) {
+    for (j = 0; j < n; j++) {
+      KSPCheckDot(ksp, lhh2[j]);
+      if (ksp->reason) goto done;
+      lhh2[j] = -lhh2[j];
+    }
+    PetscCall(VecMAXPY(VEC_VV(it + 1), n, lhh2, gcrodr->W));
+    for (j = 0; j < n; j++) lhh[j] += lhh2[j];
+  }
+  /* note lhh[j] is -<w,vnew>, hence the sign */
+  for (j = 0; j < k; j++) *BB(j, it) = -lhh[j];
+  for (j = 0; j <= it; j++) *HH(j, it) = *HES(j, it) = -lhh[k + j];
+done:
+  PetscCall(PetscLogEventEnd(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+    Runs one cycle of GCRODR.
+
+    On entry, VEC_VV(0) holds the residual. Its component in the range of C is removed, the corresponding correction U C^H r being added to the
+    solution together with the one from the Krylov subspace, which is built with the operator projected onto the orthogonal complement of C.
+ */
+static PetscErrorCode KSPGCRODRCycle(PetscInt *itcount, KSP ksp)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscReal   res, hapbnd, tt;
+  PetscInt    it = 0, k = gcrodr->k, max_k = gcrodr->max_k - gcrodr->k, j;
+  PetscBool   hapend = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (itcount) *itcount = 0;
+  for (j = 0; j < k; j++) gcrodr->W[j] = gcrodr->C[j];
+  if (k) {
+    PetscScalar *mcr = gcrodr->cr + gcrodr->recycle;
+
+    PetscCall(VecMDot(VEC_VV(0), k, gcrodr->C, gcrodr->cr));
+    for (j = 0; j < k; j++) mcr[j] = -gcrodr->cr[j];
+    PetscCall(VecMAXPY(VEC_VV(0), k, mcr, gcrodr->C));
+  }
+  gcrodr->kr = k;
+  PetscCall(VecNormalize(VEC_VV(0), &res));
+  KSPCheckNorm(ksp, res);
+
+  /* the constant .1 is arbitrary, just some measure at how incorrect the residuals are */
+  if ((ksp->rnorm > 0.0) && (PetscAbsReal(res - ksp->rnorm) > gcrodr->breakdowntol * gcrodr->rnorm0)) {
+    PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_CONV_FAILED, "Residual norm computed by GCRODR recursion formula %g is far from the computed residual norm %g at restart, residual norm at start of cycle %g",
+               (double)ksp->rnorm, (double)res, (double)gcrodr->rnorm0);
+    PetscCall(PetscInfo(ksp, "Residual norm computed by GCRODR recursion formula %g is far from the computed residual norm %g at restart, residual norm at start of cycle %g\n", (double)ksp->rnorm, (double)res, (double)gcrodr->rnorm0));
+    ksp->reason = KSP_DIVERGED_BREAKDOWN;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  *GRS(0) = gcrodr->rnorm0 = res;
+
+  /* check for the convergence */
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->rnorm = res;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+  gcrodr->it = (it - 1);
+  PetscCall(KSPLogResidualHistory(ksp, res));
+  PetscCall(KSPLogErrorHistory(ksp));
+  PetscCall(KSPMonitor(ksp, ksp->its, res));
+  if (!res) {
+    ksp->reason = KSP_CONVERGED_ATOL;
+    PetscCall(PetscInfo(ksp, "Converged due to zero residual norm on entry\n"));
+  } else PetscCall((*ksp->converged)(ksp, ksp->its, res, &ksp->reason, ksp->cnvP));
+
+  while (!ksp->reason && it < max_k && ksp->its < ksp->max_it) {
+    if (it) {
+      PetscCall(KSPLogResidualHistory(ksp, res));
+      PetscCall(KSPLogErrorHistory(ksp));
+      PetscCall(KSPMonitor(ksp, ksp->its, res));
+    }
+    gcrodr->it = (it - 1);
+    if (gcrodr->vv_allocated <= it + VEC_OFFSET + 1) PetscCall(KSPGMRESGetNewVectors(ksp, it + 1));
+    PetscCall(KSP_PCApplyBAorAB(ksp, VEC_VV(it), VEC_VV(1 + it), VEC_TEMP_MATOP));
+
+    /* update the Hessenberg matrix and B, and do Gram-Schmidt against [C, V] */
+    gcrodr->W[k + it] = VEC_VV(it);
+    PetscCall(KSPGCRODROrthogonalization(ksp, it));
+    if (ksp->reason) break;
+
+    /* vv(i+1) . vv(i+1) */
+    PetscCall(VecNormalize(VEC_VV(it + 1), &tt));
+    KSPCheckNorm(ksp, tt);
+
+    /* save the magnitude */
+    *HH(it + 1, it)  = tt;
+    *HES(it + 1, it) = tt;
+
+    /* check for the happy breakdown */
+    hapbnd = PetscAbsScalar(tt / *GRS(it));
+    if (hapbnd > gcrodr->haptol) hapbnd = gcrodr->haptol;
+    if (tt < hapbnd) {
+      PetscCall(PetscInfo(ksp, "Detected happy breakdown, current hapbnd = %14.12e tt = %14.12e\n", (double)hapbnd, (double)tt));
+      hapend = PETSC_TRUE;
+    }
+    PetscCall(KSPGCRODRUpdateHessenberg(ksp, it, hapend, &res));
+
+    it++;
+    gcrodr->it = (it - 1); /* For converged */
+    ksp->its++;
+    ksp->rnorm = res;
+    if (ksp->reason) break;
+
+    PetscCall((*ksp->converged)(ksp, ksp->its, res, &ksp->reason, ksp->cnvP));
+
+    /* Catch error in happy breakdown and signal convergence and break from loop */
+    if (hapend) {
+      if (ksp->normtype == KSP_NORM_NONE) { /* convergence test was skipped in this case */
+        ksp->reason = KSP_CONVERGED_HAPPY_BREAKDOWN;
+      } else if (!ksp->reason) {
+        PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Reached happy break down, but convergence was not indicated. Residual norm = %g", (double)res);
+        ksp->reason = KSP_DIVERGED_BREAKDOWN;
+        break;
+      }
+    }
+  }
+
+  /* Monitor if we know that we will not return for a restart */
+  if (it && (ksp->reason || ksp->its >= ksp->max_it)) {
+    PetscCall(KSPLogResidualHistory(ksp, res));
+    PetscCall(KSPLogErrorHistory(ksp));
+    PetscCall(KSPMonitor(ksp, ksp->its, res));
+  }
+
+  if (itcount) *itcount = it;
+
+  /* Form the solution (or the solution so far) */
+  PetscCall(KSPGCRODRBuildSoln(ksp->vec_sol, ksp->vec_sol, ksp, it - 1));
+  gcrodr->kr = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Updates the recycled subspace after a cycle of n iterations, see Algorithm 2 of [1]. With D = diag(1/||u_i||),
+
+     op [U D, V(:, 0:n-1)] = [C, V(:, 0:n)] G,  G = [D B; 0 H]
+
+   and the new subspace is spanned by the harmonic Ritz vectors [U D, V(:, 0:n-1)] z associated with the harmonic Ritz values theta of smallest
+   magnitude, given by the generalized eigenvalue problem
+
+     G^H G z = theta G^H [C, V(:, 0:n)]^H [U D, V(:, 0:n-1)] z
+
+   which is solved as the standard eigenvalue problem (G^H G)^-1 G^H [C, V]^H [U D, V] z = 1/theta z. With G P = Q R, the new C is [C, V] Q and
+   the new U is [U D, V] P R^-1.
+*/
+static PetscErrorCode KSPGCRODRUpdateRecycleSpace(KSP ksp, PetscInt n)
+{
+  KSP_GCRODR  *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscInt     k = gcrodr->k, nv = k + n, m = nv + 1, max_k = gcrodr->max_k, recycle = gcrodr->recycle, kmax, kk = 0, i, j, c;
+  PetscScalar *G, *WV, *A1, *X, *VR, *P, *GP, *R, *tau, *w, *work, sdummy = 0.0, one = 1.0, zero = 0.0;
+  PetscReal   *key = gcrodr->rwork;
+  PetscInt    *perm = gcrodr->iwork, *taken = gcrodr->iwork + max_k;
+  PetscBLASInt bm, bnv, bkk, lwork, idummy = 1, info;
+  Vec         *swap;
+#if !defined(PETSC_USE_COMPLEX)
+  PetscReal *wr = gcrodr->rwork + max_k, *wi = gcrodr->rwork + 2 * max_k;
+#endif
+
+  PetscFunctionBegin;
+  if (!recycle || !n) PetscFunctionReturn(PETSC_SUCCESS);
+  G    = gcrodr->swork;
+  WV   = G + (max_k + 1) * max_k;
+  A1   = WV + (max_k + 1) * max_k;
+  X    = A1 + max_k * max_k;
+  VR   = X + max_k * max_k;
+  P    = VR + max_k * max_k;
+  GP   = P + max_k * recycle;
+  R    = GP + (max_k + 1) * recycle;
+  tau  = R + recycle * recycle;
+  w    = tau + recycle;
+  work = w + max_k;
+  PetscCall(PetscBLASIntCast(m, &bm));
+  PetscCall(PetscBLASIntCast(nv, &bnv));
+  PetscCall(PetscBLASIntCast(8 * (max_k + 1), &lwork));
+
+  /* G = [D B; 0 H] */
+  PetscCall(PetscArrayzero(G, m * nv));
+  for (i = 0; i < k; i++) G[i + i * m] = 1.0 / gcrodr->unorm[i];
+  for (j = 0; j < n; j++) {
+    for (i = 0; i < k; i++) G[i + (k + j) * m] = *BB(i, j);
+    for (i = 0; i <= j + 1; i++) G[k + i + (k + j) * m] = *HES(i, j);
+  }
+
+  /* WV = [C, V]^H [U D, V], with a single reduction for the block of U */
+  for (i = 0; i < k; i++) gcrodr->W[i] = gcrodr->C[i];
+  for (j = 0; j <= n; j++) gcrodr->W[k + j] = VEC_VV(j);
+  PetscCall(PetscArrayzero(WV, m * nv));
+  for (i = 0; i < k; i++) PetscCall(VecMDotBegin(gcrodr->U[i], m, gcrodr->W, WV + i * m));
+  if (k) PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)ksp)));
+  for (i = 0; i < k; i++) PetscCall(VecMDotEnd(gcrodr->U[i], m, gcrodr->W, WV + i * m));
+  for (i = 0; i < k; i++) {
+    for (j = 0; j < m; j++) WV[j + i * m] /= gcrodr->unorm[i];
+  }
+  for (j = 0; j < n; j++) WV[k + j + (k + j) * m] = 1.0;
+
+  /* X = (G^H G)^-1 G^H WV */
+  PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &bnv, &bnv, &bm, &one, G, &bm, G, &bm, &zero, A1, &bnv));
+  PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &bnv, &bnv, &bm, &one, G, &bm, WV, &bm, &zero, X, &bnv));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+  PetscCallBLAS("LAPACKpotrf", LAPACKpotrf_("U", &bnv, A1, &bnv, &info));
+  if (info) {
+    PetscCall(PetscFPTrapPop());
+    PetscCall(PetscInfo(ksp, "G^H G is not numerically positive definite, keeping the recycled subspace\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCallBLAS("LAPACKpotrs", LAPACKpotrs_("U", &bnv, &bnv, A1, &bnv, X, &bnv, &info));
+  PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in LAPACK routine xPOTRS %d", (int)info);
+#if defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKgeev", LAPACKgeev_("N", "V", &bnv, X, &bnv, w, &sdummy, &idummy, VR, &bnv, work, &lwork, gcrodr->rwork + max_k, &info));
+  for (i = 0; i < nv; i++) key[i] = -PetscAbsScalar(w[i]);
+#else
+  PetscCallBLAS("LAPACKgeev", LAPACKgeev_("N", "V", &bnv, X, &bnv, wr, wi, &sdummy, &idummy, VR, &bnv, work, &lwork, &info));
+  for (i = 0; i < nv; i++) key[i] = -PetscSqrtReal(wr[i] * wr[i] + wi[i] * wi[i]);
+#endif
+  PetscCall(PetscFPTrapPop());
+  PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in LAPACK routine xGEEV %d", (int)info);
+
+  /* P holds the eigenvectors of the eigenvalues 1/theta of largest magnitude, a complex conjugate pair through its real and imaginary parts */
+  for (i = 0; i < nv; i++) {
+    perm[i]  = i;
+    taken[i] = 0;
+  }
+  PetscCall(PetscSortRealWithPermutation(nv, key, perm));
+  kmax = PetscMin(recycle, nv);
+  for (i = 0; i < nv && kk < kmax; i++) {
+    c = perm[i];
+#if !defined(PETSC_USE_COMPLEX)
+    if (wi[c] != 0.0) {
+      if (wi[c] < 0.0) c--;
+      if (taken[c]) continue;
+      if (kk + 2 > kmax) break;
+      taken[c] = 1;
+      PetscCall(PetscArraycpy(P + kk * nv, VR + c * nv, 2 * nv));
+      kk += 2;
+      continue;
+    }
+#endif
+    PetscCall(PetscArraycpy(P + kk * nv, VR + c * nv, nv));
+    kk++;
+  }
+  if (!kk) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscBLASIntCast(kk, &bkk));
+
+  /* G P = Q R */
+  PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bm, &bkk, &bnv, &one, G, &bm, P, &bnv, &zero, GP, &bm));
+  PetscCallBLAS("LAPACKgeqrf", LAPACKgeqrf_(&bm, &bkk, GP, &bm, tau, work, &lwork, &info));
+  PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in LAPACK routine xGEQRF %d", (int)info);
+  for (j = 0; j < kk; j++) {
+    for (i = 0; i < kk; i++) R[i + j * kk] = i <= j ? GP[i + j * m] : 0.0;
+    if (R[j + j * kk] == 0.0) {
+      PetscCall(PetscInfo(ksp, "G P is rank deficient, keeping the recycled subspace\n"));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+  PetscCallBLAS("LAPACKorgqr", LAPACKorgqr_(&bm, &bkk, &bkk, GP, &bm, tau, work, &lwork, &info));
+  PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in LAPACK routine xORGQR %d", (int)info);
+
+  /* P = diag(D, I) P R^-1 */
+  for (j = 0; j < kk; j++) {
+    for (i = 0; i < k; i++) P[i + j * nv] /= gcrodr->unorm[i];
+  }
+  PetscCallBLAS("BLAStrsm", BLAStrsm_("R", "U", "N", "N", &bnv, &bkk, &one, R, &bkk, P, &bnv));
+
+  /* C = [C, V] Q and U = [U, V] P */
+  for (i = 0; i < kk; i++) PetscCall(VecMAXPBY(gcrodr->Cnew[i], m, GP + i * m, 0.0, gcrodr->W));
+  for (i = 0; i < k; i++) gcrodr->W[i] = gcrodr->U[i];
+  for (i = 0; i < kk; i++) PetscCall(VecMAXPBY(gcrodr->Unew[i], nv, P + i * nv, 0.0, gcrodr->W));
+  swap         = gcrodr->C;
+  gcrodr->C    = gcrodr->Cnew;
+  gcrodr->Cnew = swap;
+  swap         = gcrodr->U;
+  gcrodr->U    = gcrodr->Unew;
+  gcrodr->Unew = swap;
+  gcrodr->k    = kk;
+  PetscCall(KSPGCRODRComputeUNorms_Private(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSolve_GCRODR(KSP ksp)
+{
+  KSP_GCRODR *gcrodr     = (KSP_GCRODR *)ksp->data;
+  PetscBool   guess_zero = ksp->guess_zero;
+  PetscInt    its, itcount;
+
+  PetscFunctionBegin;
+  PetscCheck(!ksp->calc_sings, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "KSPGCRODR does not support KSPSetComputeSingularValues()");
+
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->its = 0;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+
+  gcrodr->it = -1;
+  gcrodr->kr = 0;
+  PetscCall(KSPGCRODRCheckOperators_Private(ksp));
+  itcount    = 0;
+  ksp->rnorm = -1.0; /* special marker for KSPGCRODRCycle() */
+  while (!ksp->reason || (ksp->rnorm == -1 && ksp->reason == KSP_DIVERGED_PC_FAILED)) {
+    PetscCall(KSPInitialResidual(ksp, ksp->vec_sol, VEC_TEMP, VEC_TEMP_MATOP, VEC_VV(0), ksp->vec_rhs));
+    PetscCall(KSPGCRODRCycle(&its, ksp));
+    if (ksp->reason >= 0 || ksp->reason == KSP_DIVERGED_ITS) PetscCall(KSPGCRODRUpdateRecycleSpace(ksp, its));
+    itcount += its;
+    if (itcount >= ksp->max_it) {
+      if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    ksp->guess_zero = PETSC_FALSE; /* every future call to KSPInitialResidual() will have nonzero guess */
+  }
+  ksp->guess_zero = guess_zero; /* restore if user provided nonzero initial guess */
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPReset_GCRODR(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPGCRODRDestroyRecycleSpace_Private(ksp));
+  PetscCall(KSPReset_GMRES(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPDestroy_GCRODR(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPGCRODRDestroyRecycleSpace_Private(ksp));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGCRODRSetRecycleDimension_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGCRODRResetRecycleSpace_C", NULL));
+  PetscCall(KSPDestroy_GMRES(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+    KSPGCRODRBuildSoln - create the solution from the starting vector and the current iterates, i.e., vs + U (C^H r - B y) + V y
+    with y the minimizer of the residual in the Krylov subspace
+
+    Input parameters:
+        vs    - the initial guess
+        vdest - the result, vs may == vdest
+        it    - one less than the number of iterations of the current cycle
+ */
+static PetscErrorCode KSPGCRODRBuildSoln(Vec vs, Vec vdest, KSP ksp, PetscInt it)
+{
+  KSP_GCRODR  *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscScalar *nrs = gcrodr->nrs, *cu = gcrodr->cr + gcrodr->recycle, tt;
+  PetscInt     kr  = gcrodr->kr, ii, i, k, j;
+
+  PetscFunctionBegin;
+  /* If it is < 0, no iterations have been performed, but the component in the recycled subspace may still be missing */
+  if (it < 0 && !kr) {
+    PetscCall(VecCopy(vs, vdest)); /* VecCopy() is smart, exists immediately if vguess == vdest */
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (it >= 0) {
+    if (*HH(it, it) != 0.0) {
+      nrs[it] = *GRS(it) / *HH(it, it);
+    } else {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "You reached the break down in GCRODR; HH(it,it) = 0");
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+
+      PetscCall(PetscInfo(ksp, "Likely your matrix or preconditioner is singular. HH(it,it) is identically zero; it = %" PetscInt_FMT " GRS(it) = %g\n", it, (double)PetscAbsScalar(*GRS(it))));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    for (ii = 1; ii <= it; ii++) {
+      k  = it - ii;
+      tt = *GRS(k);
+      for (j = k + 1; j <= it; j++) tt = tt - *HH(k, j) * nrs[j];
+      if (*HH(k, k) == 0.0) {
+        PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "Likely your matrix or preconditioner is singular. HH(k,k) is identically zero; k = %" PetscInt_FMT, k);
+        ksp->reason = KSP_DIVERGED_BREAKDOWN;
+        PetscCall(PetscInfo(ksp, "Likely your matrix or preconditioner is singular. HH(k,k) is identically zero; k = %" PetscInt_FMT "\n", k));
+        PetscFunctionReturn(PETSC_SUCCESS);
+      }
+      nrs[k] = tt / *HH(k, k);
+    }
+  }
+  for (i = 0; i < kr; i++) {
+    cu[i] = gcrodr->cr[i];
+    for (j = 0; j <= it; j++) cu[i] -= *BB(i, j) * nrs[j];
+  }
+
+  /* Accumulate the correction to the solution of the preconditioned problem in TEMP */
+  if (it >= 0) PetscCall(VecMAXPBY(VEC_TEMP, it + 1, nrs, 0, &VEC_VV(0)));
+  else PetscCall(VecSet(VEC_TEMP, 0.0));
+  PetscCall(VecMAXPY(VEC_TEMP, kr, cu, gcrodr->U));
+
+  PetscCall(KSPUnwindPreconditioner(ksp, VEC_TEMP, VEC_TEMP_MATOP));
+  /* add solution to previous solution */
+  if (vdest != vs) PetscCall(VecCopy(vs, vdest));
+  PetscCall(VecAXPY(vdest, 1.0, VEC_TEMP));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Do the scalar work for the orthogonalization.  Return new residual norm.
+ */
+static PetscErrorCode KSPGCRODRUpdateHessenberg(KSP ksp, PetscInt it, PetscBool hapend, PetscReal *res)
+{
+  KSP_GCRODR  *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscScalar *hh, *cc, *ss, tt;
+  PetscInt     j;
+
+  PetscFunctionBegin;
+  hh = HH(0, it);
+  cc = CC(0);
+  ss = SS(0);
+
+  /* Apply all the previously computed plane rotations to the new column of the Hessenberg matrix */
+  for (j = 1; j <= it; j++) {
+    tt  = *hh;
+    *hh = PetscConj(*cc) * tt + *ss * *(hh + 1);
+    hh++;
+    *hh = *cc++ * *hh - (*ss++ * tt);
+  }
+
+  /*
+    compute the new plane rotation, and apply it to:
+     1) the right-hand-side of the Hessenberg system
+     2) the new column of the Hessenberg matrix
+    thus obtaining the updated value of the residual
+  */
+  if (!hapend) {
+    tt = PetscSqrtScalar(PetscConj(*hh) * *hh + PetscConj(*(hh + 1)) * *(hh + 1));
+    if (tt == 0.0) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "tt == 0.0");
+      ksp->reason = KSP_DIVERGED_NULL;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    *cc          = *hh / tt;
+    *ss          = *(hh + 1) / tt;
+    *GRS(it + 1) = -(*ss * *GRS(it));
+    *GRS(it)     = PetscConj(*cc) * *GRS(it);
+    *hh          = PetscConj(*cc) * *hh + *ss * *(hh + 1);
+    *res         = PetscAbsScalar(*GRS(it + 1));
+  } else {
+    /* happy breakdown: HH(it+1, it) = 0, the residual is zero */
+    *res = 0.0;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPBuildSolution_GCRODR(KSP ksp, Vec ptr, Vec *result)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  if (!ptr) {
+    if (!gcrodr->sol_temp) PetscCall(VecDuplicate(ksp->vec_sol, &gcrodr->sol_temp));
+    ptr = gcrodr->sol_temp;
+  }
+  PetscCall(KSPGCRODRBuildSoln(ksp->vec_sol, ptr, ksp, gcrodr->it));
+  if (result) *result = ptr;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPView_GCRODR(KSP ksp, PetscViewer viewer)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscBool   iascii;
+
+  PetscFunctionBegin;
+  PetscCall(KSPView_GMRES(ksp, viewer));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) PetscCall(PetscViewerASCIIPrintf(viewer, "  dimension of the recycled subspace=%" PetscInt_FMT ", currently %" PetscInt_FMT "\n", gcrodr->recycle, gcrodr->k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetFromOptions_GCRODR(KSP ksp, PetscOptionItems *PetscOptionsObject)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+  PetscInt    recycle;
+  PetscBool   flg;
+
+  PetscFunctionBegin;
+  PetscCall(KSPSetFromOptions_GMRES(ksp, PetscOptionsObject));
+  PetscOptionsHeadBegin(PetscOptionsObject, "KSP GCRODR Options");
+  PetscCall(PetscOptionsInt("-ksp_gcrodr_recycle", "Dimension of the recycled subspace", "KSPGCRODRSetRecycleDimension", gcrodr->recycle, &recycle, &flg));
+  if (flg) PetscCall(KSPGCRODRSetRecycleDimension(ksp, recycle));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPGCRODRSetRecycleDimension_GCRODR(KSP ksp, PetscInt recycle)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCheck(recycle >= 0, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Dimension of the recycled subspace must be nonnegative");
+  if (recycle == gcrodr->recycle) PetscFunctionReturn(PETSC_SUCCESS);
+  if (ksp->setupstage) {
+    /* free the data structures, then create them again */
+    PetscCall(KSPReset_GCRODR(ksp));
+    ksp->setupstage = KSP_SETUP_NEW;
+  }
+  gcrodr->recycle = recycle;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPGCRODRResetRecycleSpace_GCRODR(KSP ksp)
+{
+  KSP_GCRODR *gcrodr = (KSP_GCRODR *)ksp->data;
+
+  PetscFunctionBegin;
+  gcrodr->k = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+  KSPGCRODR - GCRO-DR, the generalized conjugate residual method with inner orthogonalization and deflated restarting [1], which keeps a subspace
+  from one restart to the next, and from one `KSPSolve()` to the next, so that sequences of linear systems with slowly changing operators,
+  e.g., in `SNES` or `TS`, converge in fewer iterations.
+
+  Options Database Keys:
++   -ksp_gcrodr_recycle <k> - dimension of the recycled subspace
+.   -ksp_gmres_restart <restart> - total approximation space size (Krylov directions + recycled subspace)
+.   -ksp_gmres_haptol <tol> - sets the tolerance for "happy ending" (exact convergence)
+.   -ksp_gmres_preallocate - preallocate all the Krylov search directions initially (otherwise groups of vectors are allocated as needed)
+-   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
+                                  stability of the classical Gram-Schmidt orthogonalization.
+
+  Level: intermediate
+
+  Notes:
+  Supports both left and right preconditioning, but not symmetric.
+
+  Each cycle removes the component of the residual in the range C of the (preconditioned) operator on the recycled subspace U, then
+  performs restart - k iterations of Arnoldi with the operator projected onto the orthogonal complement of C, and updates U with the
+  harmonic Ritz vectors associated with the harmonic Ritz values of smallest magnitude, i.e., U approximates an invariant subspace for the
+  eigenvalues of smallest magnitude. The first cycle of the first `KSPSolve()` is a `KSPGMRES` cycle.
+
+  When the operators have changed since the previous `KSPSolve()`, which is detected with `PetscObjectStateGet()`, C is recomputed with k
+  applications of the operator. Use `KSPGCRODRResetRecycleSpace()` to discard U when the problem changes too much for it to be useful.
+
+  The orthogonalization is classical Gram-Schmidt against both C and the Krylov basis, with the same reductions for both.
+
+  This object is subclassed off of `KSPGMRES`, see the source code in src/ksp/ksp/impls/gmres for comments on the structure of the code
+
+  References:
+. [1] - M. L. Parks, E. de Sturler, G. Mackey, D. D. Johnson and S. Maiti, Recycling Krylov subspaces for sequences of linear systems,
+  SIAM Journal on Scientific Computing, 28 (2006).
+
+.seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPGMRES`, `KSPLGMRES`, `KSPDGMRES`, `KSPRCG`, `KSPHPDDM`,
+          `KSPGCRODRSetRecycleDimension()`, `KSPGCRODRResetRecycleSpace()`, `KSPGMRESSetRestart()`, `KSPGMRESSetHapTol()`,
+          `KSPGMRESSetPreAllocateVectors()`, `KSPGMRESCGSRefinementType`, `KSPGMRESSetCGSRefinementType()`, `KSPGMRESGetCGSRefinementType()`
+M*/
+
+PETSC_EXTERN PetscErrorCode KSPCreate_GCRODR(KSP ksp)
+{
+  KSP_GCRODR *gcrodr;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&gcrodr));
+
+  ksp->data = (void *)gcrodr;
+
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_PRECONDITIONED, PC_LEFT, 3));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_UNPRECONDITIONED, PC_RIGHT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_RIGHT, 1));
+
+  ksp->ops->buildsolution  = KSPBuildSolution_GCRODR;
+  ksp->ops->setup          = KSPSetUp_GCRODR;
+  ksp->ops->solve          = KSPSolve_GCRODR;
+  ksp->ops->reset          = KSPReset_GCRODR;
+  ksp->ops->destroy        = KSPDestroy_GCRODR;
+  ksp->ops->view           = KSPView_GCRODR;
+  ksp->ops->setfromoptions = KSPSetFromOptions_GCRODR;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetPreAllocateVectors_C", KSPGMRESSetPreAllocateVectors_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetRestart_C", KSPGMRESSetRestart_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetRestart_C", KSPGMRESGetRestart_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetHapTol_C", KSPGMRESSetHapTol_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetCGSRefinementType_C", KSPGMRESSetCGSRefinementType_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetCGSRefinementType_C", KSPGMRESGetCGSRefinementType_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGCRODRSetRecycleDimension_C", KSPGCRODRSetRecycleDimension_GCRODR));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGCRODRResetRecycleSpace_C", KSPGCRODRResetRecycleSpace_GCRODR));
+
+  gcrodr->haptol         = 1.0e-30;
+  gcrodr->breakdowntol   = 0.1;
+  gcrodr->q_preallocate  = 0;
+  gcrodr->delta_allocate = GCRODR_DELTA_DIRECTIONS;
+  gcrodr->orthog         = KSPGMRESClassicalGramSchmidtOrthogonalization;
+  gcrodr->max_k          = GCRODR_DEFAULT_MAXK;
+  gcrodr->cgstype        = KSP_GMRES_CGS_REFINE_NEVER;
+  gcrodr->recycle        = GCRODR_DEFAULT_RECYCLE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
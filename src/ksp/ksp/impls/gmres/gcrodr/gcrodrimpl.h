@@ -0,0 +1,50 @@
+/*
+   Private data structure used by the GCRODR method.
+*/
+
+#pragma once
+
+#define KSPGMRES_NO_MACROS
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h>
+
+typedef struct {
+  KSPGMRESHEADER
+
+  /* the recycled subspace, kept from one KSPSolve() to the next */
+  PetscInt     recycle; /* maximal dimension of the recycled subspace */
+  PetscInt     k;       /* current dimension of the recycled subspace */
+  PetscInt     kr;      /* number of entries of cr not yet added to the solution */
+  Vec         *U;       /* basis of the recycled subspace */
+  Vec         *C;       /* image of U by the preconditioned operator, with C^H C = I */
+  Vec         *Unew;    /* work vectors to compute the next U */
+  Vec         *Cnew;    /* work vectors to compute the next C */
+  Vec         *W;       /* pointers to [C, V] or [U, V] */
+  PetscReal   *unorm;   /* norms of the columns of U */
+  PetscScalar *cr;      /* C^H r at the beginning of the cycle, and work space to build the solution */
+  PetscScalar *B;       /* C^H op V, recycle x max_k */
+  PetscScalar *swork;   /* work space for the update of the recycled subspace */
+  PetscReal   *rwork;
+  PetscInt    *iwork;
+
+  /* operators used to compute C, a change triggers the recomputation of C */
+  PetscObjectId    Aid, Pid;
+  PetscObjectState Astate, Pstate;
+  PetscBool        transpose;
+} KSP_GCRODR;
+
+#define HH(a, b)  (gcrodr->hh_origin + (b) * (gcrodr->max_k + 2) + (a))
+#define HES(a, b) (gcrodr->hes_origin + (b) * (gcrodr->max_k + 1) + (a))
+#define CC(a)     (gcrodr->cc_origin + (a))
+#define SS(a)     (gcrodr->ss_origin + (a))
+#define GRS(a)    (gcrodr->rs_origin + (a))
+#define BB(a, b)  (gcrodr->B + (b) * gcrodr->recycle + (a))
+
+/* vector names */
+#define VEC_OFFSET     2
+#define VEC_TEMP       gcrodr->vecs[0]
+#define VEC_TEMP_MATOP gcrodr->vecs[1]
+#define VEC_VV(i)      gcrodr->vecs[VEC_OFFSET + i]
+
+#define GCRODR_DELTA_DIRECTIONS 10
+#define GCRODR_DEFAULT_MAXK     30
+#define GCRODR_DEFAULT_RECYCLE  10
@@ -294,6 +294,7 @@ PetscErrorCode KSPDestroy_GMRES(KSP ksp)
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetBreakdownTolerance_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetCGSRefinementType_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetCGSRefinementType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESUseBlockMatSolve_C", NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 /*
@@ -482,6 +483,7 @@ PetscErrorCode KSPView_GMRES(KSP ksp, PetscViewer viewer)
   if (iascii) {
     PetscCall(PetscViewerASCIIPrintf(viewer, "  restart=%" PetscInt_FMT ", using %s\n", gmres->max_k, cstr));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  happy breakdown tolerance %g\n", (double)gmres->haptol));
+    if (ksp->ops->matsolve == KSPMatSolve_GMRES_Block) PetscCall(PetscViewerASCIIPrintf(viewer, "  using block GMRES in KSPMatSolve()\n"));
   } else if (isstring) {
     PetscCall(PetscViewerStringSPrintf(viewer, "%s restart %" PetscInt_FMT, cstr, gmres->max_k));
   }
@@ -534,7 +536,7 @@ PetscErrorCode KSPSetFromOptions_GMRES(KSP ksp, PetscOptionItems *PetscOptionsOb
   PetscInt   restart;
   PetscReal  haptol, breakdowntol;
   KSP_GMRES *gmres = (KSP_GMRES *)ksp->data;
-  PetscBool  flg;
+  PetscBool  flg, block;
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject, "KSP GMRES Options");
@@ -552,6 +554,9 @@ PetscErrorCode KSPSetFromOptions_GMRES(KSP ksp, PetscOptionItems *PetscOptionsOb
   PetscCall(PetscOptionsBoolGroupEnd("-ksp_gmres_modifiedgramschmidt", "Modified Gram-Schmidt (slow,more stable)", "KSPGMRESSetOrthogonalization", &flg));
   if (flg) PetscCall(KSPGMRESSetOrthogonalization(ksp, KSPGMRESModifiedGramSchmidtOrthogonalization));
   PetscCall(PetscOptionsEnum("-ksp_gmres_cgs_refinement_type", "Type of iterative refinement for classical (unmodified) Gram-Schmidt", "KSPGMRESSetCGSRefinementType", KSPGMRESCGSRefinementTypes, (PetscEnum)gmres->cgstype, (PetscEnum *)&gmres->cgstype, &flg));
+  block = (PetscBool)(ksp->ops->matsolve == KSPMatSolve_GMRES_Block);
+  PetscCall(PetscOptionsBool("-ksp_gmres_block_matsolve", "Use block GMRES with all the right-hand sides in KSPMatSolve()", "KSPGMRESUseBlockMatSolve", block, &block, &flg));
+  if (flg) PetscCall(KSPGMRESUseBlockMatSolve(ksp, block));
   flg = PETSC_FALSE;
   PetscCall(PetscOptionsBool("-ksp_gmres_krylov_monitor", "Plot the Krylov directions", "KSPMonitorSet", flg, &flg, NULL));
   if (flg) {
@@ -646,6 +651,13 @@ PetscErrorCode KSPGMRESSetCGSRefinementType_GMRES(KSP ksp, KSPGMRESCGSRefinement
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode KSPGMRESUseBlockMatSolve_GMRES(KSP ksp, PetscBool flg)
+{
+  PetscFunctionBegin;
+  ksp->ops->matsolve = flg ? KSPMatSolve_GMRES_Block : NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode KSPGMRESGetCGSRefinementType_GMRES(KSP ksp, KSPGMRESCGSRefinementType *type)
 {
   KSP_GMRES *gmres = (KSP_GMRES *)ksp->data;
@@ -821,6 +833,44 @@ PetscErrorCode KSPGMRESSetBreakdownTolerance(KSP ksp, PetscReal tol)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  KSPGMRESUseBlockMatSolve - Solves all the right-hand sides of `KSPMatSolve()` together with a block GMRES method
+
+  Logically Collective
+
+  Input Parameters:
++ ksp - the Krylov space context
+- flg - turn on or off the block method
+
+  Options Database Key:
+. -ksp_gmres_block_matsolve <bool> - Use block GMRES in `KSPMatSolve()`
+
+  Level: intermediate
+
+  Notes:
+  At each block iteration, the new block of directions is orthogonalized against the whole Krylov basis with dense matrix-matrix
+  products on the local rows and a single `MPI_Allreduce()`, plus another one when a second pass is requested with
+  `KSPGMRESSetCGSRefinementType()`, whatever the number of right-hand sides. The directions that are numerically in the span of
+  the basis are dropped, and the columns that have converged are removed from the block at each restart. The restart set with
+  `KSPGMRESSetRestart()` is the number of block iterations in a cycle, so the basis holds up to (restart + 1) times the number of
+  right-hand sides vectors.
+
+  The iteration count of the `KSP` is the number of block iterations, the monitored residual norm is the largest norm of the
+  columns that have not converged yet, and each column is tested for convergence relative to its own initial residual norm.
+
+  This is only available for `KSPGMRES`, left and right preconditioning are supported.
+
+.seealso: [](ch_ksp), `KSPGMRES`, `KSPMatSolve()`, `KSPSetMatSolveBatchSize()`, `KSPCGUseBlockMatSolve()`, `KSPHPDDM`
+@*/
+PetscErrorCode KSPGMRESUseBlockMatSolve(KSP ksp, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp, KSP_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(ksp, flg, 2);
+  PetscTryMethod(ksp, "KSPGMRESUseBlockMatSolve_C", (KSP, PetscBool), (ksp, flg));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*MC
      KSPGMRES - Implements the Generalized Minimal Residual method [1] with restart
 
@@ -833,7 +883,8 @@ PetscErrorCode KSPGMRESSetBreakdownTolerance(KSP ksp, PetscReal tol)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
 .   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
                                    stability of the classical Gram-Schmidt  orthogonalization.
--   -ksp_gmres_krylov_monitor - plot the Krylov space generated
+.   -ksp_gmres_krylov_monitor - plot the Krylov space generated
+-   -ksp_gmres_block_matsolve - solve all the right-hand sides of `KSPMatSolve()` together with block GMRES, see `KSPGMRESUseBlockMatSolve()`
 
    Level: beginner
 
@@ -847,7 +898,8 @@ PetscErrorCode KSPGMRESSetBreakdownTolerance(KSP ksp, PetscReal tol)
 .seealso: [](ch_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`, `KSPFGMRES`, `KSPLGMRES`,
           `KSPGMRESSetRestart()`, `KSPGMRESSetHapTol()`, `KSPGMRESSetPreAllocateVectors()`, `KSPGMRESSetOrthogonalization()`, `KSPGMRESGetOrthogonalization()`,
           `KSPGMRESClassicalGramSchmidtOrthogonalization()`, `KSPGMRESModifiedGramSchmidtOrthogonalization()`,
-          `KSPGMRESCGSRefinementType`, `KSPGMRESSetCGSRefinementType()`, `KSPGMRESGetCGSRefinementType()`, `KSPGMRESMonitorKrylov()`, `KSPSetPCSide()`
+          `KSPGMRESCGSRefinementType`, `KSPGMRESSetCGSRefinementType()`, `KSPGMRESGetCGSRefinementType()`, `KSPGMRESMonitorKrylov()`, `KSPSetPCSide()`,
+          `KSPGMRESUseBlockMatSolve()`
 M*/
 
 PETSC_EXTERN PetscErrorCode KSPCreate_GMRES(KSP ksp)
@@ -883,6 +935,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_GMRES(KSP ksp)
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetBreakdownTolerance_C", KSPGMRESSetBreakdownTolerance_GMRES));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESSetCGSRefinementType_C", KSPGMRESSetCGSRefinementType_GMRES));
   PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESGetCGSRefinementType_C", KSPGMRESGetCGSRefinementType_GMRES));
+  PetscCall(PetscObjectComposeFunction((PetscObject)ksp, "KSPGMRESUseBlockMatSolve_C", KSPGMRESUseBlockMatSolve_GMRES));
 
   gmres->haptol         = 1.0e-30;
   gmres->breakdowntol   = 0.1;
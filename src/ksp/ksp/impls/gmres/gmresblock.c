@@ -0,0 +1,238 @@
+/*
+    Block GMRES for KSPMatSolve() with KSPGMRES, see KSPGMRESUseBlockMatSolve()
+*/
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h> /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
+
+/*
+   Applies Q^H, with Q the product of the k Householder reflectors stored by geqrf() in the h x k panel Qp, to the h x n matrix C
+*/
+static void KSPGMRESBlockApplyQH_Private(PetscInt h, PetscInt k, const PetscScalar *Qp, PetscInt ldq, const PetscScalar *tau, PetscInt n, PetscScalar *C, PetscInt ldc)
+{
+  for (PetscInt l = 0; l < k; l++) {
+    for (PetscInt c = 0; c < n; c++) {
+      PetscScalar s = C[c * ldc + l];
+
+      for (PetscInt i = l + 1; i < h; i++) s += PetscConj(Qp[l * ldq + i]) * C[c * ldc + i];
+      s *= PetscConj(tau[l]);
+      C[c * ldc + l] -= s;
+      for (PetscInt i = l + 1; i < h; i++) C[c * ldc + i] -= s * Qp[l * ldq + i];
+    }
+  }
+}
+
+/*
+   W = M^{-1} A V(:, col:col+k) with left preconditioning, or A M^{-1} V(:, col:col+k) with right preconditioning; Vk, AV and Z
+   are work matrices kept between calls, and W points to one of them
+*/
+static PetscErrorCode KSPGMRESBlockApplyOp_Private(KSP ksp, Mat A, Mat B, Mat V, PetscInt col, PetscInt k, Mat *Vk, Mat *AV, Mat *Z, Mat *W)
+{
+  Mat Vj;
+
+  PetscFunctionBegin;
+  PetscCall(KSPMatDenseResize_Private(B, k, Vk));
+  PetscCall(MatDenseGetSubMatrix(V, PETSC_DECIDE, PETSC_DECIDE, col, col + k, &Vj));
+  if (ksp->pc_side == PC_RIGHT) PetscCall(KSP_PCMatApply(ksp, Vj, *Vk));
+  else PetscCall(MatCopy(Vj, *Vk, SAME_NONZERO_PATTERN));
+  PetscCall(MatDenseRestoreSubMatrix(V, &Vj));
+  PetscCall(KSPBlockMatMult_Private(ksp, A, *Vk, AV));
+  if (ksp->pc_side == PC_RIGHT) *W = *AV;
+  else {
+    PetscCall(KSPMatDenseResize_Private(B, k, Z));
+    PetscCall(KSP_PCMatApply(ksp, *AV, *Z));
+    *W = *Z;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   KSPMatSolve_GMRES_Block - Solves A X = B with the restarted block GMRES method
+
+   Each block Arnoldi step computes the inner products of the new block with the whole basis and with itself with a single
+   MPI_Allreduce(), the Gram matrix of the projected block being obtained from the Pythagorean identity; a second pass is done
+   depending on KSPGMRESSetCGSRefinementType(). The new block is orthonormalized, dropping the directions that are numerically
+   in the span of the basis, from its Gram matrix, and the block Hessenberg matrix is factored with Householder reflectors as it
+   is built, which gives the residual norm of each column. The columns that have converged are deflated at each restart.
+
+   References:
++  * - Dianne P. O'Leary, The block conjugate gradient algorithm and related methods, Linear Algebra and its Applications, 1980.
+-  * - Yousef Saad, Iterative Methods for Sparse Linear Systems, second edition, SIAM, 2003, Section 6.12.
+*/
+PetscErrorCode KSPMatSolve_GMRES_Block(KSP ksp, Mat B, Mat X)
+{
+  KSP_GMRES   *gmres = (KSP_GMRES *)ksp->data;
+  Mat          A, Xa = NULL, Ba = NULL, R = NULL, Z = NULL, V = NULL, Vk = NULL, AV = NULL, W;
+  MPI_Comm     comm;
+  PetscInt     N, a, m = gmres->max_k, ldh, *idx, *off, *keep, J, r;
+  PetscBool   *conv, refine;
+  PetscReal   *rnorm, *rnorm0, *wref;
+  PetscScalar *H, *E, *tau, *buf, *G, *T, *work, one = 1.0, mone = -1.0;
+  PetscBLASInt bn, bk, bh, bldh, lwork, info;
+
+  PetscFunctionBegin;
+  PetscCheck(ksp->pc_side != PC_SYMMETRIC, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Block KSPGMRES does not support symmetric preconditioning");
+  PetscCall(PetscObjectGetComm((PetscObject)ksp, &comm));
+  PetscCall(PCGetOperators(ksp->pc, &A, NULL));
+  PetscCall(MatGetSize(B, NULL, &N));
+  ldh = (m + 1) * N;
+  PetscCall(PetscMalloc7(N, &idx, m + 2, &off, N, &keep, N, &conv, N, &rnorm, N, &rnorm0, N, &wref));
+  PetscCall(PetscMalloc7(ldh * m * N, &H, ldh * N, &E, m * N, &tau, ldh * N + N * N, &buf, N * N, &G, N * N, &T, 64 * N, &work));
+  PetscCall(PetscBLASIntCast(ldh, &bldh));
+  PetscCall(PetscBLASIntCast(64 * N, &lwork));
+  for (PetscInt i = 0; i < N; i++) {
+    idx[i]    = i;
+    conv[i]   = PETSC_FALSE;
+    rnorm0[i] = 0.0;
+  }
+  a = N;
+
+  PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+  ksp->its    = 0;
+  ksp->rnorm  = 0.0;
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+  PetscCall(KSPMatDenseResize_Private(B, N, &Xa));
+  PetscCall(KSPMatDenseResize_Private(B, N, &Ba));
+  PetscCall(MatCopy(X, Xa, SAME_NONZERO_PATTERN));
+  PetscCall(MatCopy(B, Ba, SAME_NONZERO_PATTERN));
+  while (!ksp->reason) {
+    Mat AX = NULL, Rp;
+
+    /* (preconditioned) residual of the active columns and its Gram matrix */
+    PetscCall(KSPMatDenseResize_Private(B, a, &R));
+    PetscCall(MatCopy(Ba, R, SAME_NONZERO_PATTERN));
+    if (!ksp->guess_zero || ksp->its) {
+      PetscCall(KSPBlockMatMult_Private(ksp, A, Xa, &AX));
+      PetscCall(MatAXPY(R, -1.0, AX, SAME_NONZERO_PATTERN));
+      PetscCall(MatDestroy(&AX));
+    }
+    if (ksp->pc_side == PC_LEFT) {
+      PetscCall(KSPMatDenseResize_Private(B, a, &Z));
+      PetscCall(KSP_PCMatApply(ksp, R, Z));
+      Rp = Z;
+    } else Rp = R;
+    PetscCall(KSPMatDenseLocalGram_Private(Rp, 0, a, Rp, 0, a, G, a));
+    PetscCall(MPIU_Allreduce(MPI_IN_PLACE, G, a * a, MPIU_SCALAR, MPIU_SUM, comm));
+    for (PetscInt i = 0; i < a; i++) rnorm[i] = PetscSqrtReal(PetscAbsScalar(G[i * a + i]));
+    PetscCall(KSPBlockConverged_Private(ksp, N, a, idx, ksp->normtype != KSP_NORM_NONE ? rnorm : NULL, rnorm0, conv));
+    if (ksp->reason) break;
+
+    /* deflation of the converged columns */
+    r = 0;
+    for (PetscInt i = 0; i < a; i++) {
+      if (!conv[idx[i]]) keep[r++] = i;
+    }
+    if (r < a) {
+      PetscCall(KSPMatDenseCopyColumns_Private(Xa, a, idx, conv, X));
+      PetscCall(KSPMatDenseKeepColumns_Private(&Xa, r, keep));
+      PetscCall(KSPMatDenseKeepColumns_Private(&Ba, r, keep));
+      PetscCall(KSPMatDenseKeepColumns_Private(&Rp, r, keep));
+      if (ksp->pc_side == PC_LEFT) Z = Rp;
+      else R = Rp;
+      for (PetscInt j = 0; j < r; j++) {
+        for (PetscInt i = 0; i < r; i++) G[j * r + i] = G[keep[j] * a + keep[i]];
+        idx[j] = idx[keep[j]];
+      }
+      a = r;
+    }
+
+    /* first block of the basis, R = V_0 E_0 */
+    PetscCall(PetscArrayzero(E, ldh * a));
+    PetscCall(KSPBlockOrthonormalize_Private(a, G, NULL, PETSC_SQRT_MACHINE_EPSILON, &r, T, E, ldh));
+    if (!r) {
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      break;
+    }
+    PetscCall(KSPMatDenseResize_Private(B, (m + 1) * a, &V));
+    PetscCall(KSPMatDenseGEMM_Private(V, 0, r, 0.0, 1.0, Rp, 0, a, T, a));
+    off[0] = 0;
+    off[1] = r;
+
+    for (J = 0; J < m;) {
+      const PetscInt k = off[J + 1] - off[J], nv = off[J + 1];
+      PetscScalar   *Hj = H + off[J] * ldh, *VW = buf, *WW = buf + nv * k;
+
+      PetscCall(KSPGMRESBlockApplyOp_Private(ksp, A, B, V, off[J], k, &Vk, &AV, &Z, &W));
+      PetscCall(PetscBLASIntCast(k, &bk));
+      PetscCall(PetscBLASIntCast(nv, &bn));
+
+      /* block classical Gram-Schmidt, [V W]^H W with a single reduction and (W - V h)^H (W - V h) = W^H W - h^H h */
+      for (PetscInt c = 0; c < k; c++) PetscCall(PetscArrayzero(Hj + c * ldh, ldh));
+      refine = PETSC_TRUE;
+      for (PetscInt pass = 0; pass < 2 && refine; pass++) {
+        PetscCall(KSPMatDenseLocalGram_Private(V, 0, nv, W, 0, k, VW, nv));
+        PetscCall(KSPMatDenseLocalGram_Private(W, 0, k, W, 0, k, WW, k));
+        PetscCall(MPIU_Allreduce(MPI_IN_PLACE, buf, (nv + k) * k, MPIU_SCALAR, MPIU_SUM, comm));
+        PetscCall(KSPMatDenseGEMM_Private(W, 0, k, 1.0, -1.0, V, 0, nv, VW, nv));
+        if (!pass) {
+          for (PetscInt c = 0; c < k; c++) wref[c] = PetscRealPart(WW[c * k + c]);
+        }
+        PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &bk, &bk, &bn, &mone, VW, &bn, VW, &bn, &one, WW, &bk));
+        PetscCall(PetscLogFlops(2.0 * nv * k * k));
+        for (PetscInt c = 0; c < k; c++) {
+          for (PetscInt i = 0; i < nv; i++) Hj[c * ldh + i] += VW[c * nv + i];
+        }
+        if (gmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS) refine = PETSC_TRUE;
+        else if (gmres->cgstype == KSP_GMRES_CGS_REFINE_IFNEEDED) {
+          refine = PETSC_FALSE;
+          for (PetscInt c = 0; c < k; c++) refine = (PetscBool)(refine || PetscRealPart(WW[c * k + c]) < 0.5 * wref[c]);
+        } else refine = PETSC_FALSE;
+      }
+      PetscCall(PetscArraycpy(G, WW, k * k));
+      PetscCall(KSPBlockOrthonormalize_Private(k, G, wref, PETSC_SQRT_MACHINE_EPSILON, &r, T, Hj + nv, ldh));
+      PetscCall(KSPMatDenseGEMM_Private(V, nv, r, 0.0, 1.0, W, 0, k, T, k));
+      off[J + 2] = nv + r;
+
+      /* QR factorization of the new block column of the Hessenberg matrix, and residual norms from the right-hand side */
+      for (PetscInt i = 0; i < J; i++) KSPGMRESBlockApplyQH_Private(off[i + 2] - off[i], off[i + 1] - off[i], H + off[i] * ldh + off[i], ldh, tau + off[i], k, Hj + off[i], ldh);
+      PetscCall(PetscBLASIntCast(k + r, &bh));
+      PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+      PetscCallBLAS("LAPACKgeqrf", LAPACKgeqrf_(&bh, &bk, Hj + off[J], &bldh, tau + off[J], work, &lwork, &info));
+      PetscCall(PetscFPTrapPop());
+      PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in LAPACK routine %" PetscBLASInt_FMT, info);
+      KSPGMRESBlockApplyQH_Private(k + r, k, Hj + off[J], ldh, tau + off[J], a, E + off[J], ldh);
+      PetscCall(PetscLogFlops(4.0 * (nv + r) * k * (nv + a)));
+      for (PetscInt c = 0; c < a; c++) {
+        PetscReal s = 0.0;
+
+        for (PetscInt i = nv; i < nv + r; i++) s += PetscRealPart(PetscConj(E[c * ldh + i]) * E[c * ldh + i]);
+        rnorm[c] = PetscSqrtReal(s);
+      }
+      J++;
+      PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+      ksp->its++;
+      PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+      PetscCall(KSPBlockConverged_Private(ksp, N, a, idx, ksp->normtype != KSP_NORM_NONE ? rnorm : NULL, rnorm0, conv));
+      if (ksp->reason) break;
+      if (!r) {
+        PetscCall(PetscInfo(ksp, "Block Krylov subspace is invariant at iteration %" PetscInt_FMT "\n", ksp->its));
+        break;
+      }
+    }
+
+    /* Y = R^{-1} E, stored in E, and X = X + V Y or X + M^{-1} V Y */
+    PetscCall(PetscBLASIntCast(off[J], &bn));
+    PetscCall(PetscBLASIntCast(a, &bk));
+    PetscCallBLAS("BLAStrsm", BLAStrsm_("L", "U", "N", "N", &bn, &bk, &one, H, &bldh, E, &bldh));
+    PetscCall(PetscLogFlops(1.0 * off[J] * off[J] * a));
+    if (ksp->pc_side == PC_LEFT) PetscCall(KSPMatDenseGEMM_Private(Xa, 0, a, 1.0, 1.0, V, 0, off[J], E, ldh));
+    else {
+      PetscCall(KSPMatDenseResize_Private(B, a, &Z));
+      PetscCall(KSPMatDenseGEMM_Private(R, 0, a, 0.0, 1.0, V, 0, off[J], E, ldh));
+      PetscCall(KSP_PCMatApply(ksp, R, Z));
+      PetscCall(MatAXPY(Xa, 1.0, Z, SAME_NONZERO_PATTERN));
+    }
+  }
+  PetscCall(KSPMatDenseCopyColumns_Private(Xa, a, idx, NULL, X));
+
+  PetscCall(MatDestroy(&AV));
+  PetscCall(MatDestroy(&Vk));
+  PetscCall(MatDestroy(&V));
+  PetscCall(MatDestroy(&Z));
+  PetscCall(MatDestroy(&R));
+  PetscCall(MatDestroy(&Ba));
+  PetscCall(MatDestroy(&Xa));
+  PetscCall(PetscFree7(H, E, tau, buf, G, T, work));
+  PetscCall(PetscFree7(idx, off, keep, conv, rnorm, rnorm0, wref));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
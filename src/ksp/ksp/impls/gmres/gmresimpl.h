@@ -61,6 +61,7 @@ PETSC_INTERN PetscErrorCode KSPComputeRitz_GMRES(KSP, PetscBool, PetscBool, Pets
 PETSC_INTERN PetscErrorCode KSPReset_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPDestroy_GMRES(KSP);
 PETSC_INTERN PetscErrorCode KSPGMRESGetNewVectors(KSP, PetscInt);
+PETSC_INTERN PetscErrorCode KSPMatSolve_GMRES_Block(KSP, Mat, Mat);
 
 typedef PetscErrorCode (*FCN)(KSP, PetscInt); /* force argument to next function to not be extern C*/
 
@@ -0,0 +1,289 @@
+/*
+   Routines shared by the block Krylov methods used in KSPMatSolve()
+*/
+#include <petsc/private/kspimpl.h> /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
+
+/*
+  KSPMatDenseResize_Private - Makes X a dense matrix with k columns and the row layout and type of B, keeping X if it already has k columns
+*/
+PetscErrorCode KSPMatDenseResize_Private(Mat B, PetscInt k, Mat *X)
+{
+  PetscInt m, M, N;
+
+  PetscFunctionBegin;
+  if (*X) {
+    PetscCall(MatGetSize(*X, NULL, &N));
+    if (N == k) PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatDestroy(X));
+  PetscCall(MatGetLocalSize(B, &m, NULL));
+  PetscCall(MatGetSize(B, &M, NULL));
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)B), X));
+  PetscCall(MatSetSizes(*X, m, PETSC_DECIDE, M, k));
+  PetscCall(MatSetType(*X, ((PetscObject)B)->type_name));
+  PetscCall(MatSetUp(*X));
+  PetscCall(MatSetOption(*X, MAT_NO_OFF_PROC_ENTRIES, PETSC_TRUE));
+  PetscCall(MatAssemblyBegin(*X, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*X, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPBlockMatMult_Private - Y = A X, or A^T X for a transpose solve, Y is reused as long as X is the same matrix
+*/
+PetscErrorCode KSPBlockMatMult_Private(KSP ksp, Mat A, Mat X, Mat *Y)
+{
+  PetscInt N, NY;
+
+  PetscFunctionBegin;
+  if (*Y) {
+    PetscCall(MatGetSize(X, NULL, &N));
+    PetscCall(MatGetSize(*Y, NULL, &NY));
+    if (NY != N) PetscCall(MatDestroy(Y));
+  }
+  if (!ksp->transpose_solve) PetscCall(MatMatMult(A, X, *Y ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX, PETSC_DEFAULT, Y));
+  else PetscCall(MatTransposeMatMult(A, X, *Y ? MAT_REUSE_MATRIX : MAT_INITIAL_MATRIX, PETSC_DEFAULT, Y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPBlockOrthonormalize_Private - From the Gram matrix G = W^H W of a block of k vectors, computes T (k x r, leading dimension k)
+  such that W T is orthonormal and S (r x k, leading dimension lds) such that W = (W T) S up to the dropped directions
+
+  The columns of W are first scaled to unit norm, so that vectors of very different norms are kept. A column whose squared norm
+  is below tol times ref[] (for example its squared norm before an orthogonalization) is considered zero, and the directions of
+  the scaled block whose squared singular value is below tol are dropped, so r <= k is the numerical rank of W; G is overwritten
+*/
+PetscErrorCode KSPBlockOrthonormalize_Private(PetscInt k, PetscScalar *G, const PetscReal ref[], PetscReal tol, PetscInt *r, PetscScalar *T, PetscScalar *S, PetscInt lds)
+{
+  PetscBLASInt bk, lwork, info;
+  PetscReal   *eig, *rwork, *d;
+  PetscScalar *work;
+
+  PetscFunctionBegin;
+  *r = 0;
+  if (!k) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscBLASIntCast(k, &bk));
+  PetscCall(PetscBLASIntCast(3 * k, &lwork));
+  PetscCall(PetscMalloc4(k, &eig, 3 * k, &work, 3 * k, &rwork, k, &d));
+  for (PetscInt i = 0; i < k; i++) {
+    const PetscReal g = PetscRealPart(G[i * k + i]);
+
+    d[i] = (g > 0.0 && (!ref || g > tol * ref[i])) ? PetscSqrtReal(g) : 0.0;
+  }
+  for (PetscInt j = 0; j < k; j++) {
+    for (PetscInt i = 0; i < k; i++) G[j * k + i] = (d[i] > 0.0 && d[j] > 0.0) ? G[j * k + i] / (d[i] * d[j]) : 0.0;
+  }
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKsyev", LAPACKsyev_("V", "U", &bk, G, &bk, eig, work, &lwork, rwork, &info));
+#else
+  PetscCallBLAS("LAPACKsyev", LAPACKsyev_("V", "U", &bk, G, &bk, eig, work, &lwork, &info));
+#endif
+  PetscCall(PetscFPTrapPop());
+  PetscCheck(!info, PETSC_COMM_SELF, PETSC_ERR_LIB, "Error in LAPACK routine %" PetscBLASInt_FMT, info);
+  /* the eigenvalues are in ascending order, keep the largest ones first */
+  for (PetscInt i = k - 1; i >= 0 && eig[i] > tol; i--) {
+    const PetscReal s = PetscSqrtReal(eig[i]);
+
+    for (PetscInt j = 0; j < k; j++) {
+      T[*r * k + j]   = d[j] > 0.0 ? G[i * k + j] / (s * d[j]) : 0.0;
+      S[j * lds + *r] = s * d[j] * PetscConj(G[i * k + j]);
+    }
+    ++*r;
+  }
+  PetscCall(PetscFree4(eig, work, rwork, d));
+  PetscCall(PetscLogFlops(9.0 * k * k * k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPBlockConverged_Private - Tests the convergence of the n columns idx[] of the N columns of a block solve, given their
+  residual norms, each against the tolerances of the KSP relative to its own initial residual norm, and monitors the
+  largest residual norm; rnorm is NULL with KSP_NORM_NONE
+*/
+PetscErrorCode KSPBlockConverged_Private(KSP ksp, PetscInt N, PetscInt n, const PetscInt idx[], const PetscReal rnorm[], PetscReal rnorm0[], PetscBool conv[])
+{
+  PetscReal max = 0.0;
+  PetscBool all = PETSC_TRUE, atol = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  if (rnorm) {
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscInt j = idx ? idx[i] : i;
+
+      if (!ksp->its) rnorm0[j] = rnorm[i];
+      max = PetscMax(max, rnorm[i]);
+      if (PetscIsInfOrNanReal(rnorm[i])) ksp->reason = KSP_DIVERGED_NANORINF;
+      else if (ksp->its >= ksp->min_it && rnorm[i] <= PetscMax(ksp->rtol * rnorm0[j], ksp->abstol)) conv[j] = PETSC_TRUE;
+      else if (rnorm[i] >= ksp->divtol * rnorm0[j] && ksp->reason == KSP_CONVERGED_ITERATING) ksp->reason = KSP_DIVERGED_DTOL;
+    }
+    for (PetscInt j = 0; j < N; j++) {
+      all  = (PetscBool)(all && conv[j]);
+      atol = (PetscBool)(atol && (!conv[j] || ksp->rtol * rnorm0[j] < ksp->abstol));
+    }
+    PetscCall(PetscObjectSAWsTakeAccess((PetscObject)ksp));
+    ksp->rnorm = max;
+    PetscCall(PetscObjectSAWsGrantAccess((PetscObject)ksp));
+    PetscCall(KSPLogResidualHistory(ksp, max));
+    PetscCall(KSPMonitor(ksp, ksp->its, max));
+  } else all = PETSC_FALSE;
+  if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
+  if (all) ksp->reason = atol ? KSP_CONVERGED_ATOL : KSP_CONVERGED_RTOL;
+  else if (ksp->its >= ksp->max_it) ksp->reason = rnorm ? KSP_DIVERGED_ITS : KSP_CONVERGED_ITS;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPMatDenseLocalGram_Private - Computes the local part G = X(:, xcol:xcol+kx)^H Y(:, ycol:ycol+ky) of the Gram matrix of
+  columns of dense matrices with the same row layout, G has leading dimension ldg; the caller sums the parts over the processes
+*/
+PetscErrorCode KSPMatDenseLocalGram_Private(Mat X, PetscInt xcol, PetscInt kx, Mat Y, PetscInt ycol, PetscInt ky, PetscScalar *G, PetscInt ldg)
+{
+  const PetscScalar *x, *y;
+  PetscScalar        one = 1.0, zero = 0.0;
+  PetscInt           m, ldx, ldy;
+  PetscBLASInt       bm, bkx, bky, bldx, bldy, bldg;
+
+  PetscFunctionBegin;
+  if (!kx || !ky) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatGetLocalSize(X, &m, NULL));
+  if (!m) {
+    for (PetscInt j = 0; j < ky; j++) PetscCall(PetscArrayzero(G + j * ldg, kx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatDenseGetLDA(X, &ldx));
+  PetscCall(MatDenseGetLDA(Y, &ldy));
+  PetscCall(PetscBLASIntCast(m, &bm));
+  PetscCall(PetscBLASIntCast(kx, &bkx));
+  PetscCall(PetscBLASIntCast(ky, &bky));
+  PetscCall(PetscBLASIntCast(ldx, &bldx));
+  PetscCall(PetscBLASIntCast(ldy, &bldy));
+  PetscCall(PetscBLASIntCast(ldg, &bldg));
+  PetscCall(MatDenseGetArrayRead(X, &x));
+  if (Y != X) PetscCall(MatDenseGetArrayRead(Y, &y));
+  else y = x;
+  PetscCallBLAS("BLASgemm", BLASgemm_("C", "N", &bkx, &bky, &bm, &one, x + xcol * ldx, &bldx, y + ycol * ldy, &bldy, &zero, G, &bldg));
+  if (Y != X) PetscCall(MatDenseRestoreArrayRead(Y, &y));
+  PetscCall(MatDenseRestoreArrayRead(X, &x));
+  PetscCall(PetscLogFlops(2.0 * m * kx * ky));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPMatDenseLocalColumnDots_Private - Computes the local parts d[j] = X(:, j)^H Y(:, j) of the inner products of the first k
+  columns of dense matrices with the same row layout
+*/
+PetscErrorCode KSPMatDenseLocalColumnDots_Private(Mat X, Mat Y, PetscInt k, PetscScalar d[])
+{
+  const PetscScalar *x, *y;
+  PetscInt           m, ldx, ldy;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetLocalSize(X, &m, NULL));
+  PetscCall(MatDenseGetLDA(X, &ldx));
+  PetscCall(MatDenseGetLDA(Y, &ldy));
+  PetscCall(MatDenseGetArrayRead(X, &x));
+  if (Y != X) PetscCall(MatDenseGetArrayRead(Y, &y));
+  else y = x;
+  for (PetscInt j = 0; j < k; j++) {
+    PetscScalar sum = 0.0;
+
+    for (PetscInt i = 0; i < m; i++) sum += PetscConj(x[j * ldx + i]) * y[j * ldy + i];
+    d[j] = sum;
+  }
+  if (Y != X) PetscCall(MatDenseRestoreArrayRead(Y, &y));
+  PetscCall(MatDenseRestoreArrayRead(X, &x));
+  PetscCall(PetscLogFlops(2.0 * m * k));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPMatDenseGEMM_Private - Computes Y(:, ycol:ycol+ky) = beta Y(:, ycol:ycol+ky) + alpha X(:, xcol:xcol+kx) C on the local rows of
+  dense matrices with the same row layout, C is kx x ky with leading dimension ldc; X and Y may only be the same matrix if the
+  column ranges do not overlap
+*/
+PetscErrorCode KSPMatDenseGEMM_Private(Mat Y, PetscInt ycol, PetscInt ky, PetscScalar beta, PetscScalar alpha, Mat X, PetscInt xcol, PetscInt kx, const PetscScalar *C, PetscInt ldc)
+{
+  const PetscScalar *x;
+  PetscScalar       *y;
+  PetscInt           m, ldx, ldy;
+  PetscBLASInt       bm, bkx, bky, bldx, bldy, bldc;
+
+  PetscFunctionBegin;
+  if (!ky) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatGetLocalSize(Y, &m, NULL));
+  PetscCall(MatDenseGetLDA(X, &ldx));
+  PetscCall(MatDenseGetLDA(Y, &ldy));
+  PetscCall(MatDenseGetArray(Y, &y));
+  if (m && !kx) {
+    for (PetscInt j = 0; j < ky; j++) {
+      for (PetscInt i = 0; i < m; i++) y[(ycol + j) * ldy + i] *= beta;
+    }
+  } else if (m) {
+    PetscCall(PetscBLASIntCast(m, &bm));
+    PetscCall(PetscBLASIntCast(kx, &bkx));
+    PetscCall(PetscBLASIntCast(ky, &bky));
+    PetscCall(PetscBLASIntCast(ldx, &bldx));
+    PetscCall(PetscBLASIntCast(ldy, &bldy));
+    PetscCall(PetscBLASIntCast(ldc, &bldc));
+    if (X != Y) PetscCall(MatDenseGetArrayRead(X, &x));
+    else x = y;
+    PetscCallBLAS("BLASgemm", BLASgemm_("N", "N", &bm, &bky, &bkx, &alpha, x + xcol * ldx, &bldx, C, &bldc, &beta, y + ycol * ldy, &bldy));
+    if (X != Y) PetscCall(MatDenseRestoreArrayRead(X, &x));
+  }
+  PetscCall(MatDenseRestoreArray(Y, &y));
+  PetscCall(PetscLogFlops(2.0 * m * kx * ky));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPMatDenseKeepColumns_Private - Replaces the dense matrix X by the matrix made of its n columns keep[] in this order
+*/
+PetscErrorCode KSPMatDenseKeepColumns_Private(Mat *X, PetscInt n, const PetscInt keep[])
+{
+  Mat                Y = NULL;
+  const PetscScalar *x;
+  PetscScalar       *y;
+  PetscInt           m, ldx, ldy;
+
+  PetscFunctionBegin;
+  PetscCall(KSPMatDenseResize_Private(*X, n, &Y));
+  PetscCall(MatGetLocalSize(*X, &m, NULL));
+  PetscCall(MatDenseGetLDA(*X, &ldx));
+  PetscCall(MatDenseGetLDA(Y, &ldy));
+  PetscCall(MatDenseGetArrayRead(*X, &x));
+  PetscCall(MatDenseGetArrayWrite(Y, &y));
+  for (PetscInt j = 0; j < n; j++) PetscCall(PetscArraycpy(y + j * ldy, x + keep[j] * ldx, m));
+  PetscCall(MatDenseRestoreArrayWrite(Y, &y));
+  PetscCall(MatDenseRestoreArrayRead(*X, &x));
+  PetscCall(MatDestroy(X));
+  *X = Y;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  KSPMatDenseCopyColumns_Private - Copies the column j of Xa to the column idx[j] of X, for the first n columns of Xa or only
+  for those with sel[idx[j]] set if sel is not NULL
+*/
+PetscErrorCode KSPMatDenseCopyColumns_Private(Mat Xa, PetscInt n, const PetscInt idx[], const PetscBool sel[], Mat X)
+{
+  const PetscScalar *xa;
+  PetscScalar       *x;
+  PetscInt           m, lda, ldx;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetLocalSize(X, &m, NULL));
+  PetscCall(MatDenseGetLDA(Xa, &lda));
+  PetscCall(MatDenseGetLDA(X, &ldx));
+  PetscCall(MatDenseGetArrayRead(Xa, &xa));
+  PetscCall(MatDenseGetArray(X, &x));
+  for (PetscInt j = 0; j < n; j++) {
+    if (!sel || sel[idx[j]]) PetscCall(PetscArraycpy(x + idx[j] * ldx, xa + j * lda, m));
+  }
+  PetscCall(MatDenseRestoreArray(X, &x));
+  PetscCall(MatDenseRestoreArrayRead(Xa, &xa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -9,6 +9,8 @@ PETSC_EXTERN PetscErrorCode KSPCreate_PIPECGRR(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPELCG(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPEPRCG(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPECG2(KSP);
+PETSC_EXTERN PetscErrorCode KSPCreate_CACG(KSP);
+PETSC_EXTERN PetscErrorCode KSPCreate_RCG(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_CGNE(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_NASH(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_STCG(KSP);
@@ -37,6 +39,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_PIPEFGMRES(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_MINRES(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_SYMMLQ(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_LGMRES(KSP);
+PETSC_EXTERN PetscErrorCode KSPCreate_GCRODR(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_LCD(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_GCR(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPEGCR(KSP);
@@ -73,6 +76,8 @@ PetscErrorCode KSPRegisterAll(void)
   PetscCall(KSPRegister(KSPPIPELCG, KSPCreate_PIPELCG));
   PetscCall(KSPRegister(KSPPIPEPRCG, KSPCreate_PIPEPRCG));
   PetscCall(KSPRegister(KSPPIPECG2, KSPCreate_PIPECG2));
+  PetscCall(KSPRegister(KSPCACG, KSPCreate_CACG));
+  PetscCall(KSPRegister(KSPRCG, KSPCreate_RCG));
   PetscCall(KSPRegister(KSPCGNE, KSPCreate_CGNE));
   PetscCall(KSPRegister(KSPNASH, KSPCreate_NASH));
   PetscCall(KSPRegister(KSPSTCG, KSPCreate_STCG));
@@ -104,6 +109,7 @@ PetscErrorCode KSPRegisterAll(void)
   PetscCall(KSPRegister(KSPMINRES, KSPCreate_MINRES));
   PetscCall(KSPRegister(KSPSYMMLQ, KSPCreate_SYMMLQ));
   PetscCall(KSPRegister(KSPLGMRES, KSPCreate_LGMRES));
+  PetscCall(KSPRegister(KSPGCRODR, KSPCreate_GCRODR));
   PetscCall(KSPRegister(KSPLCD, KSPCreate_LCD));
   PetscCall(KSPRegister(KSPGCR, KSPCreate_GCR));
   PetscCall(KSPRegister(KSPPIPEGCR, KSPCreate_PIPEGCR));
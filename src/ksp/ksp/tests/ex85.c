@@ -0,0 +1,113 @@
+static char help[] = "Tests KSPMatSolve() with the block methods of KSPCG and KSPGMRES against KSPSolve() column by column.\n\n";
+
+#include <petscksp.h>
+
+int main(int argc, char **argv)
+{
+  Mat          A, B, X;
+  Vec          b, x;
+  KSP          ksp;
+  PetscInt     m = 16, n = 12, nrhs = 8, nsame = 0, Istart, Iend;
+  PetscReal    convection = 0.0, err, nrm, tol = 1e-6;
+  PetscBool    zero = PETSC_FALSE, transpose = PETSC_FALSE;
+  PetscScalar *array;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nrhs", &nrhs, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nsame", &nsame, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-convection", &convection, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-tol", &tol, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-zero", &zero, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-transpose", &transpose, NULL));
+  PetscCheck(nsame >= 0 && nsame < nrhs, PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE, "-nsame must be in [0, nrhs)");
+
+  /* 5-point Laplacian, with an upwind convection term in the x direction */
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, m * n, m * n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSetUp(A));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (PetscInt Ii = Istart; Ii < Iend; Ii++) {
+    PetscInt i = Ii / n, j = Ii - i * n;
+
+    if (i > 0) PetscCall(MatSetValue(A, Ii, Ii - n, -1.0, INSERT_VALUES));
+    if (i < m - 1) PetscCall(MatSetValue(A, Ii, Ii + n, -1.0, INSERT_VALUES));
+    if (j > 0) PetscCall(MatSetValue(A, Ii, Ii - 1, -1.0 - convection, INSERT_VALUES));
+    if (j < n - 1) PetscCall(MatSetValue(A, Ii, Ii + 1, -1.0, INSERT_VALUES));
+    PetscCall(MatSetValue(A, Ii, Ii, 4.0 + convection, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  /* right-hand sides independent of the partition, the last nsame ones being copies of the first ones, and the first one possibly zero */
+  PetscCall(MatCreateDense(PETSC_COMM_WORLD, Iend - Istart, PETSC_DECIDE, m * n, nrhs, NULL, &B));
+  PetscCall(MatDenseGetArray(B, &array));
+  for (PetscInt j = 0; j < nrhs; j++) {
+    for (PetscInt Ii = Istart; Ii < Iend; Ii++) array[j * (Iend - Istart) + Ii - Istart] = PetscSinReal((PetscReal)((Ii + 1) * (j % (nrhs - nsame) + 1))) + 0.1 * (j % (nrhs - nsame));
+  }
+  if (zero) PetscCall(PetscArrayzero(array, Iend - Istart));
+  PetscCall(MatDenseRestoreArray(B, &array));
+  PetscCall(MatDuplicate(B, MAT_DO_NOT_COPY_VALUES, &X));
+
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, A, A));
+  PetscCall(KSPSetTolerances(ksp, 1e-10, PETSC_DEFAULT, PETSC_DEFAULT, 1000));
+  PetscCall(KSPSetFromOptions(ksp));
+  if (!transpose) PetscCall(KSPMatSolve(ksp, B, X));
+  else PetscCall(KSPMatSolveTranspose(ksp, B, X));
+
+  /* the same solves column by column, without the block method */
+  PetscCall(KSPCGUseBlockMatSolve(ksp, PETSC_FALSE));
+  PetscCall(KSPGMRESUseBlockMatSolve(ksp, PETSC_FALSE));
+  PetscCall(PetscOptionsClearValue(NULL, "-ksp_converged_reason"));
+  PetscCall(MatCreateVecs(A, &x, NULL));
+  for (PetscInt j = 0; j < nrhs; j++) {
+    Vec xj;
+
+    PetscCall(MatDenseGetColumnVecRead(B, j, &b));
+    if (!transpose) PetscCall(KSPSolve(ksp, b, x));
+    else PetscCall(KSPSolveTranspose(ksp, b, x));
+    PetscCall(MatDenseRestoreColumnVecRead(B, j, &b));
+    PetscCall(MatDenseGetColumnVecRead(X, j, &xj));
+    PetscCall(VecNorm(x, NORM_2, &nrm));
+    PetscCall(VecAXPY(x, -1.0, xj));
+    PetscCall(VecNorm(x, NORM_2, &err));
+    PetscCall(MatDenseRestoreColumnVecRead(X, j, &xj));
+    PetscCheck(err <= tol * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Column %" PetscInt_FMT " of KSPMatSolve() has relative error %g", j, (double)(nrm > 0.0 ? err / nrm : err));
+  }
+
+  PetscCall(VecDestroy(&x));
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(MatDestroy(&X));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      nsize: {{1 2}}
+      args: -ksp_converged_reason -pc_type jacobi
+
+      test:
+        suffix: cg
+        args: -ksp_type cg -ksp_cg_block_matsolve -nsame {{0 3}separate output} -ksp_norm_type {{preconditioned unpreconditioned natural}separate output}
+
+      test:
+        suffix: cg_zero
+        args: -ksp_type cg -ksp_cg_block_matsolve -zero -nsame 2 -ksp_matsolve_batch_size 5 -transpose -pc_type none
+
+      test:
+        suffix: gmres
+        args: -ksp_type gmres -ksp_gmres_block_matsolve -convection 2 -ksp_gmres_restart 4 -nsame {{0 3}separate output} -ksp_pc_side {{left right}separate output} -ksp_gmres_cgs_refinement_type {{refine_never refine_ifneeded}shared output}
+
+      test:
+        suffix: gmres_zero
+        args: -ksp_type gmres -ksp_gmres_block_matsolve -convection 2 -zero -nsame 2 -ksp_matsolve_batch_size 5 -ksp_gmres_cgs_refinement_type refine_always
+
+TEST*/
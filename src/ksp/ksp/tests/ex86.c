@@ -0,0 +1,106 @@
+static char help[] = "Tests KSPGCRODR and KSPRCG on a sequence of linear systems with slowly changing operators and right-hand sides.\n\n";
+
+#include <petscksp.h>
+
+int main(int argc, char **argv)
+{
+  Mat       A;
+  Vec       b, x, r;
+  KSP       ksp;
+  PetscInt  m = 24, n = 20, nsolves = 5, Istart, Iend, its, total = 0;
+  PetscReal convection = 0.0, shift = 0.01, nrm, bnrm;
+  PetscBool reset = PETSC_FALSE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nsolves", &nsolves, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-convection", &convection, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-shift", &shift, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-reset", &reset, NULL));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, m * n, m * n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSetUp(A));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  PetscCall(MatCreateVecs(A, &x, &b));
+  PetscCall(VecDuplicate(b, &r));
+
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, A, A));
+  PetscCall(KSPSetTolerances(ksp, 1e-8, PETSC_DEFAULT, PETSC_DEFAULT, 1000));
+  PetscCall(KSPSetFromOptions(ksp));
+
+  for (PetscInt s = 0; s < nsolves; s++) {
+    /* 5-point Laplacian, with an upwind convection term in the x direction, and a variable reaction term that changes with s */
+    for (PetscInt Ii = Istart; Ii < Iend; Ii++) {
+      PetscInt i = Ii / n, j = Ii - i * n;
+
+      if (i > 0) PetscCall(MatSetValue(A, Ii, Ii - n, -1.0, INSERT_VALUES));
+      if (i < m - 1) PetscCall(MatSetValue(A, Ii, Ii + n, -1.0, INSERT_VALUES));
+      if (j > 0) PetscCall(MatSetValue(A, Ii, Ii - 1, -1.0 - convection, INSERT_VALUES));
+      if (j < n - 1) PetscCall(MatSetValue(A, Ii, Ii + 1, -1.0, INSERT_VALUES));
+      PetscCall(MatSetValue(A, Ii, Ii, 4.0 + convection + shift * s * (1.0 + PetscSinReal((PetscReal)(Ii + 1))), INSERT_VALUES));
+    }
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+    /* right-hand sides independent of the partition */
+    for (PetscInt Ii = Istart; Ii < Iend; Ii++) PetscCall(VecSetValue(b, Ii, PetscSinReal((PetscReal)((Ii + 1) * (s + 1))) + 1.0, INSERT_VALUES));
+    PetscCall(VecAssemblyBegin(b));
+    PetscCall(VecAssemblyEnd(b));
+
+    if (reset && s) {
+      PetscCall(KSPGCRODRResetRecycleSpace(ksp));
+      PetscCall(KSPRCGResetRecycleSpace(ksp));
+    }
+    PetscCall(KSPSolve(ksp, b, x));
+    PetscCall(KSPGetIterationNumber(ksp, &its));
+    total += its;
+
+    PetscCall(MatMult(A, x, r));
+    PetscCall(VecAXPY(r, -1.0, b));
+    PetscCall(VecNorm(r, NORM_2, &nrm));
+    PetscCall(VecNorm(b, NORM_2, &bnrm));
+    PetscCheck(nrm <= 1e-6 * bnrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Solve %" PetscInt_FMT " has relative residual %g", s, (double)(nrm / bnrm));
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Total number of iterations %" PetscInt_FMT "\n", total));
+
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(VecDestroy(&r));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&b));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      nsize: {{1 2}}
+      args: -ksp_converged_reason -pc_type jacobi
+
+      test:
+        suffix: gcrodr
+        args: -ksp_type gcrodr -convection 2 -ksp_gmres_restart 20 -ksp_gcrodr_recycle {{0 8}separate output} -ksp_pc_side {{left right}separate output}
+
+      test:
+        suffix: gcrodr_refine
+        args: -ksp_type gcrodr -convection 2 -ksp_gmres_restart 20 -ksp_gcrodr_recycle 8 -ksp_gmres_cgs_refinement_type {{refine_ifneeded refine_always}shared output}
+
+      test:
+        suffix: gcrodr_reset
+        args: -ksp_type gcrodr -convection 2 -ksp_gmres_restart 20 -ksp_gcrodr_recycle 8 -reset
+
+      test:
+        suffix: rcg
+        args: -ksp_type rcg -ksp_rcg_recycle {{0 10}separate output} -ksp_norm_type {{preconditioned unpreconditioned natural}separate output}
+
+      test:
+        suffix: rcg_reset
+        args: -ksp_type rcg -reset
+
+TEST*/
@@ -0,0 +1,112 @@
+static char help[] = "Tests PCGAMGSetReuseAggregates() on a sequence of linear systems with the same nonzero pattern and changing values.\n\n";
+
+#include <petscksp.h>
+
+int main(int argc, char **argv)
+{
+  Mat       A;
+  Vec       b, x, xref;
+  KSP       ksp, kspref = NULL;
+  PC        pc;
+  PetscInt  m = 32, n = 32, nsolves = 4, Istart, Iend, its;
+  PetscReal anisotropy = 0.5, shift = 0.1, err, nrm, eps;
+  PetscBool check = PETSC_FALSE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nsolves", &nsolves, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-anisotropy", &anisotropy, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-shift", &shift, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-check", &check, NULL));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, m * n, m * n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSetUp(A));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  PetscCall(MatCreateVecs(A, &x, &b));
+
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, A, A));
+  PetscCall(KSPSetType(ksp, KSPCG));
+  PetscCall(KSPGetPC(ksp, &pc));
+  PetscCall(PCSetType(pc, PCGAMG));
+  PetscCall(PCGAMGSetReuseAggregates(pc, PETSC_TRUE));
+  PetscCall(KSPSetTolerances(ksp, 1e-10, PETSC_DEFAULT, PETSC_DEFAULT, 200));
+  PetscCall(KSPSetFromOptions(ksp));
+  if (check) {
+    /* the same preconditioner, rebuilt from scratch for each matrix */
+    PetscCall(KSPCreate(PETSC_COMM_WORLD, &kspref));
+    PetscCall(KSPSetOptionsPrefix(kspref, "ref_"));
+    PetscCall(KSPSetOperators(kspref, A, A));
+    PetscCall(KSPSetType(kspref, KSPCG));
+    PetscCall(KSPGetPC(kspref, &pc));
+    PetscCall(PCSetType(pc, PCGAMG));
+    PetscCall(PCGAMGSetReuseInterpolation(pc, PETSC_FALSE));
+    PetscCall(KSPSetTolerances(kspref, 1e-10, PETSC_DEFAULT, PETSC_DEFAULT, 200));
+    PetscCall(KSPSetFromOptions(kspref));
+    PetscCall(VecDuplicate(x, &xref));
+  }
+
+  for (PetscInt s = 0; s < nsolves; s++) {
+    /* -eps u_xx - u_yy + c u, with eps going from 1 to anisotropy, and a reaction term c that changes with s */
+    eps = nsolves > 1 ? PetscPowReal(anisotropy, (PetscReal)s / (nsolves - 1)) : 1.0;
+    for (PetscInt Ii = Istart; Ii < Iend; Ii++) {
+      PetscInt i = Ii / n, j = Ii - i * n;
+
+      if (i > 0) PetscCall(MatSetValue(A, Ii, Ii - n, -1.0, INSERT_VALUES));
+      if (i < m - 1) PetscCall(MatSetValue(A, Ii, Ii + n, -1.0, INSERT_VALUES));
+      if (j > 0) PetscCall(MatSetValue(A, Ii, Ii - 1, -eps, INSERT_VALUES));
+      if (j < n - 1) PetscCall(MatSetValue(A, Ii, Ii + 1, -eps, INSERT_VALUES));
+      PetscCall(MatSetValue(A, Ii, Ii, 2.0 + 2.0 * eps + shift * s * (1.0 + PetscSinReal((PetscReal)(Ii + 1))), INSERT_VALUES));
+    }
+    PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatSetOption(A, MAT_SPD, PETSC_TRUE));
+
+    /* right-hand side independent of the partition */
+    for (PetscInt Ii = Istart; Ii < Iend; Ii++) PetscCall(VecSetValue(b, Ii, PetscSinReal((PetscReal)((Ii + 1) * (s + 1))) + 1.0, INSERT_VALUES));
+    PetscCall(VecAssemblyBegin(b));
+    PetscCall(VecAssemblyEnd(b));
+
+    PetscCall(KSPSolve(ksp, b, x));
+    PetscCall(KSPGetIterationNumber(ksp, &its));
+    PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Solve %" PetscInt_FMT ": %" PetscInt_FMT " iterations\n", s, its));
+    if (check) {
+      PetscCall(KSPSolve(kspref, b, xref));
+      PetscCall(KSPGetIterationNumber(kspref, &its));
+      PetscCall(PetscPrintf(PETSC_COMM_WORLD, "  rebuilt from scratch: %" PetscInt_FMT " iterations\n", its));
+      PetscCall(VecNorm(xref, NORM_2, &nrm));
+      PetscCall(VecAXPY(xref, -1.0, x));
+      PetscCall(VecNorm(xref, NORM_2, &err));
+      PetscCheck(err <= 1e-6 * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Solve %" PetscInt_FMT " differs from the one with a preconditioner rebuilt from scratch, relative error %g", s, (double)(err / nrm));
+    }
+  }
+
+  if (check) {
+    PetscCall(VecDestroy(&xref));
+    PetscCall(KSPDestroy(&kspref));
+  }
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&b));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: check
+      nsize: {{1 2}separate output}
+      args: -check -pc_gamg_eigenvalues 0.1,2 -ref_pc_gamg_eigenvalues 0.1,2 -pc_gamg_recompute_esteig false
+
+   test:
+      suffix: drift
+      nsize: {{1 2}separate output}
+      args: -anisotropy 1e-3 -nsolves 5 -pc_gamg_threshold 0.05 -pc_gamg_reuse_aggregates_tol {{-1 0.25}separate output}
+
+TEST*/
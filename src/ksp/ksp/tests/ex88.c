@@ -0,0 +1,186 @@
+static char help[] = "Tests the residual history of KSPCG with KSP_NORM_PRECONDITIONED and of KSPBCGS, whose norms and inner products\n\
+are computed together in one reduction, against the iterations written with separate reductions.\n\n";
+
+#include <petscksp.h>
+
+/* CG with left preconditioning, a zero initial guess, and the norm of the preconditioned residual */
+static PetscErrorCode ReferenceCG(Mat A, PC pc, Vec b, PetscReal rtol, PetscInt maxit, PetscReal hist[], PetscInt *its)
+{
+  Vec         x, r, z, p, w;
+  PetscScalar beta, betaold = 1.0, dpi, a;
+  PetscReal   dp;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecDuplicate(b, &x));
+  PetscCall(VecDuplicate(b, &r));
+  PetscCall(VecDuplicate(b, &z));
+  PetscCall(VecDuplicate(b, &p));
+  PetscCall(VecDuplicate(b, &w));
+  PetscCall(VecSet(x, 0.0));
+  PetscCall(VecCopy(b, r));
+  PetscCall(PCApply(pc, r, z));
+  PetscCall(VecNorm(z, NORM_2, &dp));
+  PetscCall(VecDot(z, r, &beta));
+  hist[0] = dp;
+  for (*its = 0; *its < maxit && dp > rtol * hist[0];) {
+    if (*its) PetscCall(VecAYPX(p, beta / betaold, z));
+    else PetscCall(VecCopy(z, p));
+    PetscCall(MatMult(A, p, w));
+    PetscCall(VecDot(w, p, &dpi));
+    a       = beta / dpi;
+    betaold = beta;
+    PetscCall(VecAXPY(x, a, p));
+    PetscCall(VecAXPY(r, -a, w));
+    PetscCall(PCApply(pc, r, z));
+    PetscCall(VecNorm(z, NORM_2, &dp));
+    PetscCall(VecDot(z, r, &beta));
+    hist[++*its] = dp;
+  }
+  PetscCall(VecDestroy(&w));
+  PetscCall(VecDestroy(&p));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroy(&r));
+  PetscCall(VecDestroy(&x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* BiCGStab with left preconditioning, a zero initial guess, and the norm of the preconditioned residual */
+static PetscErrorCode ReferenceBCGS(Mat A, PC pc, Vec b, PetscReal rtol, PetscInt maxit, PetscReal hist[], PetscInt *its)
+{
+  Vec         x, r, rp, p, v, s, t, w;
+  PetscScalar rho, rhoold = 1.0, alpha = 1.0, omega, omegaold = 1.0, beta, d1;
+  PetscReal   dp, d2;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecDuplicate(b, &x));
+  PetscCall(VecDuplicate(b, &r));
+  PetscCall(VecDuplicate(b, &rp));
+  PetscCall(VecDuplicate(b, &p));
+  PetscCall(VecDuplicate(b, &v));
+  PetscCall(VecDuplicate(b, &s));
+  PetscCall(VecDuplicate(b, &t));
+  PetscCall(VecDuplicate(b, &w));
+  PetscCall(VecSet(x, 0.0));
+  PetscCall(VecSet(p, 0.0));
+  PetscCall(VecSet(v, 0.0));
+  PetscCall(PCApply(pc, b, r));
+  PetscCall(VecCopy(r, rp));
+  PetscCall(VecNorm(r, NORM_2, &dp));
+  hist[0] = dp;
+  for (*its = 0; *its < maxit && dp > rtol * hist[0];) {
+    PetscCall(VecDot(r, rp, &rho));
+    beta = (rho / rhoold) * (alpha / omegaold);
+    PetscCall(VecAXPBYPCZ(p, 1.0, -omegaold * beta, beta, r, v));
+    PetscCall(MatMult(A, p, w));
+    PetscCall(PCApply(pc, w, v));
+    PetscCall(VecDot(v, rp, &d1));
+    alpha = rho / d1;
+    PetscCall(VecWAXPY(s, -alpha, v, r));
+    PetscCall(MatMult(A, s, w));
+    PetscCall(PCApply(pc, w, t));
+    PetscCall(VecDotNorm2(s, t, &d1, &d2));
+    omega = d1 / d2;
+    PetscCall(VecAXPBYPCZ(x, alpha, omega, 1.0, p, s));
+    PetscCall(VecWAXPY(r, -omega, t, s));
+    PetscCall(VecNorm(r, NORM_2, &dp));
+    rhoold       = rho;
+    omegaold     = omega;
+    hist[++*its] = dp;
+  }
+  PetscCall(VecDestroy(&w));
+  PetscCall(VecDestroy(&t));
+  PetscCall(VecDestroy(&s));
+  PetscCall(VecDestroy(&v));
+  PetscCall(VecDestroy(&p));
+  PetscCall(VecDestroy(&rp));
+  PetscCall(VecDestroy(&r));
+  PetscCall(VecDestroy(&x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A;
+  Vec         x, b;
+  KSP         ksp;
+  PC          pc;
+  PetscInt    m = 20, n = 20, Istart, Iend, its, itsref, nhist, maxit = 200;
+  PetscReal   convection = 0.0, rtol = 1e-8, *hist, *histref;
+  PetscBool   bcgs;
+  const char *type;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetReal(NULL, NULL, "-convection", &convection, NULL));
+
+  /* -u_xx - u_yy + c u_x with a varying reaction term */
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, m * n, m * n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSetUp(A));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (PetscInt Ii = Istart; Ii < Iend; Ii++) {
+    PetscInt i = Ii / n, j = Ii - i * n;
+
+    if (i > 0) PetscCall(MatSetValue(A, Ii, Ii - n, -1.0, INSERT_VALUES));
+    if (i < m - 1) PetscCall(MatSetValue(A, Ii, Ii + n, -1.0, INSERT_VALUES));
+    if (j > 0) PetscCall(MatSetValue(A, Ii, Ii - 1, -1.0 - convection, INSERT_VALUES));
+    if (j < n - 1) PetscCall(MatSetValue(A, Ii, Ii + 1, -1.0 + convection, INSERT_VALUES));
+    PetscCall(MatSetValue(A, Ii, Ii, 4.0 + 0.5 * (1.0 + PetscSinReal((PetscReal)(Ii + 1))), INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatCreateVecs(A, &x, &b));
+  for (PetscInt Ii = Istart; Ii < Iend; Ii++) PetscCall(VecSetValue(b, Ii, PetscSinReal((PetscReal)(Ii + 1)) + 1.0, INSERT_VALUES));
+  PetscCall(VecAssemblyBegin(b));
+  PetscCall(VecAssemblyEnd(b));
+
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, A, A));
+  PetscCall(KSPSetType(ksp, KSPCG));
+  PetscCall(KSPGetPC(ksp, &pc));
+  PetscCall(PCSetType(pc, PCJACOBI));
+  PetscCall(KSPSetNormType(ksp, KSP_NORM_PRECONDITIONED));
+  PetscCall(KSPSetTolerances(ksp, rtol, PETSC_DEFAULT, PETSC_DEFAULT, maxit));
+  PetscCall(KSPSetFromOptions(ksp));
+  PetscCall(KSPSetUp(ksp));
+  PetscCall(KSPGetType(ksp, &type));
+  PetscCall(PetscStrcmp(type, KSPBCGS, &bcgs));
+  PetscCall(KSPGetTolerances(ksp, &rtol, NULL, NULL, &maxit));
+  PetscCall(PetscMalloc2(maxit + 1, &hist, maxit + 1, &histref));
+  PetscCall(KSPSetResidualHistory(ksp, hist, maxit + 1, PETSC_TRUE));
+
+  PetscCall(KSPSolve(ksp, b, x));
+  PetscCall(KSPGetIterationNumber(ksp, &its));
+  PetscCall(KSPGetResidualHistory(ksp, NULL, &nhist));
+  if (bcgs) PetscCall(ReferenceBCGS(A, pc, b, rtol, maxit, histref, &itsref));
+  else PetscCall(ReferenceCG(A, pc, b, rtol, maxit, histref, &itsref));
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%s: %" PetscInt_FMT " iterations\n", type, its));
+  PetscCheck(its == itsref && nhist == itsref + 1, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%" PetscInt_FMT " iterations and %" PetscInt_FMT " residual norms instead of %" PetscInt_FMT, its, nhist, itsref);
+  for (PetscInt i = 0; i < nhist; i++) PetscCheck(PetscAbsReal(hist[i] - histref[i]) <= 1e-10 * histref[i], PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Residual norm %g at iteration %" PetscInt_FMT " instead of %g", (double)hist[i], i, (double)histref[i]);
+
+  PetscCall(PetscFree2(hist, histref));
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&b));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: cg
+      nsize: {{1 3}}
+      output_file: output/ex88_cg.out
+
+   test:
+      suffix: bcgs
+      nsize: {{1 3}}
+      args: -ksp_type bcgs -convection 0.5
+      output_file: output/ex88_bcgs.out
+
+TEST*/
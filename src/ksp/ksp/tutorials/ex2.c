@@ -237,6 +237,12 @@ int main(int argc, char **args)
       suffix: 3
       args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: asm_single
+      nsize: 3
+      requires: double
+      args: -m 12 -n 12 -pc_type asm -pc_asm_overlap 2 -pc_asm_restriction_single_precision -ksp_monitor_short
+
    test:
       suffix: 4
       args: -pc_type eisenstat -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
@@ -262,6 +268,12 @@ int main(int argc, char **args)
       nsize: 4
       args: -pc_type bjacobi -pc_bjacobi_blocks 4 -ksp_monitor_short -sub_pc_type jacobi -sub_ksp_type gmres
 
+   test:
+      suffix: split_rows
+      nsize: 4
+      args: -pc_type bjacobi -pc_bjacobi_blocks 4 -ksp_monitor_short -sub_pc_type jacobi -sub_ksp_type gmres -matmult_split_rows -sf_type {{basic neighbor}}
+      output_file: output/ex2_bjacobi_3.out
+
    test:
       suffix: qmrcgs
       args: -ksp_type qmrcgs -pc_type ilu
@@ -312,6 +324,21 @@ int main(int argc, char **args)
       suffix: pipecr
       args: -ksp_monitor_short -ksp_type pipecr -m 9 -n 9
 
+   test:
+      suffix: cacg
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type cacg -m 9 -n 9 -ksp_cacg_s {{1 4}} -ksp_cacg_newton_basis {{0 1}} -ksp_norm_type {{preconditioned unpreconditioned natural}separate output}
+
+   test:
+      suffix: chebyshev_matrix_powers
+      nsize: 4
+      args: -m 15 -n 15 -ksp_type chebyshev -ksp_chebyshev_esteig -ksp_norm_type none -ksp_max_it 5 -ksp_converged_reason -pc_type {{none jacobi}} -ksp_initial_guess_nonzero {{0 1}} -ksp_chebyshev_matrix_powers {{0 1}}
+
+   test:
+      suffix: gamg_chebyshev_matrix_powers
+      nsize: 4
+      args: -m 40 -n 40 -ksp_monitor_short -ksp_type cg -pc_type gamg -mg_levels_ksp_chebyshev_matrix_powers {{0 1}}
+
    test:
       suffix: pipelcg
       args: -ksp_monitor_short -ksp_type pipelcg -m 9 -n 9 -pc_type none -ksp_pipelcg_pipel 2 -ksp_pipelcg_lmax 2
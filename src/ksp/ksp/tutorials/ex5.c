@@ -446,4 +446,10 @@ int main(int argc, char **args)
       args: -pc_type lu -pc_factor_mat_solver_type superlu_dist -test_scaledMat
       output_file: output/ex5_superlu_dist.out
 
+   test:
+      suffix: ksp_aijfloat
+      nsize: 2
+      requires: !complex !single
+      args: -ksp_type fgmres -pc_type ksp -pc_ksp_mat_type aijfloat -ksp_ksp_type cg -ksp_ksp_rtol 1e-2 -ksp_pc_type gamg -ksp_rtol 1e-6
+
 TEST*/
@@ -12,6 +12,7 @@
 
 #include <petsc/private/pcasmimpl.h> /*I "petscpc.h" I*/
 #include "petsc/private/matimpl.h"
+#include <petscsf.h>
 
 static PetscErrorCode PCView_ASM(PC pc, PetscViewer viewer)
 {
@@ -34,6 +35,7 @@ static PetscErrorCode PCView_ASM(PC pc, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer, "  restriction/interpolation type - %s\n", PCASMTypes[osm->type]));
     if (osm->dm_subdomains) PetscCall(PetscViewerASCIIPrintf(viewer, "  Additive Schwarz: using DM to define subdomains\n"));
     if (osm->loctype != PC_COMPOSITE_ADDITIVE) PetscCall(PetscViewerASCIIPrintf(viewer, "  Additive Schwarz: local solve composition type - %s\n", PCCompositeTypes[osm->loctype]));
+    if (osm->single_prec) PetscCall(PetscViewerASCIIPrintf(viewer, "  Additive Schwarz: exchanging the overlap in single precision\n"));
     PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)pc), &rank));
     PetscCall(PetscViewerGetFormat(viewer, &format));
     if (format != PETSC_VIEWER_ASCII_INFO_DETAIL) {
@@ -322,6 +324,7 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
     PetscCall(VecSetType(osm->lx, vtype));
     PetscCall(VecDuplicate(osm->lx, &osm->ly));
     PetscCall(VecScatterCreate(vec, osm->lis, osm->lx, isl, &osm->restriction));
+    PetscCall(PetscSFSetUseSinglePrecision(osm->restriction, osm->single_prec));
     PetscCall(ISDestroy(&isl));
 
     for (i = 0; i < osm->n_local_true; ++i) {
@@ -721,6 +724,7 @@ static PetscErrorCode PCSetFromOptions_ASM(PC pc, PetscOptionItems *PetscOptions
   if (flg) PetscCall(PCASMSetLocalType(pc, loctype));
   PetscCall(PetscOptionsFList("-pc_asm_sub_mat_type", "Subsolve Matrix Type", "PCASMSetSubMatType", MatList, NULL, sub_mat_type, 256, &flg));
   if (flg) PetscCall(PCASMSetSubMatType(pc, sub_mat_type));
+  PetscCall(PetscOptionsBool("-pc_asm_restriction_single_precision", "Exchange the values of the overlap in single precision", "PetscSFSetUseSinglePrecision", osm->single_prec, &osm->single_prec, NULL));
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1226,7 +1230,8 @@ PetscErrorCode PCASMGetSubKSP(PC pc, PetscInt *n_local, PetscInt *first_local, K
 +  -pc_asm_blocks <blks> - Sets total blocks. Defaults to one block per MPI rank.
 .  -pc_asm_overlap <ovl> - Sets overlap
 .  -pc_asm_type [basic,restrict,interpolate,none] - Sets `PCASMType`, default is restrict. See `PCASMSetType()`
--  -pc_asm_local_type [additive, multiplicative] - Sets `PCCompositeType`, default is additive. See `PCASMSetLocalType()`
+.  -pc_asm_local_type [additive, multiplicative] - Sets `PCCompositeType`, default is additive. See `PCASMSetLocalType()`
+-  -pc_asm_restriction_single_precision - Exchanges the values of the overlap between MPI processes in single precision, halving the size of the messages. See `PetscSFSetUseSinglePrecision()`
 
    Level: beginner
 
@@ -1378,7 +1378,16 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc, Mat Amat, Mat *a_P)
     PetscCall(PetscLogEventBegin(petsc_gamg_setup_matmat_events[pc_gamg->current_level][2], 0, 0, 0, 0));
     PetscCall(MatMatMult(Amat, Prol, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &tMat));
     PetscCall(PetscLogEventEnd(petsc_gamg_setup_matmat_events[pc_gamg->current_level][2], 0, 0, 0, 0));
-    PetscCall(MatProductClear(tMat));
+    if (pc_gamg->reuse_aggs_ok && pc_gamg_agg->nsmooths == 1) {
+      /* keep P0 and the product A P0 to recompute P1 when the values of A change */
+      PetscCall(PetscObjectReference((PetscObject)Prol));
+      pc_gamg->Prol0[pc_gamg->current_level]  = Prol;
+      pc_gamg->AProl0[pc_gamg->current_level] = tMat;
+      PetscCall(MatDuplicate(tMat, MAT_COPY_VALUES, &tMat));
+    } else {
+      pc_gamg->reuse_aggs_ok = PETSC_FALSE;
+      PetscCall(MatProductClear(tMat));
+    }
     PetscCall(MatCreateVecs(Amat, &diag, NULL));
     PetscCall(MatGetDiagonal(Amat, diag)); /* effectively PCJACOBI */
     PetscCall(VecReciprocal(diag));
@@ -1388,7 +1397,8 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc, Mat Amat, Mat *a_P)
     /* TODO: Set a PCFailedReason and exit the building of the AMG preconditioner */
     PetscCheck(emax != 0.0, PetscObjectComm((PetscObject)pc), PETSC_ERR_PLIB, "Computed maximum singular value as zero");
     /* TODO: Document the 1.4 and don't hardwire it in this routine */
-    alpha = -1.4 / emax;
+    alpha                                       = -1.4 / emax;
+    pc_gamg->prol_omega[pc_gamg->current_level] = alpha;
 
     PetscCall(MatAYPX(tMat, alpha, Prol, SUBSET_NONZERO_PATTERN));
     PetscCall(MatDestroy(&Prol));
@@ -1400,6 +1410,42 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc, Mat Amat, Mat *a_P)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   PCGAMGOptProlongatorNumeric_AGG - recomputes P1 := (I - omega/lam D^{-1}A)P0 after a change of the values of A, with the
+   tentative prolongator, the damping, and the data structure of the product A P0 of the last full setup
+
+  Input Parameter:
+   . pc - this
+   . level - the level of Amat in the hierarchy, 0 being the finest
+   . Amat - matrix on this fine level, with the same nonzero pattern as the one used to create P
+ In/Output Parameter:
+   . P - prolongation operator to the next level
+*/
+static PetscErrorCode PCGAMGOptProlongatorNumeric_AGG(PC pc, PetscInt level, Mat Amat, Mat P)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+  Mat      AP      = pc_gamg->AProl0[level];
+  Vec      diag;
+
+  PetscFunctionBegin;
+  if (!AP) PetscFunctionReturn(PETSC_SUCCESS); /* P0 was not smoothed, it does not depend on the values of A */
+  PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_OPTSM], 0, 0, 0, 0));
+  if (AP->product->A != Amat) PetscCall(MatProductReplaceMats(Amat, NULL, NULL, AP));
+  PetscCall(PetscLogEventBegin(petsc_gamg_setup_matmat_events[level][2], 0, 0, 0, 0));
+  PetscCall(MatProductNumeric(AP));
+  PetscCall(PetscLogEventEnd(petsc_gamg_setup_matmat_events[level][2], 0, 0, 0, 0));
+  PetscCall(MatCopy(AP, P, SAME_NONZERO_PATTERN));
+  PetscCall(MatCreateVecs(Amat, &diag, NULL));
+  PetscCall(MatGetDiagonal(Amat, diag)); /* effectively PCJACOBI */
+  PetscCall(VecReciprocal(diag));
+  PetscCall(MatDiagonalScale(P, diag, NULL));
+  PetscCall(VecDestroy(&diag));
+  PetscCall(MatAYPX(P, pc_gamg->prol_omega[level], pc_gamg->Prol0[level], SUBSET_NONZERO_PATTERN));
+  PetscCall(PetscLogEventEnd(petsc_gamg_setup_events[GAMG_OPTSM], 0, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    PCCreateGAMG_AGG
 
@@ -1422,12 +1468,13 @@ PetscErrorCode PCCreateGAMG_AGG(PC pc)
   /* reset does not do anything; setup not virtual */
 
   /* set internal function pointers */
-  pc_gamg->ops->creategraph       = PCGAMGCreateGraph_AGG;
-  pc_gamg->ops->coarsen           = PCGAMGCoarsen_AGG;
-  pc_gamg->ops->prolongator       = PCGAMGProlongator_AGG;
-  pc_gamg->ops->optprolongator    = PCGAMGOptProlongator_AGG;
-  pc_gamg->ops->createdefaultdata = PCSetData_AGG;
-  pc_gamg->ops->view              = PCView_GAMG_AGG;
+  pc_gamg->ops->creategraph           = PCGAMGCreateGraph_AGG;
+  pc_gamg->ops->coarsen               = PCGAMGCoarsen_AGG;
+  pc_gamg->ops->prolongator           = PCGAMGProlongator_AGG;
+  pc_gamg->ops->optprolongator        = PCGAMGOptProlongator_AGG;
+  pc_gamg->ops->optprolongatornumeric = PCGAMGOptProlongatorNumeric_AGG;
+  pc_gamg->ops->createdefaultdata     = PCSetData_AGG;
+  pc_gamg->ops->view                  = PCView_GAMG_AGG;
 
   pc_gamg_agg->nsmooths                     = 1;
   pc_gamg_agg->aggressive_coarsening_levels = 1;
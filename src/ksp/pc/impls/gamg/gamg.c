@@ -24,6 +24,21 @@ static PetscLogStage gamg_stages[PETSC_MG_MAXLEVELS];
 static PetscFunctionList GAMGList = NULL;
 static PetscBool         PCGAMGPackageInitialized;
 
+static PetscErrorCode PCGAMGResetReuseAggregates_Private(PC_GAMG *pc_gamg)
+{
+  PetscFunctionBegin;
+  for (PetscInt level = 0; level < PETSC_MG_MAXLEVELS; level++) {
+    PetscCall(MatDestroy(&pc_gamg->Prol0[level]));
+    PetscCall(MatDestroy(&pc_gamg->AProl0[level]));
+    PetscCall(MatDestroy(&pc_gamg->Prolred[level]));
+    PetscCall(ISDestroy(&pc_gamg->Prolperm[level]));
+    pc_gamg->prol_omega[level] = 0;
+  }
+  pc_gamg->reuse_aggs_ok = PETSC_FALSE;
+  pc_gamg->cycle_rate    = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PCReset_GAMG(PC pc)
 {
   PC_MG   *mg      = (PC_MG *)pc->data;
@@ -39,6 +54,7 @@ static PetscErrorCode PCReset_GAMG(PC pc)
   }
   pc_gamg->emin = 0;
   pc_gamg->emax = 0;
+  PetscCall(PCGAMGResetReuseAggregates_Private(pc_gamg));
   PetscCall(PCReset_MG(pc));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -493,6 +509,37 @@ PetscErrorCode PCGAMGSquareGraph_GAMG(PC a_pc, Mat Gmat1, Mat *Gmat2)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   PCGAMGEstimateCycleRate_Private - estimates the convergence factor of the stationary iteration with the multigrid cycle,
+     from a few iterations on the homogeneous problem started from a noisy error, used by PCGAMGSetReuseAggregates()
+     to detect that a numeric rebuild of the hierarchy degraded the preconditioner
+*/
+static PetscErrorCode PCGAMGEstimateCycleRate_Private(PC pc, PetscReal *rate)
+{
+  const PetscInt its = 5;
+  Vec            e, r, y;
+  PetscReal      nrm, nrm0 = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreateVecs(pc->pmat, &e, &r));
+  PetscCall(VecDuplicate(e, &y));
+  PetscCall(KSPSetNoisy_Private(e));
+  /* the first iteration removes the components of the noise damped by the smoothers, only the following ones are measured */
+  for (PetscInt k = 0; k < its; k++) {
+    PetscCall(MatMult(pc->pmat, e, r));
+    PetscCall(PCApply(pc, r, y));
+    PetscCall(VecAXPY(e, -1.0, y));
+    PetscCall(VecNorm(e, NORM_2, &nrm));
+    if (!k) nrm0 = nrm;
+  }
+  *rate = nrm0 > 0.0 ? PetscPowReal(nrm / nrm0, 1.0 / (its - 1)) : 0.0;
+  *rate = PetscMax(*rate, PETSC_SMALL);
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&r));
+  PetscCall(VecDestroy(&e));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    PCSetUp_GAMG - Prepares for the use of the GAMG preconditioner
                     by setting data structures and options.
@@ -523,11 +570,12 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
   PetscCallMPI(MPI_Comm_size(comm, &size));
   PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_SETUP], 0, 0, 0, 0));
   if (pc->setupcalled) {
-    if (!pc_gamg->reuse_prol || pc->flag == DIFFERENT_NONZERO_PATTERN) {
-      /* reset everything */
-      PetscCall(PCReset_MG(pc));
-      pc->setupcalled = 0;
-    } else {
+    /* recompute the prolongators with the aggregates of the last full setup */
+    PetscBool numeric = (PetscBool)(pc_gamg->reuse_aggs && pc_gamg->reuse_aggs_ok && pc->flag != DIFFERENT_NONZERO_PATTERN);
+    PetscBool rebuild = PETSC_FALSE;
+
+    if (!numeric && (!pc_gamg->reuse_prol || pc->flag == DIFFERENT_NONZERO_PATTERN)) rebuild = PETSC_TRUE;
+    else {
       PC_MG_Levels **mglevels = mg->levels;
       /* just do Galerkin grids */
       Mat B, dA, dB;
@@ -544,6 +592,23 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
           PetscCall(PetscLogStagePush(gamg_stages[gl]));
 #endif
           /* matrix structure can change from repartitioning or process reduction but don't know if we have process reduction here. Should fix */
+          if (numeric) {
+            Mat P = pc_gamg->Prolred[gl] ? pc_gamg->Prolred[gl] : mglevels[level + 1]->interpolate;
+
+            PetscCall(pc_gamg->ops->optprolongatornumeric(pc, gl, dB, P));
+            if (pc_gamg->Prolred[gl]) { /* move the columns of P as in the reduction of the number of active processes */
+              IS       findices;
+              PetscInt Istart, Iend, f_bs;
+              Mat      Pnew = mglevels[level + 1]->interpolate;
+
+              PetscCall(MatGetBlockSize(dB, &f_bs));
+              PetscCall(MatGetOwnershipRange(P, &Istart, &Iend));
+              PetscCall(ISCreateStride(comm, Iend - Istart, Istart, 1, &findices));
+              PetscCall(ISSetBlockSize(findices, f_bs));
+              PetscCall(MatCreateSubMatrix(P, findices, pc_gamg->Prolperm[gl], MAT_REUSE_MATRIX, &Pnew));
+              PetscCall(ISDestroy(&findices));
+            }
+          }
           PetscCall(KSPGetOperators(mglevels[level]->smoothd, NULL, &B));
           if (B->product) {
             if (B->product->A == dB && B->product->B == mglevels[level + 1]->interpolate) reuse = MAT_REUSE_MATRIX;
@@ -581,6 +646,23 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
       }
 
       PetscCall(PCSetUp_MG(pc));
+      if (numeric && pc_gamg->reuse_aggs_tol >= 0.0) {
+        PetscReal rate, rate0 = pc_gamg->cycle_rate;
+
+        /* the number of iterations needed to reduce the error by a given factor is proportional to -1/log(rate) */
+        PetscCall(PCGAMGEstimateCycleRate_Private(pc, &rate));
+        if (rate > rate0) {
+          if (rate >= 1.0) rebuild = (PetscBool)(rate0 < 1.0);
+          else rebuild = (PetscBool)(PetscLogReal(rate0) / PetscLogReal(rate) > 1.0 + pc_gamg->reuse_aggs_tol);
+        }
+        PetscCall(PetscInfo(pc, "%s: convergence factor of the cycle %g after numeric rebuild, %g after last full setup%s\n", ((PetscObject)pc)->prefix, (double)rate, (double)rate0, rebuild ? ", rebuild the hierarchy" : ""));
+      }
+    }
+    if (rebuild) {
+      /* reset everything */
+      PetscCall(PCReset_MG(pc));
+      pc->setupcalled = 0;
+    } else {
       PetscCall(PetscLogEventEnd(petsc_gamg_setup_events[GAMG_SETUP], 0, 0, 0, 0));
       PetscFunctionReturn(PETSC_SUCCESS);
     }
@@ -604,13 +686,17 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
   }
 
   /* cache original data for reuse */
-  if (!pc_gamg->orig_data && (PetscBool)(!pc_gamg->reuse_prol)) {
+  if (!pc_gamg->orig_data && (PetscBool)(!pc_gamg->reuse_prol || pc_gamg->reuse_aggs)) {
     PetscCall(PetscMalloc1(pc_gamg->data_sz, &pc_gamg->orig_data));
     for (qq = 0; qq < pc_gamg->data_sz; qq++) pc_gamg->orig_data[qq] = pc_gamg->data[qq];
     pc_gamg->orig_data_cell_rows = pc_gamg->data_cell_rows;
     pc_gamg->orig_data_cell_cols = pc_gamg->data_cell_cols;
   }
 
+  /* data needed by a later numeric rebuild of the hierarchy, the hierarchy construction disables it if unsupported */
+  PetscCall(PCGAMGResetReuseAggregates_Private(pc_gamg));
+  pc_gamg->reuse_aggs_ok = (PetscBool)(pc_gamg->reuse_aggs && pc_gamg->ops->optprolongatornumeric);
+
   /* get basic dims */
   PetscCall(MatGetBlockSize(Pmat, &bs));
   PetscCall(MatGetSize(Pmat, &M, &N));
@@ -690,7 +776,14 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
     if (N <= pc_gamg->coarse_eq_limit) is_last = PETSC_TRUE;
     if (level1 == pc_gamg->Nlevels - 1) is_last = PETSC_TRUE;
     PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_LEVEL], 0, 0, 0, 0));
-    PetscCall(pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last));
+    if (pc_gamg->reuse_aggs_ok) {
+      Mat Pold = Parr[level1];
+
+      PetscCall(PetscObjectReference((PetscObject)Pold));
+      PetscCall(pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, &pc_gamg->Prolperm[level], is_last));
+      if (Parr[level1] != Pold) pc_gamg->Prolred[level] = Pold; /* reduction of the number of active processes */
+      else PetscCall(MatDestroy(&Pold));
+    } else PetscCall(pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last));
     PetscCall(PetscLogEventEnd(petsc_gamg_setup_events[GAMG_LEVEL], 0, 0, 0, 0));
 
     PetscCall(MatGetSize(Aarr[level1], &M, &N)); /* M is loop test variables */
@@ -821,6 +914,11 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
     }
 
     PetscCall(PCSetUp_MG(pc));
+    if (pc_gamg->reuse_aggs_ok && pc_gamg->reuse_aggs_tol >= 0.0) {
+      pc->setupcalled = 1; /* set by PCSetUp() on return, needed now so that PCApply() does not set up again */
+      PetscCall(PCGAMGEstimateCycleRate_Private(pc, &pc_gamg->cycle_rate));
+      PetscCall(PetscInfo(pc, "%s: convergence factor of the cycle %g\n", ((PetscObject)pc)->prefix, (double)pc_gamg->cycle_rate));
+    }
 
     /* clean up */
     for (level = 1; level < pc_gamg->Nlevels; level++) {
@@ -831,6 +929,7 @@ static PetscErrorCode PCSetUp_GAMG(PC pc)
     KSP smoother;
 
     PetscCall(PetscInfo(pc, "%s: One level solver used (system is seen as DD). Using default solver.\n", ((PetscObject)pc)->prefix));
+    pc_gamg->reuse_aggs_ok = PETSC_FALSE;
     PetscCall(PCMGGetSmoother(pc, 0, &smoother));
     PetscCall(KSPSetOperators(smoother, Aarr[0], Aarr[0]));
     PetscCall(KSPSetType(smoother, KSPPREONLY));
@@ -867,6 +966,8 @@ PetscErrorCode PCDestroy_GAMG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseSAEstEig_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRecomputeEstEig_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseInterpolation_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseAggregates_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseAggregatesTolerance_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGASMSetUseAggs_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetParallelCoarseGridSolve_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetCpuPinCoarseGrids_C", NULL));
@@ -1145,6 +1246,95 @@ static PetscErrorCode PCGAMGSetReuseInterpolation_GAMG(PC pc, PetscBool n)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  PCGAMGSetReuseAggregates - Keep the aggregates, and the nonzero pattern of the prolongators, when rebuilding a `PCGAMG` algebraic multigrid
+  preconditioner for a matrix with the same nonzero pattern, and only recompute the values of the prolongators and of the coarse grid operators
+
+  Logically Collective
+
+  Input Parameters:
++ pc - the preconditioner context
+- n  - `PETSC_TRUE` or `PETSC_FALSE`
+
+  Options Database Key:
+. -pc_gamg_reuse_aggregates <true,false> - reuse the aggregates
+
+  Level: intermediate
+
+  Notes:
+  This takes precedence over `PCGAMGSetReuseInterpolation()`. The numeric rebuild skips the construction of the graph, the coarsening, and the eigenvalue
+  estimates of the smoothed aggregation, and reuses the symbolic phases of the matrix-matrix products.
+
+  After each numeric rebuild, the convergence factor of the multigrid cycle is estimated with a few iterations and compared to the one
+  after the last full setup, and the hierarchy is rebuilt from scratch if it degraded by more than the tolerance set with `PCGAMGSetReuseAggregatesTolerance()`.
+  This estimate costs 5 applications of the cycle and 5 products by the operator in each full setup and each numeric rebuild; a negative tolerance
+  turns the check, and its cost, off.
+
+  The hierarchy is always rebuilt from scratch with `PCGAMGCLASSICAL` or when more than one smoothing step of the prolongators is used, see `PCGAMGSetNSmooths()`.
+
+.seealso: `PCGAMG`, `PCGAMGSetReuseAggregatesTolerance()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGSetNSmooths()`
+@*/
+PetscErrorCode PCGAMGSetReuseAggregates(PC pc, PetscBool n)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(pc, n, 2);
+  PetscTryMethod(pc, "PCGAMGSetReuseAggregates_C", (PC, PetscBool), (pc, n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCGAMGSetReuseAggregates_GAMG(PC pc, PetscBool n)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->reuse_aggs = n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  PCGAMGSetReuseAggregatesTolerance - Set the tolerance on the degradation of the multigrid cycle after a numeric rebuild of a `PCGAMG`
+  algebraic multigrid preconditioner, above which the hierarchy is rebuilt from scratch
+
+  Logically Collective
+
+  Input Parameters:
++ pc  - the preconditioner context
+- tol - the tolerance, or a negative value to never check the cycle after a numeric rebuild
+
+  Options Database Key:
+. -pc_gamg_reuse_aggregates_tol <tol, default=0.25> - the tolerance
+
+  Level: intermediate
+
+  Note:
+  With a convergence factor of the cycle `rate` after the numeric rebuild, and `rate0` after the last full setup, the hierarchy is rebuilt
+  from scratch if log(`rate0`)/log(`rate`) > 1 + `tol`, that is, if the number of iterations needed to reduce the error by a given factor increased
+  by more than a fraction `tol`. The estimate of the convergence factor costs 5 applications of the cycle and 5 products by the operator in each
+  full setup and each numeric rebuild, a negative `tol` avoids this cost.
+
+.seealso: `PCGAMG`, `PCGAMGSetReuseAggregates()`
+@*/
+PetscErrorCode PCGAMGSetReuseAggregatesTolerance(PC pc, PetscReal tol)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveReal(pc, tol, 2);
+  PetscTryMethod(pc, "PCGAMGSetReuseAggregatesTolerance_C", (PC, PetscReal), (pc, tol));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCGAMGSetReuseAggregatesTolerance_GAMG(PC pc, PetscReal tol)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+
+  PetscFunctionBegin;
+  pc_gamg->reuse_aggs_tol = tol;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   PCGAMGASMSetUseAggs - Have the `PCGAMG` smoother on each level use the aggregates defined by the coarsening process as the subdomains for the additive Schwarz preconditioner
   used as the smoother
@@ -1537,6 +1727,10 @@ static PetscErrorCode PCView_GAMG(PC pc, PetscViewer viewer)
   PetscCall(PetscViewerASCIIPrintf(viewer, "      Threshold scaling factor for each level not specified = %g\n", (double)pc_gamg->threshold_scale));
   if (pc_gamg->use_aggs_in_asm) PetscCall(PetscViewerASCIIPrintf(viewer, "      Using aggregates from coarsening process to define subdomains for PCASM\n"));
   if (pc_gamg->use_parallel_coarse_grid_solver) PetscCall(PetscViewerASCIIPrintf(viewer, "      Using parallel coarse grid solver (all coarse grid equations not put on one process)\n"));
+  if (pc_gamg->reuse_aggs) {
+    if (pc_gamg->reuse_aggs_tol >= 0.0) PetscCall(PetscViewerASCIIPrintf(viewer, "      Reusing aggregates, full rebuild if the cycle convergence rate degrades by more than %g\n", (double)pc_gamg->reuse_aggs_tol));
+    else PetscCall(PetscViewerASCIIPrintf(viewer, "      Reusing aggregates\n"));
+  }
   if (pc_gamg->ops->view) PetscCall((*pc_gamg->ops->view)(pc, viewer));
   PetscCall(PCMGGetGridComplexity(pc, &gc, &oc));
   PetscCall(PetscViewerASCIIPrintf(viewer, "      Complexity:    grid = %g    operator = %g\n", (double)gc, (double)oc));
@@ -1562,6 +1756,8 @@ static PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOption
   PetscCall(PetscOptionsBool("-pc_gamg_use_sa_esteig", "Use eigen estimate from smoothed aggregation for smoother", "PCGAMGSetUseSAEstEig", pc_gamg->use_sa_esteig, &pc_gamg->use_sa_esteig, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_recompute_esteig", "Set flag to recompute eigen estimates for Chebyshev when matrix changes", "PCGAMGSetRecomputeEstEig", pc_gamg->recompute_esteig, &pc_gamg->recompute_esteig, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_reuse_interpolation", "Reuse prolongation operator", "PCGAMGReuseInterpolation", pc_gamg->reuse_prol, &pc_gamg->reuse_prol, NULL));
+  PetscCall(PetscOptionsBool("-pc_gamg_reuse_aggregates", "Reuse aggregates and only recompute the values of the prolongation operator", "PCGAMGSetReuseAggregates", pc_gamg->reuse_aggs, &pc_gamg->reuse_aggs, NULL));
+  PetscCall(PetscOptionsReal("-pc_gamg_reuse_aggregates_tol", "Degradation of the cycle convergence rate that triggers a full rebuild (negative for none)", "PCGAMGSetReuseAggregatesTolerance", pc_gamg->reuse_aggs_tol, &pc_gamg->reuse_aggs_tol, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_asm_use_agg", "Use aggregation aggregates for ASM smoother", "PCGAMGASMSetUseAggs", pc_gamg->use_aggs_in_asm, &pc_gamg->use_aggs_in_asm, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_parallel_coarse_grid_solver", "Use parallel coarse grid solver (otherwise put last grid on one process)", "PCGAMGSetParallelCoarseGridSolve", pc_gamg->use_parallel_coarse_grid_solver, &pc_gamg->use_parallel_coarse_grid_solver, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_cpu_pin_coarse_grids", "Pin coarse grids to the CPU", "PCGAMGSetCpuPinCoarseGrids", pc_gamg->cpu_pin_coarse_grids, &pc_gamg->cpu_pin_coarse_grids, NULL));
@@ -1616,6 +1812,8 @@ static PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOption
                                         equations on each process that has degrees of freedom
 . -pc_gamg_coarse_eq_limit <limit, default=50> - Set maximum number of equations on coarsest grid to aim for.
 . -pc_gamg_reuse_interpolation <bool,default=true> - when rebuilding the algebraic multigrid preconditioner reuse the previously computed interpolations (should always be true)
+. -pc_gamg_reuse_aggregates <bool,default=false> - when rebuilding the algebraic multigrid preconditioner for a matrix with the same nonzero pattern, reuse the aggregates and only recompute the values of the interpolations
+. -pc_gamg_reuse_aggregates_tol <tol,default=0.25> - rebuild the hierarchy from scratch if the convergence rate of the cycle degraded by more than this after reusing the aggregates
 . -pc_gamg_threshold[] <thresh,default=[-1,...]> - Before aggregating the graph `PCGAMG` will remove small values from the graph on each level (< 0 does no filtering)
 - -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
 
@@ -1644,7 +1842,7 @@ static PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOption
   See [the Users Manual section on PCGAMG](sec_amg) and [the Users Manual section on PCMG](sec_mg)for more details.
 
 .seealso: `PCCreate()`, `PCSetType()`, `MatSetBlockSize()`, `PCMGType`, `PCSetCoordinates()`, `MatSetNearNullSpace()`, `PCGAMGSetType()`, `PCGAMGAGG`, `PCGAMGGEO`, `PCGAMGCLASSICAL`, `PCGAMGSetProcEqLim()`,
-          `PCGAMGSetCoarseEqLim()`, `PCGAMGSetRepartition()`, `PCGAMGRegister()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGASMSetUseAggs()`, `PCGAMGSetParallelCoarseGridSolve()`, `PCGAMGSetNlevels()`, `PCGAMGSetThreshold()`, `PCGAMGGetType()`, `PCGAMGSetUseSAEstEig()`
+          `PCGAMGSetCoarseEqLim()`, `PCGAMGSetRepartition()`, `PCGAMGRegister()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGSetReuseAggregates()`, `PCGAMGASMSetUseAggs()`, `PCGAMGSetParallelCoarseGridSolve()`, `PCGAMGSetNlevels()`, `PCGAMGSetThreshold()`, `PCGAMGGetType()`, `PCGAMGSetUseSAEstEig()`
 M*/
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
 {
@@ -1685,6 +1883,8 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseSAEstEig_C", PCGAMGSetUseSAEstEig_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRecomputeEstEig_C", PCGAMGSetRecomputeEstEig_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseInterpolation_C", PCGAMGSetReuseInterpolation_GAMG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseAggregates_C", PCGAMGSetReuseAggregates_GAMG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseAggregatesTolerance_C", PCGAMGSetReuseAggregatesTolerance_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGASMSetUseAggs_C", PCGAMGASMSetUseAggs_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetParallelCoarseGridSolve_C", PCGAMGSetParallelCoarseGridSolve_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetCpuPinCoarseGrids_C", PCGAMGSetCpuPinCoarseGrids_GAMG));
@@ -1697,6 +1897,8 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetNlevels_C", PCGAMGSetNlevels_GAMG));
   pc_gamg->repart                          = PETSC_FALSE;
   pc_gamg->reuse_prol                      = PETSC_TRUE;
+  pc_gamg->reuse_aggs                      = PETSC_FALSE;
+  pc_gamg->reuse_aggs_tol                  = 0.25;
   pc_gamg->use_aggs_in_asm                 = PETSC_FALSE;
   pc_gamg->use_parallel_coarse_grid_solver = PETSC_FALSE;
   pc_gamg->cpu_pin_coarse_grids            = PETSC_FALSE;
@@ -3,8 +3,11 @@
 #include <petscksp.h> /*I "petscksp.h" I*/
 
 typedef struct {
-  KSP      ksp;
-  PetscInt its; /* total number of iterations KSP uses */
+  KSP           ksp;
+  PetscInt      its;     /* total number of iterations KSP uses */
+  MatType       mattype; /* type the preconditioning matrix is converted to for the inner solve */
+  Mat           pmat;    /* the converted preconditioning matrix */
+  PetscObjectId pmatid;  /* id of the preconditioning matrix it was converted from */
 } PC_KSP;
 
 static PetscErrorCode PCKSPCreateKSP_KSP(PC pc)
@@ -86,16 +89,28 @@ static PetscErrorCode PCApplyTranspose_KSP(PC pc, Vec x, Vec y)
 static PetscErrorCode PCSetUp_KSP(PC pc)
 {
   PC_KSP *jac = (PC_KSP *)pc->data;
-  Mat     mat;
+  Mat     mat, pmat = pc->pmat;
 
   PetscFunctionBegin;
   if (!jac->ksp) {
     PetscCall(PCKSPCreateKSP_KSP(pc));
     PetscCall(KSPSetFromOptions(jac->ksp));
   }
+  if (jac->mattype) {
+    PetscObjectId id;
+
+    PetscCall(PetscObjectGetId((PetscObject)pc->pmat, &id));
+    if (jac->pmat && id == jac->pmatid && pc->flag == SAME_NONZERO_PATTERN) PetscCall(MatCopy(pc->pmat, jac->pmat, SAME_NONZERO_PATTERN));
+    else {
+      PetscCall(MatDestroy(&jac->pmat));
+      PetscCall(MatConvert(pc->pmat, jac->mattype, MAT_INITIAL_MATRIX, &jac->pmat));
+      jac->pmatid = id;
+    }
+    pmat = jac->pmat;
+  }
   if (pc->useAmat) mat = pc->mat;
-  else mat = pc->pmat;
-  PetscCall(KSPSetOperators(jac->ksp, mat, pc->pmat));
+  else mat = pmat;
+  PetscCall(KSPSetOperators(jac->ksp, mat, pmat));
   PetscCall(KSPSetUp(jac->ksp));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -107,6 +122,7 @@ static PetscErrorCode PCReset_KSP(PC pc)
 
   PetscFunctionBegin;
   PetscCall(KSPDestroy(&jac->ksp));
+  PetscCall(MatDestroy(&jac->pmat));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -116,8 +132,12 @@ static PetscErrorCode PCDestroy_KSP(PC pc)
 
   PetscFunctionBegin;
   PetscCall(KSPDestroy(&jac->ksp));
+  PetscCall(MatDestroy(&jac->pmat));
+  PetscCall(PetscFree(jac->mattype));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCKSPGetKSP_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCKSPSetKSP_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCKSPGetMatType_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCKSPSetMatType_C", NULL));
   PetscCall(PetscFree(pc->data));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -132,6 +152,7 @@ static PetscErrorCode PCView_KSP(PC pc, PetscViewer viewer)
   PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
   if (iascii) {
     if (pc->useAmat) PetscCall(PetscViewerASCIIPrintf(viewer, "  Using Amat (not Pmat) as operator on inner solve\n"));
+    if (jac->mattype) PetscCall(PetscViewerASCIIPrintf(viewer, "  Pmat converted to %s for the inner solve\n", jac->mattype));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  KSP and PC on KSP preconditioner follow\n"));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  ---------------------------------\n"));
   }
@@ -218,12 +239,98 @@ PetscErrorCode PCKSPGetKSP(PC pc, KSP *ksp)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode PCSetFromOptions_KSP(PC pc, PetscOptionItems *PetscOptionsObject)
+static PetscErrorCode PCKSPSetMatType_KSP(PC pc, MatType mattype)
+{
+  PC_KSP   *jac = (PC_KSP *)pc->data;
+  PetscBool same;
+
+  PetscFunctionBegin;
+  PetscCall(PetscStrcmp(jac->mattype, mattype, &same));
+  if (same) PetscFunctionReturn(PETSC_SUCCESS); /* keep the converted matrix */
+  PetscCall(PetscFree(jac->mattype));
+  PetscCall(PetscStrallocpy(mattype, (char **)&jac->mattype));
+  PetscCall(MatDestroy(&jac->pmat));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PCKSPSetMatType - Sets the type the preconditioning matrix is converted to for the inner solve of a `PCKSP`
+
+  Logically Collective
+
+  Input Parameters:
++ pc      - the preconditioner context
+- mattype - the `MatType`, or `NULL` to use the preconditioning matrix as it is
+
+  Options Database Key:
+. -pc_ksp_mat_type <mattype> - sets the matrix type, for example, aijfloat
+
+  Level: advanced
+
+  Notes:
+  The converted matrix is used as both operators of the inner `KSP`, unless `PCSetUseAmat()` is set, and its values are copied
+  from the preconditioning matrix when it only changes values.
+
+  With `MATAIJFLOAT` the inner solve, and for example the `PCGAMG` hierarchy built from it, applies the matrix with its values in single
+  precision while the outer solve uses the double precision preconditioning matrix, giving a mixed precision iterative refinement with
+  a flexible outer `KSP` such as `KSPFGMRES`.
+
+.seealso: `PCKSP`, `PCKSPGetMatType()`, `PCKSPGetKSP()`, `MatConvert()`, `MATAIJFLOAT`
+@*/
+PetscErrorCode PCKSPSetMatType(PC pc, MatType mattype)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscTryMethod(pc, "PCKSPSetMatType_C", (PC, MatType), (pc, mattype));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCKSPGetMatType_KSP(PC pc, MatType *mattype)
 {
   PC_KSP *jac = (PC_KSP *)pc->data;
 
+  PetscFunctionBegin;
+  *mattype = jac->mattype;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PCKSPGetMatType - Gets the type the preconditioning matrix is converted to for the inner solve of a `PCKSP`
+
+  Not Collective
+
+  Input Parameter:
+. pc - the preconditioner context
+
+  Output Parameter:
+. mattype - the `MatType`, or `NULL` if the preconditioning matrix is used as it is
+
+  Level: advanced
+
+.seealso: `PCKSP`, `PCKSPSetMatType()`
+@*/
+PetscErrorCode PCKSPGetMatType(PC pc, MatType *mattype)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscAssertPointer(mattype, 2);
+  PetscUseMethod(pc, "PCKSPGetMatType_C", (PC, MatType *), (pc, mattype));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetFromOptions_KSP(PC pc, PetscOptionItems *PetscOptionsObject)
+{
+  PC_KSP   *jac = (PC_KSP *)pc->data;
+  char      mattype[256];
+  PetscBool flg, same;
+
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject, "PC KSP options");
+  PetscCall(PetscOptionsFList("-pc_ksp_mat_type", "Matrix type the preconditioning matrix is converted to for the inner solve", "PCKSPSetMatType", MatList, jac->mattype, mattype, sizeof(mattype), &flg));
+  if (flg) {
+    PetscCall(PetscStrcmp(jac->mattype, mattype, &same));
+    if (!same) PetscCall(PCKSPSetMatType(pc, mattype));
+  }
   if (jac->ksp) PetscCall(KSPSetFromOptions(jac->ksp));
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -233,10 +340,11 @@ static PetscErrorCode PCSetFromOptions_KSP(PC pc, PetscOptionItems *PetscOptions
      PCKSP -    Defines a preconditioner as any `KSP` solver.
                  This allows, for example, embedding a Krylov method inside a preconditioner.
 
-   Options Database Key:
-.   -pc_use_amat - use the matrix that defines the linear system, Amat as the matrix for the
+   Options Database Keys:
++   -pc_use_amat - use the matrix that defines the linear system, Amat as the matrix for the
                     inner solver, otherwise by default it uses the matrix used to construct
                     the preconditioner, Pmat (see `PCSetOperators()`)
+-   -pc_ksp_mat_type <mattype> - convert Pmat to this type for the inner solver, for example aijfloat, see `PCKSPSetMatType()`
 
    Level: intermediate
 
@@ -256,7 +364,7 @@ static PetscErrorCode PCSetFromOptions_KSP(PC pc, PetscOptionItems *PetscOptions
     Richardson code) inside the `PCApplyRichardson_PCKSP()` leading to duplicate code.
 
 .seealso: `PCCreate()`, `PCSetType()`, `PCType`, `PC`,
-          `PCSHELL`, `PCCOMPOSITE`, `PCSetUseAmat()`, `PCKSPGetKSP()`, `KSPFGMRES`, `KSPGCR`, `KSPFCG`
+          `PCSHELL`, `PCCOMPOSITE`, `PCSetUseAmat()`, `PCKSPGetKSP()`, `PCKSPSetMatType()`, `KSPFGMRES`, `KSPGCR`, `KSPFCG`
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_KSP(PC pc)
@@ -279,5 +387,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_KSP(PC pc)
 
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCKSPGetKSP_C", PCKSPGetKSP_KSP));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCKSPSetKSP_C", PCKSPSetKSP_KSP));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCKSPGetMatType_C", PCKSPGetMatType_KSP));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCKSPSetMatType_C", PCKSPSetMatType_KSP));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -311,6 +311,8 @@
       PetscEnum, parameter :: MATOP_DESTROYSUBMATRICES=145
       PetscEnum, parameter :: MATOP_TRANSPOSE_SOLVE=146
       PetscEnum, parameter :: MATOP_GET_VALUES_LOCAL=147
+      PetscEnum, parameter :: MATOP_MULT_DOT=152
+      PetscEnum, parameter :: MATOP_MULT_ADD_NORM=153
 !
 !
 !
@@ -615,6 +617,8 @@
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_DESTROYSUBMATRICES
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_TRANSPOSE_SOLVE
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_GET_VALUES_LOCAL
+!DEC$ ATTRIBUTES DLLEXPORT::MATOP_MULT_DOT
+!DEC$ ATTRIBUTES DLLEXPORT::MATOP_MULT_ADD_NORM
 !DEC$ ATTRIBUTES DLLEXPORT::MP_CHACO_MULTILEVEL_KL
 !DEC$ ATTRIBUTES DLLEXPORT::MP_CHACO_SPECTRAL
 !DEC$ ATTRIBUTES DLLEXPORT::MP_CHACO_LINEAR
@@ -112,6 +112,7 @@ PetscErrorCode MatSetUpMultiply_MPIAIJ(Mat mat)
 
   /* generate the scatter context */
   PetscCall(VecScatterDestroy(&aij->Mvctx));
+  PetscCall(MatMPIAIJResetSplitRows_Private(mat));
   PetscCall(VecScatterCreate(gvec, from, aij->lvec, to, &aij->Mvctx));
   PetscCall(VecScatterViewFromOptions(aij->Mvctx, (PetscObject)mat, "-matmult_vecscatter_view"));
   aij->garray = garray;
@@ -136,6 +137,8 @@ PetscErrorCode MatDisAssemble_MPIAIJ(Mat A)
   PetscFunctionBegin;
   /* free stuff related to matrix-vec multiply */
   PetscCall(VecDestroy(&aij->lvec));
+  PetscCall(MatMPIAIJResetSplitRows_Private(A));
+  PetscCall(MatMatrixPowersDestroy_Private(&aij->powers));
   if (aij->colmap) {
 #if defined(PETSC_USE_CTABLE)
     PetscCall(PetscHMapIDestroy(&aij->colmap));
@@ -6,6 +6,16 @@
 #include <petscsf.h>
 #include <petsc/private/hashmapi.h>
 
+PetscErrorCode MatMPIAIJResetSplitRows_Private(Mat A)
+{
+  Mat_MPIAIJ *a = (Mat_MPIAIJ *)A->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree3(a->splitndeps, a->splitcnt, a->splitoffset));
+  PetscCall(PetscFree2(a->splitrow, a->splitdone));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
 {
   Mat_MPIAIJ *aij = (Mat_MPIAIJ *)mat->data;
@@ -26,6 +36,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   PetscCall(VecScatterDestroy(&aij->Mvctx));
   PetscCall(PetscFree2(aij->rowvalues, aij->rowindices));
   PetscCall(PetscFree(aij->ld));
+  PetscCall(MatMPIAIJResetSplitRows_Private(mat));
+  PetscCall(MatMatrixPowersDestroy_Private(&aij->powers));
 
   PetscCall(PetscFree(mat->data));
 
@@ -40,6 +52,7 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatResetPreallocation_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatMPIAIJSetPreallocationCSR_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatDiagonalScaleLocal_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatGetMatrixPowers_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpibaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpisbaij_C", NULL));
 #if defined(PETSC_HAVE_CUDA)
@@ -68,6 +81,9 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatMPIAIJSetUseScalableIncreaseOverlap_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijperm_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijsell_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijfloat_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijdelta_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpivbaij_C", NULL));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)mat, "MatConvert_mpiaij_mpiaijmkl_C", NULL));
 #endif
@@ -603,7 +619,9 @@ PetscErrorCode MatSetValues_MPIAIJ(Mat mat, PetscInt m, const PetscInt im[], Pet
       PetscCheck(!mat->nooffprocentries, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Setting off process row %" PetscInt_FMT " even though MatSetOption(,MAT_NO_OFF_PROC_ENTRIES,PETSC_TRUE) was set", im[i]);
       if (!aij->donotstash) {
         mat->assembled = PETSC_FALSE;
-        if (roworiented) {
+        if (mat->stash.ht) {
+          PetscCall(MatStashValuesCombine_Private(&mat->stash, im[i], n, in, v ? (roworiented ? v + i * n : v + i) : NULL, roworiented ? 1 : m, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES)), addv));
+        } else if (roworiented) {
           PetscCall(MatStashValuesRow_Private(&mat->stash, im[i], n, in, v ? v + i * n : NULL, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES))));
         } else {
           PetscCall(MatStashValuesCol_Private(&mat->stash, im[i], n, in, v ? v + i : NULL, m, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES))));
@@ -1034,6 +1052,102 @@ static PetscErrorCode MatZeroRowsColumns_MPIAIJ(Mat A, PetscInt N, const PetscIn
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Count the neighbors (root ranks of Mvctx) each row of B needs data from and list, for each neighbor, the rows depending on it */
+static PetscErrorCode MatMPIAIJSetUpSplitRows_Private(Mat A)
+{
+  Mat_MPIAIJ     *a = (Mat_MPIAIJ *)A->data;
+  Mat_SeqAIJ     *b = (Mat_SeqAIJ *)a->B->data;
+  PetscInt        m = a->B->rmap->n, nranks, i, j, k, *colrank, *mark, *pos;
+  const PetscInt *roffset, *rmine;
+
+  PetscFunctionBegin;
+  if (a->splitndeps && a->splitstate == a->B->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatMPIAIJResetSplitRows_Private(A));
+  PetscCall(PetscSFSetUp(a->Mvctx));
+  PetscCall(PetscSFGetRootRanks(a->Mvctx, &nranks, NULL, &roffset, &rmine, NULL));
+  PetscCall(PetscMalloc3(a->B->cmap->n, &colrank, nranks, &mark, nranks, &pos));
+  PetscCall(PetscMalloc3(m, &a->splitndeps, m, &a->splitcnt, nranks + 1, &a->splitoffset));
+  for (i = 0; i < nranks; i++) {
+    for (k = roffset[i]; k < roffset[i + 1]; k++) colrank[rmine[k]] = i;
+    mark[i] = -1;
+  }
+  PetscCall(PetscArrayzero(a->splitoffset, nranks + 1));
+  for (i = 0; i < m; i++) {
+    a->splitndeps[i] = 0;
+    for (j = b->i[i]; j < b->i[i + 1]; j++) {
+      k = colrank[b->j[j]];
+      if (mark[k] == i) continue;
+      mark[k] = i;
+      a->splitndeps[i]++;
+      a->splitoffset[k + 1]++;
+    }
+  }
+  for (i = 0; i < nranks; i++) {
+    a->splitoffset[i + 1] += a->splitoffset[i];
+    pos[i]  = a->splitoffset[i];
+    mark[i] = -1;
+  }
+  PetscCall(PetscMalloc2(a->splitoffset[nranks], &a->splitrow, nranks, &a->splitdone));
+  for (i = 0; i < m; i++) {
+    for (j = b->i[i]; j < b->i[i + 1]; j++) {
+      k = colrank[b->j[j]];
+      if (mark[k] == i) continue;
+      mark[k]               = i;
+      a->splitrow[pos[k]++] = i;
+    }
+  }
+  PetscCall(PetscFree3(colrank, mark, pos));
+  a->splitstate = a->B->nonzerostate;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  zz = A xx (+ yy): the diagonal block is applied while the halo is in flight, as in MatMult_MPIAIJ(), but instead of
+  waiting for all the messages each boundary row (a row of B) is computed as soon as the neighbors it depends on have
+  sent their part of lvec, so a late neighbor only delays the rows it contributes to.
+*/
+static PetscErrorCode MatMultAdd_MPIAIJ_SplitRows(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_MPIAIJ        *a = (Mat_MPIAIJ *)A->data;
+  Mat_SeqAIJ        *b = (Mat_SeqAIJ *)a->B->data;
+  const PetscScalar *x, *aa = b->a, *v;
+  PetscScalar       *lv, *z, sum;
+  const PetscInt    *ii = b->i, *jj = b->j, *idx;
+  PetscInt           nleft, ndone, i, k, r, n;
+
+  PetscFunctionBegin;
+  PetscCall(MatMPIAIJSetUpSplitRows_Private(A));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(a->lvec, &lv));
+  PetscCall(PetscSFBcastBegin(a->Mvctx, MPIU_SCALAR, x, lv, MPI_REPLACE));
+  if (yy) PetscCall((*a->A->ops->multadd)(a->A, xx, yy, zz));
+  else PetscCall((*a->A->ops->mult)(a->A, xx, zz));
+  PetscCall(VecGetArray(zz, &z));
+  PetscCall(PetscArraycpy(a->splitcnt, a->splitndeps, a->B->rmap->n));
+  PetscCall(PetscSFGetRootRanks(a->Mvctx, &nleft, NULL, NULL, NULL, NULL));
+  do {
+    PetscCall(PetscSFBcastEndSome(a->Mvctx, MPIU_SCALAR, x, lv, MPI_REPLACE, &ndone, a->splitdone));
+    for (i = 0; i < ndone; i++) {
+      for (k = a->splitoffset[a->splitdone[i]]; k < a->splitoffset[a->splitdone[i] + 1]; k++) {
+        r = a->splitrow[k];
+        if (--a->splitcnt[r]) continue;
+        n   = ii[r + 1] - ii[r];
+        v   = aa + ii[r];
+        idx = jj + ii[r];
+        sum = 0.0;
+        PetscSparseDensePlusDot(sum, lv, v, idx, n);
+        z[r] += sum;
+      }
+    }
+    nleft -= ndone;
+  } while (nleft > 0);
+  PetscCall(PetscLogFlops(2.0 * b->nz));
+  PetscCall(VecRestoreArray(zz, &z));
+  PetscCall(VecRestoreArray(a->lvec, &lv));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatMult_MPIAIJ(Mat A, Vec xx, Vec yy)
 {
   Mat_MPIAIJ *a = (Mat_MPIAIJ *)A->data;
@@ -1043,6 +1157,15 @@ static PetscErrorCode MatMult_MPIAIJ(Mat A, Vec xx, Vec yy)
   PetscFunctionBegin;
   PetscCall(VecGetLocalSize(xx, &nt));
   PetscCheck(nt == A->cmap->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Incompatible partition of A (%" PetscInt_FMT ") and xx (%" PetscInt_FMT ")", A->cmap->n, nt);
+  if (a->splitrows) { /* B is read directly from its CSR arrays, subtypes keep their own kernels */
+    PetscBool seqaij;
+
+    PetscCall(PetscObjectTypeCompare((PetscObject)a->B, MATSEQAIJ, &seqaij));
+    if (seqaij) {
+      PetscCall(MatMultAdd_MPIAIJ_SplitRows(A, xx, NULL, yy));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
   PetscCall(VecScatterBegin(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
   PetscUseTypeMethod(a->A, mult, xx, yy);
   PetscCall(VecScatterEnd(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
@@ -1065,6 +1188,15 @@ static PetscErrorCode MatMultAdd_MPIAIJ(Mat A, Vec xx, Vec yy, Vec zz)
   VecScatter  Mvctx = a->Mvctx;
 
   PetscFunctionBegin;
+  if (a->splitrows) { /* B is read directly from its CSR arrays, subtypes keep their own kernels */
+    PetscBool seqaij;
+
+    PetscCall(PetscObjectTypeCompare((PetscObject)a->B, MATSEQAIJ, &seqaij));
+    if (seqaij) {
+      PetscCall(MatMultAdd_MPIAIJ_SplitRows(A, xx, yy, zz));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
   PetscCall(VecScatterBegin(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
   PetscCall((*a->A->ops->multadd)(a->A, xx, yy, zz));
   PetscCall(VecScatterEnd(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
@@ -1072,6 +1204,58 @@ static PetscErrorCode MatMultAdd_MPIAIJ(Mat A, Vec xx, Vec yy, Vec zz)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* the off-diagonal part is added last, so the reduction is accumulated as it completes each entry of the result */
+static PetscErrorCode MatMultDot_MPIAIJ(Mat A, Vec xx, Vec yy, Vec ww, PetscScalar *dot)
+{
+  Mat_MPIAIJ *a     = (Mat_MPIAIJ *)A->data;
+  VecScatter  Mvctx = a->Mvctx;
+  PetscScalar d;
+
+  PetscFunctionBegin;
+  if (A->ops->mult != MatMult_MPIAIJ) {
+    PetscCall(MatMultDot_Basic(A, xx, yy, ww, dot));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecScatterBegin(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  PetscUseTypeMethod(a->A, mult, xx, yy);
+  PetscCall(VecScatterEnd(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  if (MatSeqAIJUsesAIJMult_Private(a->B)) {
+    PetscCall(MatMultAddDot_SeqAIJ(a->B, a->lvec, yy, yy, ww, &d));
+    PetscCall(MPIU_Allreduce(&d, dot, 1, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)A)));
+  } else {
+    PetscUseTypeMethod(a->B, multadd, a->lvec, yy, yy);
+    PetscCall(VecDot(ww, yy, dot));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAddNorm_MPIAIJ(Mat A, Vec xx, Vec yy, Vec zz, PetscReal *norm)
+{
+  Mat_MPIAIJ *a     = (Mat_MPIAIJ *)A->data;
+  VecScatter  Mvctx = a->Mvctx;
+  PetscScalar d;
+  PetscReal   sum;
+
+  PetscFunctionBegin;
+  if (A->ops->multadd != MatMultAdd_MPIAIJ) {
+    PetscCall(MatMultAddNorm_Basic(A, xx, yy, zz, norm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecScatterBegin(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCall((*a->A->ops->multadd)(a->A, xx, yy, zz));
+  PetscCall(VecScatterEnd(Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  if (MatSeqAIJUsesAIJMult_Private(a->B)) {
+    PetscCall(MatMultAddDot_SeqAIJ(a->B, a->lvec, zz, zz, NULL, &d));
+    sum = PetscRealPart(d);
+    PetscCall(MPIU_Allreduce(&sum, norm, 1, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)A)));
+    *norm = PetscSqrtReal(*norm);
+  } else {
+    PetscUseTypeMethod(a->B, multadd, a->lvec, zz, zz);
+    PetscCall(VecNorm(zz, NORM_2, norm));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatMultTranspose_MPIAIJ(Mat A, Vec xx, Vec yy)
 {
   Mat_MPIAIJ *a = (Mat_MPIAIJ *)A->data;
@@ -2646,13 +2830,15 @@ PetscErrorCode MatMPIAIJSetUseScalableIncreaseOverlap(Mat A, PetscBool sc)
 
 PetscErrorCode MatSetFromOptions_MPIAIJ(Mat A, PetscOptionItems *PetscOptionsObject)
 {
-  PetscBool sc = PETSC_FALSE, flg;
+  Mat_MPIAIJ *a  = (Mat_MPIAIJ *)A->data;
+  PetscBool   sc = PETSC_FALSE, flg;
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject, "MPIAIJ options");
   if (A->ops->increaseoverlap == MatIncreaseOverlap_MPIAIJ_Scalable) sc = PETSC_TRUE;
   PetscCall(PetscOptionsBool("-mat_increase_overlap_scalable", "Use a scalable algorithm to compute the overlap", "MatIncreaseOverlap", sc, &sc, &flg));
   if (flg) PetscCall(MatMPIAIJSetUseScalableIncreaseOverlap(A, sc));
+  PetscCall(PetscOptionsBool("-matmult_split_rows", "Compute each off-process row as soon as the messages it depends on arrive", "MatMult", a->splitrows, &a->splitrows, NULL));
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -2859,7 +3045,9 @@ static struct _MatOps MatOps_Values = {MatSetValues_MPIAIJ,
                                        MatCreateGraph_Simple_AIJ,
                                        NULL,
                                        /*150*/ NULL,
-                                       MatEliminateZeros_MPIAIJ};
+                                       MatEliminateZeros_MPIAIJ,
+                                       MatMultDot_MPIAIJ,
+                                       MatMultAddNorm_MPIAIJ};
 
 static PetscErrorCode MatStoreValues_MPIAIJ(Mat mat)
 {
@@ -2902,6 +3090,8 @@ PetscErrorCode MatMPIAIJSetPreallocation_MPIAIJ(Mat B, PetscInt d_nz, const Pets
   PetscCall(PetscFree(b->garray));
   PetscCall(VecDestroy(&b->lvec));
   PetscCall(VecScatterDestroy(&b->Mvctx));
+  PetscCall(MatMPIAIJResetSplitRows_Private(B));
+  PetscCall(MatMatrixPowersDestroy_Private(&b->powers));
 
   PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)B), &size));
   PetscCall(MatDestroy(&b->B));
@@ -2941,6 +3131,8 @@ static PetscErrorCode MatResetPreallocation_MPIAIJ(Mat B)
   PetscCall(PetscFree(b->garray));
   PetscCall(VecDestroy(&b->lvec));
   PetscCall(VecScatterDestroy(&b->Mvctx));
+  PetscCall(MatMPIAIJResetSplitRows_Private(B));
+  PetscCall(MatMatrixPowersDestroy_Private(&b->powers));
 
   PetscCall(MatResetPreallocation(b->A));
   PetscCall(MatResetPreallocation(b->B));
@@ -2972,6 +3164,7 @@ PetscErrorCode MatDuplicate_MPIAIJ(Mat matin, MatDuplicateOption cpvalues, Mat *
   a->rank         = oldmat->rank;
   a->donotstash   = oldmat->donotstash;
   a->roworiented  = oldmat->roworiented;
+  a->splitrows    = oldmat->splitrows;
   a->rowindices   = NULL;
   a->rowvalues    = NULL;
   a->getrowactive = PETSC_FALSE;
@@ -5991,6 +6184,9 @@ PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat A, Mat B, MatReuse scall, PetscInt
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJPERM(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJSELL(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJFloat(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJDelta(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIVBAIJ(Mat, MatType, MatReuse, Mat *);
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMKL(Mat, MatType, MatReuse, Mat *);
 #endif
@@ -6384,6 +6580,7 @@ PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat, PetscCount coo_n, PetscInt
   PetscCall(PetscFree(mpiaij->colmap));
 #endif
   PetscCall(VecScatterDestroy(&mpiaij->Mvctx));
+  PetscCall(MatMPIAIJResetSplitRows_Private(mat));
   mat->assembled     = PETSC_FALSE;
   mat->was_assembled = PETSC_FALSE;
 
@@ -6781,7 +6978,8 @@ static PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat, const PetscScalar v[], Ins
    MATMPIAIJ - MATMPIAIJ = "mpiaij" - A matrix type to be used for parallel sparse matrices.
 
    Options Database Keys:
-. -mat_type mpiaij - sets the matrix type to `MATMPIAIJ` during a call to `MatSetFromOptions()`
++ -mat_type mpiaij  - sets the matrix type to `MATMPIAIJ` during a call to `MatSetFromOptions()`
+- -matstash_combine - combine the values set for the same off-process location in a hash table as they are set, instead of stashing each of them until the assembly
 
    Level: beginner
 
@@ -6793,7 +6991,11 @@ static PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat, const PetscScalar v[], Ins
     `MatSetOptions`(,`MAT_STRUCTURE_ONLY`,`PETSC_TRUE`) may be called for this matrix type. In this no
     space is allocated for the nonzero entries and any entries passed with `MatSetValues()` are ignored
 
-.seealso: [](ch_matrices), `Mat`, `MATSEQAIJ`, `MATAIJ`, `MatCreateAIJ()`
+    With `-matstash_combine` the memory used for the off-process values, and the size of the messages sent by `MatAssemblyBegin()`,
+    is proportional to the number of distinct off-process locations, which is much smaller than the number of values set when, for
+    example, many finite elements contribute to the same rows of the interface between the processes
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJ`, `MATAIJ`, `MatCreateAIJ()`, `MatStashSetInitialSize()`
 M*/
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
 {
@@ -6840,8 +7042,12 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatResetPreallocation_C", MatResetPreallocation_MPIAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatMPIAIJSetPreallocationCSR_C", MatMPIAIJSetPreallocationCSR_MPIAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatDiagonalScaleLocal_C", MatDiagonalScaleLocal_MPIAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatGetMatrixPowers_C", MatGetMatrixPowers_MPIAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijperm_C", MatConvert_MPIAIJ_MPIAIJPERM));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijsell_C", MatConvert_MPIAIJ_MPIAIJSELL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijfloat_C", MatConvert_MPIAIJ_MPIAIJFloat));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijdelta_C", MatConvert_MPIAIJ_MPIAIJDelta));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpivbaij_C", MatConvert_MPIAIJ_MPIVBAIJ));
 #if defined(PETSC_HAVE_CUDA)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_mpiaij_mpiaijcusparse_C", MatConvert_MPIAIJ_MPIAIJCUSPARSE));
 #endif
@@ -8088,7 +8294,9 @@ PETSC_EXTERN void matsetvaluesmpiaij_(Mat *mmat, PetscInt *mm, const PetscInt im
           }
         }
       } else if (!aij->donotstash) {
-        if (roworiented) {
+        if (mat->stash.ht) {
+          PetscCall(MatStashValuesCombine_Private(&mat->stash, im[i], n, in, roworiented ? v + i * n : v + i, roworiented ? 1 : m, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES)), addv));
+        } else if (roworiented) {
           PetscCall(MatStashValuesRow_Private(&mat->stash, im[i], n, in, v + i * n, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES))));
         } else {
           PetscCall(MatStashValuesCol_Private(&mat->stash, im[i], n, in, v + i, m, (PetscBool)(ignorezeroentries && (addv == ADD_VALUES))));
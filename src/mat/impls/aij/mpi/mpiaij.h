@@ -63,6 +63,17 @@ typedef struct {
 
   PetscInt *ld; /* number of entries per row left of diagonal block */
 
+  /* Used by MatMult() with -matmult_split_rows: the rows of B are processed as the messages they depend on arrive */
+  PetscBool        splitrows;
+  PetscObjectState splitstate;  /* nonzero state of B when the following were computed */
+  PetscInt        *splitndeps;  /* number of neighbors each row of B depends on, 0 for interior rows */
+  PetscInt        *splitcnt;    /* work copy of splitndeps[] */
+  PetscInt        *splitoffset; /* rows of B depending on the i-th root rank of Mvctx are splitrow[splitoffset[i]:splitoffset[i+1]] */
+  PetscInt        *splitrow;
+  PetscInt        *splitdone; /* root ranks returned by PetscSFBcastEndSome() */
+
+  Mat_MatrixPowers *powers; /* ghost region used by MatMatrixPowers() */
+
   /* Used by device classes */
   void *spptr;
 
@@ -93,6 +104,8 @@ PETSC_INTERN PetscErrorCode MatDisAssemble_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDuplicate_MPIAIJ(Mat, MatDuplicateOption, Mat *);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ(Mat, PetscInt, IS[], PetscInt);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ_Scalable(Mat, PetscInt, IS[], PetscInt);
+PETSC_INTERN PetscErrorCode MatGetMatrixPowers_MPIAIJ(Mat, PetscInt, Mat_MatrixPowers **);
+PETSC_INTERN PetscErrorCode MatMPIAIJResetSplitRows_Private(Mat);
 PETSC_INTERN PetscErrorCode MatFDColoringCreate_MPIXAIJ(Mat, ISColoring, MatFDColoring);
 PETSC_INTERN PetscErrorCode MatFDColoringSetUp_MPIXAIJ(Mat, ISColoring, MatFDColoring);
 PETSC_INTERN PetscErrorCode MatCreateSubMatrices_MPIAIJ(Mat, PetscInt, const IS[], const IS[], MatReuse, Mat *[]);
@@ -2938,6 +2938,7 @@ PetscErrorCode MatSetSeqMats_MPIAIJ(Mat C, IS rowemb, IS dcolemb, IS ocolemb, Ma
       if (aij->garray) PetscCall(PetscFree(aij->garray));
       PetscCall(VecDestroy(&aij->lvec));
       PetscCall(VecScatterDestroy(&aij->Mvctx));
+      PetscCall(MatMPIAIJResetSplitRows_Private(C));
     }
     if (aij->B && B && pattern == DIFFERENT_NONZERO_PATTERN) PetscCall(MatDestroy(&aij->B));
     if (aij->B && B && pattern == SUBSET_NONZERO_PATTERN) PetscCall(MatZeroEntries(aij->B));
@@ -3208,3 +3209,156 @@ PetscErrorCode MatCreateSubMatricesMPI_MPIAIJ(Mat C, PetscInt ismax, const IS is
   PetscCall(MatCreateSubMatricesMPI_MPIXAIJ(C, ismax, isrow, iscol, scall, submat, MatCreateSubMatrices_MPIAIJ, MatGetSeqMats_MPIAIJ, MatSetSeqMat_SeqAIJ, MatSetSeqMats_MPIAIJ));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/* copies the values of the submatrix into the rows of the region, and also their column indices if setj */
+static PetscErrorCode MatMatrixPowersSetValues_Private(Mat_MatrixPowers *mpk, PetscBool setj)
+{
+  PetscInt m = mpk->nlevel[mpk->k - 1];
+
+  PetscFunctionBegin;
+  for (PetscInt e = 0; e < m; e++) {
+    const PetscInt    *cols;
+    const PetscScalar *vals;
+    PetscInt           nz;
+
+    PetscCall(MatGetRow(mpk->sub[0], mpk->rowperm[e], &nz, &cols, &vals));
+    PetscCheck(nz == mpk->i[e + 1] - mpk->i[e], PETSC_COMM_SELF, PETSC_ERR_PLIB, "Row %" PetscInt_FMT " of the submatrix has %" PetscInt_FMT " nonzeros instead of %" PetscInt_FMT, mpk->rowperm[e], nz, mpk->i[e + 1] - mpk->i[e]);
+    mpk->diag[e] = 0.0;
+    for (PetscInt c = 0; c < nz; c++) {
+      const PetscInt col = mpk->colperm[cols[c]];
+
+      if (setj) mpk->j[mpk->i[e] + c] = col;
+      mpk->a[mpk->i[e] + c] = vals[c];
+      if (col == e) mpk->diag[e] = vals[c];
+    }
+    PetscCall(MatRestoreRow(mpk->sub[0], mpk->rowperm[e], &nz, &cols, &vals));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMatrixPowersCreate_MPIAIJ(Mat A, PetscInt k, Mat_MatrixPowers **mpk)
+{
+  Mat_MatrixPowers *p;
+  IS               *is;
+  PetscInt          n = A->rmap->n, rstart = A->rmap->rstart, nk, m, ne, *g, *ilocal;
+  const PetscInt   *idx, *pidx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&p));
+  p->k = k;
+  PetscCall(PetscMalloc1(k + 1, &p->nlevel));
+  PetscCall(PetscMalloc1(k + 1, &is));
+  PetscCall(ISCreateStride(PETSC_COMM_SELF, n, rstart, 1, &is[0]));
+  p->nlevel[0] = n;
+  for (PetscInt l = 1; l <= k; l++) {
+    PetscCall(ISDuplicate(is[l - 1], &is[l]));
+    PetscCall(MatIncreaseOverlap(A, 1, &is[l], 1));
+    PetscCall(ISSortRemoveDups(is[l]));
+    PetscCall(ISGetLocalSize(is[l], &p->nlevel[l]));
+  }
+
+  /* order the entries of the region by level, the local rows first */
+  nk = p->nlevel[k];
+  PetscCall(PetscMalloc1(nk, &g));
+  for (PetscInt i = 0; i < n; i++) g[i] = rstart + i;
+  ne = n;
+  for (PetscInt l = 1; l <= k; l++) {
+    PetscInt q = 0;
+
+    PetscCall(ISGetIndices(is[l], &idx));
+    PetscCall(ISGetIndices(is[l - 1], &pidx));
+    for (PetscInt i = 0; i < p->nlevel[l]; i++) {
+      while (q < p->nlevel[l - 1] && pidx[q] < idx[i]) q++;
+      if (q < p->nlevel[l - 1] && pidx[q] == idx[i]) continue;
+      g[ne++] = idx[i];
+    }
+    PetscCall(ISRestoreIndices(is[l - 1], &pidx));
+    PetscCall(ISRestoreIndices(is[l], &idx));
+    PetscCheck(ne == p->nlevel[l], PETSC_COMM_SELF, PETSC_ERR_PLIB, "Level %" PetscInt_FMT " does not contain level %" PetscInt_FMT, l, l - 1);
+  }
+
+  /* the rows within distance k-1 only use the columns within distance k */
+  m = p->nlevel[k - 1];
+  PetscCall(PetscObjectReference((PetscObject)is[k - 1]));
+  PetscCall(PetscObjectReference((PetscObject)is[k]));
+  p->isrow = is[k - 1];
+  p->iscol = is[k];
+  for (PetscInt l = 0; l <= k; l++) PetscCall(ISDestroy(&is[l]));
+  PetscCall(PetscFree(is));
+  PetscCall(MatCreateSubMatrices(A, 1, &p->isrow, &p->iscol, MAT_INITIAL_MATRIX, &p->sub));
+  PetscCall(PetscMalloc2(m, &p->rowperm, nk, &p->colperm));
+  PetscCall(ISGetIndices(p->isrow, &pidx));
+  PetscCall(ISGetIndices(p->iscol, &idx));
+  for (PetscInt e = 0; e < nk; e++) {
+    PetscInt pos;
+
+    PetscCall(PetscFindInt(g[e], nk, idx, &pos));
+    PetscCheck(pos >= 0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Entry %" PetscInt_FMT " not found in the columns of the region", g[e]);
+    p->colperm[pos] = e;
+    if (e < m) {
+      PetscCall(PetscFindInt(g[e], m, pidx, &pos));
+      PetscCheck(pos >= 0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Entry %" PetscInt_FMT " not found in the rows of the region", g[e]);
+      p->rowperm[e] = pos;
+    }
+  }
+  PetscCall(ISRestoreIndices(p->iscol, &idx));
+  PetscCall(ISRestoreIndices(p->isrow, &pidx));
+
+  /* CSR structure of the rows of the region */
+  {
+    PetscInt nnz = 0, *rnz;
+
+    PetscCall(PetscMalloc1(m, &rnz));
+    for (PetscInt e = 0; e < m; e++) {
+      PetscInt nz;
+
+      PetscCall(MatGetRow(p->sub[0], p->rowperm[e], &nz, NULL, NULL));
+      rnz[e] = nz;
+      nnz += nz;
+      PetscCall(MatRestoreRow(p->sub[0], p->rowperm[e], &nz, NULL, NULL));
+    }
+    PetscCall(PetscMalloc3(m + 1, &p->i, nnz, &p->j, nnz, &p->a));
+    p->i[0] = 0;
+    for (PetscInt e = 0; e < m; e++) p->i[e + 1] = p->i[e] + rnz[e];
+    PetscCall(PetscFree(rnz));
+  }
+  PetscCall(PetscMalloc1(m, &p->diag));
+  PetscCall(MatMatrixPowersSetValues_Private(p, PETSC_TRUE));
+  PetscCall(PetscMalloc2(nk, &p->work[0], nk, &p->work[1]));
+
+  /* the ghost entries are received from their owners with a single message per neighbor */
+  PetscCall(PetscMalloc1(nk - n, &ilocal));
+  for (PetscInt e = n; e < nk; e++) ilocal[e - n] = e;
+  PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)A), &p->sf));
+  PetscCall(PetscSFSetGraphLayout(p->sf, A->rmap, nk - n, ilocal, PETSC_OWN_POINTER, g + n));
+  PetscCall(PetscSFSetUp(p->sf));
+  PetscCall(PetscCalloc1(k, &p->sfl));
+  PetscCall(PetscFree(g));
+  p->nonzerostate = A->nonzerostate;
+  PetscCall(PetscInfo(A, "Matrix powers region of depth %" PetscInt_FMT ": %" PetscInt_FMT " local rows, %" PetscInt_FMT " rows computed, %" PetscInt_FMT " entries, %" PetscInt_FMT " nonzeros\n", k, n, m, nk, p->i[m]));
+  *mpk = p;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatGetMatrixPowers_MPIAIJ(Mat A, PetscInt k, Mat_MatrixPowers **mpk)
+{
+  Mat_MPIAIJ      *a = (Mat_MPIAIJ *)A->data;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  PetscCheck(A->rmap->N == A->cmap->N && A->rmap->n == A->cmap->n, PetscObjectComm((PetscObject)A), PETSC_ERR_ARG_SIZ, "Only for square matrices with the same row and column layouts");
+  PetscCall(PetscObjectStateGet((PetscObject)A, &state));
+  if (a->powers && (a->powers->k < k || a->powers->nonzerostate != A->nonzerostate)) {
+    k = PetscMax(k, a->powers->k);
+    PetscCall(MatMatrixPowersDestroy_Private(&a->powers));
+  }
+  if (!a->powers) {
+    PetscCall(MatMatrixPowersCreate_MPIAIJ(A, k, &a->powers));
+  } else if (a->powers->state != state) {
+    PetscCall(MatCreateSubMatrices(A, 1, &a->powers->isrow, &a->powers->iscol, MAT_REUSE_MATRIX, &a->powers->sub));
+    PetscCall(MatMatrixPowersSetValues_Private(a->powers, PETSC_FALSE));
+  }
+  a->powers->state = state;
+  *mpk             = a->powers;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,137 @@
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+/*@C
+  MatCreateMPIVBAIJ - Creates a sparse parallel matrix whose rows and columns are partitioned into blocks of
+  variable size, and whose diagonal portions are stored as `MATSEQVBAIJ` matrices (a matrix class that inherits
+  from SEQAIJ but performs the matrix-vector products and relaxations with dense blocks).
+
+  Collective
+
+  Input Parameters:
++ comm    - MPI communicator
+. nblocks - number of local blocks
+. bsizes  - the size of each local block
+. M       - number of global rows (or `PETSC_DETERMINE` to have calculated from `bsizes`)
+. d_nz    - number of nonzeros per row in DIAGONAL portion of local submatrix
+           (same value is used for all local rows)
+. d_nnz   - array containing the number of nonzeros in the various rows of the
+           DIAGONAL portion of the local submatrix (possibly different for each row)
+           or `NULL`, if `d_nz` is used to specify the nonzero structure.
+. o_nz    - number of nonzeros per row in the OFF-DIAGONAL portion of local
+           submatrix (same value is used for all local rows).
+- o_nnz   - array containing the number of nonzeros in the various rows of the
+           OFF-DIAGONAL portion of the local submatrix (possibly different for
+           each row) or `NULL`, if `o_nz` is used to specify the nonzero
+           structure.
+
+  Output Parameter:
+. A - the matrix, whose local number of rows and columns is the sum of `bsizes`
+
+  Level: intermediate
+
+  Notes:
+  The blocks are set with `MatSetVariableBlockSizes()` and passed on to the diagonal portion at each final assembly.
+  The OFF-DIAGONAL portion, whose columns are those of the other processes, is stored as `MATSEQAIJ`.
+
+  When calling this routine with a single process communicator, a matrix of
+  type `MATSEQVBAIJ` is returned.
+
+.seealso: [](ch_matrices), `Mat`, [Sparse Matrix Creation](sec_matsparse), `MATSEQVBAIJ`, `MATMPIVBAIJ`, `MATVBAIJ`, `MatCreate()`, `MatCreateSeqVBAIJ()`, `MatSetVariableBlockSizes()`, `MatSetValues()`
+@*/
+PetscErrorCode MatCreateMPIVBAIJ(MPI_Comm comm, PetscInt nblocks, const PetscInt bsizes[], PetscInt M, PetscInt d_nz, const PetscInt d_nnz[], PetscInt o_nz, const PetscInt o_nnz[], Mat *A)
+{
+  PetscMPIInt size;
+  PetscInt    m = 0;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < nblocks; i++) m += bsizes[i];
+  PetscCall(MatCreate(comm, A));
+  PetscCall(MatSetSizes(*A, m, m, M, M));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  if (size > 1) {
+    PetscCall(MatSetType(*A, MATMPIVBAIJ));
+    PetscCall(MatMPIAIJSetPreallocation(*A, d_nz, d_nnz, o_nz, o_nnz));
+  } else {
+    PetscCall(MatSetType(*A, MATSEQVBAIJ));
+    PetscCall(MatSeqAIJSetPreallocation(*A, d_nz, d_nnz));
+  }
+  PetscCall(MatSetVariableBlockSizes(*A, nblocks, (PetscInt *)bsizes));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqVBAIJ(Mat, MatType, MatReuse, Mat *);
+
+static PetscErrorCode MatMPIAIJSetPreallocation_MPIVBAIJ(Mat B, PetscInt d_nz, const PetscInt d_nnz[], PetscInt o_nz, const PetscInt o_nnz[])
+{
+  Mat_MPIAIJ *b = (Mat_MPIAIJ *)B->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMPIAIJSetPreallocation_MPIAIJ(B, d_nz, d_nnz, o_nz, o_nnz));
+  PetscCall(MatConvert_SeqAIJ_SeqVBAIJ(b->A, MATSEQVBAIJ, MAT_INPLACE_MATRIX, &b->A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the blocks of the diagonal portion are those of the local rows */
+static PetscErrorCode MatAssemblyEnd_MPIVBAIJ(Mat B, MatAssemblyType mode)
+{
+  Mat_MPIAIJ *b = (Mat_MPIAIJ *)B->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatAssemblyEnd_MPIAIJ(B, mode));
+  if (mode == MAT_FINAL_ASSEMBLY && B->nblocks) PetscCall(MatSetVariableBlockSizes(b->A, B->nblocks, B->bsizes));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIVBAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat B = *newmat;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+    if (A->nblocks) PetscCall(MatSetVariableBlockSizes(B, A->nblocks, A->bsizes));
+  }
+
+  /* If the matrix is already preallocated the diagonal portion exists and is converted now, otherwise this happens at preallocation */
+  if (B->preallocated) {
+    Mat_MPIAIJ *b = (Mat_MPIAIJ *)B->data;
+
+    PetscCall(MatConvert_SeqAIJ_SeqVBAIJ(b->A, MATSEQVBAIJ, MAT_INPLACE_MATRIX, &b->A));
+    if (B->nblocks) PetscCall(MatSetVariableBlockSizes(b->A, B->nblocks, B->bsizes));
+  }
+  B->ops->assemblyend = MatAssemblyEnd_MPIVBAIJ;
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATMPIVBAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatMPIAIJSetPreallocation_C", MatMPIAIJSetPreallocation_MPIVBAIJ));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_MPIVBAIJ(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATMPIAIJ));
+  PetscCall(MatConvert_MPIAIJ_MPIVBAIJ(A, MATMPIVBAIJ, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATVBAIJ - "vbaij" - A matrix type to be used for sparse matrices whose rows and columns are partitioned into
+   blocks of variable size with `MatSetVariableBlockSizes()`, for example with several fields per node where the
+   number of fields differs between nodes.
+
+   This matrix type is identical to `MATSEQVBAIJ` when constructed with a single process communicator,
+   and `MATMPIVBAIJ` otherwise.  As a result, for single process communicators,
+   MatSeqAIJSetPreallocation() is supported, and similarly `MatMPIAIJSetPreallocation()` is supported
+   for communicators controlling multiple processes.  It is recommended that you call both of
+   the above preallocation routines for simplicity.
+
+   Options Database Key:
+. -mat_type vbaij - sets the matrix type to `MATVBAIJ`
+
+  Level: beginner
+
+  Note:
+  The values are stored as in `MATAIJ`, so all of its operations are available; `MatMult()`, `MatMultAdd()` and `MatSOR()`
+  of the diagonal portion process the blocks as dense blocks, see `MatCreateSeqVBAIJ()`.
+
+.seealso: [](ch_matrices), `Mat`, `MatCreateMPIVBAIJ()`, `MatCreateSeqVBAIJ()`, `MATSEQVBAIJ`, `MATMPIVBAIJ`, `MATBAIJ`, `MatSetVariableBlockSizes()`, `PCVPBJACOBI`
+M*/
@@ -1089,6 +1089,7 @@ PetscErrorCode MatView_SeqAIJ(Mat A, PetscViewer viewer)
   else if (isbinary) PetscCall(MatView_SeqAIJ_Binary(A, viewer));
   else if (isdraw) PetscCall(MatView_SeqAIJ_Draw(A, viewer));
   PetscCall(MatView_SeqAIJ_Inode(A, viewer));
+  PetscCall(MatView_SeqAIJ_Autotune(A, viewer));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1153,6 +1154,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
 
   if (!A->structure_only) PetscCall(MatCheckCompressedRow(A, a->nonzerorowcnt, &a->compressedrow, a->i, m, ratio));
   PetscCall(MatAssemblyEnd_SeqAIJ_Inode(A, mode));
+  PetscCall(MatAssemblyEnd_SeqAIJ_Autotune(A, mode));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1224,6 +1226,7 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscFree(a->saved_values));
   PetscCall(PetscFree2(a->compressedrow.i, a->compressedrow.rindex));
   PetscCall(MatDestroy_SeqAIJ_Inode(A));
+  PetscCall(MatDestroy_SeqAIJ_Schedule(A));
   PetscCall(PetscFree(A->data));
 
   /* MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted may allocate this.
@@ -1243,6 +1246,9 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqbaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijperm_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijsell_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijfloat_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijdelta_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqvbaij_C", NULL));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijmkl_C", NULL));
 #endif
@@ -1289,6 +1295,9 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   /* these calls do not belong here: the subclasses Duplicate/Destroy are wrong */
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijsell_seqaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijperm_seqaij_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijfloat_seqaij_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijdelta_seqaij_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqvbaij_seqaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijviennacl_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatProductSetFromOptions_seqaijviennacl_seqdense_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatProductSetFromOptions_seqaijviennacl_seqaij_C", NULL));
@@ -1483,6 +1492,7 @@ PetscErrorCode MatMult_SeqAIJ(Mat A, Vec xx, Vec yy)
     m    = a->compressedrow.nrows;
     ii   = a->compressedrow.i;
     ridx = a->compressedrow.rindex;
+    PetscPragmaOMP(parallel for schedule(static) private(n, aj, aa, sum) if (m > PETSC_OMP_MIN_ITERATIONS))
     for (i = 0; i < m; i++) {
       n   = ii[i + 1] - ii[i];
       aj  = a->j + ii[i];
@@ -1490,7 +1500,7 @@ PetscErrorCode MatMult_SeqAIJ(Mat A, Vec xx, Vec yy)
       sum = 0.0;
       PetscSparseDensePlusDot(sum, x, aa, aj, n);
       /* for (j=0; j<n; j++) sum += (*aa++)*x[*aj++]; */
-      y[*ridx++] = sum;
+      y[ridx[i]] = sum;
     }
   } else { /* do not use compressed row format */
 #if defined(PETSC_USE_FORTRAN_KERNEL_MULTAIJ)
@@ -1498,6 +1508,7 @@ PetscErrorCode MatMult_SeqAIJ(Mat A, Vec xx, Vec yy)
     aa = a_a;
     fortranmultaij_(&m, x, ii, aj, aa, y);
 #else
+    PetscPragmaOMP(parallel for schedule(static) private(n, aj, aa, sum) if (m > PETSC_OMP_MIN_ITERATIONS))
     for (i = 0; i < m; i++) {
       n   = ii[i + 1] - ii[i];
       aj  = a->j + ii[i];
@@ -1641,13 +1652,14 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A, Vec xx, Vec yy, Vec zz)
     m    = a->compressedrow.nrows;
     ii   = a->compressedrow.i;
     ridx = a->compressedrow.rindex;
+    PetscPragmaOMP(parallel for schedule(static) private(n, aj, aa, sum) if (m > PETSC_OMP_MIN_ITERATIONS))
     for (i = 0; i < m; i++) {
       n   = ii[i + 1] - ii[i];
       aj  = a->j + ii[i];
       aa  = a_a + ii[i];
-      sum = y[*ridx];
+      sum = y[ridx[i]];
       PetscSparseDensePlusDot(sum, x, aa, aj, n);
-      z[*ridx++] = sum;
+      z[ridx[i]] = sum;
     }
   } else { /* do not use compressed row format */
     ii = a->i;
@@ -1656,6 +1668,7 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A, Vec xx, Vec yy, Vec zz)
     aa = a_a;
     fortranmultaddaij_(&m, x, ii, aj, aa, y, z);
 #else
+    PetscPragmaOMP(parallel for schedule(static) private(n, aj, aa, sum) if (m > PETSC_OMP_MIN_ITERATIONS))
     for (i = 0; i < m; i++) {
       n   = ii[i + 1] - ii[i];
       aj  = a->j + ii[i];
@@ -1673,6 +1686,65 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A, Vec xx, Vec yy, Vec zz)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   z = y + A x, or z = A x when y is NULL, with dot = VecDot(w,z), or dot = (z,z) when w is NULL, accumulated as each
+   entry of z is computed; the sum is local to A. z may be y, w may be x but not z.
+*/
+PetscErrorCode MatMultAddDot_SeqAIJ(Mat A, Vec xx, Vec yy, Vec zz, Vec ww, PetscScalar *dot)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  PetscScalar       *z, sum, d = 0.0;
+  const PetscScalar *x, *y = NULL, *w = NULL;
+  const MatScalar   *aa, *a_a;
+  const PetscInt    *aj, *ii = a->i;
+  PetscInt           m = A->rmap->n, n, i;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  if (ww) PetscCall(VecGetArrayRead(ww, &w));
+  if (yy && yy != zz) PetscCall(VecGetArrayRead(yy, &y));
+  PetscCall(VecGetArray(zz, &z));
+  if (yy == zz) y = z;
+  for (i = 0; i < m; i++) {
+    n   = ii[i + 1] - ii[i];
+    aj  = a->j + ii[i];
+    aa  = a_a + ii[i];
+    sum = y ? y[i] : 0.0;
+    PetscSparseDensePlusDot(sum, x, aa, aj, n);
+    z[i] = sum;
+    d += (w ? w[i] : sum) * PetscConj(sum);
+  }
+  *dot = d;
+  PetscCall(PetscLogFlops(2.0 * a->nz - (yy ? 0 : a->nonzerorowcnt) + 2.0 * m));
+  PetscCall(VecRestoreArray(zz, &z));
+  if (yy && yy != zz) PetscCall(VecRestoreArrayRead(yy, &y));
+  if (ww) PetscCall(VecRestoreArrayRead(ww, &w));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultDot_SeqAIJ(Mat A, Vec xx, Vec yy, Vec ww, PetscScalar *dot)
+{
+  PetscFunctionBegin;
+  if (MatSeqAIJUsesAIJMult_Private(A)) PetscCall(MatMultAddDot_SeqAIJ(A, xx, NULL, yy, ww, dot));
+  else PetscCall(MatMultDot_Basic(A, xx, yy, ww, dot));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultAddNorm_SeqAIJ(Mat A, Vec xx, Vec yy, Vec zz, PetscReal *norm)
+{
+  PetscScalar d;
+
+  PetscFunctionBegin;
+  if (MatSeqAIJUsesAIJMult_Private(A)) {
+    PetscCall(MatMultAddDot_SeqAIJ(A, xx, yy, zz, NULL, &d));
+    *norm = PetscSqrtReal(PetscRealPart(d));
+  } else PetscCall(MatMultAddNorm_Basic(A, xx, yy, zz, norm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
      Adds diagonal pointers to sparse matrix structure.
 */
@@ -1873,7 +1945,7 @@ static PetscErrorCode MatInvertVariableBlockDiagonal_SeqAIJ(Mat A, PetscInt nblo
 /*
    Negative shift indicates do not generate an error if there is a zero diagonal, just invert it anyways
 */
-static PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscScalar fshift)
+PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat A, PetscScalar omega, PetscScalar fshift)
 {
   Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data;
   PetscInt         i, *diag, m = A->rmap->n;
@@ -1926,7 +1998,7 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, Pe
   const PetscInt    *idx, *diag;
 
   PetscFunctionBegin;
-  if (a->inode.use && a->inode.checked && omega == 1.0 && fshift == 0.0) {
+  if (a->inode.use && a->inode.checked && omega == 1.0 && fshift == 0.0 && !a->schedule.sormulticolor) {
     PetscCall(MatSOR_SeqAIJ_Inode(A, bb, omega, flag, fshift, its, lits, xx));
     PetscFunctionReturn(PETSC_SUCCESS);
   }
@@ -1937,6 +2009,11 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, Pe
   a->fshift = fshift;
   a->omega  = omega;
 
+  if (a->schedule.sormulticolor && flag != SOR_APPLY_UPPER && flag != SOR_APPLY_LOWER && !(flag & SOR_EISENSTAT)) {
+    PetscCall(MatSOR_SeqAIJ_Multicolor(A, bb, omega, flag, its, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   diag  = a->diag;
   t     = a->ssor_work;
   idiag = a->idiag;
@@ -3608,7 +3685,9 @@ static struct _MatOps MatOps_Values = {MatSetValues_SeqAIJ,
                                        MatCreateGraph_Simple_AIJ,
                                        NULL,
                                        /*150*/ MatTransposeSymbolic_SeqAIJ,
-                                       MatEliminateZeros_SeqAIJ};
+                                       MatEliminateZeros_SeqAIJ,
+                                       MatMultDot_SeqAIJ,
+                                       MatMultAddNorm_SeqAIJ};
 
 static PetscErrorCode MatSeqAIJSetColumnIndices_SeqAIJ(Mat mat, PetscInt *indices)
 {
@@ -4001,6 +4080,16 @@ PetscErrorCode MatSeqAIJSetPreallocation_SeqAIJ(Mat B, PetscInt nz, const PetscI
     }
     b->i[0] = 0;
     for (i = 1; i < B->rmap->n + 1; i++) b->i[i] = b->i[i - 1] + b->imax[i - 1];
+#if defined(PETSC_HAVE_OPENMP)
+    /* first touch the space of each row by the thread that multiplies with it in MatMult_SeqAIJ() */
+    PetscPragmaOMP(parallel for schedule(static) if (B->rmap->n > PETSC_OMP_MIN_ITERATIONS))
+    for (i = 0; i < B->rmap->n; i++) {
+      for (PetscInt k = b->i[i]; k < b->i[i + 1]; k++) {
+        b->j[k] = 0;
+        if (b->a) b->a[k] = 0.0;
+      }
+    }
+#endif
     if (B->structure_only) {
       b->singlemalloc = PETSC_FALSE;
       b->free_a       = PETSC_FALSE;
@@ -4292,8 +4381,16 @@ PetscErrorCode MatMatMultSymbolic_SeqDense_SeqAIJ(Mat A, Mat B, PetscReal fill,
    MATSEQAIJ - MATSEQAIJ = "seqaij" - A matrix type to be used for sequential sparse matrices,
    based on compressed sparse row format.
 
-   Options Database Key:
-. -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+   Options Database Keys:
++ -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+. -mat_seqaij_autotune - at each `MatAssemblyEnd()` that changes the nonzero structure, select the subtype used by `MatMult()` from `MATSEQAIJ`, `MATSEQAIJPERM`,
+                         `MATSEQAIJSELL` and `MATSEQAIJDELTA`; the decision is shown by `-mat_view ::ascii_info`
+. -mat_seqaij_autotune_benchmark - select the subtype by timing `MatMult()` with each of them instead of with a heuristic based on the nonzero structure
+. -mat_seqaij_autotune_its <10> - number of `MatMult()` timed for each subtype
+. -mat_seqaij_autotune_min_size <4194304> - storage, in bytes, below which the heuristic keeps `MATSEQAIJ`
+. -mat_sor_multicolor - `MatSOR()` sweeps over the rows by colors computed with `MatColoring`, so the rows of each color can be updated concurrently;
+                        the coloring is `MATCOLORINGGREEDY` unless changed with `-sor_mat_coloring_type`
+- -mat_solve_level_schedule - the `MatSolve()` of the LU and ILU factors of the matrix processes the rows level by level, the rows of a level concurrently
 
    Level: beginner
 
@@ -4305,6 +4402,14 @@ PetscErrorCode MatMatMultSymbolic_SeqDense_SeqAIJ(Mat A, Mat B, PetscReal fill,
     `MatSetOptions`(,`MAT_STRUCTURE_ONLY`,`PETSC_TRUE`) may be called for this matrix type. In this no
     space is allocated for the nonzero entries and any entries passed with `MatSetValues()` are ignored
 
+    With `-mat_seqaij_autotune` the values stay in the `MATSEQAIJ` arrays, so `MatSetValues()` can still be used; once a subtype other
+    than `MATSEQAIJ` has been selected it is kept by later assemblies
+
+    With `-mat_sor_multicolor` the Gauss-Seidel sweep is that of the matrix symmetrically permuted by the colors, so it converges differently
+    from the sweep in the natural ordering; `SOR_EISENSTAT` and `SOR_APPLY_UPPER` keep the natural ordering. With `PCFACTOR` the option
+    `-mat_solve_level_schedule` takes the prefix of the preconditioner and does not change the computed solution. The rows of a color or of
+    a level are distributed over the OpenMP threads when PETSc is configured with OpenMP
+
   Developer Note:
     It would be nice if all matrix formats supported passing `NULL` in for the numerical values
 
@@ -4326,7 +4431,7 @@ M*/
   Level: beginner
 
    Note:
-   Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJMKL`, `MATAIJCRL`, and also automatically switches over to use inodes when
+   Subclasses include `MATAIJCUSPARSE`, `MATAIJPERM`, `MATAIJSELL`, `MATAIJFLOAT`, `MATAIJDELTA`, `MATVBAIJ`, `MATAIJMKL`, `MATAIJCRL`, and also automatically switches over to use inodes when
    enough exist.
 
 .seealso: [](ch_matrices), `Mat`, `MatCreateAIJ()`, `MatCreateSeqAIJ()`, `MATSEQAIJ`, `MATMPIAIJ`, `MATSELL`, `MATSEQSELL`, `MATMPISELL`
@@ -4840,6 +4945,9 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqbaij_C", MatConvert_SeqAIJ_SeqBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijperm_C", MatConvert_SeqAIJ_SeqAIJPERM));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijsell_C", MatConvert_SeqAIJ_SeqAIJSELL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijfloat_C", MatConvert_SeqAIJ_SeqAIJFloat));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijdelta_C", MatConvert_SeqAIJ_SeqAIJDelta));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqvbaij_C", MatConvert_SeqAIJ_SeqVBAIJ));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijmkl_C", MatConvert_SeqAIJ_SeqAIJMKL));
 #endif
@@ -4883,6 +4991,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetPreallocationCOO_C", MatSetPreallocationCOO_SeqAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetValuesCOO_C", MatSetValuesCOO_SeqAIJ));
   PetscCall(MatCreate_SeqAIJ_Inode(B));
+  PetscCall(MatCreate_SeqAIJ_Autotune(B));
+  PetscCall(MatCreate_SeqAIJ_Schedule(B));
   PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
   PetscCall(MatSeqAIJSetTypeFromOptions(B)); /* this allows changing the matrix subtype to say MATSEQAIJPERM */
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -5489,6 +5599,9 @@ PetscErrorCode MatSeqAIJRegisterAll(void)
   PetscCall(MatSeqAIJRegister(MATSEQAIJCRL, MatConvert_SeqAIJ_SeqAIJCRL));
   PetscCall(MatSeqAIJRegister(MATSEQAIJPERM, MatConvert_SeqAIJ_SeqAIJPERM));
   PetscCall(MatSeqAIJRegister(MATSEQAIJSELL, MatConvert_SeqAIJ_SeqAIJSELL));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJFLOAT, MatConvert_SeqAIJ_SeqAIJFloat));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJDELTA, MatConvert_SeqAIJ_SeqAIJDelta));
+  PetscCall(MatSeqAIJRegister(MATSEQVBAIJ, MatConvert_SeqAIJ_SeqVBAIJ));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(MatSeqAIJRegister(MATSEQAIJMKL, MatConvert_SeqAIJ_SeqAIJMKL));
 #endif
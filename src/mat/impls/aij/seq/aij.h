@@ -92,6 +92,12 @@ typedef struct { /* used by MatTransposeMatMult() */
   PetscErrorCode (*destroy)(void *);
 } Mat_MatTransMatMult;
 
+/*
+   Number of columns of the panels of a MATSEQDENSE matrix that are copied row by row into a work array by the products
+   with MATSEQAIJ, so that each nonzero of the sparse matrix meets two cache lines of contiguous values (in double precision)
+*/
+#define MAT_SEQAIJ_SEQDENSE_PANEL 16
+
 typedef struct {
   PetscInt    *api, *apj; /* symbolic structure of A*P */
   PetscScalar *apa;       /* temporary array for storing one row of A*P */
@@ -134,10 +140,46 @@ typedef struct {
   PetscObjectState mat_nonzerostate; /* non-zero state when inodes were checked for */
 } Mat_SeqAIJ_Inode;
 
+/* Info about the selection of the MatMult() format at MatAssemblyEnd() helper class for SeqAIJ */
+#define MAT_SEQAIJ_AUTOTUNE_NTYPES 4
+typedef struct {
+  PetscBool        use;                              /* select the format at MatAssemblyEnd() */
+  PetscBool        benchmark;                        /* time the candidate formats instead of using the heuristic */
+  PetscInt         its;                              /* number of MatMult() timed for each candidate */
+  PetscReal        min_size;                         /* storage in bytes below which the heuristic keeps seqaij */
+  PetscBool        tuned;                            /* if the format has been selected */
+  PetscObjectState mat_nonzerostate;                 /* non-zero state when the format was selected */
+  PetscInt         rmin, rmax, bs;                   /* row length range and block size of the nonzero structure */
+  PetscReal        ravg, rdev;                       /* row length mean and standard deviation */
+  PetscReal        sellfill, frac16;                 /* SELL padding ratio, fraction of nonzeros in rows with 16 bit column offsets */
+  PetscLogDouble   time[MAT_SEQAIJ_AUTOTUNE_NTYPES]; /* MatMult() time of each candidate */
+  MatType          type;                             /* the selected format */
+  const char      *reason;                           /* why it was selected */
+} Mat_SeqAIJAutotune;
+
+/* Info about the multicolor MatSOR() and the level scheduled MatSolve() helper class for SeqAIJ */
+typedef struct {
+  PetscBool        sormulticolor;              /* MatSOR() sweeps over the rows by colors */
+  PetscInt         sorncolors;                 /* number of colors */
+  PetscInt        *sorptr, *sorrows;           /* the rows of color c are sorrows[sorptr[c]] ... sorrows[sorptr[c + 1] - 1] */
+  PetscObjectState sor_nonzerostate;           /* non-zero state when the rows were colored */
+  PetscBool        solve_levels;               /* MatSolve() of the factor processes the rows level by level */
+  PetscBool        solve_checked;              /* if the option for solve_levels has been checked */
+  PetscInt         nlevels[2];                 /* number of levels of L and U */
+  PetscInt        *levelptr[2], *levelrows[2]; /* the rows of level l of L are levelrows[0][levelptr[0][l]] ..., of U the same with index 1 */
+} Mat_SeqAIJSchedule;
+
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat, PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat, MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
 PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Inode(Mat);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Autotune(Mat, PetscViewer);
+PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Autotune(Mat, MatAssemblyType);
+PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Autotune(Mat);
+PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Schedule(Mat);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Schedule(Mat);
+PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat, Vec, PetscReal, MatSORType, PetscInt, Vec);
+PETSC_INTERN PetscErrorCode MatSolveSetUp_SeqAIJ_LevelSchedule(Mat);
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ_Inode(Mat, MatOption, PetscBool);
 PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ_Inode(Mat, MatDuplicateOption, Mat *);
 PETSC_INTERN PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat, Mat, MatDuplicateOption, PetscBool);
@@ -147,8 +189,10 @@ PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat, PetscScalar **);
 
 typedef struct {
   SEQAIJHEADER(MatScalar);
-  Mat_SeqAIJ_Inode inode;
-  MatScalar       *saved_values; /* location for stashing nonzero values of matrix */
+  Mat_SeqAIJ_Inode   inode;
+  Mat_SeqAIJAutotune autotune;
+  Mat_SeqAIJSchedule schedule;
+  MatScalar         *saved_values; /* location for stashing nonzero values of matrix */
 
   PetscScalar *idiag, *mdiag, *ssor_work; /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
   PetscBool    idiagvalid;                /* current idiag[] and mdiag[] are valid */
@@ -277,12 +321,23 @@ PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ(Mat, MatDuplicateOption, Mat *);
 PETSC_INTERN PetscErrorCode MatCopy_SeqAIJ(Mat, Mat, MatStructure);
 PETSC_INTERN PetscErrorCode MatMissingDiagonal_SeqAIJ(Mat, PetscBool *, PetscInt *);
 PETSC_INTERN PetscErrorCode MatMarkDiagonal_SeqAIJ(Mat);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat, PetscScalar, PetscScalar);
 PETSC_INTERN PetscErrorCode MatFindZeroDiagonals_SeqAIJ_Private(Mat, PetscInt *, PetscInt **);
 
 PETSC_INTERN PetscErrorCode MatMult_SeqAIJ(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMult_SeqAIJ_Inode(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ(Mat, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultAddDot_SeqAIJ(Mat, Vec, Vec, Vec, Vec, PetscScalar *);
+PETSC_INTERN PetscErrorCode MatMultDot_SeqAIJ(Mat, Vec, Vec, Vec, PetscScalar *);
+PETSC_INTERN PetscErrorCode MatMultAddNorm_SeqAIJ(Mat, Vec, Vec, Vec, PetscReal *);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat, Vec, Vec, Vec);
+
+/* the fused kernel replaces the AIJ and I-node kernels only; subclasses that replace them keep their own kernel */
+static inline PetscBool MatSeqAIJUsesAIJMult_Private(Mat A)
+{
+  return (PetscBool)((A->ops->mult == MatMult_SeqAIJ || A->ops->mult == MatMult_SeqAIJ_Inode) && (A->ops->multadd == MatMultAdd_SeqAIJ || A->ops->multadd == MatMultAdd_SeqAIJ_Inode));
+}
+
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
@@ -412,6 +467,9 @@ PETSC_INTERN PetscErrorCode MatConvert_AIJ_ScaLAPACK(Mat, MatType, MatReuse, Mat
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJFloat(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqVBAIJ(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatReorderForNonzeroDiagonal_SeqAIJ(Mat, PetscReal, IS, IS);
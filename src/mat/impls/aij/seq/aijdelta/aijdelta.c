@@ -0,0 +1,326 @@
+/*
+  Defines basic operations for the MATSEQAIJDELTA matrix class.
+  This class is derived from the MATSEQAIJ class and retains the
+  compressed row storage (aka Yale sparse matrix format) but augments
+  it with a compressed copy of the column indices: for each row the first
+  column is kept in full, and the remaining columns are stored as 8 bit or
+  16 bit offsets from it. Rows whose column span does not fit in 16 bits
+  keep using the full a->j indices. For banded matrices (for example after
+  a reverse Cuthill-McKee ordering) this removes most of the index traffic
+  from the matrix-vector product.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscObjectState nonzerostate; /* nonzero state of the matrix when the compressed indices were built */
+  PetscInt         m;            /* number of rows the compressed indices were built for */
+  PetscInt        *base;         /* first column of each row */
+  PetscInt        *off;          /* start of each row in j8 or j16 (unused for full width rows) */
+  unsigned char   *width;        /* bytes per column offset in each row: 1, 2, or 0 if the row uses a->j */
+  unsigned char   *j8;           /* column offsets of the rows with width 1 */
+  unsigned short  *j16;          /* column offsets of the rows with width 2 */
+  PetscInt         nrows[3];     /* number of rows stored with full, 8 bit and 16 bit indices */
+} Mat_SeqAIJDelta;
+
+static PetscErrorCode MatSeqAIJDelta_reset(Mat_SeqAIJDelta *aijdelta)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree3(aijdelta->base, aijdelta->off, aijdelta->width));
+  PetscCall(PetscFree(aijdelta->j8));
+  PetscCall(PetscFree(aijdelta->j16));
+  aijdelta->m            = 0;
+  aijdelta->nonzerostate = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJDelta_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATAIJDELTA to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat              B        = *newmat;
+  Mat_SeqAIJDelta *aijdelta = (Mat_SeqAIJDelta *)A->spptr;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+    aijdelta = (Mat_SeqAIJDelta *)B->spptr;
+  }
+
+  /* Reset the original function pointers. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijdelta_seqaij_C", NULL));
+
+  /* Free everything in the Mat_SeqAIJDelta data structure. */
+  PetscCall(MatSeqAIJDelta_reset(aijdelta));
+  PetscCall(PetscFree(B->spptr));
+
+  /* Change the type of B to MATSEQAIJ. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJDelta(Mat A)
+{
+  Mat_SeqAIJDelta *aijdelta = (Mat_SeqAIJDelta *)A->spptr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used then this SeqAIJDelta matrix will not have a spptr. */
+  if (aijdelta) {
+    PetscCall(MatSeqAIJDelta_reset(aijdelta));
+    PetscCall(PetscFree(A->spptr));
+  }
+  /* Change the type of A back to SEQAIJ and use MatDestroy_SeqAIJ()
+   * to destroy everything that remains. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijdelta_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Build the compressed column indices if and only if the nonzero structure has changed since they were last built.
+ * The values are always read from a->a, so changing them does not require a rebuild. */
+static PetscErrorCode MatSeqAIJDelta_create_aijdelta(Mat A)
+{
+  Mat_SeqAIJ      *a        = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJDelta *aijdelta = (Mat_SeqAIJDelta *)A->spptr;
+  PetscInt         m        = A->rmap->n, i, k, n, span, n8 = 0, n16 = 0;
+  const PetscInt  *ai       = a->i, *aj = a->j;
+
+  PetscFunctionBegin;
+  if (aijdelta->base && aijdelta->m == m && aijdelta->nonzerostate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSeqAIJDelta_reset(aijdelta));
+  PetscCall(PetscMalloc3(m, &aijdelta->base, m, &aijdelta->off, m, &aijdelta->width));
+  PetscCall(PetscArrayzero(aijdelta->nrows, 3));
+
+  /* choose the narrowest width that can hold the column span of each row; the columns of a row are sorted */
+  for (i = 0; i < m; i++) {
+    n                 = ai[i + 1] - ai[i];
+    span              = n ? aj[ai[i + 1] - 1] - aj[ai[i]] : 0;
+    aijdelta->base[i] = n ? aj[ai[i]] : 0;
+    if (span < 256) {
+      aijdelta->width[i] = 1;
+      aijdelta->off[i]   = n8;
+      n8 += n;
+    } else if (span < 65536) {
+      aijdelta->width[i] = 2;
+      aijdelta->off[i]   = n16;
+      n16 += n;
+    } else {
+      aijdelta->width[i] = 0;
+      aijdelta->off[i]   = ai[i];
+    }
+    aijdelta->nrows[aijdelta->width[i]]++;
+  }
+  PetscCall(PetscMalloc1(n8, &aijdelta->j8));
+  PetscCall(PetscMalloc1(n16, &aijdelta->j16));
+  for (i = 0; i < m; i++) {
+    n = ai[i + 1] - ai[i];
+    if (aijdelta->width[i] == 1) {
+      for (k = 0; k < n; k++) aijdelta->j8[aijdelta->off[i] + k] = (unsigned char)(aj[ai[i] + k] - aijdelta->base[i]);
+    } else if (aijdelta->width[i] == 2) {
+      for (k = 0; k < n; k++) aijdelta->j16[aijdelta->off[i] + k] = (unsigned short)(aj[ai[i] + k] - aijdelta->base[i]);
+    }
+  }
+  aijdelta->m            = m;
+  aijdelta->nonzerostate = A->nonzerostate;
+  PetscCall(PetscInfo(A, "Rows with 8 bit column offsets %" PetscInt_FMT ", with 16 bit %" PetscInt_FMT ", with full indices %" PetscInt_FMT "\n", aijdelta->nrows[1], aijdelta->nrows[2], aijdelta->nrows[0]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_SeqAIJDelta(Mat A, MatDuplicateOption op, Mat *M)
+{
+  PetscFunctionBegin;
+  /* MatDuplicate_SeqAIJ() sets the type of *M, so its (empty) Mat_SeqAIJDelta is already in place.
+   * The compressed indices are rebuilt when they are first needed. */
+  PetscCall(MatDuplicate_SeqAIJ(A, op, M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJDelta(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* The inode kernels read a->j directly, so they are disabled here
+   * to ensure the compressed index kernels are used. */
+  a->inode.use = PETSC_FALSE;
+
+  PetscCall(MatAssemblyEnd_SeqAIJ(A, mode));
+  PetscCall(MatSeqAIJDelta_create_aijdelta(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* sum += v[k] * xb[idx[k]] for the n entries of one row, where xb is x offset to the first column of the row */
+#define MatSeqAIJDeltaRowDot(sum, xb, v, idx, n) \
+  do { \
+    PetscInt __k; \
+    for (__k = 0; __k < (n); __k++) sum += (v)[__k] * (xb)[(idx)[__k]]; \
+  } while (0)
+
+static inline PetscScalar MatSeqAIJDelta_RowDot(const Mat_SeqAIJDelta *aijdelta, const PetscInt *aj, const MatScalar *aa, const PetscInt *ai, const PetscScalar *x, PetscInt i, PetscScalar sum)
+{
+  const PetscInt     n  = ai[i + 1] - ai[i];
+  const MatScalar   *v  = aa + ai[i];
+  const PetscScalar *xb = x + aijdelta->base[i];
+
+  switch (aijdelta->width[i]) {
+  case 1:
+    MatSeqAIJDeltaRowDot(sum, xb, v, aijdelta->j8 + aijdelta->off[i], n);
+    break;
+  case 2:
+    MatSeqAIJDeltaRowDot(sum, xb, v, aijdelta->j16 + aijdelta->off[i], n);
+    break;
+  default:
+    MatSeqAIJDeltaRowDot(sum, x, v, aj + ai[i], n);
+  }
+  return sum;
+}
+
+static PetscErrorCode MatMult_SeqAIJDelta(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a        = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJDelta   *aijdelta = (Mat_SeqAIJDelta *)A->spptr;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aa;
+  PetscInt           m = A->rmap->n, i;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJDelta_create_aijdelta(A));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  for (i = 0; i < m; i++) y[i] = MatSeqAIJDelta_RowDot(aijdelta, a->j, aa, a->i, x, i, 0.0);
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJDelta(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a        = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJDelta   *aijdelta = (Mat_SeqAIJDelta *)A->spptr;
+  PetscScalar       *y, *z;
+  const PetscScalar *x;
+  const MatScalar   *aa;
+  PetscInt           m = A->rmap->n, i;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJDelta_create_aijdelta(A));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  for (i = 0; i < m; i++) z[i] = MatSeqAIJDelta_RowDot(aijdelta, a->j, aa, a->i, x, i, y[i]);
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJDelta converts a SeqAIJ matrix into a
+ * SeqAIJDelta matrix.  This routine is called by the MatCreate_SeqAIJDelta()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJDelta one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJDelta(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat              B = *newmat;
+  Mat_SeqAIJ      *b;
+  Mat_SeqAIJDelta *aijdelta;
+  PetscBool        sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&aijdelta));
+  b        = (Mat_SeqAIJ *)B->data;
+  B->spptr = (void *)aijdelta;
+
+  /* Disable use of the inode routines so that the AIJDELTA ones will be used instead.
+   * This happens in MatAssemblyEnd_SeqAIJDelta as well, but the assembly end may not be called, so set it here, too. */
+  b->inode.use = PETSC_FALSE;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJDelta;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJDelta;
+  B->ops->destroy     = MatDestroy_SeqAIJDelta;
+  B->ops->mult        = MatMult_SeqAIJDelta;
+  B->ops->multadd     = MatMultAdd_SeqAIJDelta;
+
+  /* If A has already been assembled, compute the compressed indices. */
+  if (A->assembled) PetscCall(MatSeqAIJDelta_create_aijdelta(B));
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijdelta_seqaij_C", MatConvert_SeqAIJDelta_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJDELTA));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  MatCreateSeqAIJDelta - Creates a sparse matrix of type `MATSEQAIJDELTA`.
+
+  Collective
+
+  Input Parameters:
++ comm - MPI communicator, set to `PETSC_COMM_SELF`
+. m    - number of rows
+. n    - number of columns
+. nz   - number of nonzeros per row (same for all rows)
+- nnz  - array containing the number of nonzeros in the various rows
+         (possibly different for each row) or `NULL`
+
+  Output Parameter:
+. A - the matrix
+
+  Level: intermediate
+
+  Notes:
+  This type inherits from AIJ and is largely identical, but keeps an additional copy of the column
+  indices in which each row stores its first column and the offsets of the other columns from it in
+  8 bit or 16 bit integers, which is used by `MatMult()` and `MatMultAdd()`. Rows whose columns span more
+  than 65536 use the original `PetscInt` indices. This reduces the amount of index data streamed by the
+  matrix-vector product by a factor of 2 to 8 (more with 64 bit indices), which is effective for matrices
+  with a small bandwidth, for example after reordering them with `MatGetOrdering()` and `MATORDERINGRCM`.
+
+  Run with `-info` to see how many rows use each width.
+
+  If `nnz` is given then `nz` is ignored
+
+  Because `MATSEQAIJDELTA` is a subtype of `MATSEQAIJ`, the option `-mat_seqaij_type seqaijdelta` can be used to make
+  sequential `MATSEQAIJ` matrices default to being instances of `MATSEQAIJDELTA`.
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJDELTA`, `MatCreate()`, `MatCreateMPIAIJDelta()`, `MatSetValues()`
+@*/
+PetscErrorCode MatCreateSeqAIJDelta(MPI_Comm comm, PetscInt m, PetscInt n, PetscInt nz, const PetscInt nnz[], Mat *A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatCreate(comm, A));
+  PetscCall(MatSetSizes(*A, m, n, m, n));
+  PetscCall(MatSetType(*A, MATSEQAIJDELTA));
+  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(*A, nz, nnz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJDelta(A, MATSEQAIJDELTA, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -603,6 +603,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info
   } else {
     C->ops->solve = MatSolve_SeqAIJ;
   }
+  PetscCall(MatSolveSetUp_SeqAIJ_LevelSchedule(C));
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
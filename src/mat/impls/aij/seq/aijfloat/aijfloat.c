@@ -0,0 +1,486 @@
+/*
+  Defines basic operations for the MATSEQAIJFLOAT matrix class.
+  This class is derived from the MATSEQAIJ class and retains the
+  compressed row storage (in PetscScalar precision) as the canonical
+  copy of the matrix, used by MatSetValues() and all operations that are
+  not overridden. In addition it maintains a "shadow" copy of the nonzero
+  values stored in single precision that is used by the memory-bandwidth
+  bound kernels (MatMult(), MatMultAdd(), MatMultTranspose(), MatSOR()).
+  The vector entries and all the accumulations remain in PetscScalar precision.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  float           *af;    /* single precision copy of the nonzero values a->a */
+  PetscInt         nz;    /* length of af */
+  PetscObjectState state; /* state of the matrix when af was last filled */
+} Mat_SeqAIJFloat;
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJFloat_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATAIJFLOAT to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat              B        = *newmat;
+  Mat_SeqAIJFloat *aijfloat = (Mat_SeqAIJFloat *)A->spptr;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+    aijfloat = (Mat_SeqAIJFloat *)B->spptr;
+  }
+
+  /* Reset the original function pointers. */
+  B->ops->duplicate        = MatDuplicate_SeqAIJ;
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy          = MatDestroy_SeqAIJ;
+  B->ops->mult             = MatMult_SeqAIJ;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJ;
+  B->ops->multadd          = MatMultAdd_SeqAIJ;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJ;
+  B->ops->sor              = MatSOR_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijfloat_seqaij_C", NULL));
+
+  /* Free everything in the Mat_SeqAIJFloat data structure. */
+  PetscCall(PetscFree(aijfloat->af));
+  PetscCall(PetscFree(B->spptr));
+
+  /* Change the type of B to MATSEQAIJ. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJFloat(Mat A)
+{
+  Mat_SeqAIJFloat *aijfloat = (Mat_SeqAIJFloat *)A->spptr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used then this SeqAIJFloat matrix will not have a spptr. */
+  if (aijfloat) {
+    PetscCall(PetscFree(aijfloat->af));
+    PetscCall(PetscFree(A->spptr));
+  }
+  /* Change the type of A back to SEQAIJ and use MatDestroy_SeqAIJ()
+   * to destroy everything that remains. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijfloat_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Fill (or refill) the single precision copy of the values if and only if needed.
+ * We track the ObjectState to determine when this needs to be done. */
+static PetscErrorCode MatSeqAIJFloat_build_shadow(Mat A)
+{
+  Mat_SeqAIJ      *a        = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJFloat *aijfloat = (Mat_SeqAIJFloat *)A->spptr;
+  const MatScalar *aa;
+  PetscInt         i, nz = a->i[A->rmap->n];
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectStateGet((PetscObject)A, &state));
+  if (aijfloat->af && aijfloat->state == state && aijfloat->nz == nz) PetscFunctionReturn(PETSC_SUCCESS);
+
+  if (aijfloat->nz != nz || !aijfloat->af) {
+    PetscCall(PetscFree(aijfloat->af));
+    PetscCall(PetscMalloc1(nz, &aijfloat->af));
+    aijfloat->nz = nz;
+  }
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (i = 0; i < nz; i++) aijfloat->af[i] = (float)PetscRealPart(aa[i]);
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+
+  /* Record the ObjectState so that we can tell when the shadow values need updating */
+  PetscCall(PetscObjectStateGet((PetscObject)A, &aijfloat->state));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_SeqAIJFloat(Mat A, MatDuplicateOption op, Mat *M)
+{
+  PetscFunctionBegin;
+  /* MatDuplicate_SeqAIJ() sets the type of *M, so its (empty) Mat_SeqAIJFloat is already in place.
+   * We don't copy the single precision values -- they will be constructed as needed. */
+  PetscCall(MatDuplicate_SeqAIJ(A, op, M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJFloat(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* The inode kernels read the PetscScalar values directly, so they are disabled here
+   * to ensure the single precision kernels are used. */
+  a->inode.use = PETSC_FALSE;
+
+  PetscCall(MatAssemblyEnd_SeqAIJ(A, mode));
+  PetscCall(MatSeqAIJFloat_build_shadow(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_SeqAIJFloat(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a        = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJFloat   *aijfloat = (Mat_SeqAIJFloat *)A->spptr;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const float       *aa;
+  PetscInt           m = A->rmap->n;
+  const PetscInt    *aj, *ii, *ridx = NULL;
+  PetscInt           n, i, j;
+  PetscScalar        sum;
+  PetscBool          usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJFloat_build_shadow(A));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  ii = a->i;
+  if (usecprow) { /* use compressed row format */
+    PetscCall(PetscArrayzero(y, m));
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    for (i = 0; i < m; i++) {
+      n   = ii[i + 1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = aijfloat->af + ii[i];
+      sum = 0.0;
+      for (j = 0; j < n; j++) sum += (PetscScalar)aa[j] * x[aj[j]];
+      y[*ridx++] = sum;
+    }
+  } else { /* do not use compressed row format */
+    for (i = 0; i < m; i++) {
+      n   = ii[i + 1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = aijfloat->af + ii[i];
+      sum = 0.0;
+      for (j = 0; j < n; j++) sum += (PetscScalar)aa[j] * x[aj[j]];
+      y[i] = sum;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJFloat(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a        = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJFloat   *aijfloat = (Mat_SeqAIJFloat *)A->spptr;
+  PetscScalar       *y, *z;
+  const PetscScalar *x;
+  const float       *aa;
+  const PetscInt    *aj, *ii, *ridx = NULL;
+  PetscInt           m = A->rmap->n, n, i, j;
+  PetscScalar        sum;
+  PetscBool          usecprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJFloat_build_shadow(A));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  if (usecprow) { /* use compressed row format */
+    if (zz != yy) PetscCall(PetscArraycpy(z, y, m));
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    for (i = 0; i < m; i++) {
+      n   = ii[i + 1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = aijfloat->af + ii[i];
+      sum = y[*ridx];
+      for (j = 0; j < n; j++) sum += (PetscScalar)aa[j] * x[aj[j]];
+      z[*ridx++] = sum;
+    }
+  } else { /* do not use compressed row format */
+    ii = a->i;
+    for (i = 0; i < m; i++) {
+      n   = ii[i + 1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = aijfloat->af + ii[i];
+      sum = y[i];
+      for (j = 0; j < n; j++) sum += (PetscScalar)aa[j] * x[aj[j]];
+      z[i] = sum;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultTransposeAdd_SeqAIJFloat(Mat A, Vec xx, Vec zz, Vec yy)
+{
+  Mat_SeqAIJ        *a        = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJFloat   *aijfloat = (Mat_SeqAIJFloat *)A->spptr;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const float       *v;
+  PetscScalar        alpha;
+  PetscInt           m = A->rmap->n, n, i, j;
+  const PetscInt    *idx, *ii, *ridx = NULL;
+  Mat_CompressedRow  cprow    = a->compressedrow;
+  PetscBool          usecprow = cprow.use;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJFloat_build_shadow(A));
+  if (zz != yy) PetscCall(VecCopy(zz, yy));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  if (usecprow) {
+    m    = cprow.nrows;
+    ii   = cprow.i;
+    ridx = cprow.rindex;
+  } else {
+    ii = a->i;
+  }
+  for (i = 0; i < m; i++) {
+    idx   = a->j + ii[i];
+    v     = aijfloat->af + ii[i];
+    n     = ii[i + 1] - ii[i];
+    alpha = usecprow ? x[ridx[i]] : x[i];
+    for (j = 0; j < n; j++) y[idx[j]] += alpha * v[j];
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultTranspose_SeqAIJFloat(Mat A, Vec xx, Vec yy)
+{
+  PetscFunctionBegin;
+  PetscCall(VecSet(yy, 0.0));
+  PetscCall(MatMultTransposeAdd_SeqAIJFloat(A, xx, yy, yy));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   The off-diagonal entries are read from the single precision copy, while the (inverted) diagonal
+   is kept in PetscScalar precision by MatInvertDiagonal_SeqAIJ().
+   SOR_APPLY_UPPER and SOR_EISENSTAT are rarely used in smoothers and are handled by MatSOR_SeqAIJ().
+*/
+static PetscErrorCode MatSOR_SeqAIJFloat(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ        *a        = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJFloat   *aijfloat = (Mat_SeqAIJFloat *)A->spptr;
+  PetscScalar       *x, sum, *t;
+  const MatScalar   *idiag, *mdiag;
+  const float       *v, *aa;
+  const PetscScalar *b, *xb;
+  PetscInt           n, m = A->rmap->n, i;
+  const PetscInt    *idx, *diag;
+
+  PetscFunctionBegin;
+  if (flag == SOR_APPLY_UPPER || (flag & SOR_EISENSTAT)) {
+    PetscCall(MatSOR_SeqAIJ(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCheck(flag != SOR_APPLY_LOWER, PETSC_COMM_SELF, PETSC_ERR_SUP, "SOR_APPLY_LOWER is not implemented");
+  its = its * lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+  PetscCall(MatSeqAIJFloat_build_shadow(A));
+
+  aa    = aijfloat->af;
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  /* We count flops by assuming the upper triangular and lower triangular parts have the same number of nonzeros */
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        n   = diag[i] - a->i[i];
+        idx = a->j + a->i[i];
+        v   = aa + a->i[i];
+        sum = b[i];
+        PetscSparseDenseMinusDot(sum, x, v, idx, n);
+        t[i] = sum;
+        x[i] = sum * idiag[i];
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        n   = a->i[i + 1] - diag[i] - 1;
+        idx = a->j + diag[i] + 1;
+        v   = aa + diag[i] + 1;
+        sum = xb[i];
+        PetscSparseDenseMinusDot(sum, x, v, idx, n);
+        if (xb == b) {
+          x[i] = sum * idiag[i];
+        } else {
+          x[i] = (1 - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        /* lower */
+        n   = diag[i] - a->i[i];
+        idx = a->j + a->i[i];
+        v   = aa + a->i[i];
+        sum = b[i];
+        PetscSparseDenseMinusDot(sum, x, v, idx, n);
+        t[i] = sum; /* save application of the lower-triangular part */
+        /* upper */
+        n   = a->i[i + 1] - diag[i] - 1;
+        idx = a->j + diag[i] + 1;
+        v   = aa + diag[i] + 1;
+        PetscSparseDenseMinusDot(sum, x, v, idx, n);
+        x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        sum = xb[i];
+        if (xb == b) {
+          /* whole matrix (no checkpointing available) */
+          n   = a->i[i + 1] - a->i[i];
+          idx = a->j + a->i[i];
+          v   = aa + a->i[i];
+          PetscSparseDenseMinusDot(sum, x, v, idx, n);
+          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          n   = a->i[i + 1] - diag[i] - 1;
+          idx = a->j + diag[i] + 1;
+          v   = aa + diag[i] + 1;
+          PetscSparseDenseMinusDot(sum, x, v, idx, n);
+          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        PetscCall(PetscLogFlops(2.0 * a->nz));
+      } else {
+        PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJFloat converts a SeqAIJ matrix into a
+ * SeqAIJFloat matrix.  This routine is called by the MatCreate_SeqAIJFloat()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJFloat one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJFloat(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat              B = *newmat;
+  Mat_SeqAIJ      *b;
+  Mat_SeqAIJFloat *aijfloat;
+  PetscBool        sametype;
+
+  PetscFunctionBegin;
+  PetscCheck(!PetscDefined(USE_COMPLEX), PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "MATSEQAIJFLOAT is not supported with complex scalars");
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&aijfloat));
+  b        = (Mat_SeqAIJ *)B->data;
+  B->spptr = (void *)aijfloat;
+
+  /* Disable use of the inode routines so that the AIJFLOAT ones will be used instead.
+   * This happens in MatAssemblyEnd_SeqAIJFloat as well, but the assembly end may not be called, so set it here, too. */
+  b->inode.use = PETSC_FALSE;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate        = MatDuplicate_SeqAIJFloat;
+  B->ops->assemblyend      = MatAssemblyEnd_SeqAIJFloat;
+  B->ops->destroy          = MatDestroy_SeqAIJFloat;
+  B->ops->mult             = MatMult_SeqAIJFloat;
+  B->ops->multtranspose    = MatMultTranspose_SeqAIJFloat;
+  B->ops->multadd          = MatMultAdd_SeqAIJFloat;
+  B->ops->multtransposeadd = MatMultTransposeAdd_SeqAIJFloat;
+  B->ops->sor              = MatSOR_SeqAIJFloat;
+
+  /* If A has already been assembled, build the single precision copy. */
+  if (A->assembled) PetscCall(MatSeqAIJFloat_build_shadow(B));
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijfloat_seqaij_C", MatConvert_SeqAIJFloat_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJFLOAT));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  MatCreateSeqAIJFloat - Creates a sparse matrix of type `MATSEQAIJFLOAT`.
+
+  Collective
+
+  Input Parameters:
++ comm - MPI communicator, set to `PETSC_COMM_SELF`
+. m    - number of rows
+. n    - number of columns
+. nz   - number of nonzeros per row (same for all rows)
+- nnz  - array containing the number of nonzeros in the various rows
+         (possibly different for each row) or `NULL`
+
+  Output Parameter:
+. A - the matrix
+
+  Level: intermediate
+
+  Notes:
+  This type inherits from AIJ and is largely identical, but keeps an additional copy of the
+  nonzero values in single precision that is used by `MatMult()`, `MatMultAdd()`, `MatMultTranspose()`,
+  `MatMultTransposeAdd()`, and `MatSOR()`. The vector entries and the accumulation of the products
+  are kept in `PetscScalar` precision, so only the matrix values are rounded. Since these kernels
+  are limited by memory bandwidth, this reduces the amount of data streamed per product by about a third.
+
+  The rounding of the matrix values means the operator applied is a perturbation of the assembled one
+  (of relative size about 1e-7); it is intended to be used as a preconditioning matrix, for example
+  in the smoothers of `PCMG`, and not as the operator whose residual is measured.
+
+  This type is only available for real scalars.
+
+  If `nnz` is given then `nz` is ignored
+
+  Because `MATSEQAIJFLOAT` is a subtype of `MATSEQAIJ`, the option `-mat_seqaij_type seqaijfloat` can be used to make
+  sequential `MATSEQAIJ` matrices default to being instances of `MATSEQAIJFLOAT`.
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQAIJFLOAT`, `MatCreate()`, `MatCreateMPIAIJFloat()`, `MatSetValues()`
+@*/
+PetscErrorCode MatCreateSeqAIJFloat(MPI_Comm comm, PetscInt m, PetscInt n, PetscInt nz, const PetscInt nnz[], Mat *A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatCreate(comm, A));
+  PetscCall(MatSetSizes(*A, m, n, m, n));
+  PetscCall(MatSetType(*A, MATSEQAIJFLOAT));
+  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(*A, nz, nnz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJFloat(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJFloat(A, MATSEQAIJFLOAT, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,263 @@
+/*
+  Selection of the MatMult() format of a MATSEQAIJ matrix at MatAssemblyEnd().
+
+  The matrix keeps the AIJ arrays as its canonical storage, so MatSetValues() and everything else
+  that works on MATSEQAIJ keeps working; only the subclass whose kernels are used is changed, by
+  the same in-place conversion that -mat_seqaij_type performs.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <petsctime.h>
+
+/* the candidate formats; all of them are subclasses of MATSEQAIJ that keep the AIJ storage */
+static const MatType MatSeqAIJAutotuneTypes[MAT_SEQAIJ_AUTOTUNE_NTYPES] = {MATSEQAIJ, MATSEQAIJPERM, MATSEQAIJSELL, MATSEQAIJDELTA};
+
+/* slice height used for the estimate of the padding of the SELL shadow matrix */
+#define MAT_SEQAIJ_AUTOTUNE_SLICEHEIGHT 8
+
+static PetscBool MatSeqAIJAutotuneHasBlockSize_Private(const PetscInt *ai, const PetscInt *aj, PetscInt m, PetscInt n, PetscInt bs)
+{
+  PetscInt i, r, k, t, len, c;
+
+  if (m % bs || n % bs) return PETSC_FALSE;
+  for (i = 0; i < m; i += bs) {
+    len = ai[i + 1] - ai[i];
+    if (len % bs) return PETSC_FALSE;
+    for (r = 1; r < bs; r++) {
+      if (ai[i + r + 1] - ai[i + r] != len) return PETSC_FALSE;
+      for (k = 0; k < len; k++) {
+        if (aj[ai[i + r] + k] != aj[ai[i] + k]) return PETSC_FALSE;
+      }
+    }
+    for (k = 0; k < len; k += bs) {
+      c = aj[ai[i] + k];
+      if (c % bs) return PETSC_FALSE;
+      for (t = 1; t < bs; t++) {
+        if (aj[ai[i] + k + t] != c + t) return PETSC_FALSE;
+      }
+    }
+  }
+  return PETSC_TRUE;
+}
+
+/* Gathers the row length statistics, the block size of the nonzero structure, and the fill of a SELL or delta compressed copy */
+static PetscErrorCode MatSeqAIJAutotuneGatherStatistics_Private(Mat A)
+{
+  Mat_SeqAIJ         *a  = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJAutotune *at = &a->autotune;
+  PetscInt            m = A->rmap->n, n = A->cmap->n, i, len, slicemax = 0, sellnz = 0, nz16 = 0, bs;
+  const PetscInt     *ai = a->i, *aj = a->j;
+  PetscReal           var = 0.0;
+
+  PetscFunctionBegin;
+  at->rmin = m ? PETSC_MAX_INT : 0;
+  at->rmax = 0;
+  for (i = 0; i < m; i++) {
+    len      = ai[i + 1] - ai[i];
+    at->rmin = PetscMin(at->rmin, len);
+    at->rmax = PetscMax(at->rmax, len);
+    slicemax = PetscMax(slicemax, len);
+    if ((i + 1) % MAT_SEQAIJ_AUTOTUNE_SLICEHEIGHT == 0 || i == m - 1) {
+      sellnz  += MAT_SEQAIJ_AUTOTUNE_SLICEHEIGHT * slicemax;
+      slicemax = 0;
+    }
+    if (!len || aj[ai[i + 1] - 1] - aj[ai[i]] < 65536) nz16 += len;
+  }
+  at->ravg = m ? (PetscReal)ai[m] / m : 0.0;
+  for (i = 0; i < m; i++) var += PetscSqr(ai[i + 1] - ai[i] - at->ravg);
+  at->rdev     = m ? PetscSqrtReal(var / m) : 0.0;
+  at->sellfill = ai[m] ? (PetscReal)sellnz / ai[m] : 1.0;
+  at->frac16   = ai[m] ? (PetscReal)nz16 / ai[m] : 1.0;
+
+  /* the largest block size for which every block row consists of dense aligned blocks */
+  at->bs = 1;
+  if (A->rmap->bs > 1 && MatSeqAIJAutotuneHasBlockSize_Private(ai, aj, m, n, A->rmap->bs)) at->bs = A->rmap->bs;
+  for (bs = 8; bs > 1 && at->bs == 1; bs--) {
+    if (MatSeqAIJAutotuneHasBlockSize_Private(ai, aj, m, n, bs)) at->bs = bs;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Times MatMult() with the candidate format t; A is converted to the candidate and back to MATSEQAIJ */
+static PetscErrorCode MatSeqAIJAutotuneTime_Private(Mat A, PetscInt t, Vec x, Vec y, const struct _MatOps *ops)
+{
+  Mat_SeqAIJ         *a  = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJAutotune *at = &a->autotune;
+  PetscLogDouble      t0, t1;
+  char                name[256];
+  PetscInt            i, *isize = NULL;
+  Mat_SeqAIJ_Inode    inode = a->inode;
+  PetscErrorCode (*conv)(Mat, MatType, MatReuse, Mat *);
+
+  PetscFunctionBegin;
+  if (t) {
+    /* the assemblies done by the conversions may check the I-nodes again, or turn them off */
+    if (inode.size) {
+      PetscCall(PetscMalloc1(inode.node_count, &isize));
+      PetscCall(PetscArraycpy(isize, inode.size, inode.node_count));
+    }
+    PetscCall(MatSeqAIJSetType(A, MatSeqAIJAutotuneTypes[t]));
+  }
+  /* the first product builds the shadow data structures of the format and is not timed */
+  PetscCall((*A->ops->mult)(A, x, y));
+  PetscCall(PetscTime(&t0));
+  for (i = 0; i < at->its; i++) PetscCall((*A->ops->mult)(A, x, y));
+  PetscCall(PetscTime(&t1));
+  at->time[t] = (t1 - t0) / at->its;
+  if (t) {
+    PetscCall(PetscSNPrintf(name, sizeof(name), "MatConvert_%s_seqaij_C", MatSeqAIJAutotuneTypes[t]));
+    PetscCall(PetscObjectQueryFunction((PetscObject)A, name, &conv));
+    PetscCheck(conv, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Cannot convert %s back to %s", MatSeqAIJAutotuneTypes[t], MATSEQAIJ);
+    PetscCall((*conv)(A, MATSEQAIJ, MAT_INPLACE_MATRIX, &A));
+    /* the conversion back resets the kernels to the plain AIJ ones, which would drop the I-node kernels */
+    *A->ops = *ops;
+    a       = (Mat_SeqAIJ *)A->data;
+    if (a->inode.size != inode.size) {
+      /* the sizes were reallocated, the ones saved before the trial replace them */
+      PetscCall(PetscFree(a->inode.size));
+      inode.size = isize;
+      isize      = NULL;
+    } else if (isize) PetscCall(PetscArraycpy(a->inode.size, isize, inode.node_count));
+    a->inode.use              = inode.use;
+    a->inode.node_count       = inode.node_count;
+    a->inode.size             = inode.size;
+    a->inode.limit            = inode.limit;
+    a->inode.max_limit        = inode.max_limit;
+    a->inode.checked          = inode.checked;
+    a->inode.mat_nonzerostate = inode.mat_nonzerostate;
+    PetscCall(PetscFree(isize));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Selects a format from the statistics of the nonzero structure */
+static PetscErrorCode MatSeqAIJAutotuneHeuristic_Private(Mat A, PetscInt *t)
+{
+  Mat_SeqAIJ         *a  = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJAutotune *at = &a->autotune;
+  PetscReal           bytes;
+
+  PetscFunctionBegin;
+  bytes = (PetscReal)a->nz * (sizeof(MatScalar) + sizeof(PetscInt));
+  *t    = 0;
+  if (a->inode.size && a->inode.node_count <= A->rmap->n / 2) {
+    at->reason = "I-node kernels use the repeated rows";
+  } else if (bytes < at->min_size) {
+    at->reason = "matrix is smaller than the minimum size";
+  } else if (at->sellfill <= 1.1 && at->ravg < 16) {
+    *t         = 2;
+    at->reason = "short rows of regular length";
+  } else if (at->frac16 >= 0.9) {
+    *t         = 3;
+    at->reason = "column offsets fit in 16 bits";
+  } else {
+    at->reason = "no format is expected to be faster";
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Selects a format by timing MatMult() on the matrix itself with each candidate */
+static PetscErrorCode MatSeqAIJAutotuneBenchmark_Private(Mat A, PetscInt *t)
+{
+  Mat_SeqAIJ         *a  = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJAutotune *at = &a->autotune;
+  struct _MatOps      ops;
+  Vec                 x, y;
+  PetscInt            i;
+
+  PetscFunctionBegin;
+  ops = *A->ops;
+  PetscCall(VecCreateSeq(PETSC_COMM_SELF, A->cmap->n, &x));
+  PetscCall(VecCreateSeq(PETSC_COMM_SELF, A->rmap->n, &y));
+  PetscCall(VecSet(x, 1.0));
+  for (i = 0; i < MAT_SEQAIJ_AUTOTUNE_NTYPES; i++) PetscCall(MatSeqAIJAutotuneTime_Private(A, i, x, y, &ops));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+
+  /* another format must be clearly faster than seqaij, otherwise the timing noise decides */
+  *t         = 0;
+  at->reason = "fastest MatMult()";
+  for (i = 1; i < MAT_SEQAIJ_AUTOTUNE_NTYPES; i++) {
+    if (at->time[i] < 0.95 * at->time[0] && at->time[i] < at->time[*t]) *t = i;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatAssemblyEnd_SeqAIJ_Autotune(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ         *a  = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJAutotune *at = &a->autotune;
+  PetscBool           isseqaij, assembled;
+  PetscInt            t;
+
+  PetscFunctionBegin;
+  if (!at->use || mode == MAT_FLUSH_ASSEMBLY || A->factortype != MAT_FACTOR_NONE || A->structure_only) PetscFunctionReturn(PETSC_SUCCESS);
+  if (at->tuned && at->mat_nonzerostate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  /* once a subclass has been selected its own MatAssemblyEnd() calls this one, and the choice is kept */
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, MATSEQAIJ, &isseqaij));
+  if (!isseqaij) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(MatSeqAIJAutotuneGatherStatistics_Private(A));
+  /* the conversions and the kernels require an assembled matrix; the assembly is complete except for this flag */
+  assembled    = A->assembled;
+  A->assembled = PETSC_TRUE;
+  if (at->benchmark) PetscCall(MatSeqAIJAutotuneBenchmark_Private(A, &t));
+  else PetscCall(MatSeqAIJAutotuneHeuristic_Private(A, &t));
+  if (t) PetscCall(MatSeqAIJSetType(A, MatSeqAIJAutotuneTypes[t]));
+  A->assembled = assembled;
+
+  at->tuned            = PETSC_TRUE;
+  at->mat_nonzerostate = A->nonzerostate;
+  at->type             = MatSeqAIJAutotuneTypes[t];
+  PetscCall(PetscInfo(A, "Selected %s for MatMult(): %s\n", at->type, at->reason));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatView_SeqAIJ_Autotune(Mat A, PetscViewer viewer)
+{
+  Mat_SeqAIJ         *a  = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJAutotune *at = &a->autotune;
+  PetscBool           iascii;
+  PetscViewerFormat   format;
+  PetscInt            i;
+
+  PetscFunctionBegin;
+  if (!at->tuned) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (!iascii) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (format != PETSC_VIEWER_ASCII_INFO_DETAIL && format != PETSC_VIEWER_ASCII_INFO) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscViewerASCIIPrintf(viewer, "autotune: row lengths min %" PetscInt_FMT " max %" PetscInt_FMT " avg %g stddev %g\n", at->rmin, at->rmax, (double)at->ravg, (double)at->rdev));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "autotune: SELL fill %g, fraction of nonzeros with 16 bit column offsets %g\n", (double)at->sellfill, (double)at->frac16));
+  if (at->bs > 1) PetscCall(PetscViewerASCIIPrintf(viewer, "autotune: nonzero structure has dense %" PetscInt_FMT " x %" PetscInt_FMT " blocks, consider %s\n", at->bs, at->bs, MATBAIJ));
+  if (at->benchmark) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "autotune: MatMult() seconds"));
+    PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_FALSE));
+    for (i = 0; i < MAT_SEQAIJ_AUTOTUNE_NTYPES; i++) PetscCall(PetscViewerASCIIPrintf(viewer, " %s %g", MatSeqAIJAutotuneTypes[i], at->time[i]));
+    PetscCall(PetscViewerASCIIPrintf(viewer, "\n"));
+    PetscCall(PetscViewerASCIIUseTabs(viewer, PETSC_TRUE));
+  }
+  PetscCall(PetscViewerASCIIPrintf(viewer, "autotune: selected %s (%s)\n", at->type, at->reason));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatCreate_SeqAIJ_Autotune(Mat B)
+{
+  Mat_SeqAIJ         *b  = (Mat_SeqAIJ *)B->data;
+  Mat_SeqAIJAutotune *at = &b->autotune;
+
+  PetscFunctionBegin;
+  at->use       = PETSC_FALSE;
+  at->benchmark = PETSC_FALSE;
+  at->its       = 10;
+  at->min_size  = 4194304;
+  at->tuned     = PETSC_FALSE;
+
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "Options for SEQAIJ matrix", "Mat");
+  PetscCall(PetscOptionsBool("-mat_seqaij_autotune", "Select the MatMult() format at MatAssemblyEnd()", "MatSeqAIJSetType", at->use, &at->use, NULL));
+  PetscCall(PetscOptionsBool("-mat_seqaij_autotune_benchmark", "Time MatMult() with each candidate format instead of using a heuristic", "MatSeqAIJSetType", at->benchmark, &at->benchmark, NULL));
+  PetscCall(PetscOptionsInt("-mat_seqaij_autotune_its", "Number of MatMult() timed for each candidate format", "MatSeqAIJSetType", at->its, &at->its, NULL));
+  PetscCall(PetscOptionsReal("-mat_seqaij_autotune_min_size", "Storage in bytes below which the heuristic keeps seqaij", "MatSeqAIJSetType", at->min_size, &at->min_size, NULL));
+  PetscOptionsEnd();
+  PetscCheck(at->its > 0, PetscObjectComm((PetscObject)B), PETSC_ERR_ARG_OUTOFRANGE, "-mat_seqaij_autotune_its %" PetscInt_FMT " must be positive", at->its);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -1943,6 +1943,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B, Mat A, const MatFactorInfo
   } else {
     C->ops->solve = MatSolve_SeqAIJ;
   }
+  PetscCall(MatSolveSetUp_SeqAIJ_LevelSchedule(C));
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
@@ -1502,6 +1502,62 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqDense(Mat A, Mat B, PetscReal fill,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* sum[k] = sum_j aa[j] bt[aj[j] * nb + k], k < nb; inlined with a constant nb for the full panels */
+static inline void MatMatMultPanelRow_SeqAIJ_SeqDense(PetscInt n, const PetscScalar *aa, const PetscInt *aj, const PetscScalar *bt, PetscInt nb, PetscScalar *sum)
+{
+  PetscInt j, k;
+
+  for (k = 0; k < nb; k++) sum[k] = 0.0;
+  for (j = 0; j < n; j++) {
+    const PetscScalar  v  = aa[j];
+    const PetscScalar *bp = bt + aj[j] * nb;
+
+    PetscPragmaSIMD
+    for (k = 0; k < nb; k++) sum[k] += v * bp[k];
+  }
+}
+
+/*
+   C = A B, or C += A B, with the columns of B taken in panels of MAT_SEQAIJ_SEQDENSE_PANEL columns stored row by row in a
+   work array, so that A is traversed once per panel and each of its nonzeros multiplies a contiguous row segment of the panel
+*/
+static PetscErrorCode MatMatMultNumericAddPanel_SeqAIJ_SeqDense(Mat A, const PetscScalar *b, PetscInt bm, PetscInt cn, PetscScalar *c, PetscInt clda, PetscBool add)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  const PetscScalar *av, *aa;
+  const PetscInt    *aj;
+  PetscScalar       *bt, sum[MAT_SEQAIJ_SEQDENSE_PANEL];
+  PetscInt           am = A->rmap->n, an = A->cmap->n, col, nb, i, j, k, n;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJGetArrayRead(A, &av));
+  PetscCall(PetscMalloc1(an * MAT_SEQAIJ_SEQDENSE_PANEL, &bt));
+  for (col = 0; col < cn; col += nb) {
+    PetscScalar *c0 = c + col * clda;
+
+    nb = PetscMin(MAT_SEQAIJ_SEQDENSE_PANEL, cn - col);
+    for (j = 0; j < an; j++) {
+      for (k = 0; k < nb; k++) bt[j * nb + k] = b[(col + k) * bm + j];
+    }
+    for (i = 0; i < am; i++) {
+      n  = a->i[i + 1] - a->i[i];
+      aj = a->j + a->i[i];
+      aa = av + a->i[i];
+      if (nb == MAT_SEQAIJ_SEQDENSE_PANEL) MatMatMultPanelRow_SeqAIJ_SeqDense(n, aa, aj, bt, MAT_SEQAIJ_SEQDENSE_PANEL, sum);
+      else MatMatMultPanelRow_SeqAIJ_SeqDense(n, aa, aj, bt, nb, sum);
+      if (add) {
+        for (k = 0; k < nb; k++) c0[k * clda + i] += sum[k];
+      } else {
+        for (k = 0; k < nb; k++) c0[k * clda + i] = sum[k];
+      }
+    }
+  }
+  PetscCall(PetscFree(bt));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &av));
+  PetscCall(PetscLogFlops(cn * (2.0 * a->nz)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PETSC_INTERN PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A, Mat B, Mat C, const PetscBool add)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
@@ -1523,6 +1579,11 @@ PETSC_INTERN PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A, Mat B, M
   PetscCall(MatDenseGetArrayRead(B, &b));
   PetscCall(MatDenseGetLDA(B, &bm));
   PetscCall(MatDenseGetLDA(C, &clda));
+  /* with more than four columns the kernel below would traverse A several times */
+  if (cn > 4 && b) {
+    PetscCall(MatMatMultNumericAddPanel_SeqAIJ_SeqDense(A, b, bm, cn, c, clda, add));
+    goto restore;
+  }
   am4 = 4 * clda;
   bm4 = 4 * bm;
   if (b) {
@@ -1632,6 +1693,7 @@ PETSC_INTERN PetscErrorCode MatMatMultNumericAdd_SeqAIJ_SeqDense(Mat A, Mat B, M
     }
   }
   PetscCall(PetscLogFlops(cn * (2.0 * a->nz)));
+restore:
   if (add) {
     PetscCall(MatDenseRestoreArray(C, &c));
   } else {
@@ -20,6 +20,7 @@ static PetscErrorCode MatDestroy_SeqDense_MatTransMatMult(void *data)
 }
 
 static PetscErrorCode MatTMatTMultNumeric_SeqAIJ_SeqDense(Mat, Mat, Mat);
+static PetscErrorCode MatTransposeMatMultNumeric_SeqAIJ_SeqDense(Mat, Mat, Mat);
 
 PETSC_INTERN PetscErrorCode MatTMatTMultSymbolic_SeqAIJ_SeqDense(Mat A, Mat B, PetscReal fill, Mat C)
 {
@@ -44,33 +45,85 @@ PETSC_INTERN PetscErrorCode MatTMatTMultSymbolic_SeqAIJ_SeqDense(Mat A, Mat B, P
   if (!cisdense) PetscCall(MatSetType(C, ((PetscObject)B)->type_name));
   PetscCall(MatSetUp(C));
 
+  /* A^T B works on row-major panels of B and C directly */
+  if (C->product->type == MATPRODUCT_AtB) {
+    C->ops->transposematmultnumeric = MatTransposeMatMultNumeric_SeqAIJ_SeqDense;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
   /* create additional data structure for the product */
   PetscCall(PetscNew(&atb));
   PetscCall(MatCreateMAIJ(A, dofm, &atb->mA));
   PetscCall(MatCreateVecs(atb->mA, &atb->ct, &atb->bt));
-  C->product->data    = atb;
-  C->product->destroy = MatDestroy_SeqDense_MatTransMatMult;
+  C->product->data                = atb;
+  C->product->destroy             = MatDestroy_SeqDense_MatTransMatMult;
+  C->ops->mattransposemultnumeric = MatTMatTMultNumeric_SeqAIJ_SeqDense;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
 
-  if (C->product->type == MATPRODUCT_AtB) {
-    C->ops->transposematmultnumeric = MatTMatTMultNumeric_SeqAIJ_SeqDense;
-  } else {
-    C->ops->mattransposemultnumeric = MatTMatTMultNumeric_SeqAIJ_SeqDense;
+/*
+   C = A^T B with the columns of B and C taken in panels of MAT_SEQAIJ_SEQDENSE_PANEL columns stored row by row in work
+   arrays: each row of A scatters a multiple of the corresponding row segment of the B panel into the rows of the C panel
+*/
+static PetscErrorCode MatTransposeMatMultNumeric_SeqAIJ_SeqDense(Mat A, Mat B, Mat C)
+{
+  Mat_SeqAIJ        *a  = (Mat_SeqAIJ *)A->data;
+  PetscInt           am = A->rmap->n, an = A->cmap->n, cn = B->cmap->n, blda, clda, col, nb, i, j, k, n;
+  const PetscScalar *Barray, *av, *aa, *bp;
+  const PetscInt    *aj;
+  PetscScalar       *Carray, *bt, *ct, *cp;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C, 3);
+  PetscCall(MatSeqAIJGetArrayRead(A, &av));
+  PetscCall(MatDenseGetArrayRead(B, &Barray));
+  PetscCall(MatDenseGetLDA(B, &blda));
+  PetscCall(MatDenseGetArrayWrite(C, &Carray));
+  PetscCall(MatDenseGetLDA(C, &clda));
+  PetscCall(PetscMalloc2(am * MAT_SEQAIJ_SEQDENSE_PANEL, &bt, an * MAT_SEQAIJ_SEQDENSE_PANEL, &ct));
+  for (col = 0; col < cn; col += nb) {
+    nb = PetscMin(MAT_SEQAIJ_SEQDENSE_PANEL, cn - col);
+    for (i = 0; i < am; i++) {
+      for (k = 0; k < nb; k++) bt[i * nb + k] = Barray[(col + k) * blda + i];
+    }
+    PetscCall(PetscArrayzero(ct, an * nb));
+    for (i = 0; i < am; i++) {
+      n  = a->i[i + 1] - a->i[i];
+      aj = a->j + a->i[i];
+      aa = av + a->i[i];
+      bp = bt + i * nb;
+      for (j = 0; j < n; j++) {
+        const PetscScalar v = aa[j];
+
+        cp = ct + aj[j] * nb;
+        PetscPragmaSIMD
+        for (k = 0; k < nb; k++) cp[k] += v * bp[k];
+      }
+    }
+    for (k = 0; k < nb; k++) {
+      for (j = 0; j < an; j++) Carray[(col + k) * clda + j] = ct[j * nb + k];
+    }
   }
+  PetscCall(PetscFree2(bt, ct));
+  PetscCall(PetscLogFlops(cn * (2.0 * a->nz)));
+  PetscCall(MatDenseRestoreArrayWrite(C, &Carray));
+  PetscCall(MatDenseRestoreArrayRead(B, &Barray));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &av));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
 static PetscErrorCode MatTMatTMultNumeric_SeqAIJ_SeqDense(Mat A, Mat B, Mat C)
 {
-  PetscInt             i, j, m = A->rmap->n, n = A->cmap->n, blda, clda;
+  PetscInt             i, j, m = A->rmap->n, blda, clda;
   PetscInt             mdof = C->cmap->N;
-  const PetscScalar   *Barray;
-  PetscScalar         *Carray;
+  const PetscScalar   *Barray, *btarray;
+  PetscScalar         *Carray, *ctarray;
   Mat_MatTransMatMult *atb;
   Vec                  bt, ct;
 
   PetscFunctionBegin;
   MatCheckProduct(C, 3);
-  PetscCheck(C->product->type == MATPRODUCT_ABt || C->product->type == MATPRODUCT_AtB, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Not for product type %s", MatProductTypes[C->product->type]);
+  PetscCheck(C->product->type == MATPRODUCT_ABt, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Not for product type %s", MatProductTypes[C->product->type]);
   atb = (Mat_MatTransMatMult *)C->product->data;
   PetscCheck(atb, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Missing product struct");
   bt = atb->bt;
@@ -80,50 +133,27 @@ static PetscErrorCode MatTMatTMultNumeric_SeqAIJ_SeqDense(Mat A, Mat B, Mat C)
   PetscCall(MatDenseGetLDA(B, &blda));
   PetscCall(MatDenseGetArrayWrite(C, &Carray));
   PetscCall(MatDenseGetLDA(C, &clda));
-  if (C->product->type == MATPRODUCT_AtB) { /* transpose local array of B, then copy it to vector bt */
-    const PetscScalar *ctarray;
-    PetscScalar       *btarray;
-
-    PetscCall(VecGetArrayWrite(bt, &btarray));
-    for (j = 0; j < mdof; j++) {
-      for (i = 0; i < m; i++) btarray[i * mdof + j] = Barray[j * blda + i];
-    }
-    PetscCall(VecRestoreArrayWrite(bt, &btarray));
-
-    /* compute ct = mA^T * cb */
-    PetscCall(MatMultTranspose(atb->mA, bt, ct));
-
-    /* transpose local array of ct to matrix C */
-    PetscCall(VecGetArrayRead(ct, &ctarray));
-    for (j = 0; j < mdof; j++) {
-      for (i = 0; i < n; i++) Carray[j * clda + i] = ctarray[i * mdof + j];
-    }
-    PetscCall(VecRestoreArrayRead(ct, &ctarray));
+  /* the local array of B is the interlaced array of B^T */
+  if (blda == B->rmap->n) {
+    PetscCall(VecPlaceArray(ct, Barray));
   } else {
-    const PetscScalar *btarray;
-    PetscScalar       *ctarray;
-
-    if (blda == B->rmap->n) {
-      PetscCall(VecPlaceArray(ct, Barray));
-    } else {
-      PetscInt bn = B->cmap->n;
-      PetscInt bm = B->rmap->n;
-
-      PetscCall(VecGetArrayWrite(ct, &ctarray));
-      for (j = 0; j < bn; j++) {
-        for (i = 0; i < bm; i++) ctarray[j * bm + i] = Barray[j * blda + i];
-      }
-      PetscCall(VecRestoreArrayWrite(ct, &ctarray));
-    }
+    PetscInt bn = B->cmap->n;
+    PetscInt bm = B->rmap->n;
 
-    PetscCall(MatMult(atb->mA, ct, bt));
-    if (blda == B->rmap->n) PetscCall(VecResetArray(ct));
-    PetscCall(VecGetArrayRead(bt, &btarray));
-    for (j = 0; j < mdof; j++) {
-      for (i = 0; i < m; i++) Carray[j * clda + i] = btarray[i * mdof + j];
+    PetscCall(VecGetArrayWrite(ct, &ctarray));
+    for (j = 0; j < bn; j++) {
+      for (i = 0; i < bm; i++) ctarray[j * bm + i] = Barray[j * blda + i];
     }
-    PetscCall(VecRestoreArrayRead(bt, &btarray));
+    PetscCall(VecRestoreArrayWrite(ct, &ctarray));
+  }
+
+  PetscCall(MatMult(atb->mA, ct, bt));
+  if (blda == B->rmap->n) PetscCall(VecResetArray(ct));
+  PetscCall(VecGetArrayRead(bt, &btarray));
+  for (j = 0; j < mdof; j++) {
+    for (i = 0; i < m; i++) Carray[j * clda + i] = btarray[i * mdof + j];
   }
+  PetscCall(VecRestoreArrayRead(bt, &btarray));
   PetscCall(MatDenseRestoreArrayRead(B, &Barray));
   PetscCall(MatDenseRestoreArray(C, &Carray));
   PetscFunctionReturn(PETSC_SUCCESS);
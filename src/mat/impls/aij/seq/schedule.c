@@ -0,0 +1,264 @@
+/*
+  Orderings of the rows of a MATSEQAIJ matrix that expose independent work in the recurrences of MatSOR() and of
+  the triangular solves of its LU and ILU factors.
+
+  With -mat_sor_multicolor the rows are colored with MatColoring so that no two rows of the same color are coupled;
+  a Gauss-Seidel sweep then visits the colors in order and the rows of one color may be updated in any order, or
+  concurrently. This is SOR for the matrix symmetrically permuted by colors, so the convergence differs from the
+  sweep in the natural ordering.
+
+  With -mat_solve_level_schedule the rows of each triangular factor are grouped into levels (wavefronts) such that
+  a row only depends on rows of earlier levels; the solve processes the levels in order and the rows of a level
+  concurrently. The arithmetic of each row is unchanged, so the solution is the same as that of the natural solve.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/* sorts the rows 0..m-1 by the value of key[], keeping their order within a key; ptr[] has nkeys+1 entries */
+static PetscErrorCode MatSeqAIJScheduleSortRows_Private(PetscInt m, PetscInt nkeys, const PetscInt key[], PetscInt **ptr, PetscInt **rows)
+{
+  PetscInt i, *p, *r;
+
+  PetscFunctionBegin;
+  PetscCall(PetscCalloc1(nkeys + 1, &p));
+  PetscCall(PetscMalloc1(m, &r));
+  for (i = 0; i < m; i++) p[key[i] + 1]++;
+  for (i = 0; i < nkeys; i++) p[i + 1] += p[i];
+  for (i = 0; i < m; i++) r[p[key[i]]++] = i;
+  for (i = nkeys; i > 0; i--) p[i] = p[i - 1];
+  p[0]  = 0;
+  *ptr  = p;
+  *rows = r;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* colors the graph of A + A^T with MatColoring, by default MATCOLORINGGREEDY; the options of the coloring have the prefix of A followed by sor_ */
+static PetscErrorCode MatSeqAIJScheduleColor_Private(Mat A)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSchedule    *s = &a->schedule;
+  Mat                    G = A, At;
+  MatColoring            mc;
+  ISColoring             iscoloring;
+  const ISColoringValue *colors;
+  PetscInt               m = A->rmap->n, i, *key;
+  PetscBool              set, flg;
+
+  PetscFunctionBegin;
+  PetscCall(MatIsStructurallySymmetricKnown(A, &set, &flg));
+  if (!set || !flg) {
+    PetscCall(MatTranspose(A, MAT_INITIAL_MATRIX, &At));
+    PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &G));
+    PetscCall(MatAXPY(G, 1.0, At, DIFFERENT_NONZERO_PATTERN));
+    PetscCall(MatDestroy(&At));
+  }
+  PetscCall(MatColoringCreate(G, &mc));
+  PetscCall(PetscObjectSetOptionsPrefix((PetscObject)mc, ((PetscObject)A)->prefix));
+  PetscCall(PetscObjectAppendOptionsPrefix((PetscObject)mc, "sor_"));
+  PetscCall(MatColoringSetType(mc, MATCOLORINGGREEDY));
+  PetscCall(MatColoringSetDistance(mc, 1));
+  PetscCall(MatColoringSetFromOptions(mc));
+  PetscCall(MatColoringApply(mc, &iscoloring));
+  PetscCall(MatColoringDestroy(&mc));
+  if (G != A) PetscCall(MatDestroy(&G));
+
+  PetscCall(ISColoringGetColors(iscoloring, NULL, &s->sorncolors, &colors));
+  PetscCall(PetscMalloc1(m, &key));
+  for (i = 0; i < m; i++) key[i] = colors[i];
+  PetscCall(PetscFree(s->sorptr));
+  PetscCall(PetscFree(s->sorrows));
+  PetscCall(MatSeqAIJScheduleSortRows_Private(m, s->sorncolors, key, &s->sorptr, &s->sorrows));
+  PetscCall(PetscFree(key));
+  PetscCall(ISColoringDestroy(&iscoloring));
+  s->sor_nonzerostate = A->nonzerostate;
+  PetscCall(PetscInfo(A, "Multicolor MatSOR() with %" PetscInt_FMT " colors for %" PetscInt_FMT " rows\n", s->sorncolors, m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* one Gauss-Seidel update of the rows of one color; the rows of a color are not coupled so they are independent */
+static inline void MatSORColor_SeqAIJ_Private(const PetscInt *ai, const PetscInt *aj, const MatScalar *aa, const PetscScalar *mdiag, const PetscScalar *idiag, const PetscInt *rows, PetscInt nrows, PetscReal omega, const PetscScalar *b, PetscScalar *x)
+{
+  PetscPragmaOMP(parallel for schedule(static) if (nrows > PETSC_OMP_MIN_ITERATIONS))
+  for (PetscInt k = 0; k < nrows; k++) {
+    const PetscInt   i = rows[k], n = ai[i + 1] - ai[i];
+    const MatScalar *v   = aa + ai[i];
+    const PetscInt  *idx = aj + ai[i];
+    PetscScalar      sum = b[i];
+
+    PetscSparseDenseMinusDot(sum, x, v, idx, n);
+    x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i]; /* omega in idiag */
+  }
+}
+
+/*
+   Called by MatSOR_SeqAIJ() once idiag[] and mdiag[] are valid; SOR_EISENSTAT and SOR_APPLY_UPPER use the natural ordering.
+   The forward sweep visits the colors in increasing order and the backward sweep in decreasing order.
+*/
+PetscErrorCode MatSOR_SeqAIJ_Multicolor(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscInt its, Vec xx)
+{
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSchedule *s = &a->schedule;
+  PetscScalar        *x;
+  const PetscScalar  *b;
+  const MatScalar    *aa;
+  PetscInt            c;
+
+  PetscFunctionBegin;
+  if (!s->sorptr || s->sor_nonzerostate != A->nonzerostate) PetscCall(MatSeqAIJScheduleColor_Private(A));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(bb, &b));
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    PetscCall(VecGetArrayWrite(xx, &x));
+    PetscCall(PetscArrayzero(x, A->rmap->n));
+  } else PetscCall(VecGetArray(xx, &x));
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (c = 0; c < s->sorncolors; c++) MatSORColor_SeqAIJ_Private(a->i, a->j, aa, a->mdiag, a->idiag, s->sorrows + s->sorptr[c], s->sorptr[c + 1] - s->sorptr[c], omega, b, x);
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    }
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (c = s->sorncolors - 1; c >= 0; c--) MatSORColor_SeqAIJ_Private(a->i, a->j, aa, a->mdiag, a->idiag, s->sorrows + s->sorptr[c], s->sorptr[c + 1] - s->sorptr[c], omega, b, x);
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    }
+  }
+  if (flag & SOR_ZERO_INITIAL_GUESS) PetscCall(VecRestoreArrayWrite(xx, &x));
+  else PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the rows of the factor level by level; within a level the rows are independent */
+static PetscErrorCode MatSolve_SeqAIJ_LevelSchedule(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSchedule *s = &a->schedule;
+  const PetscInt     *ai = a->i, *aj = a->j, *adiag = a->diag, *r, *c;
+  PetscInt            n = A->rmap->n, l;
+  PetscScalar        *x, *tmp = a->solve_work;
+  const PetscScalar  *b;
+  const MatScalar    *aa = a->a;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  PetscCall(ISGetIndices(a->row, &r));
+  PetscCall(ISGetIndices(a->col, &c));
+
+  /* forward solve the lower triangular */
+  for (l = 0; l < s->nlevels[0]; l++) {
+    const PetscInt *rows = s->levelrows[0] + s->levelptr[0][l], nrows = s->levelptr[0][l + 1] - s->levelptr[0][l];
+
+    PetscPragmaOMP(parallel for schedule(static) if (nrows > PETSC_OMP_MIN_ITERATIONS))
+    for (PetscInt k = 0; k < nrows; k++) {
+      const PetscInt   i = rows[k], nz = ai[i + 1] - ai[i];
+      const MatScalar *v   = aa + ai[i];
+      const PetscInt  *vi  = aj + ai[i];
+      PetscScalar      sum = b[r[i]];
+
+      PetscSparseDenseMinusDot(sum, tmp, v, vi, nz);
+      tmp[i] = sum;
+    }
+  }
+
+  /* backward solve the upper triangular */
+  for (l = 0; l < s->nlevels[1]; l++) {
+    const PetscInt *rows = s->levelrows[1] + s->levelptr[1][l], nrows = s->levelptr[1][l + 1] - s->levelptr[1][l];
+
+    PetscPragmaOMP(parallel for schedule(static) if (nrows > PETSC_OMP_MIN_ITERATIONS))
+    for (PetscInt k = 0; k < nrows; k++) {
+      const PetscInt   i  = rows[k], nz = adiag[i] - adiag[i + 1] - 1;
+      const MatScalar *v  = aa + adiag[i + 1] + 1;
+      const PetscInt  *vi = aj + adiag[i + 1] + 1;
+      PetscScalar      sum = tmp[i];
+
+      PetscSparseDenseMinusDot(sum, tmp, v, vi, nz);
+      x[c[i]] = tmp[i] = sum * v[nz]; /* v[nz] = aa[adiag[i]] */
+    }
+  }
+
+  PetscCall(ISRestoreIndices(a->row, &r));
+  PetscCall(ISRestoreIndices(a->col, &c));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(2.0 * a->nz - A->cmap->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Called at the end of the numeric LU and ILU factorizations of MATSEQAIJ with the factor in the (non inplace) storage where
+   row i of U is stored at adiag[i + 1] + 1 ... adiag[i]; with -mat_solve_level_schedule the level sets of L and U are
+   computed and MatSolve() uses them
+*/
+PetscErrorCode MatSolveSetUp_SeqAIJ_LevelSchedule(Mat C)
+{
+  Mat_SeqAIJ         *b = (Mat_SeqAIJ *)C->data;
+  Mat_SeqAIJSchedule *s = &b->schedule;
+  const PetscInt     *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  PetscInt            n = C->rmap->n, i, k, *level;
+
+  PetscFunctionBegin;
+  if (!s->solve_checked) {
+    PetscObjectOptionsBegin((PetscObject)C);
+    PetscCall(PetscOptionsBool("-mat_solve_level_schedule", "Solve with the factors level by level", "MatSolve", s->solve_levels, &s->solve_levels, NULL));
+    PetscOptionsEnd();
+    s->solve_checked = PETSC_TRUE;
+  }
+  if (!s->solve_levels) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* the nonzero structure may have changed with a new symbolic factorization, and this is cheaper than the numeric factorization */
+  for (k = 0; k < 2; k++) {
+    PetscCall(PetscFree(s->levelptr[k]));
+    PetscCall(PetscFree(s->levelrows[k]));
+  }
+  PetscCall(PetscMalloc1(n, &level));
+  s->nlevels[0] = 0;
+  for (i = 0; i < n; i++) {
+    level[i] = 0;
+    for (k = bi[i]; k < bi[i + 1]; k++) level[i] = PetscMax(level[i], level[bj[k]] + 1);
+    s->nlevels[0] = PetscMax(s->nlevels[0], level[i] + 1);
+  }
+  PetscCall(MatSeqAIJScheduleSortRows_Private(n, s->nlevels[0], level, &s->levelptr[0], &s->levelrows[0]));
+  s->nlevels[1] = 0;
+  for (i = n - 1; i >= 0; i--) {
+    level[i] = 0;
+    for (k = bdiag[i + 1] + 1; k < bdiag[i]; k++) level[i] = PetscMax(level[i], level[bj[k]] + 1);
+    s->nlevels[1] = PetscMax(s->nlevels[1], level[i] + 1);
+  }
+  PetscCall(MatSeqAIJScheduleSortRows_Private(n, s->nlevels[1], level, &s->levelptr[1], &s->levelrows[1]));
+  PetscCall(PetscFree(level));
+  PetscCall(PetscInfo(C, "Level scheduled MatSolve() with %" PetscInt_FMT " levels in L and %" PetscInt_FMT " in U for %" PetscInt_FMT " rows\n", s->nlevels[0], s->nlevels[1], n));
+  C->ops->solve = MatSolve_SeqAIJ_LevelSchedule;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatDestroy_SeqAIJ_Schedule(Mat A)
+{
+  Mat_SeqAIJ         *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJSchedule *s = &a->schedule;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(s->sorptr));
+  PetscCall(PetscFree(s->sorrows));
+  for (PetscInt k = 0; k < 2; k++) {
+    PetscCall(PetscFree(s->levelptr[k]));
+    PetscCall(PetscFree(s->levelrows[k]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatCreate_SeqAIJ_Schedule(Mat B)
+{
+  Mat_SeqAIJ         *b = (Mat_SeqAIJ *)B->data;
+  Mat_SeqAIJSchedule *s = &b->schedule;
+
+  PetscFunctionBegin;
+  s->sormulticolor = PETSC_FALSE;
+  s->solve_levels  = PETSC_FALSE;
+  s->solve_checked = PETSC_FALSE;
+
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "Options for SEQAIJ matrix", "Mat");
+  PetscCall(PetscOptionsBool("-mat_sor_multicolor", "Sweep over the rows by colors in MatSOR()", "MatSOR", s->sormulticolor, &s->sormulticolor, NULL));
+  PetscOptionsEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
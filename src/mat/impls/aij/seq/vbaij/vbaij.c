@@ -0,0 +1,499 @@
+/*
+  Defines basic operations for the MATSEQVBAIJ matrix class.
+  This class is derived from the MATSEQAIJ class and retains the
+  compressed row storage (aka Yale sparse matrix format), but uses the
+  partition of the rows into blocks of variable size given with
+  MatSetVariableBlockSizes(). The same partition is applied to the columns,
+  and a block row whose rows have the same nonzero columns, made of complete
+  blocks, is treated as a row of dense blocks: the kernels load one index per
+  block instead of one per nonzero and reuse each loaded entry of x for all
+  the rows of the block row. The values stay in a->a, where the rows of a block
+  row are consecutive and have the same length, so the k-th row of a block row
+  with row length L starts L entries after the (k-1)-th one.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+/* block rows larger than this keep the row-by-row kernels */
+#define MAT_SEQVBAIJ_MAX_BS 16
+
+typedef struct {
+  PetscObjectState nonzerostate; /* nonzero state of the matrix when the block structure was built */
+  PetscInt         nblocks;      /* number of block rows, 0 if the block structure has not been built */
+  PetscInt        *bsizes;       /* the block sizes the structure was built for */
+  PetscInt        *bstart;       /* first row (and column) of each block */
+  PetscInt        *bi;           /* the blocks of dense block row ib are bj[bi[ib]] ... bj[bi[ib + 1] - 1] */
+  PetscInt        *bj;           /* block column index of each block */
+  PetscBool       *dense;        /* if block row ib is made of complete dense blocks */
+  PetscInt         ndense;       /* number of dense block rows */
+  PetscScalar     *ibdiag;       /* inverses of the diagonal blocks, column oriented, used by MatSOR() */
+  PetscObjectState ibdiagstate;  /* state of the matrix when ibdiag was computed */
+  PetscBool        ibdiagvalid;
+} Mat_SeqVBAIJ;
+
+static PetscErrorCode MatSeqVBAIJ_reset(Mat_SeqVBAIJ *vbaij)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree3(vbaij->bsizes, vbaij->bstart, vbaij->bi));
+  PetscCall(PetscFree(vbaij->bj));
+  PetscCall(PetscFree(vbaij->dense));
+  PetscCall(PetscFree(vbaij->ibdiag));
+  vbaij->nblocks      = 0;
+  vbaij->ndense       = 0;
+  vbaij->nonzerostate = 0;
+  vbaij->ibdiagvalid  = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqVBAIJ_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQVBAIJ to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat           B     = *newmat;
+  Mat_SeqVBAIJ *vbaij = (Mat_SeqVBAIJ *)A->spptr;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+    vbaij = (Mat_SeqVBAIJ *)B->spptr;
+  }
+
+  /* Reset the original function pointers. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->sor         = MatSOR_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqvbaij_seqaij_C", NULL));
+
+  /* Free everything in the Mat_SeqVBAIJ data structure. */
+  PetscCall(MatSeqVBAIJ_reset(vbaij));
+  PetscCall(PetscFree(B->spptr));
+
+  /* Change the type of B to MATSEQAIJ. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqVBAIJ(Mat A)
+{
+  Mat_SeqVBAIJ *vbaij = (Mat_SeqVBAIJ *)A->spptr;
+
+  PetscFunctionBegin;
+  /* If MatHeaderMerge() was used then this SeqVBAIJ matrix will not have a spptr. */
+  if (vbaij) {
+    PetscCall(MatSeqVBAIJ_reset(vbaij));
+    PetscCall(PetscFree(A->spptr));
+  }
+  /* Change the type of A back to SEQAIJ and use MatDestroy_SeqAIJ()
+   * to destroy everything that remains. */
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqvbaij_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the block sizes set with MatSetVariableBlockSizes(), otherwise the constant block size of the rows, if larger than one */
+static PetscErrorCode MatSeqVBAIJGetBlockSizes_Private(Mat A, PetscInt *nblocks, PetscInt **bsizes, PetscBool *alloc)
+{
+  PetscInt m = A->rmap->n, bs = A->rmap->bs;
+
+  PetscFunctionBegin;
+  *alloc = PETSC_FALSE;
+  if (A->nblocks) {
+    *nblocks = A->nblocks;
+    *bsizes  = A->bsizes;
+  } else if (bs <= 1) {
+    *nblocks = 0;
+    *bsizes  = NULL;
+  } else {
+    *nblocks = m / bs;
+    *alloc   = PETSC_TRUE;
+    PetscCall(PetscMalloc1(*nblocks, bsizes));
+    for (PetscInt i = 0; i < *nblocks; i++) (*bsizes)[i] = bs;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Build the block structure if and only if the nonzero structure or the block sizes have changed since it was last built.
+ * The values are always read from a->a, so changing them does not require a rebuild. */
+static PetscErrorCode MatSeqVBAIJ_create_vbaij(Mat A)
+{
+  Mat_SeqAIJ     *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqVBAIJ   *vbaij = (Mat_SeqVBAIJ *)A->spptr;
+  PetscInt        m = A->rmap->n, nblocks, *bsizes, ib, jb, k, p, r0, len, c, nb = 0, *colblock;
+  const PetscInt *ai = a->i, *aj = a->j;
+  PetscBool       alloc, same;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqVBAIJGetBlockSizes_Private(A, &nblocks, &bsizes, &alloc));
+  if (vbaij->nblocks && vbaij->nonzerostate == A->nonzerostate && vbaij->nblocks == nblocks) {
+    PetscCall(PetscArraycmp(vbaij->bsizes, bsizes, nblocks, &same));
+    if (same) {
+      if (alloc) PetscCall(PetscFree(bsizes));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+  PetscCall(MatSeqVBAIJ_reset(vbaij));
+  if (!nblocks || A->cmap->n != m) {
+    if (alloc) PetscCall(PetscFree(bsizes));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscMalloc3(nblocks, &vbaij->bsizes, nblocks + 1, &vbaij->bstart, nblocks + 1, &vbaij->bi));
+  PetscCall(PetscMalloc1(nblocks, &vbaij->dense));
+  PetscCall(PetscArraycpy(vbaij->bsizes, bsizes, nblocks));
+  if (alloc) PetscCall(PetscFree(bsizes));
+  vbaij->bstart[0] = 0;
+  for (ib = 0; ib < nblocks; ib++) vbaij->bstart[ib + 1] = vbaij->bstart[ib] + vbaij->bsizes[ib];
+  PetscCall(PetscMalloc1(m, &colblock));
+  for (ib = 0; ib < nblocks; ib++) {
+    for (k = vbaij->bstart[ib]; k < vbaij->bstart[ib + 1]; k++) colblock[k] = ib;
+  }
+
+  /* a block row is dense if all its rows have the columns of its first row, and these are made of complete blocks */
+  vbaij->bi[0] = 0;
+  for (ib = 0; ib < nblocks; ib++) {
+    r0              = vbaij->bstart[ib];
+    len             = ai[r0 + 1] - ai[r0];
+    vbaij->dense[ib] = (PetscBool)(vbaij->bsizes[ib] <= MAT_SEQVBAIJ_MAX_BS);
+    for (k = r0 + 1; k < vbaij->bstart[ib + 1] && vbaij->dense[ib]; k++) {
+      if (ai[k + 1] - ai[k] != len) vbaij->dense[ib] = PETSC_FALSE;
+      else {
+        PetscCall(PetscArraycmp(aj + ai[k], aj + ai[r0], len, &same));
+        if (!same) vbaij->dense[ib] = PETSC_FALSE;
+      }
+    }
+    for (p = 0; p < len && vbaij->dense[ib];) {
+      c = aj[ai[r0] + p];
+      jb = colblock[c];
+      if (c != vbaij->bstart[jb] || p + vbaij->bsizes[jb] > len || aj[ai[r0] + p + vbaij->bsizes[jb] - 1] != vbaij->bstart[jb + 1] - 1) vbaij->dense[ib] = PETSC_FALSE;
+      p += vbaij->bsizes[jb];
+      nb++;
+    }
+    if (vbaij->dense[ib]) vbaij->ndense++;
+  }
+  PetscCall(PetscMalloc1(nb, &vbaij->bj));
+  for (ib = 0, nb = 0; ib < nblocks; ib++) {
+    r0 = vbaij->bstart[ib];
+    if (vbaij->dense[ib]) {
+      for (p = ai[r0]; p < ai[r0 + 1]; p += vbaij->bsizes[colblock[aj[p]]]) vbaij->bj[nb++] = colblock[aj[p]];
+    }
+    vbaij->bi[ib + 1] = nb;
+  }
+  PetscCall(PetscFree(colblock));
+  vbaij->nblocks      = nblocks;
+  vbaij->nonzerostate = A->nonzerostate;
+  PetscCall(PetscInfo(A, "Dense block rows %" PetscInt_FMT " of %" PetscInt_FMT " with %" PetscInt_FMT " blocks\n", vbaij->ndense, nblocks, nb));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_SeqVBAIJ(Mat A, MatDuplicateOption op, Mat *M)
+{
+  PetscFunctionBegin;
+  /* MatDuplicate_SeqAIJ() sets the type of *M, so its (empty) Mat_SeqVBAIJ is already in place.
+   * The block structure is rebuilt when it is first needed. */
+  PetscCall(MatDuplicate_SeqAIJ(A, op, M));
+  if (A->nblocks) PetscCall(MatSetVariableBlockSizes(*M, A->nblocks, A->bsizes));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqVBAIJ(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* The block rows play the role of the inodes, so the inode kernels are disabled here
+   * to ensure the block kernels are used. */
+  a->inode.use = PETSC_FALSE;
+
+  PetscCall(MatAssemblyEnd_SeqAIJ(A, mode));
+  PetscCall(MatSeqVBAIJ_create_vbaij(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* z[r0 .. r0 + bs - 1] = y[] + A x over the rows of block row ib, where y is NULL for MatMult() */
+static inline void MatSeqVBAIJ_BlockRow(const Mat_SeqVBAIJ *vbaij, const PetscInt *ai, const PetscInt *aj, const MatScalar *aa, const PetscScalar *x, const PetscScalar *y, PetscScalar *z, PetscInt ib)
+{
+  const PetscInt r0 = vbaij->bstart[ib], bs = vbaij->bsizes[ib];
+  PetscInt       k, l, b;
+
+  if (vbaij->dense[ib]) {
+    const PetscInt   len = ai[r0 + 1] - ai[r0];
+    const MatScalar *v   = aa + ai[r0];
+    PetscScalar      sum[MAT_SEQVBAIJ_MAX_BS];
+
+    for (k = 0; k < bs; k++) sum[k] = y ? y[r0 + k] : 0.0;
+    for (b = vbaij->bi[ib]; b < vbaij->bi[ib + 1]; b++) {
+      const PetscInt     jb  = vbaij->bj[b], w = vbaij->bsizes[jb];
+      const PetscScalar *xb = x + vbaij->bstart[jb];
+
+      /* the dense bs x w block is stored by rows, with the rows len apart */
+      for (l = 0; l < w; l++) {
+        const PetscScalar xl = xb[l];
+
+        for (k = 0; k < bs; k++) sum[k] += v[k * len + l] * xl;
+      }
+      v += w;
+    }
+    for (k = 0; k < bs; k++) z[r0 + k] = sum[k];
+  } else {
+    for (k = r0; k < r0 + bs; k++) {
+      PetscScalar sum = y ? y[k] : 0.0;
+
+      for (l = ai[k]; l < ai[k + 1]; l++) sum += aa[l] * x[aj[l]];
+      z[k] = sum;
+    }
+  }
+}
+
+static PetscErrorCode MatMult_SeqVBAIJ(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqVBAIJ      *vbaij = (Mat_SeqVBAIJ *)A->spptr;
+  PetscScalar       *y;
+  const PetscScalar *x;
+  const MatScalar   *aa;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqVBAIJ_create_vbaij(A));
+  if (!vbaij->nblocks) {
+    PetscCall(MatMult_SeqAIJ(A, xx, yy));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayWrite(yy, &y));
+  for (PetscInt ib = 0; ib < vbaij->nblocks; ib++) MatSeqVBAIJ_BlockRow(vbaij, a->i, a->j, aa, x, NULL, y, ib);
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayWrite(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqVBAIJ(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqVBAIJ      *vbaij = (Mat_SeqVBAIJ *)A->spptr;
+  PetscScalar       *y, *z;
+  const PetscScalar *x;
+  const MatScalar   *aa;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqVBAIJ_create_vbaij(A));
+  if (!vbaij->nblocks) {
+    PetscCall(MatMultAdd_SeqAIJ(A, xx, yy, zz));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  for (PetscInt ib = 0; ib < vbaij->nblocks; ib++) MatSeqVBAIJ_BlockRow(vbaij, a->i, a->j, aa, x, y, z, ib);
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* x_I = (1 - omega) x_I + omega D_I^{-1} (b_I - sum_{J != I} A_IJ x_J) for block row I = ib */
+static inline void MatSeqVBAIJ_SORBlock(const Mat_SeqVBAIJ *vbaij, const PetscInt *ai, const PetscInt *aj, const MatScalar *aa, const PetscScalar *idiag, PetscReal omega, const PetscScalar *b, PetscScalar *x, PetscScalar *t, PetscInt ib)
+{
+  const PetscInt r0 = vbaij->bstart[ib], r1 = vbaij->bstart[ib + 1], bs = r1 - r0;
+  PetscInt       k, l;
+
+  for (k = 0; k < bs; k++) {
+    PetscScalar sum = b[r0 + k];
+
+    for (l = ai[r0 + k]; l < ai[r0 + k + 1]; l++) {
+      if (aj[l] < r0 || aj[l] >= r1) sum -= aa[l] * x[aj[l]];
+    }
+    t[k] = sum;
+  }
+  for (k = 0; k < bs; k++) {
+    PetscScalar sum = 0.0;
+
+    for (l = 0; l < bs; l++) sum += idiag[l * bs + k] * t[l];
+    t[bs + k] = sum;
+  }
+  for (k = 0; k < bs; k++) x[r0 + k] = (1.0 - omega) * x[r0 + k] + omega * t[bs + k];
+}
+
+/*
+   Block Gauss-Seidel with the inverses of the diagonal blocks from MatInvertVariableBlockDiagonal(), which uses the dense
+   block kernels of BAIJ; sweeps with a shift, SOR_EISENSTAT and SOR_APPLY_UPPER/LOWER use the point relaxation of MATSEQAIJ
+*/
+static PetscErrorCode MatSOR_SeqVBAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ        *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqVBAIJ      *vbaij = (Mat_SeqVBAIJ *)A->spptr;
+  PetscScalar       *x, *t, *idiag;
+  const PetscScalar *b;
+  const MatScalar   *aa;
+  PetscObjectState   state;
+  PetscInt           ib, n = 0, bsmax = 0;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqVBAIJ_create_vbaij(A));
+  if (!vbaij->nblocks || fshift != 0.0 || flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || (flag & SOR_EISENSTAT)) {
+    PetscCall(MatSOR_SeqAIJ(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (ib = 0; ib < vbaij->nblocks; ib++) {
+    n += vbaij->bsizes[ib] * vbaij->bsizes[ib];
+    bsmax = PetscMax(bsmax, vbaij->bsizes[ib]);
+  }
+  PetscCall(PetscObjectStateGet((PetscObject)A, &state));
+  if (!vbaij->ibdiagvalid || vbaij->ibdiagstate != state) {
+    if (!vbaij->ibdiag) PetscCall(PetscMalloc1(n, &vbaij->ibdiag));
+    PetscCall(MatInvertVariableBlockDiagonal(A, vbaij->nblocks, vbaij->bsizes, vbaij->ibdiag));
+    vbaij->ibdiagvalid = PETSC_TRUE;
+    vbaij->ibdiagstate = state;
+  }
+  its = its * lits;
+  PetscCall(PetscMalloc1(2 * bsmax, &t));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArrayRead(bb, &b));
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    PetscCall(VecGetArrayWrite(xx, &x));
+    PetscCall(PetscArrayzero(x, A->rmap->n));
+  } else PetscCall(VecGetArray(xx, &x));
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      idiag = vbaij->ibdiag;
+      for (ib = 0; ib < vbaij->nblocks; ib++) {
+        MatSeqVBAIJ_SORBlock(vbaij, a->i, a->j, aa, idiag, omega, b, x, t, ib);
+        idiag += vbaij->bsizes[ib] * vbaij->bsizes[ib];
+      }
+      PetscCall(PetscLogFlops(2.0 * (a->nz + n)));
+    }
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      idiag = vbaij->ibdiag + n;
+      for (ib = vbaij->nblocks - 1; ib >= 0; ib--) {
+        idiag -= vbaij->bsizes[ib] * vbaij->bsizes[ib];
+        MatSeqVBAIJ_SORBlock(vbaij, a->i, a->j, aa, idiag, omega, b, x, t, ib);
+      }
+      PetscCall(PetscLogFlops(2.0 * (a->nz + n)));
+    }
+  }
+  if (flag & SOR_ZERO_INITIAL_GUESS) PetscCall(VecRestoreArrayWrite(xx, &x));
+  else PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(PetscFree(t));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqVBAIJ converts a SeqAIJ matrix into a
+ * SeqVBAIJ matrix.  This routine is called by the MatCreate_SeqVBAIJ()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqVBAIJ one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqVBAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat           B = *newmat;
+  Mat_SeqAIJ   *b;
+  Mat_SeqVBAIJ *vbaij;
+  PetscBool     sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) {
+    PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+    if (A->nblocks) PetscCall(MatSetVariableBlockSizes(B, A->nblocks, A->bsizes));
+  }
+
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&vbaij));
+  b        = (Mat_SeqAIJ *)B->data;
+  B->spptr = (void *)vbaij;
+
+  /* Disable use of the inode routines so that the VBAIJ ones will be used instead.
+   * This happens in MatAssemblyEnd_SeqVBAIJ as well, but the assembly end may not be called, so set it here, too. */
+  b->inode.use = PETSC_FALSE;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate   = MatDuplicate_SeqVBAIJ;
+  B->ops->assemblyend = MatAssemblyEnd_SeqVBAIJ;
+  B->ops->destroy     = MatDestroy_SeqVBAIJ;
+  B->ops->mult        = MatMult_SeqVBAIJ;
+  B->ops->multadd     = MatMultAdd_SeqVBAIJ;
+  B->ops->sor         = MatSOR_SeqVBAIJ;
+
+  /* If A has already been assembled, compute the block structure. */
+  if (A->assembled) PetscCall(MatSeqVBAIJ_create_vbaij(B));
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqvbaij_seqaij_C", MatConvert_SeqVBAIJ_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQVBAIJ));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  MatCreateSeqVBAIJ - Creates a sparse matrix of type `MATSEQVBAIJ` whose rows and columns are partitioned into blocks of variable size.
+
+  Collective
+
+  Input Parameters:
++ comm    - MPI communicator, set to `PETSC_COMM_SELF`
+. nblocks - number of blocks
+. bsizes  - the size of each block
+. nz      - number of nonzeros per row (same for all rows)
+- nnz     - array containing the number of nonzeros in the various rows
+            (possibly different for each row) or `NULL`
+
+  Output Parameter:
+. A - the matrix, of size the sum of `bsizes`
+
+  Level: intermediate
+
+  Notes:
+  This type inherits from AIJ and is largely identical; it uses the partition given with `MatSetVariableBlockSizes()` for its
+  rows and columns, and treats each block row whose rows have the same nonzero columns, made of complete blocks, as a row of
+  dense blocks in `MatMult()` and `MatMultAdd()`. `MatSOR()` is block Gauss-Seidel with the diagonal blocks inverted by
+  `MatInvertVariableBlockDiagonal()`, and `PCVPBJACOBI` uses the same blocks. Block rows that are not made of dense blocks,
+  for example because some entries of a block were never set, use the row-by-row kernels. To get dense blocks, set all the
+  entries of the coupled blocks, with zeros if needed.
+
+  If no variable block sizes have been set, the constant block size of the matrix is used when it is larger than one.
+
+  The factorizations with `MATSOLVERPETSC` are those of `MATSEQAIJ`, whose Inode kernels process groups of up to 5 rows
+  with the same nonzero structure, which includes the rows of the dense block rows.
+
+  Run with `-info` to see how many block rows are dense.
+
+  If `nnz` is given then `nz` is ignored
+
+  Because `MATSEQVBAIJ` is a subtype of `MATSEQAIJ`, the option `-mat_seqaij_type seqvbaij` can be used to make
+  sequential `MATSEQAIJ` matrices default to being instances of `MATSEQVBAIJ`.
+
+.seealso: [](ch_matrices), `Mat`, `MATSEQVBAIJ`, `MatCreate()`, `MatCreateMPIVBAIJ()`, `MatSetVariableBlockSizes()`, `MatSetValues()`, `PCVPBJACOBI`
+@*/
+PetscErrorCode MatCreateSeqVBAIJ(MPI_Comm comm, PetscInt nblocks, const PetscInt bsizes[], PetscInt nz, const PetscInt nnz[], Mat *A)
+{
+  PetscInt m = 0;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < nblocks; i++) m += bsizes[i];
+  PetscCall(MatCreate(comm, A));
+  PetscCall(MatSetSizes(*A, m, m, m, m));
+  PetscCall(MatSetType(*A, MATSEQVBAIJ));
+  PetscCall(MatSetVariableBlockSizes(*A, nblocks, (PetscInt *)bsizes));
+  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(*A, nz, nnz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqVBAIJ(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqVBAIJ(A, MATSEQVBAIJ, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
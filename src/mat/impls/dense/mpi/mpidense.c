@@ -467,6 +467,7 @@ PETSC_INTERN PetscErrorCode MatMult_SeqDense(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqDense(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqDense(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqDense(Mat, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultAddDot_SeqDense(Mat, Vec, Vec, Vec, Vec, PetscScalar *);
 
 static PetscErrorCode MatMult_MPIDense(Mat mat, Vec xx, Vec yy)
 {
@@ -506,6 +507,57 @@ static PetscErrorCode MatMultAdd_MPIDense(Mat mat, Vec xx, Vec yy, Vec zz)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode MatMultDot_MPIDense(Mat mat, Vec xx, Vec yy, Vec ww, PetscScalar *dot)
+{
+  Mat_MPIDense      *mdn = (Mat_MPIDense *)mat->data;
+  const PetscScalar *ax;
+  PetscScalar       *ay, d;
+  PetscMemType       axmtype, aymtype;
+
+  PetscFunctionBegin;
+  if (mat->ops->mult != MatMult_MPIDense || mdn->A->ops->mult != MatMult_SeqDense) {
+    PetscCall(MatMultDot_Basic(mat, xx, yy, ww, dot));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (!mdn->Mvctx) PetscCall(MatSetUpMultiply_MPIDense(mat));
+  PetscCall(VecGetArrayReadAndMemType(xx, &ax, &axmtype));
+  PetscCall(VecGetArrayAndMemType(mdn->lvec, &ay, &aymtype));
+  PetscCall(PetscSFBcastWithMemTypeBegin(mdn->Mvctx, MPIU_SCALAR, axmtype, ax, aymtype, ay, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(mdn->Mvctx, MPIU_SCALAR, ax, ay, MPI_REPLACE));
+  PetscCall(VecRestoreArrayAndMemType(mdn->lvec, &ay));
+  PetscCall(VecRestoreArrayReadAndMemType(xx, &ax));
+  PetscCall(MatMultAddDot_SeqDense(mdn->A, mdn->lvec, NULL, yy, ww, &d));
+  PetscCall(MPIU_Allreduce(&d, dot, 1, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)mat)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAddNorm_MPIDense(Mat mat, Vec xx, Vec yy, Vec zz, PetscReal *norm)
+{
+  Mat_MPIDense      *mdn = (Mat_MPIDense *)mat->data;
+  const PetscScalar *ax;
+  PetscScalar       *ay, d;
+  PetscReal          sum;
+  PetscMemType       axmtype, aymtype;
+
+  PetscFunctionBegin;
+  if (mat->ops->multadd != MatMultAdd_MPIDense || mdn->A->ops->multadd != MatMultAdd_SeqDense) {
+    PetscCall(MatMultAddNorm_Basic(mat, xx, yy, zz, norm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (!mdn->Mvctx) PetscCall(MatSetUpMultiply_MPIDense(mat));
+  PetscCall(VecGetArrayReadAndMemType(xx, &ax, &axmtype));
+  PetscCall(VecGetArrayAndMemType(mdn->lvec, &ay, &aymtype));
+  PetscCall(PetscSFBcastWithMemTypeBegin(mdn->Mvctx, MPIU_SCALAR, axmtype, ax, aymtype, ay, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(mdn->Mvctx, MPIU_SCALAR, ax, ay, MPI_REPLACE));
+  PetscCall(VecRestoreArrayAndMemType(mdn->lvec, &ay));
+  PetscCall(VecRestoreArrayReadAndMemType(xx, &ax));
+  PetscCall(MatMultAddDot_SeqDense(mdn->A, mdn->lvec, yy, zz, NULL, &d));
+  sum = PetscRealPart(d);
+  PetscCall(MPIU_Allreduce(&sum, norm, 1, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)mat)));
+  *norm = PetscSqrtReal(*norm);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatMultTranspose_MPIDense(Mat A, Vec xx, Vec yy)
 {
   Mat_MPIDense      *a = (Mat_MPIDense *)A->data;
@@ -1263,7 +1315,9 @@ static struct _MatOps MatOps_Values = {MatSetValues_MPIDense,
                                        NULL,
                                        NULL,
                                        /*150*/ NULL,
-                                       NULL};
+                                       NULL,
+                                       MatMultDot_MPIDense,
+                                       MatMultAddNorm_MPIDense};
 
 static PetscErrorCode MatMPIDenseSetPreallocation_MPIDense(Mat mat, PetscScalar *data)
 {
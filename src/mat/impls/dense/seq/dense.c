@@ -1125,6 +1125,75 @@ PetscErrorCode MatMultAdd_SeqDense(Mat A, Vec xx, Vec zz, Vec yy)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   z = y + A x, or z = A x when y is NULL, with dot = VecDot(w,z), or dot = (z,z) when w is NULL; the sum is local to A.
+   All columns but the last go through BLAS, the last one is applied in the same loop that adds y and accumulates the dot.
+   z may be y, w may be x but not z.
+*/
+PetscErrorCode MatMultAddDot_SeqDense(Mat A, Vec xx, Vec yy, Vec zz, Vec ww, PetscScalar *dot)
+{
+  Mat_SeqDense      *mat = (Mat_SeqDense *)A->data;
+  const PetscScalar *v   = mat->v, *x, *y = NULL, *w = NULL, *vl;
+  PetscScalar       *z, xl = 0.0, d = 0.0, _DOne = 1.0, _DZero = 0.0;
+  PetscBLASInt       m, n, n1, _One = 1;
+  PetscInt           i;
+
+  PetscFunctionBegin;
+  PetscCall(PetscBLASIntCast(A->rmap->n, &m));
+  PetscCall(PetscBLASIntCast(A->cmap->n, &n));
+  PetscCall(VecGetArrayRead(xx, &x));
+  if (ww) PetscCall(VecGetArrayRead(ww, &w));
+  if (yy && yy != zz) PetscCall(VecGetArrayRead(yy, &y));
+  PetscCall(VecGetArray(zz, &z));
+  if (yy == zz) y = z;
+  n1 = n > 1 ? n - 1 : 0;
+  vl = n ? v + (PetscInt)n1 * mat->lda : NULL;
+  if (n) xl = x[n1];
+  if (m && n1) {
+    if (y && y != z) {
+      PetscCallBLAS("BLASgemv", BLASgemv_("N", &m, &n1, &_DOne, v, &mat->lda, x, &_One, &_DZero, z, &_One));
+    } else {
+      PetscCallBLAS("BLASgemv", BLASgemv_("N", &m, &n1, &_DOne, v, &mat->lda, x, &_One, y ? &_DOne : &_DZero, z, &_One));
+      y = NULL; /* already added, or no y at all */
+    }
+  }
+  for (i = 0; i < m; i++) {
+    PetscScalar s = n1 ? z[i] : 0.0;
+
+    if (n) s += vl[i] * xl;
+    if (y) s += y[i];
+    z[i] = s;
+    d += (w ? w[i] : s) * PetscConj(s);
+  }
+  *dot = d;
+  PetscCall(PetscLogFlops(2.0 * A->rmap->n * A->cmap->n + 2.0 * A->rmap->n));
+  PetscCall(VecRestoreArray(zz, &z));
+  if (yy && yy != zz) PetscCall(VecRestoreArrayRead(yy, &y));
+  if (ww) PetscCall(VecRestoreArrayRead(ww, &w));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultDot_SeqDense(Mat A, Vec xx, Vec yy, Vec ww, PetscScalar *dot)
+{
+  PetscFunctionBegin;
+  if (A->ops->mult == MatMult_SeqDense) PetscCall(MatMultAddDot_SeqDense(A, xx, NULL, yy, ww, dot));
+  else PetscCall(MatMultDot_Basic(A, xx, yy, ww, dot));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultAddNorm_SeqDense(Mat A, Vec xx, Vec yy, Vec zz, PetscReal *norm)
+{
+  PetscScalar d;
+
+  PetscFunctionBegin;
+  if (A->ops->multadd == MatMultAdd_SeqDense) {
+    PetscCall(MatMultAddDot_SeqDense(A, xx, yy, zz, NULL, &d));
+    *norm = PetscSqrtReal(PetscRealPart(d));
+  } else PetscCall(MatMultAddNorm_Basic(A, xx, yy, zz, norm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatMultTransposeAdd_SeqDense(Mat A, Vec xx, Vec zz, Vec yy)
 {
   Mat_SeqDense      *mat = (Mat_SeqDense *)A->data;
@@ -3235,7 +3304,9 @@ static struct _MatOps MatOps_Values = {MatSetValues_SeqDense,
                                        NULL,
                                        NULL,
                                        /*150*/ NULL,
-                                       NULL};
+                                       NULL,
+                                       MatMultDot_SeqDense,
+                                       MatMultAddNorm_SeqDense};
 
 /*@C
   MatCreateSeqDense - Creates a `MATSEQDENSE` that
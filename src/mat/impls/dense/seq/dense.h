@@ -67,6 +67,9 @@ PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqDense(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqDense(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqDense(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMult_SeqDense(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultAddDot_SeqDense(Mat, Vec, Vec, Vec, Vec, PetscScalar *);
+PETSC_INTERN PetscErrorCode MatMultDot_SeqDense(Mat, Vec, Vec, Vec, PetscScalar *);
+PETSC_INTERN PetscErrorCode MatMultAddNorm_SeqDense(Mat, Vec, Vec, Vec, PetscReal *);
 PETSC_INTERN PetscErrorCode MatDuplicate_SeqDense(Mat, MatDuplicateOption, Mat *);
 PETSC_INTERN PetscErrorCode MatSeqDenseSetPreallocation_SeqDense(Mat, PetscScalar *);
 PETSC_INTERN PetscErrorCode MatCholeskyFactor_SeqDense(Mat, IS, const MatFactorInfo *);
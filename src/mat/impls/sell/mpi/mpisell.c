@@ -402,6 +402,56 @@ static PetscErrorCode MatMultAdd_MPISELL(Mat A, Vec xx, Vec yy, Vec zz)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* the off-diagonal part is added last, so the reduction is accumulated as it completes each entry of the result */
+static PetscErrorCode MatMultDot_MPISELL(Mat A, Vec xx, Vec yy, Vec ww, PetscScalar *dot)
+{
+  Mat_MPISELL *a = (Mat_MPISELL *)A->data;
+  PetscScalar  d;
+
+  PetscFunctionBegin;
+  if (A->ops->mult != MatMult_MPISELL) {
+    PetscCall(MatMultDot_Basic(A, xx, yy, ww, dot));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecScatterBegin(a->Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCall((*a->A->ops->mult)(a->A, xx, yy));
+  PetscCall(VecScatterEnd(a->Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  if (a->B->ops->multadd == MatMultAdd_SeqSELL) {
+    PetscCall(MatMultAddDot_SeqSELL(a->B, a->lvec, yy, yy, ww, &d));
+    PetscCall(MPIU_Allreduce(&d, dot, 1, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)A)));
+  } else {
+    PetscUseTypeMethod(a->B, multadd, a->lvec, yy, yy);
+    PetscCall(VecDot(ww, yy, dot));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAddNorm_MPISELL(Mat A, Vec xx, Vec yy, Vec zz, PetscReal *norm)
+{
+  Mat_MPISELL *a = (Mat_MPISELL *)A->data;
+  PetscScalar  d;
+  PetscReal    sum;
+
+  PetscFunctionBegin;
+  if (A->ops->multadd != MatMultAdd_MPISELL) {
+    PetscCall(MatMultAddNorm_Basic(A, xx, yy, zz, norm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecScatterBegin(a->Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCall((*a->A->ops->multadd)(a->A, xx, yy, zz));
+  PetscCall(VecScatterEnd(a->Mvctx, xx, a->lvec, INSERT_VALUES, SCATTER_FORWARD));
+  if (a->B->ops->multadd == MatMultAdd_SeqSELL) {
+    PetscCall(MatMultAddDot_SeqSELL(a->B, a->lvec, zz, zz, NULL, &d));
+    sum = PetscRealPart(d);
+    PetscCall(MPIU_Allreduce(&sum, norm, 1, MPIU_REAL, MPIU_SUM, PetscObjectComm((PetscObject)A)));
+    *norm = PetscSqrtReal(*norm);
+  } else {
+    PetscUseTypeMethod(a->B, multadd, a->lvec, zz, zz);
+    PetscCall(VecNorm(zz, NORM_2, norm));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode MatMultTranspose_MPISELL(Mat A, Vec xx, Vec yy)
 {
   Mat_MPISELL *a = (Mat_MPISELL *)A->data;
@@ -1249,7 +1299,9 @@ static const struct _MatOps MatOps_Values = {MatSetValues_MPISELL,
                                              NULL,
                                              NULL,
                                              /*150*/ NULL,
-                                             NULL};
+                                             NULL,
+                                             MatMultDot_MPISELL,
+                                             MatMultAddNorm_MPISELL};
 
 /*@C
   MatMPISELLSetPreallocation - Preallocates memory for a `MATMPISELL` sparse parallel matrix in sell format.
@@ -41,6 +41,44 @@ static const char citation[] = "@inproceedings{ZhangELLPACK2018,\n"
   #endif
 #endif /* PETSC_HAVE_IMMINTRIN_H */
 
+/*
+  For each row r of the slice stored in val[k0:k1) subtract from sum[r] the products with the entries whose column c satisfies
+  c < lo + r*dlo or c >= hi + r*dhi. Used by the triangular sweeps (SOR and MatSolve) for the entries that only involve
+  x[] values that do not change while the rows of the slice are processed, thus all the rows of the slice are handled at once.
+*/
+static inline void MatSeqSELLSliceSubtract_Private(const MatScalar *val, const PetscInt *colidx, PetscInt k0, PetscInt k1, PetscInt sliceheight, PetscInt lo, PetscInt dlo, PetscInt hi, PetscInt dhi, const PetscScalar *x, PetscScalar *sum)
+{
+  PetscInt k, r, c;
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+  __m512d  vec_x, vec_vals, vec_sum;
+  __m512i  vec_idx, vec_lo, vec_hi, vec_r;
+  __mmask8 mask;
+
+  if (sliceheight == 8) {
+    vec_r   = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 0, 0, 0, 0, 0, 0, 0, 0);
+    vec_lo  = _mm512_add_epi32(_mm512_set1_epi32(lo), _mm512_mullo_epi32(vec_r, _mm512_set1_epi32(dlo)));
+    vec_hi  = _mm512_add_epi32(_mm512_set1_epi32(hi), _mm512_mullo_epi32(vec_r, _mm512_set1_epi32(dhi)));
+    vec_sum = _mm512_loadu_pd(sum);
+    for (k = k0; k < k1; k += 8) {
+      vec_idx  = _mm512_castsi256_si512(_mm256_loadu_si256((__m256i const *)(colidx + k)));
+      mask     = (__mmask8)(_mm512_mask_cmplt_epi32_mask(0xFF, vec_idx, vec_lo) | _mm512_mask_cmpge_epi32_mask(0xFF, vec_idx, vec_hi));
+      vec_vals = _mm512_loadu_pd(val + k);
+      vec_x    = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, _mm512_castsi512_si256(vec_idx), x, _MM_SCALE_8);
+      vec_sum  = _mm512_mask3_fnmadd_pd(vec_vals, vec_x, vec_sum, mask);
+    }
+    _mm512_storeu_pd(sum, vec_sum);
+    return;
+  }
+#endif
+  for (k = k0; k < k1; k += sliceheight) {
+    PetscPragmaSIMD
+    for (r = 0; r < sliceheight; r++) {
+      c = colidx[k + r];
+      if (c < lo + r * dlo || c >= hi + r * dhi) sum[r] -= val[k + r] * x[c];
+    }
+  }
+}
+
 /*@C
   MatSeqSELLSetPreallocation - For good matrix assembly performance
   the user should preallocate the matrix storage by setting the parameter `nz`
@@ -708,6 +746,72 @@ PetscErrorCode MatMultAdd_SeqSELL(Mat A, Vec xx, Vec yy, Vec zz)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   z = y + A x, or z = A x when y is NULL, with dot = VecDot(w,z), or dot = (z,z) when w is NULL, accumulated as each
+   slice of z is completed; the sum is local to A. z may be y, w may be x but not z.
+*/
+PetscErrorCode MatMultAddDot_SeqSELL(Mat A, Vec xx, Vec yy, Vec zz, Vec ww, PetscScalar *dot)
+{
+  Mat_SeqSELL       *a = (Mat_SeqSELL *)A->data;
+  PetscScalar       *z, sum[32], d = 0.0;
+  const PetscScalar *x, *y = NULL, *w = NULL;
+  const MatScalar   *aval    = a->val;
+  const PetscInt    *acolidx = a->colidx;
+  PetscInt           sliceheight = a->sliceheight, m = A->rmap->n, i, j, jb, k, row, nrows, nb;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xx, &x));
+  if (ww) PetscCall(VecGetArrayRead(ww, &w));
+  if (yy && yy != zz) PetscCall(VecGetArrayRead(yy, &y));
+  PetscCall(VecGetArray(zz, &z));
+  if (yy == zz) y = z;
+  for (i = 0; i < a->totalslices; i++) {
+    /* the rows of a slice are processed together, at most 32 at a time, one column of the slice after the other */
+    for (jb = 0; jb < sliceheight; jb += 32) {
+      nb = PetscMin(32, sliceheight - jb);
+      PetscCall(PetscArrayzero(sum, nb));
+      for (k = a->sliidx[i] + jb; k < a->sliidx[i + 1]; k += sliceheight) {
+        PetscPragmaSIMD
+        for (j = 0; j < nb; j++) sum[j] += aval[k + j] * x[acolidx[k + j]];
+      }
+      row   = i * sliceheight + jb;
+      nrows = PetscMin(nb, m - row);
+      for (j = 0; j < nrows; j++) {
+        if (y) sum[j] += y[row + j];
+        z[row + j] = sum[j];
+        d += (w ? w[row + j] : sum[j]) * PetscConj(sum[j]);
+      }
+    }
+  }
+  *dot = d;
+  PetscCall(PetscLogFlops(2.0 * a->nz - (yy ? 0 : a->nonzerorowcnt) + 2.0 * m));
+  PetscCall(VecRestoreArray(zz, &z));
+  if (yy && yy != zz) PetscCall(VecRestoreArrayRead(yy, &y));
+  if (ww) PetscCall(VecRestoreArrayRead(ww, &w));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultDot_SeqSELL(Mat A, Vec xx, Vec yy, Vec ww, PetscScalar *dot)
+{
+  PetscFunctionBegin;
+  if (A->ops->mult == MatMult_SeqSELL) PetscCall(MatMultAddDot_SeqSELL(A, xx, NULL, yy, ww, dot));
+  else PetscCall(MatMultDot_Basic(A, xx, yy, ww, dot));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultAddNorm_SeqSELL(Mat A, Vec xx, Vec yy, Vec zz, PetscReal *norm)
+{
+  PetscScalar d;
+
+  PetscFunctionBegin;
+  if (A->ops->multadd == MatMultAdd_SeqSELL) {
+    PetscCall(MatMultAddDot_SeqSELL(A, xx, yy, zz, NULL, &d));
+    *norm = PetscSqrtReal(PetscRealPart(d));
+  } else PetscCall(MatMultAddNorm_Basic(A, xx, yy, zz, norm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A, Vec xx, Vec zz, Vec yy)
 {
   Mat_SeqSELL       *a = (Mat_SeqSELL *)A->data;
@@ -715,7 +819,13 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A, Vec xx, Vec zz, Vec yy)
   const PetscScalar *x;
   const MatScalar   *aval    = a->val;
   const PetscInt    *acolidx = a->colidx;
-  PetscInt           i, j, r, row, nnz_in_row, totalslices = a->totalslices, sliceheight = a->sliceheight;
+  PetscInt           i, j, r, nr, m = A->rmap->n, totalslices = a->totalslices, sliceheight = a->sliceheight;
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(__AVX512CD__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+  __m512d  vec_x, vec_y, vec_vals;
+  __m256i  vec_idx;
+  __m512i  vec_conflict;
+  __mmask8 mask;
+#endif
 
 #if defined(PETSC_HAVE_PRAGMA_DISJOINT)
   #pragma disjoint(*x, *y, *aval)
@@ -731,18 +841,34 @@ PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat A, Vec xx, Vec zz, Vec yy)
   if (a->nz) {
     PetscCall(VecGetArrayRead(xx, &x));
     PetscCall(VecGetArray(yy, &y));
-    for (i = 0; i < a->totalslices; i++) { /* loop over slices */
-      if (i == totalslices - 1 && (A->rmap->n % sliceheight)) {
-        for (r = 0; r < (A->rmap->n % sliceheight); ++r) {
-          row        = sliceheight * i + r;
-          nnz_in_row = a->rlen[row];
-          for (j = 0; j < nnz_in_row; ++j) y[acolidx[sliceheight * j + r]] += aval[sliceheight * j + r] * x[row];
+    /* the slices are traversed column by column so that val[] and colidx[] are streamed contiguously */
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX512F__) && defined(__AVX512CD__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+    PetscCheck(sliceheight == 8, PETSC_COMM_SELF, PETSC_ERR_SUP, "The kernel requires a slice height of 8, but the input matrix has a slice height of %" PetscInt_FMT, sliceheight);
+    for (i = 0; i < totalslices; i++) { /* loop over slices */
+      nr    = PetscMin(8, m - 8 * i);
+      mask  = (__mmask8)((1 << nr) - 1);
+      vec_x = _mm512_maskz_loadu_pd(mask, x + 8 * i);
+      for (j = a->sliidx[i]; j < a->sliidx[i + 1]; j += 8) {
+        vec_idx      = _mm256_loadu_si256((__m256i const *)(acolidx + j));
+        vec_conflict = _mm512_maskz_conflict_epi32(mask, _mm512_castsi256_si512(vec_idx));
+        if (_mm512_test_epi32_mask(vec_conflict, vec_conflict)) { /* several rows of the slice update the same entry of y */
+          for (r = 0; r < nr; r++) y[acolidx[j + r]] += aval[j + r] * x[8 * i + r];
+        } else {
+          vec_vals = _mm512_loadu_pd(aval + j);
+          vec_y    = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), mask, vec_idx, y, _MM_SCALE_8);
+          vec_y    = _mm512_fmadd_pd(vec_vals, vec_x, vec_y);
+          _mm512_mask_i32scatter_pd(y, mask, vec_idx, vec_y, _MM_SCALE_8);
         }
-        break;
       }
-      for (r = 0; r < sliceheight; ++r)
-        for (j = a->sliidx[i] + r; j < a->sliidx[i + 1]; j += sliceheight) y[acolidx[j]] += aval[j] * x[sliceheight * i + r];
     }
+#else
+    for (i = 0; i < totalslices; i++) { /* loop over slices */
+      nr = PetscMin(sliceheight, m - sliceheight * i);
+      for (j = a->sliidx[i]; j < a->sliidx[i + 1]; j += sliceheight) {
+        for (r = 0; r < nr; r++) y[acolidx[j + r]] += aval[j + r] * x[sliceheight * i + r];
+      }
+    }
+#endif
     PetscCall(PetscLogFlops(2.0 * a->nz));
     PetscCall(VecRestoreArrayRead(xx, &x));
     PetscCall(VecRestoreArray(yy, &y));
@@ -905,6 +1031,7 @@ PetscErrorCode MatDestroy_SeqSELL(Mat A)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatSeqSELLGetAvgSliceWidth_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatSeqSELLGetVarSliceSize_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatSeqSELLSetSliceHeight_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatFactorGetSolverType_C", NULL));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1685,14 +1812,19 @@ PetscErrorCode MatShift_SeqSELL(Mat Y, PetscScalar a)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  The sweeps process one slice at a time: the couplings to rows outside the current slice only involve x[] values that are
+  not modified while the rows of the slice are updated, so they are accumulated for all the rows of the slice at once
+  (see MatSeqSELLSliceSubtract_Private()); only the couplings inside the diagonal block of the slice are applied row by row.
+*/
 PetscErrorCode MatSOR_SeqSELL(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
 {
   Mat_SeqSELL       *a = (Mat_SeqSELL *)A->data;
-  PetscScalar       *x, sum, *t;
-  const MatScalar   *idiag = NULL, *mdiag;
+  PetscScalar       *x, *t, *sum, *usum;
+  const MatScalar   *idiag = NULL, *mdiag, *val = a->val;
   const PetscScalar *b, *xb;
-  PetscInt           n, m = A->rmap->n, i, j, shift;
-  const PetscInt    *diag;
+  PetscInt           m = A->rmap->n, s, r, j, row, row0, nr, jend, totalslices = a->totalslices, sliceheight = a->sliceheight;
+  const PetscInt    *diag, *colidx = a->colidx, *sliidx = a->sliidx, *rlen = a->rlen;
 
   PetscFunctionBegin;
   its = its * lits;
@@ -1713,30 +1845,40 @@ PetscErrorCode MatSOR_SeqSELL(Mat A, Vec bb, PetscReal omega, MatSORType flag, P
   PetscCheck(flag != SOR_APPLY_UPPER, PETSC_COMM_SELF, PETSC_ERR_SUP, "SOR_APPLY_UPPER is not implemented");
   PetscCheck(flag != SOR_APPLY_LOWER, PETSC_COMM_SELF, PETSC_ERR_SUP, "SOR_APPLY_LOWER is not implemented");
   PetscCheck(!(flag & SOR_EISENSTAT), PETSC_COMM_SELF, PETSC_ERR_SUP, "No support yet for Eisenstat");
+  PetscCall(PetscMalloc2(sliceheight, &sum, sliceheight, &usum));
 
   if (flag & SOR_ZERO_INITIAL_GUESS) {
     if ((flag & SOR_FORWARD_SWEEP) || (flag & SOR_LOCAL_FORWARD_SWEEP)) {
-      for (i = 0; i < m; i++) {
-        shift = a->sliidx[i / a->sliceheight] + i % a->sliceheight; /* starting index of the row i */
-        sum   = b[i];
-        n     = (diag[i] - shift) / a->sliceheight;
-        for (j = 0; j < n; j++) sum -= a->val[shift + a->sliceheight * j] * x[a->colidx[shift + a->sliceheight * j]];
-        t[i] = sum;
-        x[i] = sum * idiag[i];
+      for (s = 0; s < totalslices; s++) {
+        row0 = sliceheight * s;
+        nr   = PetscMin(sliceheight, m - row0);
+        for (r = 0; r < sliceheight; r++) sum[r] = r < nr ? b[row0 + r] : 0.0;
+        MatSeqSELLSliceSubtract_Private(val, colidx, sliidx[s], sliidx[s + 1], sliceheight, row0, 0, PETSC_MAX_INT, 0, x, sum); /* columns before the slice */
+        for (r = 0; r < nr; r++) {
+          row = row0 + r;
+          for (j = diag[row] - sliceheight; j >= sliidx[s] && colidx[j] >= row0; j -= sliceheight) sum[r] -= val[j] * x[colidx[j]];
+          t[row] = sum[r];
+          x[row] = sum[r] * idiag[row];
+        }
       }
       xb = t;
       PetscCall(PetscLogFlops(a->nz));
     } else xb = b;
     if ((flag & SOR_BACKWARD_SWEEP) || (flag & SOR_LOCAL_BACKWARD_SWEEP)) {
-      for (i = m - 1; i >= 0; i--) {
-        shift = a->sliidx[i / a->sliceheight] + i % a->sliceheight; /* starting index of the row i */
-        sum   = xb[i];
-        n     = a->rlen[i] - (diag[i] - shift) / a->sliceheight - 1;
-        for (j = 1; j <= n; j++) sum -= a->val[diag[i] + a->sliceheight * j] * x[a->colidx[diag[i] + a->sliceheight * j]];
-        if (xb == b) {
-          x[i] = sum * idiag[i];
-        } else {
-          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+      for (s = totalslices - 1; s >= 0; s--) {
+        row0 = sliceheight * s;
+        nr   = PetscMin(sliceheight, m - row0);
+        for (r = 0; r < sliceheight; r++) sum[r] = r < nr ? xb[row0 + r] : 0.0;
+        MatSeqSELLSliceSubtract_Private(val, colidx, sliidx[s], sliidx[s + 1], sliceheight, 0, 0, row0 + sliceheight, 0, x, sum); /* columns after the slice */
+        for (r = nr - 1; r >= 0; r--) {
+          row  = row0 + r;
+          jend = sliidx[s] + r + sliceheight * rlen[row];
+          for (j = diag[row] + sliceheight; j < jend && colidx[j] < row0 + sliceheight; j += sliceheight) sum[r] -= val[j] * x[colidx[j]];
+          if (xb == b) {
+            x[row] = sum[r] * idiag[row];
+          } else {
+            x[row] = (1. - omega) * x[row] + sum[r] * idiag[row]; /* omega in idiag */
+          }
         }
       }
       PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
@@ -1745,34 +1887,45 @@ PetscErrorCode MatSOR_SeqSELL(Mat A, Vec bb, PetscReal omega, MatSORType flag, P
   }
   while (its--) {
     if ((flag & SOR_FORWARD_SWEEP) || (flag & SOR_LOCAL_FORWARD_SWEEP)) {
-      for (i = 0; i < m; i++) {
-        /* lower */
-        shift = a->sliidx[i / a->sliceheight] + i % a->sliceheight; /* starting index of the row i */
-        sum   = b[i];
-        n     = (diag[i] - shift) / a->sliceheight;
-        for (j = 0; j < n; j++) sum -= a->val[shift + a->sliceheight * j] * x[a->colidx[shift + a->sliceheight * j]];
-        t[i] = sum; /* save application of the lower-triangular part */
-        /* upper */
-        n = a->rlen[i] - (diag[i] - shift) / a->sliceheight - 1;
-        for (j = 1; j <= n; j++) sum -= a->val[diag[i] + a->sliceheight * j] * x[a->colidx[diag[i] + a->sliceheight * j]];
-        x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+      for (s = 0; s < totalslices; s++) {
+        row0 = sliceheight * s;
+        nr   = PetscMin(sliceheight, m - row0);
+        for (r = 0; r < sliceheight; r++) {
+          sum[r]  = r < nr ? b[row0 + r] : 0.0;
+          usum[r] = 0.0;
+        }
+        MatSeqSELLSliceSubtract_Private(val, colidx, sliidx[s], sliidx[s + 1], sliceheight, row0, 0, PETSC_MAX_INT, 0, x, sum); /* lower, columns before the slice */
+        MatSeqSELLSliceSubtract_Private(val, colidx, sliidx[s], sliidx[s + 1], sliceheight, 0, 0, row0 + 1, 1, x, usum);        /* upper */
+        for (r = 0; r < nr; r++) {
+          row = row0 + r;
+          for (j = diag[row] - sliceheight; j >= sliidx[s] && colidx[j] >= row0; j -= sliceheight) sum[r] -= val[j] * x[colidx[j]];
+          t[row] = sum[r]; /* save application of the lower-triangular part */
+          x[row] = (1. - omega) * x[row] + (sum[r] + usum[r]) * idiag[row];
+        }
       }
       xb = t;
       PetscCall(PetscLogFlops(2.0 * a->nz));
     } else xb = b;
     if ((flag & SOR_BACKWARD_SWEEP) || (flag & SOR_LOCAL_BACKWARD_SWEEP)) {
-      for (i = m - 1; i >= 0; i--) {
-        shift = a->sliidx[i / a->sliceheight] + i % a->sliceheight; /* starting index of the row i */
-        sum   = xb[i];
+      for (s = totalslices - 1; s >= 0; s--) {
+        row0 = sliceheight * s;
+        nr   = PetscMin(sliceheight, m - row0);
+        for (r = 0; r < sliceheight; r++) sum[r] = r < nr ? xb[row0 + r] : 0.0;
         if (xb == b) {
-          /* whole matrix (no checkpointing available) */
-          n = a->rlen[i];
-          for (j = 0; j < n; j++) sum -= a->val[shift + a->sliceheight * j] * x[a->colidx[shift + a->sliceheight * j]];
-          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
+          /* whole matrix (no checkpointing available), the diagonal is applied with the current x and corrected below */
+          MatSeqSELLSliceSubtract_Private(val, colidx, sliidx[s], sliidx[s + 1], sliceheight, row0 + 1, 1, row0 + sliceheight, 0, x, sum);
         } else { /* lower-triangular part has been saved, so only apply upper-triangular */
-          n = a->rlen[i] - (diag[i] - shift) / a->sliceheight - 1;
-          for (j = 1; j <= n; j++) sum -= a->val[diag[i] + a->sliceheight * j] * x[a->colidx[diag[i] + a->sliceheight * j]];
-          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+          MatSeqSELLSliceSubtract_Private(val, colidx, sliidx[s], sliidx[s + 1], sliceheight, 0, 0, row0 + sliceheight, 0, x, sum);
+        }
+        for (r = nr - 1; r >= 0; r--) {
+          row  = row0 + r;
+          jend = sliidx[s] + r + sliceheight * rlen[row];
+          for (j = diag[row] + sliceheight; j < jend && colidx[j] < row0 + sliceheight; j += sliceheight) sum[r] -= val[j] * x[colidx[j]];
+          if (xb == b) {
+            x[row] = (1. - omega) * x[row] + (sum[r] + mdiag[row] * x[row]) * idiag[row];
+          } else {
+            x[row] = (1. - omega) * x[row] + sum[r] * idiag[row]; /* omega in idiag */
+          }
         }
       }
       if (xb == b) {
@@ -1782,6 +1935,7 @@ PetscErrorCode MatSOR_SeqSELL(Mat A, Vec bb, PetscReal omega, MatSORType flag, P
       }
     }
   }
+  PetscCall(PetscFree2(sum, usum));
   PetscCall(VecRestoreArray(xx, &x));
   PetscCall(VecRestoreArrayRead(bb, &b));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1938,7 +2092,9 @@ static struct _MatOps MatOps_Values = {MatSetValues_SeqSELL,
                                        NULL,
                                        NULL,
                                        /*150*/ NULL,
-                                       NULL};
+                                       NULL,
+                                       MatMultDot_SeqSELL,
+                                       MatMultAddNorm_SeqSELL};
 
 static PetscErrorCode MatStoreValues_SeqSELL(Mat mat)
 {
@@ -2242,10 +2398,12 @@ static PetscErrorCode MatDuplicateNoCreate_SeqSELL(Mat C, Mat A, MatDuplicateOpt
   PetscCall(PetscLayoutReference(A->rmap, &C->rmap));
   PetscCall(PetscLayoutReference(A->cmap, &C->cmap));
 
+  c->sliceheight = a->sliceheight;
+  c->totalslices = totalslices;
   PetscCall(PetscMalloc1(a->sliceheight * totalslices, &c->rlen));
   PetscCall(PetscMalloc1(totalslices + 1, &c->sliidx));
 
-  for (i = 0; i < m; i++) c->rlen[i] = a->rlen[i];
+  for (i = 0; i < a->sliceheight * totalslices; i++) c->rlen[i] = a->rlen[i];
   for (i = 0; i < totalslices + 1; i++) c->sliidx[i] = a->sliidx[i];
 
   /* allocate the matrix space */
@@ -2304,6 +2462,161 @@ PetscErrorCode MatDuplicate_SeqSELL(Mat A, MatDuplicateOption cpvalues, Mat *B)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  ILU(0) in the natural ordering: the factor has exactly the nonzero structure of the matrix, so it is stored as a
+  SELL matrix sharing the slice layout of the original matrix. The strictly lower triangular part holds L (with unit
+  diagonal), the upper triangular part holds U and the diagonal entries hold the inverses of the pivots.
+*/
+static PetscErrorCode MatSolve_SeqSELL(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqSELL       *a      = (Mat_SeqSELL *)A->data;
+  const MatScalar   *val    = a->val;
+  const PetscInt    *colidx = a->colidx, *sliidx = a->sliidx, *rlen = a->rlen, *diag = a->diag;
+  PetscInt           m      = A->rmap->n, s, r, j, row, row0, nr, jend, totalslices = a->totalslices, sliceheight = a->sliceheight;
+  PetscScalar       *x, *sum;
+  const PetscScalar *b;
+
+  PetscFunctionBegin;
+  if (!m) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  PetscCall(PetscMalloc1(sliceheight, &sum));
+
+  /* forward solve the lower triangular part */
+  for (s = 0; s < totalslices; s++) {
+    row0 = sliceheight * s;
+    nr   = PetscMin(sliceheight, m - row0);
+    for (r = 0; r < sliceheight; r++) sum[r] = r < nr ? b[row0 + r] : 0.0;
+    MatSeqSELLSliceSubtract_Private(val, colidx, sliidx[s], sliidx[s + 1], sliceheight, row0, 0, PETSC_MAX_INT, 0, x, sum);
+    for (r = 0; r < nr; r++) {
+      row = row0 + r;
+      for (j = diag[row] - sliceheight; j >= sliidx[s] && colidx[j] >= row0; j -= sliceheight) sum[r] -= val[j] * x[colidx[j]];
+      x[row] = sum[r];
+    }
+  }
+  /* backward solve the upper triangular part */
+  for (s = totalslices - 1; s >= 0; s--) {
+    row0 = sliceheight * s;
+    nr   = PetscMin(sliceheight, m - row0);
+    for (r = 0; r < sliceheight; r++) sum[r] = r < nr ? x[row0 + r] : 0.0;
+    MatSeqSELLSliceSubtract_Private(val, colidx, sliidx[s], sliidx[s + 1], sliceheight, 0, 0, row0 + sliceheight, 0, x, sum);
+    for (r = nr - 1; r >= 0; r--) {
+      row  = row0 + r;
+      jend = sliidx[s] + r + sliceheight * rlen[row];
+      for (j = diag[row] + sliceheight; j < jend && colidx[j] < row0 + sliceheight; j += sliceheight) sum[r] -= val[j] * x[colidx[j]];
+      x[row] = sum[r] * val[diag[row]];
+    }
+  }
+  PetscCall(PetscFree(sum));
+  PetscCall(PetscLogFlops(2.0 * a->nz - m));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatLUFactorNumeric_SeqSELL(Mat B, Mat A, const MatFactorInfo *info)
+{
+  Mat_SeqSELL    *b = (Mat_SeqSELL *)B->data, *a = (Mat_SeqSELL *)A->data;
+  MatScalar      *val;
+  PetscScalar     mult;
+  PetscInt        m = A->rmap->n, i, k, p, q, col, shift, qend, *jmap, sliceheight = b->sliceheight;
+  const PetscInt *colidx, *diag, *rlen;
+
+  PetscFunctionBegin;
+  PetscCheck(B->nonzerostate == A->nonzerostate, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "The nonzero structure of the matrix has changed since the symbolic factorization");
+  PetscCall(PetscArraycpy(b->val, a->val, a->sliidx[a->totalslices]));
+  val    = b->val;
+  colidx = b->colidx;
+  diag   = b->diag;
+  rlen   = b->rlen;
+
+  B->factorerrortype = MAT_FACTOR_NOERROR;
+  PetscCall(PetscMalloc1(A->cmap->n, &jmap));
+  for (i = 0; i < A->cmap->n; i++) jmap[i] = -1;
+  for (i = 0; i < m; i++) {
+    shift = b->sliidx[i / sliceheight] + i % sliceheight; /* starting index of the row i */
+    for (k = 0; k < rlen[i]; k++) jmap[colidx[shift + sliceheight * k]] = shift + sliceheight * k;
+    /* eliminate with the previous rows, their pivots are already inverted */
+    for (p = shift; p < diag[i]; p += sliceheight) {
+      col    = colidx[p];
+      mult   = val[p] * val[diag[col]];
+      val[p] = mult;
+      if (mult == (PetscScalar)0.0) continue;
+      qend = b->sliidx[col / sliceheight] + col % sliceheight + sliceheight * rlen[col];
+      for (q = diag[col] + sliceheight; q < qend; q += sliceheight) {
+        if (jmap[colidx[q]] >= 0) val[jmap[colidx[q]]] -= mult * val[q];
+      }
+    }
+    if (PetscAbsScalar(val[diag[i]]) <= info->zeropivot) {
+      PetscCheck(!A->erroriffailure, PETSC_COMM_SELF, PETSC_ERR_MAT_LU_ZRPVT, "Zero pivot row %" PetscInt_FMT " value %g tolerance %g", i, (double)PetscAbsScalar(val[diag[i]]), (double)info->zeropivot);
+      PetscCall(PetscInfo(A, "Zero pivot row %" PetscInt_FMT " value %g tolerance %g\n", i, (double)PetscAbsScalar(val[diag[i]]), (double)info->zeropivot));
+      B->factorerrortype             = MAT_FACTOR_NUMERIC_ZEROPIVOT;
+      B->factorerror_zeropivot_value = PetscAbsScalar(val[diag[i]]);
+      B->factorerror_zeropivot_row   = i;
+      break;
+    }
+    val[diag[i]] = 1.0 / val[diag[i]];
+    for (k = 0; k < rlen[i]; k++) jmap[colidx[shift + sliceheight * k]] = -1;
+  }
+  PetscCall(PetscFree(jmap));
+
+  B->ops->solve   = MatSolve_SeqSELL;
+  B->assembled    = PETSC_TRUE;
+  B->preallocated = PETSC_TRUE;
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatILUFactorSymbolic_SeqSELL(Mat B, Mat A, IS isrow, IS iscol, const MatFactorInfo *info)
+{
+  PetscBool row_identity = PETSC_TRUE, col_identity = PETSC_TRUE, missing;
+  PetscInt  d;
+
+  PetscFunctionBegin;
+  PetscCheck(A->rmap->n == A->cmap->n, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Matrix must be square");
+  PetscCheck(!(PetscInt)info->levels, PETSC_COMM_SELF, PETSC_ERR_SUP, "Only ILU(0) is supported for MATSEQSELL, convert to MATSEQAIJ for more levels of fill");
+  PetscCheck(info->shifttype == (PetscReal)MAT_SHIFT_NONE || info->shifttype == (PetscReal)MAT_SHIFT_INBLOCKS, PETSC_COMM_SELF, PETSC_ERR_SUP, "Shifts are not supported for MATSEQSELL");
+  if (isrow) PetscCall(ISIdentity(isrow, &row_identity));
+  if (iscol) PetscCall(ISIdentity(iscol, &col_identity));
+  PetscCheck(row_identity && col_identity, PETSC_COMM_SELF, PETSC_ERR_SUP, "Only the natural ordering is supported for MATSEQSELL");
+  PetscCall(MatMissingDiagonal(A, &missing, &d));
+  PetscCheck(!missing, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Matrix is missing diagonal entry %" PetscInt_FMT, d);
+
+  PetscCall(MatDuplicateNoCreate_SeqSELL(B, A, MAT_DO_NOT_COPY_VALUES, PETSC_TRUE));
+  B->factortype             = MAT_FACTOR_ILU;
+  B->info.factor_mallocs    = 0;
+  B->info.fill_ratio_given  = info->fill;
+  B->info.fill_ratio_needed = 1.0;
+  B->ops->lufactornumeric   = MatLUFactorNumeric_SeqSELL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatFactorGetSolverType_seqsell_petsc(Mat A, MatSolverType *type)
+{
+  PetscFunctionBegin;
+  *type = MATSOLVERPETSC;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatGetFactor_seqsell_petsc(Mat A, MatFactorType ftype, Mat *B)
+{
+  PetscInt n = A->rmap->n;
+
+  PetscFunctionBegin;
+  PetscCheck(ftype == MAT_FACTOR_ILU, PETSC_COMM_SELF, PETSC_ERR_SUP, "Factor type not supported, MATSEQSELL only provides ILU(0)");
+  PetscCall(MatCreate(PetscObjectComm((PetscObject)A), B));
+  PetscCall(MatSetSizes(*B, n, n, n, n));
+  PetscCall(MatSetType(*B, MATSEQSELL));
+  (*B)->ops->ilufactorsymbolic = MatILUFactorSymbolic_SeqSELL;
+  (*B)->factortype             = ftype;
+  (*B)->canuseordering         = PETSC_FALSE;
+
+  PetscCall(PetscFree((*B)->solvertype));
+  PetscCall(PetscStrallocpy(MATSOLVERPETSC, &(*B)->solvertype));
+  PetscCall(PetscObjectComposeFunction((PetscObject)*B, "MatFactorGetSolverType_C", MatFactorGetSolverType_seqsell_petsc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*MC
    MATSEQSELL - MATSEQSELL = "seqsell" - A matrix type to be used for sequential sparse matrices,
    based on the sliced Ellpack format
@@ -191,6 +191,9 @@ static inline PetscErrorCode MatSeqXSELLFreeSELL(Mat AA, MatScalar **val, PetscI
 PETSC_INTERN PetscErrorCode MatSeqSELLSetPreallocation_SeqSELL(Mat, PetscInt, const PetscInt[]);
 PETSC_INTERN PetscErrorCode MatMult_SeqSELL(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqSELL(Mat, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultAddDot_SeqSELL(Mat, Vec, Vec, Vec, Vec, PetscScalar *);
+PETSC_INTERN PetscErrorCode MatMultDot_SeqSELL(Mat, Vec, Vec, Vec, PetscScalar *);
+PETSC_INTERN PetscErrorCode MatMultAddNorm_SeqSELL(Mat, Vec, Vec, Vec, PetscReal *);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqSELL(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqSELL(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMissingDiagonal_SeqSELL(Mat, PetscBool *, PetscInt *);
@@ -39,6 +39,12 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJPERM(Mat);
 
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSELL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSELL(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJFloat(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJFloat(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJDelta(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJDelta(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqVBAIJ(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIVBAIJ(Mat);
 
 #if defined(PETSC_HAVE_MKL_SPARSE)
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMKL(Mat);
@@ -152,6 +158,18 @@ PetscErrorCode MatRegisterAll(void)
   PetscCall(MatRegister(MATMPIAIJSELL, MatCreate_MPIAIJSELL));
   PetscCall(MatRegister(MATSEQAIJSELL, MatCreate_SeqAIJSELL));
 
+  PetscCall(MatRegisterRootName(MATAIJFLOAT, MATSEQAIJFLOAT, MATMPIAIJFLOAT));
+  PetscCall(MatRegister(MATMPIAIJFLOAT, MatCreate_MPIAIJFloat));
+  PetscCall(MatRegister(MATSEQAIJFLOAT, MatCreate_SeqAIJFloat));
+
+  PetscCall(MatRegisterRootName(MATAIJDELTA, MATSEQAIJDELTA, MATMPIAIJDELTA));
+  PetscCall(MatRegister(MATMPIAIJDELTA, MatCreate_MPIAIJDelta));
+  PetscCall(MatRegister(MATSEQAIJDELTA, MatCreate_SeqAIJDelta));
+
+  PetscCall(MatRegisterRootName(MATVBAIJ, MATSEQVBAIJ, MATMPIVBAIJ));
+  PetscCall(MatRegister(MATMPIVBAIJ, MatCreate_MPIVBAIJ));
+  PetscCall(MatRegister(MATSEQVBAIJ, MatCreate_SeqVBAIJ));
+
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(MatRegisterRootName(MATAIJMKL, MATSEQAIJMKL, MATMPIAIJMKL));
   PetscCall(MatRegister(MATMPIAIJMKL, MatCreate_MPIAIJMKL));
@@ -7,6 +7,7 @@
 #include <petsc/private/matimpl.h> /*I "petscmat.h" I*/
 #include <petsc/private/isimpl.h>
 #include <petsc/private/vecimpl.h>
+#include <petscsf.h>
 
 /* Logging support */
 PetscClassId MAT_CLASSID;
@@ -14,7 +15,7 @@ PetscClassId MAT_COLORING_CLASSID;
 PetscClassId MAT_FDCOLORING_CLASSID;
 PetscClassId MAT_TRANSPOSECOLORING_CLASSID;
 
-PetscLogEvent MAT_Mult, MAT_MultAdd, MAT_MultTranspose;
+PetscLogEvent MAT_Mult, MAT_MultAdd, MAT_MultTranspose, MAT_MultDot, MAT_MultAddNorm, MAT_MatrixPowers;
 PetscLogEvent MAT_MultTransposeAdd, MAT_Solve, MAT_Solves, MAT_SolveAdd, MAT_SolveTranspose, MAT_MatSolve, MAT_MatTrSolve;
 PetscLogEvent MAT_SolveTransposeAdd, MAT_SOR, MAT_ForwardSolve, MAT_BackwardSolve, MAT_LUFactor, MAT_LUFactorSymbolic;
 PetscLogEvent MAT_LUFactorNumeric, MAT_CholeskyFactor, MAT_CholeskyFactorSymbolic, MAT_CholeskyFactorNumeric, MAT_ILUFactor;
@@ -2784,6 +2785,296 @@ PetscErrorCode MatMultAdd(Mat mat, Vec v1, Vec v2, Vec v3)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   The unfused versions, used by the implementations when the matrix-vector product kernel they fuse with is not the one in use
+*/
+PetscErrorCode MatMultDot_Basic(Mat mat, Vec x, Vec y, Vec w, PetscScalar *dot)
+{
+  PetscFunctionBegin;
+  PetscUseTypeMethod(mat, mult, x, y);
+  PetscCall(VecDot(w, y, dot));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultAddNorm_Basic(Mat mat, Vec v1, Vec v2, Vec v3, PetscReal *norm)
+{
+  PetscFunctionBegin;
+  PetscUseTypeMethod(mat, multadd, v1, v2, v3);
+  PetscCall(VecNorm(v3, NORM_2, norm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  MatMultDot - Computes the matrix-vector product y = A * x together with the inner product `VecDot`(w,y)
+
+  Neighbor-wise Collective
+
+  Input Parameters:
++ mat - the matrix
+. x   - the vector to be multiplied
+- w   - the vector the result is dotted with, it may be `x`
+
+  Output Parameters:
++ y   - the result
+- dot - the inner product `VecDot`(w,y)
+
+  Level: intermediate
+
+  Notes:
+  For the matrix types that provide it the inner product is accumulated while each entry of `y` is computed, which saves
+  reading `y` again as a separate `VecDot()` after `MatMult()` does; the other types compute `MatMult()` followed by `VecDot()`.
+
+  The vectors `x` and `y` cannot be the same, neither can `w` and `y`.
+
+  Since the inner product is computed as the entries of `y` are, a different order of summation than `VecDot()` may be used,
+  so the result can differ from that of `MatMult()` followed by `VecDot()` by rounding.
+
+  The time and flops of `MatMultDot()` are logged under its own event, so `-log_view` reports them as `MatMultDot`, not as `MatMult`.
+
+.seealso: [](ch_matrices), `Mat`, `MatMult()`, `VecDot()`, `MatMultAddNorm()`
+@*/
+PetscErrorCode MatMultDot(Mat mat, Vec x, Vec y, Vec w, PetscScalar *dot)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat, MAT_CLASSID, 1);
+  PetscValidType(mat, 1);
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 2);
+  VecCheckAssembled(x);
+  PetscValidHeaderSpecific(y, VEC_CLASSID, 3);
+  PetscValidHeaderSpecific(w, VEC_CLASSID, 4);
+  PetscAssertPointer(dot, 5);
+  PetscCheck(mat->assembled, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for unassembled matrix");
+  PetscCheck(!mat->factortype, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for factored matrix");
+  PetscCheck(x != y, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_IDN, "x and y must be different vectors");
+  PetscCheck(w != y, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_IDN, "w and y must be different vectors");
+  PetscCheck(mat->cmap->N == x->map->N, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_SIZ, "Mat mat,Vec x: global dim %" PetscInt_FMT " %" PetscInt_FMT, mat->cmap->N, x->map->N);
+  PetscCheck(mat->rmap->N == y->map->N, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_SIZ, "Mat mat,Vec y: global dim %" PetscInt_FMT " %" PetscInt_FMT, mat->rmap->N, y->map->N);
+  PetscCheck(mat->cmap->n == x->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec x: local dim %" PetscInt_FMT " %" PetscInt_FMT, mat->cmap->n, x->map->n);
+  PetscCheck(mat->rmap->n == y->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec y: local dim %" PetscInt_FMT " %" PetscInt_FMT, mat->rmap->n, y->map->n);
+  PetscCheck(mat->rmap->n == w->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec w: local dim %" PetscInt_FMT " %" PetscInt_FMT, mat->rmap->n, w->map->n);
+  PetscCall(VecSetErrorIfLocked(y, 3));
+  if (mat->erroriffailure) PetscCall(VecValidValues_Internal(x, 2, PETSC_TRUE));
+  MatCheckPreallocated(mat, 1);
+
+  PetscCall(VecLockReadPush(x));
+  PetscCall(VecLockReadPush(w));
+  PetscCall(PetscLogEventBegin(MAT_MultDot, mat, x, y, w));
+  if (mat->ops->multdot) PetscUseTypeMethod(mat, multdot, x, y, w, dot);
+  else PetscCall(MatMultDot_Basic(mat, x, y, w, dot));
+  PetscCall(PetscLogEventEnd(MAT_MultDot, mat, x, y, w));
+  if (mat->erroriffailure) PetscCall(VecValidValues_Internal(y, 3, PETSC_FALSE));
+  PetscCall(VecLockReadPop(w));
+  PetscCall(VecLockReadPop(x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  MatMultAddNorm - Computes v3 = v2 + A * v1 together with the 2-norm of v3
+
+  Neighbor-wise Collective
+
+  Input Parameters:
++ mat - the matrix
+. v1  - the vector to be multiplied by `mat`
+- v2  - the vector to be added to the result
+
+  Output Parameters:
++ v3   - the result
+- norm - the 2-norm of `v3`
+
+  Level: intermediate
+
+  Notes:
+  For the matrix types that provide it the norm is accumulated while each entry of `v3` is computed, which saves reading `v3`
+  again as a separate `VecNorm()` after `MatMultAdd()` does; the other types compute `MatMultAdd()` followed by `VecNorm()`.
+
+  The vectors `v1` and `v3` cannot be the same.
+
+  The time and flops of `MatMultAddNorm()` are logged under its own event, so `-log_view` reports them as `MatMultAddNorm`, not as `MatMultAdd`.
+
+.seealso: [](ch_matrices), `Mat`, `MatMultAdd()`, `VecNorm()`, `MatMultDot()`
+@*/
+PetscErrorCode MatMultAddNorm(Mat mat, Vec v1, Vec v2, Vec v3, PetscReal *norm)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat, MAT_CLASSID, 1);
+  PetscValidType(mat, 1);
+  PetscValidHeaderSpecific(v1, VEC_CLASSID, 2);
+  PetscValidHeaderSpecific(v2, VEC_CLASSID, 3);
+  PetscValidHeaderSpecific(v3, VEC_CLASSID, 4);
+  PetscAssertPointer(norm, 5);
+  PetscCheck(mat->assembled, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for unassembled matrix");
+  PetscCheck(!mat->factortype, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for factored matrix");
+  PetscCheck(mat->cmap->N == v1->map->N, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_SIZ, "Mat mat,Vec v1: global dim %" PetscInt_FMT " %" PetscInt_FMT, mat->cmap->N, v1->map->N);
+  PetscCheck(mat->rmap->n == v3->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec v3: local dim %" PetscInt_FMT " %" PetscInt_FMT, mat->rmap->n, v3->map->n);
+  PetscCheck(mat->rmap->n == v2->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec v2: local dim %" PetscInt_FMT " %" PetscInt_FMT, mat->rmap->n, v2->map->n);
+  PetscCheck(v1 != v3, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_IDN, "v1 and v3 must be different vectors");
+  MatCheckPreallocated(mat, 1);
+
+  PetscCall(PetscLogEventBegin(MAT_MultAddNorm, mat, v1, v2, v3));
+  PetscCall(VecLockReadPush(v1));
+  if (mat->ops->multaddnorm) PetscUseTypeMethod(mat, multaddnorm, v1, v2, v3, norm);
+  else PetscCall(MatMultAddNorm_Basic(mat, v1, v2, v3, norm));
+  PetscCall(VecLockReadPop(v1));
+  PetscCall(PetscLogEventEnd(MAT_MultAddNorm, mat, v1, v2, v3));
+  PetscCall(PetscObjectStateIncrease((PetscObject)v3));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  MatGetMatrixPowers_Private - Gets the ghost region of depth at least k of the local rows of a matrix, or NULL if the matrix
+  type does not provide one; the region is owned by the matrix and kept up to date with its values
+*/
+PetscErrorCode MatGetMatrixPowers_Private(Mat mat, PetscInt k, Mat_MatrixPowers **mpk)
+{
+  PetscErrorCode (*f)(Mat, PetscInt, Mat_MatrixPowers **);
+
+  PetscFunctionBegin;
+  *mpk = NULL;
+  PetscCall(PetscObjectQueryFunction((PetscObject)mat, "MatGetMatrixPowers_C", &f));
+  if (f) PetscCall((*f)(mat, k, mpk));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  MatMatrixPowersGetSF_Private - Gets the star forest that exchanges the ghost entries within distance l <= k of the region,
+  so that a region deeper than needed only sends the entries that are used; collective when l < k and it is not created yet
+*/
+PetscErrorCode MatMatrixPowersGetSF_Private(Mat_MatrixPowers *mpk, PetscInt l, PetscSF *sf)
+{
+  PetscFunctionBegin;
+  PetscCheck(l > 0 && l <= mpk->k, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Distance %" PetscInt_FMT " not in [1, %" PetscInt_FMT "]", l, mpk->k);
+  if (l == mpk->k) {
+    *sf = mpk->sf;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (!mpk->sfl[l]) {
+    PetscInt nsel = mpk->nlevel[l] - mpk->nlevel[0], *sel;
+
+    /* the leaves of sf are the ghost entries in the order of the region, so the closest ones come first */
+    PetscCall(PetscMalloc1(nsel, &sel));
+    for (PetscInt i = 0; i < nsel; i++) sel[i] = i;
+    PetscCall(PetscSFCreateEmbeddedLeafSF(mpk->sf, nsel, sel, &mpk->sfl[l]));
+    PetscCall(PetscFree(sel));
+  }
+  *sf = mpk->sfl[l];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  MatMatrixPowersMult_Private - Computes y = A x on the first m rows of the region, x must be valid on all the entries these rows use
+*/
+PetscErrorCode MatMatrixPowersMult_Private(Mat_MatrixPowers *mpk, PetscInt m, const PetscScalar *x, PetscScalar *y)
+{
+  const PetscInt  *ai = mpk->i, *aj = mpk->j;
+  const MatScalar *aa = mpk->a;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < m; i++) {
+    PetscScalar sum = 0.0;
+
+    for (PetscInt jj = ai[i]; jj < ai[i + 1]; jj++) sum += aa[jj] * x[aj[jj]];
+    y[i] = sum;
+  }
+  PetscCall(PetscLogFlops(2.0 * ai[m] - m));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMatrixPowersDestroy_Private(Mat_MatrixPowers **mpk)
+{
+  PetscFunctionBegin;
+  if (!*mpk) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFree((*mpk)->nlevel));
+  PetscCall(PetscFree3((*mpk)->i, (*mpk)->j, (*mpk)->a));
+  PetscCall(PetscFree((*mpk)->diag));
+  PetscCall(PetscFree2((*mpk)->work[0], (*mpk)->work[1]));
+  PetscCall(PetscSFDestroy(&(*mpk)->sf));
+  for (PetscInt l = 1; l < (*mpk)->k; l++) PetscCall(PetscSFDestroy(&(*mpk)->sfl[l]));
+  PetscCall(PetscFree((*mpk)->sfl));
+  PetscCall(ISDestroy(&(*mpk)->isrow));
+  PetscCall(ISDestroy(&(*mpk)->iscol));
+  if ((*mpk)->sub) PetscCall(MatDestroySubMatrices(1, &(*mpk)->sub));
+  PetscCall(PetscFree2((*mpk)->rowperm, (*mpk)->colperm));
+  PetscCall(PetscFree(*mpk));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+  MatMatrixPowers - Computes the products y[i] = A^(i+1) x, i = 0, ..., k-1
+
+  Neighbor-wise Collective
+
+  Input Parameters:
++ mat - the square matrix
+. k   - the number of products
+- x   - the vector to be multiplied
+
+  Output Parameter:
+. y - array of `k` vectors with the products
+
+  Level: advanced
+
+  Notes:
+  For `MATMPIAIJ` the first call builds, with `MatIncreaseOverlap()`, the rows within distance `k` - 1 of the local rows in
+  the graph of the matrix. Each call then exchanges the entries of `x` within distance `k` with a single message per neighbor
+  process, and computes the products redundantly on the shrinking overlap, so the `k` products need one message round
+  instead of the `k` of repeated `MatMult()`. This trades the latency of the messages for redundant computation and
+  memory, and pays off for small `k` and when latency dominates. The other matrix types use `MatMult()` `k` times.
+
+  The sums may be computed in a different order than `MatMult()` does, so the results can differ by rounding.
+
+.seealso: [](ch_matrices), `Mat`, `MatMult()`, `MatIncreaseOverlap()`, `KSPChebyshevSetUseMatrixPowers()`
+@*/
+PetscErrorCode MatMatrixPowers(Mat mat, PetscInt k, Vec x, Vec y[])
+{
+  Mat_MatrixPowers  *mpk;
+  PetscSF            sf;
+  const PetscScalar *xa;
+  PetscScalar       *ya, *w[2];
+  PetscInt           n;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat, MAT_CLASSID, 1);
+  PetscValidType(mat, 1);
+  PetscValidLogicalCollectiveInt(mat, k, 2);
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 3);
+  PetscCheck(k > 0, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_OUTOFRANGE, "Number of products %" PetscInt_FMT " must be positive", k);
+  PetscAssertPointer(y, 4);
+  PetscValidHeaderSpecific(*y, VEC_CLASSID, 4);
+  PetscCheck(mat->assembled, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for unassembled matrix");
+  PetscCheck(!mat->factortype, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for factored matrix");
+  PetscCheck(mat->rmap->N == mat->cmap->N && mat->rmap->n == mat->cmap->n, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_SIZ, "Only for square matrices with the same row and column layouts");
+  PetscCheck(mat->cmap->n == x->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec x: local dim %" PetscInt_FMT " %" PetscInt_FMT, mat->cmap->n, x->map->n);
+  for (PetscInt i = 0; i < k; i++) PetscCheck(y[i] != x, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_IDN, "x and y[%" PetscInt_FMT "] must be different vectors", i);
+  MatCheckPreallocated(mat, 1);
+
+  PetscCall(MatGetMatrixPowers_Private(mat, k, &mpk));
+  if (!mpk) {
+    PetscCall(MatMult(mat, x, y[0]));
+    for (PetscInt i = 1; i < k; i++) PetscCall(MatMult(mat, y[i - 1], y[i]));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscLogEventBegin(MAT_MatrixPowers, mat, x, 0, 0));
+  n    = mpk->nlevel[0];
+  w[0] = mpk->work[0];
+  w[1] = mpk->work[1];
+  PetscCall(VecGetArrayRead(x, &xa));
+  PetscCall(MatMatrixPowersGetSF_Private(mpk, k, &sf));
+  PetscCall(PetscArraycpy(w[0], xa, n));
+  PetscCall(PetscSFBcastBegin(sf, MPIU_SCALAR, xa, w[0], MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(sf, MPIU_SCALAR, xa, w[0], MPI_REPLACE));
+  PetscCall(VecRestoreArrayRead(x, &xa));
+  for (PetscInt i = 0; i < k; i++) {
+    /* A^i x is valid within distance k-i, so A^(i+1) x can be computed within distance k-i-1 */
+    PetscCall(MatMatrixPowersMult_Private(mpk, mpk->nlevel[k - i - 1], w[i % 2], w[(i + 1) % 2]));
+    PetscCall(VecGetArrayWrite(y[i], &ya));
+    PetscCall(PetscArraycpy(ya, w[(i + 1) % 2], n));
+    PetscCall(VecRestoreArrayWrite(y[i], &ya));
+  }
+  PetscCall(PetscLogEventEnd(MAT_MatrixPowers, mat, x, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   MatMultTransposeAdd - Computes v3 = v2 + A' * v1.
 
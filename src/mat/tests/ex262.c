@@ -0,0 +1,148 @@
+static const char help[] = "Tests the MATAIJFLOAT kernels against MATAIJ.\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CheckClose(Vec x, Vec y, const char *op)
+{
+  PetscReal nrm, err;
+  Vec       r;
+
+  PetscFunctionBegin;
+  PetscCall(VecDuplicate(x, &r));
+  PetscCall(VecWAXPY(r, -1.0, x, y));
+  PetscCall(VecNorm(r, NORM_INFINITY, &err));
+  PetscCall(VecNorm(x, NORM_INFINITY, &nrm));
+  PetscCheck(err <= 1.e-5 * nrm, PetscObjectComm((PetscObject)x), PETSC_ERR_PLIB, "%s: single precision result differs by %g (relative to %g)", op, (double)err, (double)nrm);
+  PetscCall(VecDestroy(&r));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A, B, C;
+  Vec         x, y, z, b1, b2;
+  PetscInt    n = 10, bw = 1, i, j, Ii, J, rstart, rend;
+  PetscScalar v;
+  PetscBool   flg;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bandwidth", &bw, NULL));
+
+  /* a nonsymmetric 5-point operator whose values are not representable in single precision, with the couplings
+     of each row with the rows Ii +- 2, ..., Ii +- bw to have rows longer than the vector length of the SIMD kernels */
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, n * n, n * n));
+  PetscCall(MatSetType(A, MATAIJ));
+  PetscCall(MatSeqAIJSetPreallocation(A, 5 + 2 * bw, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(A, 5 + 2 * bw, NULL, 5 + 2 * bw, NULL));
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  for (Ii = rstart; Ii < rend; Ii++) {
+    i = Ii / n;
+    j = Ii - i * n;
+    v = -1.0 / 3.0;
+    if (i > 0) {
+      J = Ii - n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+    }
+    if (i < n - 1) {
+      J = Ii + n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+    }
+    v = -1.0 / 7.0;
+    if (j > 0) {
+      J = Ii - 1;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+    }
+    v = -1.1;
+    if (j < n - 1) {
+      J = Ii + 1;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+    }
+    for (PetscInt k = 2; k <= bw; k++) {
+      if (k == n) continue; /* already coupled with the rows Ii +- n */
+      v = 1.0 / (10 * k + 3);
+      J = Ii - k;
+      if (J >= 0) PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+      J = Ii + k;
+      if (J < n * n) PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, INSERT_VALUES));
+    }
+    v = 4.1 + 1.0 / 3.0;
+    PetscCall(MatSetValues(A, 1, &Ii, 1, &Ii, &v, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(MatConvert(A, MATAIJFLOAT, MAT_INITIAL_MATRIX, &B));
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)B, &flg, MATSEQAIJFLOAT, MATMPIAIJFLOAT, ""));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatConvert() did not produce a MATAIJFLOAT matrix");
+
+  PetscCall(MatCreateVecs(A, &x, &y));
+  PetscCall(VecDuplicate(y, &z));
+  PetscCall(VecDuplicate(y, &b1));
+  PetscCall(VecDuplicate(y, &b2));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(VecSetRandom(z, NULL));
+
+  PetscCall(MatMult(A, x, b1));
+  PetscCall(MatMult(B, x, b2));
+  PetscCall(CheckClose(b1, b2, "MatMult"));
+
+  PetscCall(MatMultAdd(A, x, z, b1));
+  PetscCall(MatMultAdd(B, x, z, b2));
+  PetscCall(CheckClose(b1, b2, "MatMultAdd"));
+
+  PetscCall(MatMultTranspose(A, x, b1));
+  PetscCall(MatMultTranspose(B, x, b2));
+  PetscCall(CheckClose(b1, b2, "MatMultTranspose"));
+
+  PetscCall(MatMultTransposeAdd(A, x, z, b1));
+  PetscCall(MatMultTransposeAdd(B, x, z, b2));
+  PetscCall(CheckClose(b1, b2, "MatMultTransposeAdd"));
+
+  PetscCall(MatSOR(A, z, 1.0, (MatSORType)(SOR_ZERO_INITIAL_GUESS | SOR_LOCAL_SYMMETRIC_SWEEP), 0.0, 2, 1, b1));
+  PetscCall(MatSOR(B, z, 1.0, (MatSORType)(SOR_ZERO_INITIAL_GUESS | SOR_LOCAL_SYMMETRIC_SWEEP), 0.0, 2, 1, b2));
+  PetscCall(CheckClose(b1, b2, "MatSOR symmetric"));
+
+  PetscCall(VecCopy(x, b1));
+  PetscCall(VecCopy(x, b2));
+  PetscCall(MatSOR(A, z, 1.2, SOR_LOCAL_FORWARD_SWEEP, 0.0, 1, 2, b1));
+  PetscCall(MatSOR(B, z, 1.2, SOR_LOCAL_FORWARD_SWEEP, 0.0, 1, 2, b2));
+  PetscCall(CheckClose(b1, b2, "MatSOR forward"));
+
+  /* changing the values must refresh the single precision copy */
+  PetscCall(MatScale(A, 2.0));
+  PetscCall(MatScale(B, 2.0));
+  PetscCall(MatDuplicate(B, MAT_COPY_VALUES, &C));
+  PetscCall(MatMult(A, x, b1));
+  PetscCall(MatMult(C, x, b2));
+  PetscCall(CheckClose(b1, b2, "MatMult after MatScale()"));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&C));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroy(&b1));
+  PetscCall(VecDestroy(&b2));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      requires: !complex
+      nsize: {{1 2}}
+      output_file: output/empty.out
+
+   test:
+      suffix: avx512
+      requires: defined(PETSC_USE_AVX512_KERNELS) double !complex !defined(PETSC_USE_64BIT_INDICES)
+      nsize: {{1 2}}
+      args: -n 7 -bandwidth 9
+      output_file: output/empty.out
+
+TEST*/
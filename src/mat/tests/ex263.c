@@ -0,0 +1,119 @@
+static const char help[] = "Tests the MATAIJDELTA kernels against MATAIJ.\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CheckClose(Vec x, Vec y, const char *op)
+{
+  PetscReal nrm, err;
+  Vec       r;
+
+  PetscFunctionBegin;
+  PetscCall(VecDuplicate(x, &r));
+  PetscCall(VecWAXPY(r, -1.0, x, y));
+  PetscCall(VecNorm(r, NORM_INFINITY, &err));
+  PetscCall(VecNorm(x, NORM_INFINITY, &nrm));
+  PetscCheck(err <= 100 * PETSC_MACHINE_EPSILON * nrm, PetscObjectComm((PetscObject)x), PETSC_ERR_PLIB, "%s: result differs by %g (relative to %g)", op, (double)err, (double)nrm);
+  PetscCall(VecDestroy(&r));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A, B, C;
+  Vec         x, y, z, b1, b2;
+  PetscInt    n = 300, N, Ii, J, rstart, rend;
+  PetscScalar v;
+  PetscBool   flg;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  N = n * n;
+
+  /* rows that need 8 bit offsets (tridiagonal), 16 bit offsets (5-point stencil) and full indices (one far away entry) */
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, N, N));
+  PetscCall(MatSetType(A, MATAIJ));
+  PetscCall(MatSeqAIJSetPreallocation(A, 5, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(A, 5, NULL, 3, NULL));
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  for (Ii = rstart; Ii < rend; Ii++) {
+    v = -1.0;
+    if (Ii % 3 == 0) {
+      J = Ii - n;
+      if (J >= 0) PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+      J = Ii + n;
+      if (J < N) PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    } else if (Ii % 3 == 2) {
+      J = (Ii + 70000) % N;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -0.5;
+    J = Ii - 1;
+    if (J >= 0) PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    J = Ii + 1;
+    if (J < N) PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    v = 4.0;
+    PetscCall(MatSetValues(A, 1, &Ii, 1, &Ii, &v, ADD_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(MatConvert(A, MATAIJDELTA, MAT_INITIAL_MATRIX, &B));
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)B, &flg, MATSEQAIJDELTA, MATMPIAIJDELTA, ""));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatConvert() did not produce a MATAIJDELTA matrix");
+
+  PetscCall(MatCreateVecs(A, &x, &y));
+  PetscCall(VecDuplicate(y, &z));
+  PetscCall(VecDuplicate(y, &b1));
+  PetscCall(VecDuplicate(y, &b2));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(VecSetRandom(z, NULL));
+
+  PetscCall(MatMult(A, x, b1));
+  PetscCall(MatMult(B, x, b2));
+  PetscCall(CheckClose(b1, b2, "MatMult"));
+
+  PetscCall(MatMultAdd(A, x, z, b1));
+  PetscCall(MatMultAdd(B, x, z, b2));
+  PetscCall(CheckClose(b1, b2, "MatMultAdd"));
+
+  /* changing the values does not require rebuilding the indices, changing the nonzero structure does */
+  PetscCall(MatScale(A, 2.0));
+  PetscCall(MatScale(B, 2.0));
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(MatSetOption(B, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  if (rstart < rend) {
+    v = 1.0;
+    J = (rstart + N / 2) % N;
+    PetscCall(MatSetValues(A, 1, &rstart, 1, &J, &v, ADD_VALUES));
+    PetscCall(MatSetValues(B, 1, &rstart, 1, &J, &v, ADD_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatDuplicate(B, MAT_COPY_VALUES, &C));
+  PetscCall(MatMult(A, x, b1));
+  PetscCall(MatMult(C, x, b2));
+  PetscCall(CheckClose(b1, b2, "MatMult after new nonzeros"));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&C));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroy(&b1));
+  PetscCall(VecDestroy(&b2));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2}}
+      output_file: output/empty.out
+
+TEST*/
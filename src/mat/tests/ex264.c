@@ -0,0 +1,173 @@
+static const char help[] = "Tests MatMultTranspose(), MatSOR() and the ILU(0) MatSolve() of MATSEQSELL against MATSEQAIJ.\n\n";
+
+#include <petscksp.h>
+
+static PetscErrorCode CheckClose(Vec x, Vec y, const char *op)
+{
+  PetscReal nrm, err;
+  Vec       r;
+
+  PetscFunctionBegin;
+  PetscCall(VecDuplicate(x, &r));
+  PetscCall(VecWAXPY(r, -1.0, x, y));
+  PetscCall(VecNorm(r, NORM_INFINITY, &err));
+  PetscCall(VecNorm(x, NORM_INFINITY, &nrm));
+  PetscCheck(err <= 1000 * PETSC_MACHINE_EPSILON * nrm, PetscObjectComm((PetscObject)x), PETSC_ERR_PLIB, "%s: result differs by %g (relative to %g)", op, (double)err, (double)nrm);
+  PetscCall(VecDestroy(&r));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode CheckSOR(Mat A, Mat S, Vec b, Vec x0, PetscReal omega, MatSORType flag, PetscInt its, PetscInt lits, const char *op)
+{
+  Vec x1, x2;
+
+  PetscFunctionBegin;
+  PetscCall(VecDuplicate(x0, &x1));
+  PetscCall(VecDuplicate(x0, &x2));
+  PetscCall(VecCopy(x0, x1));
+  PetscCall(VecCopy(x0, x2));
+  PetscCall(MatSOR(A, b, omega, flag, 0.0, its, lits, x1));
+  PetscCall(MatSOR(S, b, omega, flag, 0.0, its, lits, x2));
+  PetscCall(CheckClose(x1, x2, op));
+  PetscCall(VecDestroy(&x1));
+  PetscCall(VecDestroy(&x2));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat                A, S, D, FA, FS;
+  Vec                x, z, b1, b2;
+  IS                 row, col;
+  MatFactorInfo      info;
+  KSP                ksp;
+  PC                 pc;
+  KSPConvergedReason reason;
+  PetscInt           n = 11, N, i, j, Ii, J;
+  PetscScalar        v;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  N = n * n;
+
+  /* a nonsymmetric 5-point operator with a few long rows; N is not a multiple of the slice height */
+  PetscCall(MatCreateSeqAIJ(PETSC_COMM_SELF, N, N, 6, NULL, &A));
+  for (Ii = 0; Ii < N; Ii++) {
+    i = Ii / n;
+    j = Ii - i * n;
+    v = -1.0;
+    if (i > 0) {
+      J = Ii - n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -2.0;
+    if (i < n - 1) {
+      J = Ii + n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -0.5;
+    if (j > 0) {
+      J = Ii - 1;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -1.5;
+    if (j < n - 1) {
+      J = Ii + 1;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    if (Ii % 5 == 0) {
+      v = 0.25;
+      J = (7 * Ii + 3) % N;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = 8.0;
+    PetscCall(MatSetValues(A, 1, &Ii, 1, &Ii, &v, ADD_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatConvert(A, MATSEQSELL, MAT_INITIAL_MATRIX, &S));
+
+  PetscCall(MatCreateVecs(A, &x, &z));
+  PetscCall(VecDuplicate(x, &b1));
+  PetscCall(VecDuplicate(x, &b2));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(VecSetRandom(z, NULL));
+
+  PetscCall(MatMultTranspose(A, x, b1));
+  PetscCall(MatMultTranspose(S, x, b2));
+  PetscCall(CheckClose(b1, b2, "MatMultTranspose"));
+  PetscCall(MatMultTransposeAdd(A, x, z, b1));
+  PetscCall(MatMultTransposeAdd(S, x, z, b2));
+  PetscCall(CheckClose(b1, b2, "MatMultTransposeAdd"));
+
+  PetscCall(CheckSOR(A, S, z, x, 1.0, (MatSORType)(SOR_ZERO_INITIAL_GUESS | SOR_FORWARD_SWEEP), 1, 1, "MatSOR forward, zero initial guess"));
+  PetscCall(CheckSOR(A, S, z, x, 1.0, (MatSORType)(SOR_ZERO_INITIAL_GUESS | SOR_BACKWARD_SWEEP), 1, 1, "MatSOR backward, zero initial guess"));
+  PetscCall(CheckSOR(A, S, z, x, 1.3, (MatSORType)(SOR_ZERO_INITIAL_GUESS | SOR_SYMMETRIC_SWEEP), 2, 2, "MatSOR symmetric, zero initial guess"));
+  PetscCall(CheckSOR(A, S, z, x, 0.8, SOR_FORWARD_SWEEP, 2, 1, "MatSOR forward"));
+  PetscCall(CheckSOR(A, S, z, x, 0.8, SOR_BACKWARD_SWEEP, 2, 1, "MatSOR backward"));
+  PetscCall(CheckSOR(A, S, z, x, 1.1, SOR_SYMMETRIC_SWEEP, 1, 3, "MatSOR symmetric"));
+
+  /* ILU(0) in the natural ordering computes the same factors for both formats */
+  PetscCall(MatFactorInfoInitialize(&info));
+  info.fill = 1.0;
+  PetscCall(MatGetOrdering(A, MATORDERINGNATURAL, &row, &col));
+  PetscCall(MatGetFactor(A, MATSOLVERPETSC, MAT_FACTOR_ILU, &FA));
+  PetscCall(MatGetFactor(S, MATSOLVERPETSC, MAT_FACTOR_ILU, &FS));
+  PetscCall(MatILUFactorSymbolic(FA, A, row, col, &info));
+  PetscCall(MatILUFactorSymbolic(FS, S, row, col, &info));
+  PetscCall(MatLUFactorNumeric(FA, A, &info));
+  PetscCall(MatLUFactorNumeric(FS, S, &info));
+  PetscCall(MatSolve(FA, z, b1));
+  PetscCall(MatSolve(FS, z, b2));
+  PetscCall(CheckClose(b1, b2, "MatSolve"));
+
+  /* refactor after a change of the values */
+  PetscCall(MatShift(A, 1.0));
+  PetscCall(MatShift(S, 1.0));
+  PetscCall(MatLUFactorNumeric(FA, A, &info));
+  PetscCall(MatLUFactorNumeric(FS, S, &info));
+  PetscCall(MatSolve(FA, z, b1));
+  PetscCall(MatSolve(FS, z, b2));
+  PetscCall(CheckClose(b1, b2, "MatSolve after MatShift()"));
+
+  /* the duplicate keeps the slice layout */
+  PetscCall(MatDuplicate(S, MAT_COPY_VALUES, &D));
+  PetscCall(MatMult(A, x, b1));
+  PetscCall(MatMult(D, x, b2));
+  PetscCall(CheckClose(b1, b2, "MatMult of MatDuplicate()"));
+
+  /* PCILU used directly on the SELL matrix */
+  PetscCall(KSPCreate(PETSC_COMM_SELF, &ksp));
+  PetscCall(KSPSetOperators(ksp, S, S));
+  PetscCall(KSPSetType(ksp, KSPGMRES));
+  PetscCall(KSPGetPC(ksp, &pc));
+  PetscCall(PCSetType(pc, PCILU));
+  PetscCall(KSPSetTolerances(ksp, 1.e-10, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT));
+  PetscCall(KSPSetFromOptions(ksp));
+  PetscCall(KSPSolve(ksp, z, b2));
+  PetscCall(KSPGetConvergedReason(ksp, &reason));
+  PetscCheck(reason > 0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "KSPSolve() with PCILU did not converge: %s", KSPConvergedReasons[reason]);
+
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(ISDestroy(&row));
+  PetscCall(ISDestroy(&col));
+  PetscCall(MatDestroy(&FA));
+  PetscCall(MatDestroy(&FS));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&S));
+  PetscCall(MatDestroy(&D));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroy(&b1));
+  PetscCall(VecDestroy(&b2));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      output_file: output/empty.out
+
+TEST*/
@@ -0,0 +1,171 @@
+static const char help[] = "Tests the selection of the MatMult() format of MATSEQAIJ at MatAssemblyEnd() with -mat_seqaij_autotune.\n\n";
+
+#include <petscmat.h>
+
+/* a 5-point operator on an n x n grid with bs x bs dense blocks, optionally with an extra entry in every fifth row */
+static PetscErrorCode BuildMatrix(const char prefix[], PetscInt n, PetscInt bs, PetscBool irregular, Mat *A)
+{
+  PetscInt    N = n * n, Ii, J, i, j, c, k, l, row, col;
+  PetscScalar v;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreate(PETSC_COMM_SELF, A));
+  PetscCall(MatSetSizes(*A, N * bs, N * bs, N * bs, N * bs));
+  PetscCall(MatSetOptionsPrefix(*A, prefix));
+  PetscCall(MatSetType(*A, MATSEQAIJ));
+  PetscCall(MatSeqAIJSetPreallocation(*A, 6 * bs, NULL));
+  for (Ii = 0; Ii < N; Ii++) {
+    PetscInt cols[6], nc = 0;
+
+    i = Ii / n;
+    j = Ii - i * n;
+    if (i > 0) cols[nc++] = Ii - n;
+    if (i < n - 1) cols[nc++] = Ii + n;
+    if (j > 0) cols[nc++] = Ii - 1;
+    if (j < n - 1) cols[nc++] = Ii + 1;
+    if (irregular && Ii % 5 == 0 && (7 * Ii + 3) % N != Ii) cols[nc++] = (7 * Ii + 3) % N;
+    for (c = 0; c < nc; c++) {
+      J = cols[c];
+      for (k = 0; k < bs; k++) {
+        for (l = 0; l < bs; l++) {
+          row = Ii * bs + k;
+          col = J * bs + l;
+          v   = -1.0 / (1 + k + 2 * l + c);
+          PetscCall(MatSetValues(*A, 1, &row, 1, &col, &v, ADD_VALUES));
+        }
+      }
+    }
+    for (k = 0; k < bs; k++) {
+      for (l = 0; l < bs; l++) {
+        row = Ii * bs + k;
+        col = Ii * bs + l;
+        v   = k == l ? 8.0 : 0.5;
+        PetscCall(MatSetValues(*A, 1, &row, 1, &col, &v, ADD_VALUES));
+      }
+    }
+  }
+  PetscCall(MatAssemblyBegin(*A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode CheckMult(Mat A, Mat R, const char *op)
+{
+  Vec       x, y, z;
+  PetscReal nrm, err;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreateVecs(A, &x, &y));
+  PetscCall(VecDuplicate(y, &z));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(MatMult(A, x, y));
+  PetscCall(MatMult(R, x, z));
+  PetscCall(VecNorm(z, NORM_INFINITY, &nrm));
+  PetscCall(VecAXPY(z, -1.0, y));
+  PetscCall(VecNorm(z, NORM_INFINITY, &err));
+  PetscCheck(err <= 1000 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_SELF, PETSC_ERR_PLIB, "%s: MatMult() differs by %g (relative to %g)", op, (double)err, (double)nrm);
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* when the plain format is kept, trying the others must not change its I-nodes */
+static PetscErrorCode CheckInodes(Mat A, Mat R)
+{
+  PetscBool isseqaij, same = PETSC_TRUE;
+  PetscInt  na, nr, *sa, *sr;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, MATSEQAIJ, &isseqaij));
+  if (!isseqaij) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatInodeGetInodeSizes(A, &na, &sa, NULL));
+  PetscCall(MatInodeGetInodeSizes(R, &nr, &sr, NULL));
+  if (na != nr || !sa != !sr) same = PETSC_FALSE;
+  else if (sa) PetscCall(PetscArraycmp(sa, sr, na, &same));
+  PetscCheck(same, PETSC_COMM_SELF, PETSC_ERR_PLIB, "I-nodes differ from the ones of the untuned matrix: %" PetscInt_FMT " and %" PetscInt_FMT " nodes", na, nr);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A, R;
+  PetscInt    n = 10, bs = 1, row, col;
+  PetscBool   irregular = PETSC_FALSE, view = PETSC_TRUE;
+  PetscScalar v = 1.0;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-irregular", &irregular, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-view", &view, NULL));
+
+  /* A selects its format with the options prefixed by tuned_, R stays a plain MATSEQAIJ */
+  PetscCall(BuildMatrix("tuned_", n, bs, irregular, &A));
+  PetscCall(BuildMatrix(NULL, n, bs, irregular, &R));
+  if (view) {
+    PetscCall(PetscViewerPushFormat(PETSC_VIEWER_STDOUT_SELF, PETSC_VIEWER_ASCII_INFO));
+    PetscCall(MatView(A, PETSC_VIEWER_STDOUT_SELF));
+    PetscCall(PetscViewerPopFormat(PETSC_VIEWER_STDOUT_SELF));
+  }
+  PetscCall(CheckMult(A, R, "after the first assembly"));
+  PetscCall(CheckInodes(A, R));
+
+  /* the AIJ storage stays canonical: change values in place, then add a new nonzero */
+  row = 0;
+  PetscCall(MatSetValues(A, 1, &row, 1, &row, &v, ADD_VALUES));
+  PetscCall(MatSetValues(R, 1, &row, 1, &row, &v, ADD_VALUES));
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyBegin(R, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(R, MAT_FINAL_ASSEMBLY));
+  PetscCall(CheckMult(A, R, "after changing a value"));
+
+  PetscCall(MatGetSize(A, NULL, &col));
+  col--;
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(MatSetOption(R, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(MatSetValues(A, 1, &row, 1, &col, &v, ADD_VALUES));
+  PetscCall(MatSetValues(R, 1, &row, 1, &col, &v, ADD_VALUES));
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyBegin(R, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(R, MAT_FINAL_ASSEMBLY));
+  PetscCall(CheckMult(A, R, "after adding a nonzero"));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&R));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: sell
+      args: -tuned_mat_seqaij_autotune -tuned_mat_seqaij_autotune_min_size 0
+
+   test:
+      suffix: delta
+      args: -tuned_mat_seqaij_autotune -tuned_mat_seqaij_autotune_min_size 0 -irregular
+
+   test:
+      suffix: inode
+      args: -tuned_mat_seqaij_autotune -tuned_mat_seqaij_autotune_min_size 0 -bs 2
+
+   test:
+      suffix: small
+      args: -tuned_mat_seqaij_autotune
+
+   test:
+      suffix: benchmark
+      args: -tuned_mat_seqaij_autotune -tuned_mat_seqaij_autotune_benchmark -view 0 -irregular
+      output_file: output/empty.out
+
+   test:
+      suffix: benchmark_inode
+      args: -tuned_mat_seqaij_autotune -tuned_mat_seqaij_autotune_benchmark -tuned_mat_seqaij_autotune_min_size 0 -view 0 -bs 2
+      output_file: output/empty.out
+
+TEST*/
@@ -0,0 +1,147 @@
+static const char help[] = "Tests MatMultDot() and MatMultAddNorm() against MatMult() followed by VecDot() and MatMultAdd() followed by VecNorm().\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CheckFused(Mat A, const char *type)
+{
+  Vec         x, y, z, w, y1;
+  PetscScalar dot, ref;
+  PetscReal   nrm, nref, err, scale;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreateVecs(A, &x, &y));
+  PetscCall(VecDuplicate(y, &z));
+  PetscCall(VecDuplicate(y, &w));
+  PetscCall(VecDuplicate(y, &y1));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(VecSetRandom(z, NULL));
+  PetscCall(VecSetRandom(w, NULL));
+
+  /* y = A x with (w,y) */
+  PetscCall(MatMult(A, x, y1));
+  PetscCall(VecDot(w, y1, &ref));
+  PetscCall(MatMultDot(A, x, y, w, &dot));
+  PetscCall(VecAXPY(y1, -1.0, y));
+  PetscCall(VecNorm(y1, NORM_INFINITY, &err));
+  PetscCall(VecNorm(y, NORM_INFINITY, &scale));
+  PetscCheck(err <= 1000 * PETSC_MACHINE_EPSILON * scale, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s: MatMultDot() product differs by %g", type, (double)err);
+  PetscCheck(PetscAbsScalar(dot - ref) <= 1000 * PETSC_MACHINE_EPSILON * PetscAbsScalar(ref), PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s: MatMultDot() inner product differs by %g", type, (double)PetscAbsScalar(dot - ref));
+
+  /* y = A x with (x,y), the input vector may be used for the inner product */
+  PetscCall(MatMult(A, x, y1));
+  PetscCall(VecDot(x, y1, &ref));
+  PetscCall(MatMultDot(A, x, y, x, &dot));
+  PetscCheck(PetscAbsScalar(dot - ref) <= 1000 * PETSC_MACHINE_EPSILON * PetscAbsScalar(ref), PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s: MatMultDot() with w = x differs by %g", type, (double)PetscAbsScalar(dot - ref));
+
+  /* y = z + A x with ||y|| */
+  PetscCall(MatMultAdd(A, x, z, y1));
+  PetscCall(VecNorm(y1, NORM_2, &nref));
+  PetscCall(MatMultAddNorm(A, x, z, y, &nrm));
+  PetscCall(VecAXPY(y1, -1.0, y));
+  PetscCall(VecNorm(y1, NORM_INFINITY, &err));
+  PetscCheck(err <= 1000 * PETSC_MACHINE_EPSILON * scale, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s: MatMultAddNorm() product differs by %g", type, (double)err);
+  PetscCheck(PetscAbsReal(nrm - nref) <= 1000 * PETSC_MACHINE_EPSILON * nref, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s: MatMultAddNorm() norm differs by %g", type, (double)PetscAbsReal(nrm - nref));
+
+  /* z = z + A x in place */
+  PetscCall(MatMultAdd(A, x, z, y1));
+  PetscCall(VecNorm(y1, NORM_2, &nref));
+  PetscCall(MatMultAddNorm(A, x, z, z, &nrm));
+  PetscCall(VecAXPY(y1, -1.0, z));
+  PetscCall(VecNorm(y1, NORM_INFINITY, &err));
+  PetscCheck(err <= 1000 * PETSC_MACHINE_EPSILON * scale, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s: MatMultAddNorm() in place product differs by %g", type, (double)err);
+  PetscCheck(PetscAbsReal(nrm - nref) <= 1000 * PETSC_MACHINE_EPSILON * nref, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s: MatMultAddNorm() in place norm differs by %g", type, (double)PetscAbsReal(nrm - nref));
+
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroy(&w));
+  PetscCall(VecDestroy(&y1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A, B;
+  PetscInt    n = 11, N, i, j, Ii, J, rstart, rend;
+  PetscScalar v;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  N = n * n;
+
+  /* a nonsymmetric 5-point operator with a few long rows; N is not a multiple of the SELL slice height */
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, N, N, 6, NULL, 6, NULL, &A));
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  for (Ii = rstart; Ii < rend; Ii++) {
+    i = Ii / n;
+    j = Ii - i * n;
+    v = -1.0;
+    if (i > 0) {
+      J = Ii - n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -2.0;
+    if (i < n - 1) {
+      J = Ii + n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -0.5;
+    if (j > 0) {
+      J = Ii - 1;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    if (Ii % 5 == 0) {
+      v = 0.25;
+      J = (7 * Ii + 3) % N;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = 8.0;
+    PetscCall(MatSetValues(A, 1, &Ii, 1, &Ii, &v, ADD_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(CheckFused(A, "aij"));
+
+  PetscCall(MatConvert(A, MATSELL, MAT_INITIAL_MATRIX, &B));
+  PetscCall(CheckFused(B, "sell"));
+  PetscCall(MatDestroy(&B));
+
+  PetscCall(MatConvert(A, MATDENSE, MAT_INITIAL_MATRIX, &B));
+  PetscCall(CheckFused(B, "dense"));
+  PetscCall(MatDestroy(&B));
+
+  /* a subclass that overrides MatMult() uses the unfused default */
+  PetscCall(MatConvert(A, MATAIJPERM, MAT_INITIAL_MATRIX, &B));
+  PetscCall(CheckFused(B, "aijperm"));
+  PetscCall(MatDestroy(&B));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      output_file: output/empty.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      output_file: output/empty.out
+
+   test:
+      suffix: 3
+      nsize: 3
+      args: -n 3
+      output_file: output/empty.out
+
+   test:
+      suffix: sell_slice_height
+      nsize: {{1 2}}
+      requires: !cuda
+      args: -mat_sell_slice_height 40
+      output_file: output/empty.out
+
+TEST*/
@@ -0,0 +1,128 @@
+static const char help[] = "Tests MatMatMult() and MatTransposeMatMult() of MATAIJ with MATDENSE against products with each column.\n\n";
+
+#include <petscmat.h>
+
+/* compares the columns of C with A B_j, or A^T B_j */
+static PetscErrorCode CheckColumns(Mat A, Mat B, Mat C, PetscBool transpose, const char *op)
+{
+  Vec       b, c, r;
+  PetscInt  j, N;
+  PetscReal nrm, err;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(B, NULL, &N));
+  if (transpose) PetscCall(MatCreateVecs(A, &r, NULL));
+  else PetscCall(MatCreateVecs(A, NULL, &r));
+  for (j = 0; j < N; j++) {
+    PetscCall(MatDenseGetColumnVecRead(B, j, &b));
+    PetscCall(MatDenseGetColumnVecRead(C, j, &c));
+    if (transpose) PetscCall(MatMultTranspose(A, b, r));
+    else PetscCall(MatMult(A, b, r));
+    PetscCall(VecNorm(r, NORM_INFINITY, &nrm));
+    PetscCall(VecAXPY(r, -1.0, c));
+    PetscCall(VecNorm(r, NORM_INFINITY, &err));
+    PetscCheck(err <= 1000 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s: column %" PetscInt_FMT " differs by %g (relative to %g)", op, j, (double)err, (double)nrm);
+    PetscCall(MatDenseRestoreColumnVecRead(C, j, &c));
+    PetscCall(MatDenseRestoreColumnVecRead(B, j, &b));
+  }
+  PetscCall(VecDestroy(&r));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A, B, Bt, C, Ct;
+  PetscInt    n = 9, N, i, j, Ii, J, rstart, rend, m, k, lda, ncols[] = {1, 3, 5, 16, 21, 40}, c;
+  PetscScalar v;
+  PetscBool   uselda = PETSC_FALSE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-lda", &uselda, NULL));
+  N = n * n;
+
+  /* a nonsymmetric 5-point operator with a few long rows */
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, N, N, 6, NULL, 6, NULL, &A));
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  for (Ii = rstart; Ii < rend; Ii++) {
+    i = Ii / n;
+    j = Ii - i * n;
+    v = -1.0;
+    if (i > 0) {
+      J = Ii - n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -2.0;
+    if (i < n - 1) {
+      J = Ii + n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -0.5;
+    if (j > 0) {
+      J = Ii - 1;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    if (Ii % 5 == 0) {
+      v = 0.25;
+      J = (7 * Ii + 3) % N;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = 8.0;
+    PetscCall(MatSetValues(A, 1, &Ii, 1, &Ii, &v, ADD_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatGetLocalSize(A, &m, NULL));
+
+  for (c = 0; c < (PetscInt)PETSC_STATIC_ARRAY_LENGTH(ncols); c++) {
+    k = ncols[c];
+    /* with -lda the columns of B are not contiguous in memory */
+    lda = uselda ? m + 3 : m;
+    PetscCall(MatCreate(PETSC_COMM_WORLD, &B));
+    PetscCall(MatSetSizes(B, m, PETSC_DECIDE, N, k));
+    PetscCall(MatSetType(B, MATDENSE));
+    PetscCall(MatDenseSetLDA(B, lda));
+    PetscCall(MatSetUp(B));
+    PetscCall(MatSetRandom(B, NULL));
+    PetscCall(MatDuplicate(B, MAT_COPY_VALUES, &Bt));
+
+    PetscCall(MatMatMult(A, B, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &C));
+    PetscCall(CheckColumns(A, B, C, PETSC_FALSE, "MatMatMult"));
+    /* the numeric phase again with new values */
+    PetscCall(MatScale(B, -2.0));
+    PetscCall(MatMatMult(A, B, MAT_REUSE_MATRIX, PETSC_DEFAULT, &C));
+    PetscCall(CheckColumns(A, B, C, PETSC_FALSE, "MatMatMult with MAT_REUSE_MATRIX"));
+
+    PetscCall(MatTransposeMatMult(A, Bt, MAT_INITIAL_MATRIX, PETSC_DEFAULT, &Ct));
+    PetscCall(CheckColumns(A, Bt, Ct, PETSC_TRUE, "MatTransposeMatMult"));
+    PetscCall(MatScale(Bt, 0.5));
+    PetscCall(MatTransposeMatMult(A, Bt, MAT_REUSE_MATRIX, PETSC_DEFAULT, &Ct));
+    PetscCall(CheckColumns(A, Bt, Ct, PETSC_TRUE, "MatTransposeMatMult with MAT_REUSE_MATRIX"));
+
+    PetscCall(MatDestroy(&B));
+    PetscCall(MatDestroy(&Bt));
+    PetscCall(MatDestroy(&C));
+    PetscCall(MatDestroy(&Ct));
+  }
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      output_file: output/empty.out
+
+   test:
+      suffix: lda
+      args: -lda
+      output_file: output/empty.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      output_file: output/empty.out
+
+TEST*/
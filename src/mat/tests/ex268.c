@@ -0,0 +1,133 @@
+static const char help[] = "Tests the multicolor MatSOR() and the level scheduled MatSolve() of MATSEQAIJ.\n\n";
+
+#include <petscmat.h>
+
+/* compares the solves of two factors of A computed with the same ordering and factor type, the second one with -sched_mat_solve_level_schedule */
+static PetscErrorCode CheckSolve(Mat A, MatFactorType ftype, MatOrderingType otype, PetscReal levels, Vec b)
+{
+  Mat           F[2];
+  IS            row, col;
+  MatFactorInfo info;
+  Vec           x[2];
+  PetscReal     nrm, err;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetOrdering(A, otype, &row, &col));
+  PetscCall(MatFactorInfoInitialize(&info));
+  info.levels = levels;
+  info.fill   = 5.0;
+  for (PetscInt k = 0; k < 2; k++) {
+    PetscCall(MatGetFactor(A, MATSOLVERPETSC, ftype, &F[k]));
+    if (k) PetscCall(MatSetOptionsPrefix(F[k], "sched_"));
+    if (ftype == MAT_FACTOR_LU) PetscCall(MatLUFactorSymbolic(F[k], A, row, col, &info));
+    else PetscCall(MatILUFactorSymbolic(F[k], A, row, col, &info));
+    PetscCall(MatLUFactorNumeric(F[k], A, &info));
+    PetscCall(VecDuplicate(b, &x[k]));
+    PetscCall(MatSolve(F[k], b, x[k]));
+  }
+  PetscCall(VecNorm(x[0], NORM_INFINITY, &nrm));
+  PetscCall(VecAXPY(x[1], -1.0, x[0]));
+  PetscCall(VecNorm(x[1], NORM_INFINITY, &err));
+  PetscCheck(err <= 100 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_SELF, PETSC_ERR_PLIB, "MatSolve() with the %s ordering differs by %g (relative to %g)", otype, (double)err, (double)nrm);
+  for (PetscInt k = 0; k < 2; k++) {
+    PetscCall(MatDestroy(&F[k]));
+    PetscCall(VecDestroy(&x[k]));
+  }
+  PetscCall(ISDestroy(&row));
+  PetscCall(ISDestroy(&col));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A;
+  Vec         x, b, r;
+  PetscInt    n = 12, N, i, j, Ii, J;
+  PetscScalar v;
+  PetscReal   bnrm, rnrm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  N = n * n;
+
+  /* a diagonally dominant nonsymmetric 5-point operator with a few long rows; the options of A select the multicolor MatSOR() */
+  PetscCall(MatCreate(PETSC_COMM_SELF, &A));
+  PetscCall(MatSetSizes(A, N, N, N, N));
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSeqAIJSetPreallocation(A, 6, NULL));
+  for (Ii = 0; Ii < N; Ii++) {
+    i = Ii / n;
+    j = Ii - i * n;
+    v = -1.0;
+    if (i > 0) {
+      J = Ii - n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -2.0;
+    if (i < n - 1) {
+      J = Ii + n;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = -0.5;
+    if (j > 0) {
+      J = Ii - 1;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    if (Ii % 5 == 0) {
+      v = 0.25;
+      J = (7 * Ii + 3) % N;
+      PetscCall(MatSetValues(A, 1, &Ii, 1, &J, &v, ADD_VALUES));
+    }
+    v = 8.0;
+    PetscCall(MatSetValues(A, 1, &Ii, 1, &Ii, &v, ADD_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(MatCreateVecs(A, &x, &b));
+  PetscCall(VecDuplicate(b, &r));
+  PetscCall(VecSetRandom(b, NULL));
+  PetscCall(VecNorm(b, NORM_2, &bnrm));
+
+  /* the symmetric sweeps converge to the solution whatever the order of the rows */
+  PetscCall(MatSOR(A, b, 1.0, SOR_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS, 0.0, 40, 1, x));
+  PetscCall(MatResidual(A, b, x, r));
+  PetscCall(VecNorm(r, NORM_2, &rnrm));
+  PetscCheck(rnrm <= 1.e-10 * bnrm, PETSC_COMM_SELF, PETSC_ERR_PLIB, "MatSOR() symmetric sweeps did not converge, residual %g", (double)rnrm);
+  PetscCall(MatSOR(A, b, 0.8, SOR_FORWARD_SWEEP, 0.0, 30, 2, x));
+  PetscCall(MatSOR(A, b, 1.1, SOR_BACKWARD_SWEEP, 0.0, 30, 2, x));
+  PetscCall(MatResidual(A, b, x, r));
+  PetscCall(VecNorm(r, NORM_2, &rnrm));
+  PetscCheck(rnrm <= 1.e-10 * bnrm, PETSC_COMM_SELF, PETSC_ERR_PLIB, "MatSOR() forward and backward sweeps did not converge, residual %g", (double)rnrm);
+
+  PetscCall(CheckSolve(A, MAT_FACTOR_ILU, MATORDERINGNATURAL, 0, b));
+  PetscCall(CheckSolve(A, MAT_FACTOR_ILU, MATORDERINGRCM, 2, b));
+  PetscCall(CheckSolve(A, MAT_FACTOR_LU, MATORDERINGND, 0, b));
+
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&r));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      args: -sched_mat_solve_level_schedule
+      output_file: output/empty.out
+
+   test:
+      suffix: multicolor
+      args: -mat_sor_multicolor -sched_mat_solve_level_schedule
+      output_file: output/empty.out
+
+   test:
+      suffix: multicolor_jp
+      args: -mat_sor_multicolor -sor_mat_coloring_type jp -sched_mat_solve_level_schedule -mat_no_inode
+      output_file: output/empty.out
+
+TEST*/
@@ -0,0 +1,153 @@
+static const char help[] = "Tests MATVBAIJ against MATAIJ on a chain of nodes with a variable number of fields.\n\n";
+
+#include <petscksp.h>
+
+/* the number of fields of node i; nodes with 18 fields exceed the largest dense block and use the row-by-row kernels */
+static PetscInt NumFields(PetscInt i)
+{
+  return i % 7 == 6 ? 18 : (i % 3 == 0 ? 7 : 3);
+}
+
+/* couples each node with its neighbors with dense blocks; some blocks of node i % 5 == 4 miss an entry, so that its block row is not dense */
+static PetscErrorCode FillMatrix(Mat A, PetscInt nnodes, PetscInt nstart, PetscInt nend, const PetscInt *offset)
+{
+  PetscInt    i, j, k, l, row, col;
+  PetscScalar v;
+
+  PetscFunctionBegin;
+  for (i = nstart; i < nend; i++) {
+    for (j = PetscMax(i - 1, 0); j <= PetscMin(i + 1, nnodes - 1); j++) {
+      for (k = 0; k < NumFields(i); k++) {
+        for (l = 0; l < NumFields(j); l++) {
+          row = offset[i] + k;
+          col = offset[j] + l;
+          if (i % 5 == 4 && j == i + 1 && k == 1 && l == 0) continue;
+          if (row == col) v = 100.0;
+          else if (i == j) v = 0.5 * (k - l) / NumFields(i);
+          else v = -1.0 / (1 + k + 2 * l);
+          PetscCall(MatSetValues(A, 1, &row, 1, &col, &v, INSERT_VALUES));
+        }
+      }
+    }
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A, B;
+  Vec         x, y, z, b, r;
+  KSP         ksp;
+  PetscInt    nnodes = 40, nstart, nend, nlocal = PETSC_DECIDE, i, *offset, *bsizes;
+  PetscReal   nrm, err;
+  PetscBool   flg;
+  PetscMPIInt rank, size;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &nnodes, NULL));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCall(PetscSplitOwnership(PETSC_COMM_WORLD, &nlocal, &nnodes));
+  PetscCallMPI(MPI_Scan(&nlocal, &nend, 1, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  nstart = nend - nlocal;
+  PetscCall(PetscMalloc2(nnodes + 1, &offset, nlocal, &bsizes));
+  offset[0] = 0;
+  for (i = 0; i < nnodes; i++) offset[i + 1] = offset[i] + NumFields(i);
+  for (i = nstart; i < nend; i++) bsizes[i - nstart] = NumFields(i);
+
+  PetscCall(MatCreateMPIVBAIJ(PETSC_COMM_WORLD, nlocal, bsizes, PETSC_DETERMINE, 54, NULL, 36, NULL, &A));
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)A, &flg, MATSEQVBAIJ, MATMPIVBAIJ, ""));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Wrong matrix type");
+  PetscCall(FillMatrix(A, nnodes, nstart, nend, offset));
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, offset[nend] - offset[nstart], offset[nend] - offset[nstart], PETSC_DETERMINE, PETSC_DETERMINE, 54, NULL, 36, NULL, &B));
+  PetscCall(FillMatrix(B, nnodes, nstart, nend, offset));
+
+  PetscCall(MatCreateVecs(A, &x, &y));
+  PetscCall(VecDuplicate(y, &z));
+  PetscCall(VecDuplicate(y, &b));
+  PetscCall(VecDuplicate(y, &r));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(VecSetRandom(b, NULL));
+
+  /* the products with the dense blocks are those of MATAIJ */
+  PetscCall(MatMult(A, x, y));
+  PetscCall(MatMult(B, x, z));
+  PetscCall(VecNorm(z, NORM_INFINITY, &nrm));
+  PetscCall(VecAXPY(y, -1.0, z));
+  PetscCall(VecNorm(y, NORM_INFINITY, &err));
+  PetscCheck(err <= 100 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatMult() differs by %g (relative to %g)", (double)err, (double)nrm);
+  PetscCall(MatMultAdd(A, x, b, y));
+  PetscCall(MatMultAdd(B, x, b, z));
+  PetscCall(VecNorm(z, NORM_INFINITY, &nrm));
+  PetscCall(VecAXPY(y, -1.0, z));
+  PetscCall(VecNorm(y, NORM_INFINITY, &err));
+  PetscCheck(err <= 100 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatMultAdd() differs by %g (relative to %g)", (double)err, (double)nrm);
+
+  /* the block relaxation converges for this block diagonally dominant matrix, also after changing the values */
+  PetscCall(VecNorm(b, NORM_2, &nrm));
+  for (PetscInt k = 0; k < 2; k++) {
+    if (k) PetscCall(MatShift(A, 10.0));
+    PetscCall(MatSOR(A, b, 1.0, SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS, 0.0, 20, 1, x));
+    PetscCall(MatResidual(A, b, x, r));
+    PetscCall(VecNorm(r, NORM_2, &err));
+    PetscCheck(err <= 1.e-10 * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatSOR() symmetric sweeps did not converge, residual %g", (double)err);
+    PetscCall(MatSOR(A, b, 0.9, SOR_LOCAL_FORWARD_SWEEP, 0.0, 20, 2, x));
+    PetscCall(MatResidual(A, b, x, r));
+    PetscCall(VecNorm(r, NORM_2, &err));
+    PetscCheck(err <= 1.e-10 * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatSOR() forward sweeps did not converge, residual %g", (double)err);
+  }
+
+  /* the preconditioners that use the blocks or factor the matrix are selected with the options */
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, A, A));
+  PetscCall(KSPSetTolerances(ksp, 1.e-10, PETSC_DEFAULT, PETSC_DEFAULT, 100));
+  PetscCall(KSPSetFromOptions(ksp));
+  PetscCall(KSPSolve(ksp, b, x));
+  PetscCall(MatResidual(A, b, x, r));
+  PetscCall(VecNorm(r, NORM_2, &err));
+  PetscCheck(err <= 1.e-8 * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "KSPSolve() did not converge, residual %g", (double)err);
+
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&r));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFree2(offset, bsizes));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/empty.out
+      test:
+         suffix: ilu
+         args: -pc_type ilu
+      test:
+         suffix: vpbjacobi
+         args: -pc_type vpbjacobi
+      test:
+         suffix: sor
+         args: -pc_type sor -pc_sor_symmetric
+      test:
+         suffix: bjacobi
+         nsize: 2
+         args: -pc_type bjacobi -sub_pc_type ilu
+      test:
+         suffix: vpbjacobi_2
+         nsize: 2
+         args: -pc_type vpbjacobi
+      test:
+         suffix: sor_2
+         nsize: 3
+         args: -pc_type sor -pc_sor_local_symmetric
+
+TEST*/
@@ -0,0 +1,108 @@
+static const char help[] = "Tests the assembly of MATMPIAIJ with many values set repeatedly at the same off-process locations.\n\n";
+
+#include <petscmat.h>
+
+/* each process sets nrep times the values of the first w rows of the next process, with ADD_VALUES or INSERT_VALUES;
+   the values inserted at a location are all the same since the stash does not keep the order of the insertions */
+static PetscErrorCode Assemble(Mat A, PetscInt w, PetscInt nrep, InsertMode addv, PetscBool combine)
+{
+  PetscInt    rstart, rend, N, row, col, nstash, i, j, k;
+  PetscScalar v;
+  PetscMPIInt size;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  PetscCall(MatGetSize(A, &N, NULL));
+  for (i = rstart; i < rend; i++) {
+    v = 4.0;
+    PetscCall(MatSetValues(A, 1, &i, 1, &i, &v, addv));
+  }
+  for (k = 0; k < nrep; k++) {
+    for (i = 0; i < w; i++) {
+      row = (rend + i) % N;
+      for (j = -1; j <= 1; j++) {
+        col = (row + j + N) % N;
+        v   = addv == ADD_VALUES ? 1.0 : (PetscScalar)nrep;
+        PetscCall(MatSetValues(A, 1, &row, 1, &col, &v, addv));
+      }
+    }
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  /* the stash holds the values of each location once when they are combined as they are set */
+  PetscCall(MatStashGetInfo(A, &nstash, NULL, NULL, NULL));
+  if (size > 1) PetscCheck(nstash == 3 * w * (combine ? 1 : nrep), PETSC_COMM_SELF, PETSC_ERR_PLIB, "Stash has %" PetscInt_FMT " entries", nstash);
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode Check(Mat A, PetscInt w, PetscInt nrep, InsertMode addv)
+{
+  PetscInt    rstart, rend, N, i, j, col;
+  PetscScalar v, expected;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  PetscCall(MatGetSize(A, &N, NULL));
+  for (i = rstart; i < PetscMin(rstart + w, rend); i++) {
+    for (j = -1; j <= 1; j++) {
+      col = (i + j + N) % N;
+      PetscCall(MatGetValues(A, 1, &i, 1, &col, &v));
+      if (addv == ADD_VALUES) expected = (j ? 0.0 : 4.0) + nrep;
+      else expected = nrep;
+      PetscCheck(v == expected, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Entry (%" PetscInt_FMT ", %" PetscInt_FMT ") is %g instead of %g", i, col, (double)PetscRealPart(v), (double)PetscRealPart(expected));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat       A;
+  PetscInt  n = 10, w = 4, nrep = 25;
+  PetscBool combine = PETSC_FALSE, subset = PETSC_FALSE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_combine", &combine, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-subset", &subset, NULL));
+  for (PetscInt t = 0; t < 2; t++) {
+    InsertMode addv = t ? INSERT_VALUES : ADD_VALUES;
+
+    PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, n, n, PETSC_DETERMINE, PETSC_DETERMINE, 4, NULL, 4, NULL, &A));
+    PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+    PetscCall(MatSetOption(A, MAT_SUBSET_OFF_PROC_ENTRIES, subset));
+    PetscCall(Assemble(A, w, nrep, addv, combine));
+    PetscCall(Check(A, w, nrep, addv));
+    /* assemble again into the same nonzero structure */
+    PetscCall(MatZeroEntries(A));
+    PetscCall(Assemble(A, w, nrep, addv, combine));
+    PetscCall(Check(A, w, nrep, addv));
+    PetscCall(MatDestroy(&A));
+  }
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      nsize: 3
+      output_file: output/empty.out
+      test:
+         suffix: 1
+      test:
+         suffix: 1_subset
+         args: -subset
+      test:
+         suffix: combine
+         args: -matstash_combine
+      test:
+         suffix: combine_legacy
+         args: -matstash_combine -matstash_legacy
+      test:
+         suffix: combine_subset
+         args: -matstash_combine -subset
+
+TEST*/
@@ -0,0 +1,117 @@
+static char help[] = "Tests MatMatrixPowers() against repeated MatMult().\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode AssembleLaplacian(Mat A, PetscInt m, PetscInt n, PetscScalar shift, PetscBool extra)
+{
+  PetscInt Istart, Iend;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (PetscInt Ii = Istart; Ii < Iend; Ii++) {
+    PetscInt    i = Ii / n, j = Ii - i * n;
+    PetscScalar v = -1.0;
+
+    if (i > 0) PetscCall(MatSetValue(A, Ii, Ii - n, v, INSERT_VALUES));
+    if (i < m - 1) PetscCall(MatSetValue(A, Ii, Ii + n, v, INSERT_VALUES));
+    if (j > 0) PetscCall(MatSetValue(A, Ii, Ii - 1, v, INSERT_VALUES));
+    if (j < n - 1) PetscCall(MatSetValue(A, Ii, Ii + 1, v, INSERT_VALUES));
+    /* a nonsymmetric coupling to check the orientation of the products */
+    if (i > 1) PetscCall(MatSetValue(A, Ii, Ii - 2 * n, 0.5, INSERT_VALUES));
+    if (extra && i < m - 2) PetscCall(MatSetValue(A, Ii, Ii + 2 * n, 0.25, INSERT_VALUES));
+    PetscCall(MatSetValue(A, Ii, Ii, 4.0 + shift, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode CheckPowers(Mat A, PetscInt k, Vec x)
+{
+  Vec      *y, *yref;
+  PetscReal err, nrm;
+
+  PetscFunctionBegin;
+  PetscCall(VecDuplicateVecs(x, k, &y));
+  PetscCall(VecDuplicateVecs(x, k, &yref));
+  PetscCall(MatMatrixPowers(A, k, x, y));
+  PetscCall(MatMult(A, x, yref[0]));
+  for (PetscInt i = 1; i < k; i++) PetscCall(MatMult(A, yref[i - 1], yref[i]));
+  for (PetscInt i = 0; i < k; i++) {
+    PetscCall(VecNorm(yref[i], NORM_INFINITY, &nrm));
+    PetscCall(VecAXPY(y[i], -1.0, yref[i]));
+    PetscCall(VecNorm(y[i], NORM_INFINITY, &err));
+    PetscCheck(err <= 100 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "A^%" PetscInt_FMT " x has error %g", i + 1, (double)err);
+  }
+  PetscCall(VecDestroyVecs(k, &yref));
+  PetscCall(VecDestroyVecs(k, &y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A;
+  Vec         x;
+  PetscInt    m = 8, n = 7, k = 3;
+  PetscRandom rnd;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-k", &k, NULL));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, m * n, m * n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSetUp(A));
+  PetscCall(AssembleLaplacian(A, m, n, 0.0, PETSC_FALSE));
+  PetscCall(MatCreateVecs(A, &x, NULL));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rnd));
+  PetscCall(PetscRandomSetFromOptions(rnd));
+  PetscCall(VecSetRandom(x, rnd));
+
+  PetscCall(CheckPowers(A, k, x));
+  /* a smaller number of products reuses the ghost region, a larger one rebuilds it */
+  PetscCall(CheckPowers(A, 1, x));
+  PetscCall(CheckPowers(A, k + 1, x));
+  /* new values with the same nonzero pattern refresh the ghost region */
+  PetscCall(AssembleLaplacian(A, m, n, 1.0, PETSC_FALSE));
+  PetscCall(CheckPowers(A, k, x));
+  /* new nonzeros disassemble the matrix and change the ghost region */
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(AssembleLaplacian(A, m, n, 1.0, PETSC_TRUE));
+  PetscCall(CheckPowers(A, k, x));
+  /* a new preallocation with the original nonzero pattern */
+  PetscCall(MatSeqAIJSetPreallocation(A, 6, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(A, 6, NULL, 6, NULL));
+  PetscCall(AssembleLaplacian(A, m, n, 0.0, PETSC_FALSE));
+  PetscCall(CheckPowers(A, k, x));
+
+  PetscCall(PetscRandomDestroy(&rnd));
+  PetscCall(VecDestroy(&x));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      output_file: output/empty.out
+      args: -k {{1 3}}
+
+      test:
+        suffix: 1
+        nsize: {{1 3 4}}
+
+      test:
+        suffix: 2
+        nsize: 4
+        args: -m 3 -n 2
+
+      test:
+        suffix: seq
+        args: -mat_type seqaij
+
+TEST*/
@@ -0,0 +1,115 @@
+static char help[] = "Tests MatMult() with -matmult_split_rows after the off-process nonzero pattern of the matrix changes.\n\n";
+
+#include <petscmat.h>
+
+/* a periodic 1d Laplacian of size N, with the coupling of each row i with the row i + far */
+static PetscErrorCode Assemble(Mat A, PetscInt far)
+{
+  PetscInt N, Istart, Iend;
+
+  PetscFunctionBegin;
+  PetscCall(MatGetSize(A, &N, NULL));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (PetscInt i = Istart; i < Iend; i++) {
+    PetscCall(MatSetValue(A, i, (i + N - 1) % N, -1.0, ADD_VALUES));
+    PetscCall(MatSetValue(A, i, (i + 1) % N, -1.0, ADD_VALUES));
+    PetscCall(MatSetValue(A, i, (i + far) % N, 0.5, ADD_VALUES));
+    PetscCall(MatSetValue(A, i, i, 3.0 + (PetscReal)i / N, ADD_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* A is set from the options, Aref is the same matrix with the default MatMult() */
+static PetscErrorCode CheckMult(Mat A, Mat Aref, Vec x)
+{
+  Vec       y, yref;
+  PetscReal err, nrm;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreateVecs(A, NULL, &y));
+  PetscCall(VecDuplicate(y, &yref));
+  PetscCall(MatMult(A, x, y));
+  PetscCall(MatMult(Aref, x, yref));
+  PetscCall(VecNorm(yref, NORM_INFINITY, &nrm));
+  PetscCall(VecAXPY(y, -1.0, yref));
+  PetscCall(VecNorm(y, NORM_INFINITY, &err));
+  PetscCheck(err <= 100 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatMult() has error %g", (double)err);
+  PetscCall(MatMultAdd(A, x, yref, y));
+  PetscCall(MatMultAdd(Aref, x, yref, yref));
+  PetscCall(VecAXPY(y, -1.0, yref));
+  PetscCall(VecNorm(y, NORM_INFINITY, &err));
+  PetscCheck(err <= 100 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "MatMultAdd() has error %g", (double)err);
+  PetscCall(VecDestroy(&yref));
+  PetscCall(VecDestroy(&y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Mat         A, Aref;
+  Vec         x;
+  PetscInt    N = 40, far[2] = {10, 15}, nfar = 2;
+  PetscRandom rnd;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-N", &N, NULL));
+  PetscCall(PetscOptionsGetIntArray(NULL, NULL, "-far", far, &nfar, NULL));
+
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, N, N));
+  PetscCall(MatSetType(A, MATAIJ));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &Aref));
+  PetscCall(MatSetOptionsPrefix(Aref, "ref_"));
+  PetscCall(MatSetSizes(Aref, PETSC_DECIDE, PETSC_DECIDE, N, N));
+  PetscCall(MatSetType(Aref, MATAIJ));
+  PetscCall(MatSetFromOptions(Aref));
+
+  /* with 4 processes, the first pattern couples each process with its two neighbors, the second one also with the second next */
+  PetscCall(MatSeqAIJSetPreallocation(A, 4, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(A, 4, NULL, 3, NULL));
+  PetscCall(Assemble(A, far[0]));
+  PetscCall(MatSetUp(Aref));
+  PetscCall(MatSetOption(Aref, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(Assemble(Aref, far[0]));
+  PetscCall(MatCreateVecs(A, &x, NULL));
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rnd));
+  PetscCall(PetscRandomSetFromOptions(rnd));
+  PetscCall(VecSetRandom(x, rnd));
+  PetscCall(CheckMult(A, Aref, x));
+
+  /* a new preallocation with the same number of off-process nonzeros, so the same nonzero state, but other neighbors */
+  PetscCall(MatSeqAIJSetPreallocation(A, 4, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(A, 4, NULL, 3, NULL));
+  PetscCall(Assemble(A, far[1]));
+  PetscCall(MatZeroEntries(Aref));
+  PetscCall(Assemble(Aref, far[1]));
+  PetscCall(CheckMult(A, Aref, x));
+
+  /* new nonzeros disassemble the matrix */
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(MatZeroEntries(A));
+  PetscCall(Assemble(A, far[0]));
+  PetscCall(MatZeroEntries(Aref));
+  PetscCall(Assemble(Aref, far[0]));
+  PetscCall(CheckMult(A, Aref, x));
+
+  PetscCall(PetscRandomDestroy(&rnd));
+  PetscCall(VecDestroy(&x));
+  PetscCall(MatDestroy(&Aref));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{2 3 4}}
+      args: -matmult_split_rows
+      output_file: output/empty.out
+
+TEST*/
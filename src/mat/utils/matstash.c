@@ -77,6 +77,11 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm, PetscInt bs, MatStash *stas
   stash->blocktype   = MPI_DATATYPE_NULL;
 
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_reproduce", &stash->reproduce, NULL));
+  /* combining is only done for the point stash, whose values are set by MatSetValues() of MATMPIAIJ */
+  stash->ht = NULL;
+  flg       = PETSC_FALSE;
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_combine", &flg, NULL));
+  if (flg && bs == 1) PetscCall(PetscHMapIJVCreate(&stash->ht));
 #if !defined(PETSC_HAVE_MPIUNI)
   flg = PETSC_FALSE;
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_legacy", &flg, NULL));
@@ -104,6 +109,7 @@ PetscErrorCode MatStashDestroy_Private(MatStash *stash)
 {
   PetscFunctionBegin;
   PetscCall(PetscMatStashSpaceDestroy(&stash->space_head));
+  PetscCall(PetscHMapIJVDestroy(&stash->ht));
   if (stash->ScatterDestroy) PetscCall((*stash->ScatterDestroy)(stash));
   stash->space = NULL;
   PetscCall(PetscFree(stash->flg_v));
@@ -247,7 +253,7 @@ static PetscErrorCode MatStashExpand_Private(MatStash *stash, PetscInt incr)
 
   Input Parameters:
   stash  - the stash
-  row    - the global row correspoiding to the values
+  row    - the global row corresponding to the values
   n      - the number of elements inserted. All elements belong to the above row.
   idxn   - the global column indices corresponding to each of the values.
   values - the values inserted
@@ -283,11 +289,11 @@ PetscErrorCode MatStashValuesRow_Private(MatStash *stash, PetscInt row, PetscInt
 
   Input Parameters:
   stash   - the stash
-  row     - the global row correspoiding to the values
+  row     - the global row corresponding to the values
   n       - the number of elements inserted. All elements belong to the above row.
   idxn    - the global column indices corresponding to each of the values.
   values  - the values inserted
-  stepval - the consecutive values are sepated by a distance of stepval.
+  stepval - the consecutive values are separated by a distance of stepval.
             this happens because the input is columnoriented.
 */
 PetscErrorCode MatStashValuesCol_Private(MatStash *stash, PetscInt row, PetscInt n, const PetscInt idxn[], const PetscScalar values[], PetscInt stepval, PetscBool ignorezeroentries)
@@ -314,6 +320,63 @@ PetscErrorCode MatStashValuesCol_Private(MatStash *stash, PetscInt row, PetscInt
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  MatStashValuesCombine_Private - inserts values into the hash table of a stash created with -matstash_combine.
+  Values set at a location already in the table are added to, or replace, the value there, so the memory used
+  grows with the number of distinct off-process locations instead of with the number of calls to MatSetValues().
+  The values are moved to the stash by MatStashScatterBegin_Private().
+
+  Input Parameters:
+  stash   - the stash
+  row     - the global row corresponding to the values
+  n       - the number of elements inserted. All elements belong to the above row.
+  idxn    - the global column indices corresponding to each of the values.
+  values  - the values inserted
+  stepval - the consecutive values are separated by a distance of stepval, 1 for row oriented values
+  addv    - ADD_VALUES or INSERT_VALUES
+*/
+PetscErrorCode MatStashValuesCombine_Private(MatStash *stash, PetscInt row, PetscInt n, const PetscInt idxn[], const PetscScalar values[], PetscInt stepval, PetscBool ignorezeroentries, InsertMode addv)
+{
+  PetscHashIJKey key;
+  PetscScalar    v;
+  PetscBool      missing;
+
+  PetscFunctionBegin;
+  key.i = row;
+  for (PetscInt i = 0; i < n; i++) {
+    if (idxn[i] < 0) continue;
+    if (ignorezeroentries && values && values[i * stepval] == 0.0) continue;
+    key.j = idxn[i];
+    v     = values ? values[i * stepval] : 0.0;
+    if (addv == ADD_VALUES) PetscCall(PetscHMapIJVQueryAdd(stash->ht, key, v, &missing));
+    else PetscCall(PetscHMapIJVSet(stash->ht, key, v));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* moves the combined values from the hash table to the stash, keeping the table allocated for the next assembly */
+static PetscErrorCode MatStashCombineFlush_Private(MatStash *stash)
+{
+  PetscHashIter  it;
+  PetscHashIJKey key;
+  PetscScalar    v;
+  PetscInt       nz;
+
+  PetscFunctionBegin;
+  PetscCall(PetscHMapIJVGetSize(stash->ht, &nz));
+  if (!nz) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!stash->space || stash->space->local_remaining < nz) PetscCall(MatStashExpand_Private(stash, nz));
+  PetscHashIterBegin(stash->ht, it);
+  while (!PetscHashIterAtEnd(stash->ht, it)) {
+    PetscHashIterGetKey(stash->ht, it, key);
+    PetscHashIterGetVal(stash->ht, it, v);
+    PetscCall(MatStashValuesRow_Private(stash, key.i, 1, &key.j, &v, PETSC_FALSE));
+    PetscHashIterNext(stash->ht, it);
+  }
+  PetscCall(PetscHMapIJVClear(stash->ht));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
   MatStashValuesRowBlocked_Private - inserts blocks of values into the stash.
   This function expects the values to be roworiented. Multiple columns belong
@@ -323,7 +386,7 @@ PetscErrorCode MatStashValuesCol_Private(MatStash *stash, PetscInt row, PetscInt
 
   Input Parameters:
   stash  - the stash
-  row    - the global block-row correspoiding to the values
+  row    - the global block-row corresponding to the values
   n      - the number of elements inserted. All elements belong to the above row.
   idxn   - the global block-column indices corresponding to each of the blocks of
            values. Each block is of size bs*bs.
@@ -374,7 +437,7 @@ PetscErrorCode MatStashValuesRowBlocked_Private(MatStash *stash, PetscInt row, P
 
   Input Parameters:
   stash  - the stash
-  row    - the global block-row correspoiding to the values
+  row    - the global block-row corresponding to the values
   n      - the number of elements inserted. All elements belong to the above row.
   idxn   - the global block-column indices corresponding to each of the blocks of
            values. Each block is of size bs*bs.
@@ -434,6 +497,7 @@ PetscErrorCode MatStashValuesColBlocked_Private(MatStash *stash, PetscInt row, P
 PetscErrorCode MatStashScatterBegin_Private(Mat mat, MatStash *stash, PetscInt *owners)
 {
   PetscFunctionBegin;
+  if (stash->ht) PetscCall(MatStashCombineFlush_Private(stash));
   PetscCall((*stash->ScatterBegin)(mat, stash, owners));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
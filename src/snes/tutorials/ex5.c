@@ -816,6 +816,13 @@ int main(int argc, char **argv)
      nsize: 2
      args: -mms 1 -par 0.0 -snes_monitor_short -snes_converged_reason -snes_view -ksp_rtol 1.0e-9 -ksp_monitor_short -ksp_type richardson -pc_type asm -pc_asm_blocks 2 -pc_asm_overlap 0 -pc_asm_local_type additive -sub_pc_type lu -da_grid_x 8
 
+   test:
+     suffix: asm_4_sf_no_datatypes
+     requires: !single
+     nsize: 2
+     output_file: output/ex5_asm_4.out
+     args: -mms 1 -par 0.0 -snes_monitor_short -snes_converged_reason -snes_view -ksp_rtol 1.0e-9 -ksp_monitor_short -ksp_type richardson -pc_type asm -pc_asm_blocks 2 -pc_asm_overlap 0 -pc_asm_local_type additive -sub_pc_type lu -da_grid_x 8 -sf_use_mpi_datatypes 0
+
    test:
      suffix: msm_4
      requires: !single
@@ -0,0 +1,457 @@
+#include <../src/vec/is/sf/impls/basic/sfpack.h>
+#include <../src/vec/is/sf/impls/basic/sfbasic.h>
+
+/* SFHierarchical inherits from SFBasic. The edges whose root and leaf are on the same node are handled by a SF with
+   only these edges. The other edges go through the leaders (the first process) of the nodes in three steps:
+
+     gathersf  - the leader of the node of the roots gathers the roots in a send buffer, one entry per edge
+     leadersf  - the leader sends the entries for a node to the leader of that node in a single message
+     scattersf - the leader of the node of the leaves scatters the entries of its receive buffer to the leaves
+
+   so that the messages between two nodes are aggregated in one message. The leaves of leadersf are in the send buffer
+   and its roots in the receive buffer, the broadcast from the roots of the SF thus does a reduction with MPI_REPLACE on
+   leadersf. Since every entry of the buffers belongs to one edge, the reductions on gathersf and scattersf are the only
+   steps that need the MPI_Op, the other ones use MPI_REPLACE.
+*/
+typedef struct _n_PetscSFHierarchicalBuf *PetscSFHierarchicalBuf;
+struct _n_PetscSFHierarchicalBuf {
+  MPI_Datatype           unit;
+  MPI_Aint               unitbytes; /* Extent of unit */
+  PetscMemType           rootmtype, leafmtype;
+  const void            *rootdata, *leafdata; /* Data of the operation using the buffers */
+  char                  *sendbuf, *recvbuf;   /* [nsend], [nrecv] units on the leaders */
+  PetscSFHierarchicalBuf next;
+};
+
+typedef struct {
+  SFBASICHEADER;
+  PetscInt               nodesize;  /* Number of consecutive processes of a node that form a group with one leader, PETSC_DECIDE for all */
+  PetscSF                localsf;   /* Edges whose root and leaf are on the same node */
+  PetscSF                gathersf;  /* Roots are the roots of the SF, leaves are the send buffer of the leader */
+  PetscSF                leadersf;  /* Roots are the receive buffer of the leaders, leaves their send buffer */
+  PetscSF                scattersf; /* Roots are the receive buffer of the leader, leaves are the leaves of the SF */
+  PetscInt               nsend;     /* Number of entries of the send buffer, nonzero only on the leaders */
+  PetscInt               nrecv;     /* Number of entries of the receive buffer, nonzero only on the leaders */
+  PetscSFHierarchicalBuf bufs;      /* Buffers of the outstanding operations */
+  PetscSFHierarchicalBuf availbufs; /* Buffers available for new operations */
+} PetscSF_Hierarchical;
+
+/*===================================================================================*/
+/*              Internal routines                                                    */
+/*===================================================================================*/
+
+/* Get buffers for an operation on rootdata and leafdata, reusing the ones of a previous operation with the same unit size */
+static PetscErrorCode PetscSFHierarchicalGetBuf(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, const void *leafdata, PetscSFHierarchicalBuf *out)
+{
+  PetscSF_Hierarchical  *hier = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierarchicalBuf buf, *p;
+  MPI_Aint               lb, unitbytes;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Type_get_extent(unit, &lb, &unitbytes));
+  for (p = &hier->availbufs; (buf = *p); p = &buf->next) {
+    if (buf->unitbytes == unitbytes) {
+      *p = buf->next;
+      break;
+    }
+  }
+  if (!buf) {
+    PetscCall(PetscNew(&buf));
+    buf->unitbytes = unitbytes;
+    PetscCall(PetscMalloc2(hier->nsend * unitbytes, &buf->sendbuf, hier->nrecv * unitbytes, &buf->recvbuf));
+  }
+  buf->unit      = unit;
+  buf->rootmtype = rootmtype;
+  buf->rootdata  = rootdata;
+  buf->leafmtype = leafmtype;
+  buf->leafdata  = leafdata;
+  buf->next      = hier->bufs;
+  hier->bufs     = buf;
+  *out           = buf;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Find the buffers of the outstanding operation on rootdata and leafdata, and remove them from the outstanding ones */
+static PetscErrorCode PetscSFHierarchicalGetBufInUse(PetscSF sf, MPI_Datatype unit, const void *rootdata, const void *leafdata, PetscSFHierarchicalBuf *out)
+{
+  PetscSF_Hierarchical  *hier = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierarchicalBuf buf, *p;
+
+  PetscFunctionBegin;
+  for (p = &hier->bufs; (buf = *p); p = &buf->next) {
+    PetscBool match;
+
+    PetscCall(MPIPetsc_Type_compare(unit, buf->unit, &match));
+    if (match && rootdata == buf->rootdata && leafdata == buf->leafdata) {
+      *p   = buf->next;
+      *out = buf;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+  SETERRQ(PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Could not find the buffers of the operation");
+}
+
+static PetscErrorCode PetscSFHierarchicalReclaimBuf(PetscSF sf, PetscSFHierarchicalBuf *buf)
+{
+  PetscSF_Hierarchical *hier = (PetscSF_Hierarchical *)sf->data;
+
+  PetscFunctionBegin;
+  (*buf)->next    = hier->availbufs;
+  hier->availbufs = *buf;
+  *buf            = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Split the communicator of the SF in nodes, and return the node communicator, whose process 0 is the leader */
+static PetscErrorCode PetscSFHierarchicalGetNodeComm(PetscSF sf, MPI_Comm *nodecomm)
+{
+  PetscSF_Hierarchical *hier = (PetscSF_Hierarchical *)sf->data;
+  MPI_Comm              comm;
+  PetscMPIInt           rank;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  {
+    PetscShmComm pshmcomm;
+    MPI_Comm     shmcomm;
+
+    PetscCall(PetscShmCommGet(comm, &pshmcomm));
+    PetscCall(PetscShmCommGetMpiShmComm(pshmcomm, &shmcomm));
+    PetscCallMPI(MPI_Comm_rank(shmcomm, &rank));
+    PetscCallMPI(MPI_Comm_split(shmcomm, hier->nodesize > 0 ? (PetscMPIInt)(rank / hier->nodesize) : 0, rank, nodecomm));
+  }
+#else
+  /* Without MPI-3 the nodes are unknown, every process is its own node unless a node size is given */
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_split(comm, hier->nodesize > 0 ? (PetscMPIInt)(rank / hier->nodesize) : rank, rank, nodecomm));
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*===================================================================================*/
+/*              Implementations of SF public APIs                                    */
+/*===================================================================================*/
+static PetscErrorCode PetscSFSetUp_Hierarchical(PetscSF sf)
+{
+  PetscSF_Hierarchical *hier = (PetscSF_Hierarchical *)sf->data;
+  MPI_Comm              comm, nodecomm;
+  PetscMPIInt           rank, size, leader, noderank, nodesize, *leaders, *counts = NULL, *displs = NULL, *keys = NULL;
+  PetscMPIInt           nto = 0, nfrom, *toranks = NULL, *fromranks, tag, nreqs = 0, cnt;
+  PetscInt              nroots, nleaves, i, j, k, nlocal = 0, noff = 0, m = 0;
+  PetscInt             *lilocal, *oilocal, *records, *allrecords = NULL, *perm = NULL, *slots = NULL, *myslots, *sorted = NULL, *todata = NULL, *fromdata, *sendrecords;
+  const PetscInt       *ilocal;
+  const PetscSFNode    *iremote;
+  PetscSFNode          *liremote, *oiremote, *giremote, *siremote;
+  MPI_Request          *reqs;
+
+  PetscFunctionBegin;
+  /* SFHierarchical inherits from Basic */
+  PetscCall(PetscSFSetUp_Basic(sf));
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscSFHierarchicalGetNodeComm(sf, &nodecomm));
+  PetscCallMPI(MPI_Comm_rank(nodecomm, &noderank));
+  PetscCallMPI(MPI_Comm_size(nodecomm, &nodesize));
+
+  /* The leader of the node of every process */
+  leader = rank;
+  PetscCallMPI(MPI_Bcast(&leader, 1, MPI_INT, 0, nodecomm));
+  PetscCall(PetscMalloc1(size, &leaders));
+  PetscCallMPI(MPI_Allgather(&leader, 1, MPI_INT, leaders, 1, MPI_INT, comm));
+
+  /* Split the edges in on-node and off-node edges */
+  PetscCall(PetscSFGetGraph(sf, &nroots, &nleaves, &ilocal, &iremote));
+  for (i = 0; i < nleaves; i++) {
+    if (leaders[iremote[i].rank] == leader) nlocal++;
+    else noff++;
+  }
+  PetscCall(PetscMalloc2(nlocal, &lilocal, nlocal, &liremote));
+  PetscCall(PetscMalloc3(noff, &oilocal, noff, &oiremote, 2 * noff, &records));
+  for (i = 0, j = 0, k = 0; i < nleaves; i++) {
+    if (leaders[iremote[i].rank] == leader) {
+      lilocal[j]  = ilocal ? ilocal[i] : i;
+      liremote[j] = iremote[i];
+      j++;
+    } else {
+      oilocal[k]         = ilocal ? ilocal[i] : i;
+      records[2 * k]     = iremote[i].rank;
+      records[2 * k + 1] = iremote[i].index;
+      k++;
+    }
+  }
+  PetscCall(PetscSFCreate(comm, &hier->localsf));
+  PetscCall(PetscSFSetType(hier->localsf, PETSCSFBASIC));
+  hier->localsf->allow_multi_leaves = sf->allow_multi_leaves;
+  PetscCall(PetscSFSetGraph(hier->localsf, nroots, nlocal, lilocal, PETSC_COPY_VALUES, liremote, PETSC_COPY_VALUES));
+  PetscCall(PetscFree2(lilocal, liremote));
+
+  /* The leader gathers the roots of the off-node edges of its node, and orders them by the leader of the node of the roots */
+  if (!noderank) PetscCall(PetscMalloc2(nodesize, &counts, nodesize + 1, &displs));
+  PetscCall(PetscMPIIntCast(2 * noff, &cnt));
+  PetscCallMPI(MPI_Gather(&cnt, 1, MPI_INT, counts, 1, MPI_INT, 0, nodecomm));
+  if (!noderank) {
+    displs[0] = 0;
+    for (i = 0; i < nodesize; i++) displs[i + 1] = displs[i] + counts[i];
+    m = displs[nodesize] / 2;
+    PetscCall(PetscMalloc5(2 * m, &allrecords, m, &keys, m, &perm, m, &slots, 2 * m, &sorted));
+  }
+  PetscCallMPI(MPI_Gatherv(records, cnt, MPIU_INT, allrecords, counts, displs, MPIU_INT, 0, nodecomm));
+  for (k = 0; k < m; k++) {
+    keys[k] = leaders[allrecords[2 * k]];
+    perm[k] = k;
+  }
+  PetscCall(PetscSortMPIIntWithIntArray((PetscMPIInt)m, keys, perm));
+  for (k = 0; k < m; k++) {
+    slots[perm[k]]    = k;
+    sorted[2 * k]     = allrecords[2 * perm[k]];
+    sorted[2 * k + 1] = allrecords[2 * perm[k] + 1];
+    if (!k || keys[k] != keys[k - 1]) nto++;
+  }
+  hier->nrecv = m;
+
+  /* The processes get the entries of their off-node leaves in the receive buffer of their leader */
+  if (!noderank) {
+    for (i = 0; i < nodesize; i++) {
+      counts[i] /= 2;
+      displs[i] /= 2;
+    }
+  }
+  PetscCall(PetscMalloc1(noff, &myslots));
+  PetscCallMPI(MPI_Scatterv(slots, counts, displs, MPIU_INT, myslots, (PetscMPIInt)noff, MPIU_INT, 0, nodecomm));
+  for (k = 0; k < noff; k++) {
+    oiremote[k].rank  = leader;
+    oiremote[k].index = myslots[k];
+  }
+  PetscCall(PetscSFCreate(comm, &hier->scattersf));
+  PetscCall(PetscSFSetType(hier->scattersf, PETSCSFBASIC));
+  hier->scattersf->allow_multi_leaves = sf->allow_multi_leaves;
+  PetscCall(PetscSFSetGraph(hier->scattersf, hier->nrecv, noff, oilocal, PETSC_COPY_VALUES, oiremote, PETSC_COPY_VALUES));
+  PetscCall(PetscFree(myslots));
+  PetscCall(PetscFree3(oilocal, oiremote, records));
+
+  /* The leaders send the roots of the edges to the leaders of the nodes of the roots, with the offset in their receive buffer */
+  PetscCall(PetscMalloc2(nto, &toranks, 2 * nto, &todata));
+  for (k = 0, j = 0; k < m; k++) {
+    if (k && keys[k] == keys[k - 1]) continue;
+    toranks[j]        = keys[k];
+    todata[2 * j + 1] = k;
+    if (j) todata[2 * j - 2] = k - todata[2 * j - 1];
+    j++;
+  }
+  if (nto) todata[2 * nto - 2] = m - todata[2 * nto - 1];
+  PetscCall(PetscCommBuildTwoSided(comm, 2, MPIU_INT, nto, toranks, todata, &nfrom, &fromranks, &fromdata));
+  for (i = 0, hier->nsend = 0; i < nfrom; i++) hier->nsend += fromdata[2 * i];
+  PetscCall(PetscMalloc1(2 * hier->nsend, &sendrecords));
+  PetscCall(PetscMalloc1(nto + nfrom, &reqs));
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag));
+  for (i = 0, k = 0; i < nfrom; i++) {
+    PetscCall(PetscMPIIntCast(2 * fromdata[2 * i], &cnt));
+    PetscCallMPI(MPI_Irecv(sendrecords + 2 * k, cnt, MPIU_INT, fromranks[i], tag, comm, &reqs[nreqs++]));
+    k += fromdata[2 * i];
+  }
+  for (i = 0; i < nto; i++) {
+    PetscCall(PetscMPIIntCast(2 * todata[2 * i], &cnt));
+    PetscCallMPI(MPI_Isend(sorted + 2 * todata[2 * i + 1], cnt, MPIU_INT, toranks[i], tag, comm, &reqs[nreqs++]));
+  }
+  PetscCallMPI(MPI_Waitall(nreqs, reqs, MPI_STATUSES_IGNORE));
+  PetscCall(PetscFree(reqs));
+
+  /* The send buffer of a leader holds the entries for the nodes of fromranks[] one after the other */
+  PetscCall(PetscMalloc2(hier->nsend, &giremote, hier->nsend, &siremote));
+  for (i = 0, k = 0; i < nfrom; i++) {
+    for (j = 0; j < fromdata[2 * i]; j++, k++) {
+      giremote[k].rank  = sendrecords[2 * k];
+      giremote[k].index = sendrecords[2 * k + 1];
+      siremote[k].rank  = fromranks[i];
+      siremote[k].index = fromdata[2 * i + 1] + j;
+    }
+  }
+  PetscCall(PetscSFCreate(comm, &hier->gathersf));
+  PetscCall(PetscSFSetType(hier->gathersf, PETSCSFBASIC));
+  PetscCall(PetscSFSetGraph(hier->gathersf, nroots, hier->nsend, NULL, PETSC_OWN_POINTER, giremote, PETSC_COPY_VALUES));
+  PetscCall(PetscSFCreate(comm, &hier->leadersf));
+  PetscCall(PetscSFSetType(hier->leadersf, PETSCSFBASIC));
+  PetscCall(PetscSFSetGraph(hier->leadersf, hier->nrecv, hier->nsend, NULL, PETSC_OWN_POINTER, siremote, PETSC_COPY_VALUES));
+  PetscCall(PetscSFSetUp(hier->localsf));
+  PetscCall(PetscSFSetUp(hier->gathersf));
+  PetscCall(PetscSFSetUp(hier->leadersf));
+  PetscCall(PetscSFSetUp(hier->scattersf));
+
+  PetscCall(PetscFree2(giremote, siremote));
+  PetscCall(PetscFree(sendrecords));
+  PetscCall(PetscFree(fromranks));
+  PetscCall(PetscFree(fromdata));
+  PetscCall(PetscFree2(toranks, todata));
+  if (!noderank) {
+    PetscCall(PetscFree2(counts, displs));
+    PetscCall(PetscFree5(allrecords, keys, perm, slots, sorted));
+  }
+  PetscCall(PetscFree(leaders));
+  PetscCallMPI(MPI_Comm_free(&nodecomm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReset_Hierarchical(PetscSF sf)
+{
+  PetscSF_Hierarchical  *hier = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierarchicalBuf buf, next;
+
+  PetscFunctionBegin;
+  PetscCheck(!hier->bufs, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding operation has not been completed");
+  for (buf = hier->availbufs; buf; buf = next) {
+    next = buf->next;
+    PetscCall(PetscFree2(buf->sendbuf, buf->recvbuf));
+    PetscCall(PetscFree(buf));
+  }
+  hier->availbufs = NULL;
+  hier->nsend     = 0;
+  hier->nrecv     = 0;
+  PetscCall(PetscSFDestroy(&hier->localsf));
+  PetscCall(PetscSFDestroy(&hier->gathersf));
+  PetscCall(PetscSFDestroy(&hier->leadersf));
+  PetscCall(PetscSFDestroy(&hier->scattersf));
+  PetscCall(PetscSFReset_Basic(sf)); /* Common part */
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDestroy_Hierarchical(PetscSF sf)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSFReset_Hierarchical(sf));
+  PetscCall(PetscFree(sf->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Hierarchical(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Hierarchical *hier = (PetscSF_Hierarchical *)sf->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Hierarchical options");
+  PetscCall(PetscOptionsInt("-sf_hierarchical_node_size", "Number of consecutive processes of a node that communicate with the other nodes through one leader", "PetscSFSetFromOptions", hier->nodesize, &hier->nodesize, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDuplicate_Hierarchical(PetscSF sf, PetscSFDuplicateOption opt, PetscSF newsf)
+{
+  PetscSF_Hierarchical *hier = (PetscSF_Hierarchical *)sf->data, *newhier = (PetscSF_Hierarchical *)newsf->data;
+
+  PetscFunctionBegin;
+  newhier->nodesize = hier->nodesize;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFView_Hierarchical(PetscSF sf, PetscViewer viewer)
+{
+  PetscSF_Hierarchical *hier = (PetscSF_Hierarchical *)sf->data;
+  PetscBool             iascii;
+  PetscViewerFormat     format;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFView_Basic(sf, viewer));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  if (iascii && format == PETSC_VIEWER_ASCII_INFO_DETAIL && sf->setupcalled) {
+    PetscInt    nlocal, nleaders;
+    PetscMPIInt rank;
+
+    PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)sf), &rank));
+    PetscCall(PetscSFGetGraph(hier->localsf, NULL, &nlocal, NULL, NULL));
+    PetscCall(PetscSFGetRootRanks(hier->leadersf, &nleaders, NULL, NULL, NULL, NULL));
+    PetscCall(PetscViewerASCIIPushSynchronized(viewer));
+    PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "  [%d] On-node edges=%" PetscInt_FMT ", entries sent to %" PetscInt_FMT " leaders=%" PetscInt_FMT ", entries received from the leaders=%" PetscInt_FMT "\n", rank, nlocal, nleaders, hier->nsend, hier->nrecv));
+    PetscCall(PetscViewerFlush(viewer));
+    PetscCall(PetscViewerASCIIPopSynchronized(viewer));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastBegin_Hierarchical(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
+{
+  PetscSF_Hierarchical  *hier = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierarchicalBuf buf;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFBcastWithMemTypeBegin(hier->localsf, unit, rootmtype, rootdata, leafmtype, leafdata, op));
+  /* Gather the roots of the off-node edges on the leader and start sending them to the leaders of the nodes of the leaves */
+  PetscCall(PetscSFHierarchicalGetBuf(sf, unit, rootmtype, rootdata, leafmtype, leafdata, &buf));
+  PetscCall(PetscSFBcastWithMemTypeBegin(hier->gathersf, unit, rootmtype, rootdata, PETSC_MEMTYPE_HOST, buf->sendbuf, MPI_REPLACE));
+  PetscCall(PetscSFBcastEnd(hier->gathersf, unit, rootdata, buf->sendbuf, MPI_REPLACE));
+  PetscCall(PetscSFReduceWithMemTypeBegin(hier->leadersf, unit, PETSC_MEMTYPE_HOST, buf->sendbuf, PETSC_MEMTYPE_HOST, buf->recvbuf, MPI_REPLACE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastEnd_Hierarchical(PetscSF sf, MPI_Datatype unit, const void *rootdata, void *leafdata, MPI_Op op)
+{
+  PetscSF_Hierarchical  *hier = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierarchicalBuf buf;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFHierarchicalGetBufInUse(sf, unit, rootdata, leafdata, &buf));
+  PetscCall(PetscSFReduceEnd(hier->leadersf, unit, buf->sendbuf, buf->recvbuf, MPI_REPLACE));
+  PetscCall(PetscSFBcastWithMemTypeBegin(hier->scattersf, unit, PETSC_MEMTYPE_HOST, buf->recvbuf, buf->leafmtype, leafdata, op));
+  PetscCall(PetscSFBcastEnd(hier->scattersf, unit, buf->recvbuf, leafdata, op));
+  PetscCall(PetscSFHierarchicalReclaimBuf(sf, &buf));
+  PetscCall(PetscSFBcastEnd(hier->localsf, unit, rootdata, leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Hierarchical(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op)
+{
+  PetscSF_Hierarchical  *hier = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierarchicalBuf buf;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFReduceWithMemTypeBegin(hier->localsf, unit, leafmtype, leafdata, rootmtype, rootdata, op));
+  /* Gather the leaves of the off-node edges on the leader and start sending them to the leaders of the nodes of the roots */
+  PetscCall(PetscSFHierarchicalGetBuf(sf, unit, rootmtype, rootdata, leafmtype, leafdata, &buf));
+  PetscCall(PetscSFReduceWithMemTypeBegin(hier->scattersf, unit, leafmtype, leafdata, PETSC_MEMTYPE_HOST, buf->recvbuf, MPI_REPLACE));
+  PetscCall(PetscSFReduceEnd(hier->scattersf, unit, leafdata, buf->recvbuf, MPI_REPLACE));
+  PetscCall(PetscSFBcastWithMemTypeBegin(hier->leadersf, unit, PETSC_MEMTYPE_HOST, buf->recvbuf, PETSC_MEMTYPE_HOST, buf->sendbuf, MPI_REPLACE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Hierarchical(PetscSF sf, MPI_Datatype unit, const void *leafdata, void *rootdata, MPI_Op op)
+{
+  PetscSF_Hierarchical  *hier = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierarchicalBuf buf;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFHierarchicalGetBufInUse(sf, unit, rootdata, leafdata, &buf));
+  PetscCall(PetscSFBcastEnd(hier->leadersf, unit, buf->recvbuf, buf->sendbuf, MPI_REPLACE));
+  PetscCall(PetscSFReduceWithMemTypeBegin(hier->gathersf, unit, PETSC_MEMTYPE_HOST, buf->sendbuf, buf->rootmtype, rootdata, op));
+  PetscCall(PetscSFReduceEnd(hier->gathersf, unit, buf->sendbuf, rootdata, op));
+  PetscCall(PetscSFHierarchicalReclaimBuf(sf, &buf));
+  PetscCall(PetscSFReduceEnd(hier->localsf, unit, leafdata, rootdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFCreate_Hierarchical(PetscSF sf)
+{
+  PetscSF_Hierarchical *dat;
+
+  PetscFunctionBegin;
+  sf->ops->CreateEmbeddedRootSF = PetscSFCreateEmbeddedRootSF_Basic;
+  sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
+  sf->ops->FetchAndOpBegin      = PetscSFFetchAndOpBegin_Basic;
+  sf->ops->FetchAndOpEnd        = PetscSFFetchAndOpEnd_Basic;
+
+  sf->ops->SetUp          = PetscSFSetUp_Hierarchical;
+  sf->ops->Reset          = PetscSFReset_Hierarchical;
+  sf->ops->Destroy        = PetscSFDestroy_Hierarchical;
+  sf->ops->SetFromOptions = PetscSFSetFromOptions_Hierarchical;
+  sf->ops->Duplicate      = PetscSFDuplicate_Hierarchical;
+  sf->ops->View           = PetscSFView_Hierarchical;
+  sf->ops->BcastBegin     = PetscSFBcastBegin_Hierarchical;
+  sf->ops->BcastEnd       = PetscSFBcastEnd_Hierarchical;
+  sf->ops->ReduceBegin    = PetscSFReduceBegin_Hierarchical;
+  sf->ops->ReduceEnd      = PetscSFReduceEnd_Hierarchical;
+
+  PetscCall(PetscNew(&dat));
+  dat->nodesize = PETSC_DECIDE;
+  sf->data      = (void *)dat;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
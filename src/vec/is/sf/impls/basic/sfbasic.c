@@ -210,6 +210,79 @@ PETSC_INTERN PetscErrorCode PetscSFBcastEnd_Basic(PetscSF sf, MPI_Datatype unit,
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Broadcast nvec host arrays with one message per rank. The arrays of pointers are the keys of the link */
+static PetscErrorCode PetscSFBcastMultiBegin_Basic(PetscSF sf, MPI_Datatype unit, PetscInt nvec, const void *const *rootdata, void *const *leafdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkCreateMulti_MPI(sf, unit, nvec, rootdata, leafdata, op, &link));
+  PetscCall(PetscSFLinkPackRootDataMulti(sf, link, rootdata));
+  PetscCall(PetscSFLinkStartCommunication(sf, link, PETSCSF_ROOT2LEAF));
+  for (PetscInt j = 0; j < nvec; j++) PetscCall(PetscSFLinkScatterLocal(sf, link, PETSCSF_ROOT2LEAF, (void *)rootdata[j], leafdata[j], op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastMultiEnd_Basic(PetscSF sf, MPI_Datatype unit, PetscInt nvec, const void *const *rootdata, void *const *leafdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_OWN_POINTER, &link));
+  PetscCall(PetscSFLinkFinishCommunication(sf, link, PETSCSF_ROOT2LEAF));
+  PetscCall(PetscSFLinkUnpackLeafDataMulti(sf, link, leafdata, op));
+  PetscCall(PetscSFLinkReclaim(sf, &link));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Complete the receives of leaves one root rank at a time with MPI_Waitsome(). Only host data sent with MPI in its own
+   precision is done this way, otherwise the whole bcast is completed on the first call */
+static PetscErrorCode PetscSFBcastEndSome_Basic(PetscSF sf, MPI_Datatype unit, const void *rootdata, void *leafdata, MPI_Op op, PetscInt *ndone, PetscInt done[])
+{
+  PetscSF_Basic *bas  = (PetscSF_Basic *)sf->data;
+  PetscSFLink    link = NULL;
+  PetscMPIInt    nreqs, n = 0;
+  MPI_Request   *leafreqs;
+  PetscInt       i, cnt = 0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_USE_POINTER, &link));
+  if (link->use_nvshmem || link->use_float || !PetscMemTypeHost(link->leafmtype) || !PetscMemTypeHost(link->rootmtype)) {
+    PetscCall(PetscSFBcastEnd_Basic(sf, unit, rootdata, leafdata, op));
+    for (i = 0; i < sf->nranks; i++) done[i] = i;
+    *ndone = sf->nranks;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  /* The local scatter was done in PetscSFBcastBegin_Basic() */
+  if (!link->nleafranksdone)
+    for (; cnt < sf->ndranks; cnt++) done[cnt] = cnt;
+  PetscCall(PetscMPIIntCast(sf->nleafreqs, &nreqs));
+  if (link->nleafranksdone + cnt < sf->nranks) {
+    if (!link->leafreqsdone) PetscCall(PetscMalloc1(nreqs, &link->leafreqsdone));
+    leafreqs = link->leafreqs[PETSCSF_ROOT2LEAF][PETSC_MEMTYPE_HOST][link->leafdirect_mpi];
+    /* Do not block if we already have something to return */
+    if (cnt) PetscCallMPI(MPI_Testsome(nreqs, leafreqs, &n, link->leafreqsdone, MPI_STATUSES_IGNORE));
+    else PetscCallMPI(MPI_Waitsome(nreqs, leafreqs, &n, link->leafreqsdone, MPI_STATUSES_IGNORE));
+    PetscCheck(n != MPI_UNDEFINED, PETSC_COMM_SELF, PETSC_ERR_PLIB, "No pending receive in the bcast");
+    for (PetscMPIInt j = 0; j < n; j++) {
+      i = sf->ndranks + link->leafreqsdone[j];
+      PetscCall(PetscSFLinkUnpackLeafDataOfRank(sf, link, i, leafdata, op));
+      done[cnt++] = i;
+    }
+  }
+  link->nleafranksdone += cnt;
+  *ndone = cnt;
+
+  if (link->nleafranksdone == sf->nranks) { /* All leaves were received, wait for the sends and release the link */
+    PetscCallMPI(MPI_Waitall(bas->nrootreqs, link->rootreqs[PETSCSF_ROOT2LEAF][PETSC_MEMTYPE_HOST][link->rootdirect_mpi], MPI_STATUSES_IGNORE));
+    PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_OWN_POINTER, &link));
+    link->nleafranksdone = 0;
+    PetscCall(PetscSFLinkReclaim(sf, &link));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* Shared by ReduceBegin and FetchAndOpBegin */
 static inline PetscErrorCode PetscSFLeafToRootBegin_Basic(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op, PetscSFOperation sfop, PetscSFLink *out)
 {
@@ -256,7 +329,7 @@ PETSC_INTERN PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF sf, MPI_Datatyp
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf, MPI_Datatype unit, void *rootdata, const void *leafdata, void *leafupdate, MPI_Op op)
+PETSC_INTERN PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf, MPI_Datatype unit, void *rootdata, const void *leafdata, void *leafupdate, MPI_Op op)
 {
   PetscSFLink link = NULL;
 
@@ -444,6 +517,9 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->View                 = PetscSFView_Basic;
   sf->ops->BcastBegin           = PetscSFBcastBegin_Basic;
   sf->ops->BcastEnd             = PetscSFBcastEnd_Basic;
+  sf->ops->BcastEndSome         = PetscSFBcastEndSome_Basic;
+  sf->ops->BcastMultiBegin      = PetscSFBcastMultiBegin_Basic;
+  sf->ops->BcastMultiEnd        = PetscSFBcastMultiEnd_Basic;
   sf->ops->ReduceBegin          = PetscSFReduceBegin_Basic;
   sf->ops->ReduceEnd            = PetscSFReduceEnd_Basic;
   sf->ops->FetchAndOpBegin      = PetscSFFetchAndOpBegin_Basic;
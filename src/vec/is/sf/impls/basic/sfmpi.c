@@ -4,6 +4,21 @@
 
 #include <../src/vec/is/sf/impls/basic/sfpack.h>
 
+/* Round the n units of buf to float in fbuf, or the other way around, when the link sends PetscScalar data in single precision */
+static PetscErrorCode PetscSFLinkConvertFloatBuffer_Private(PetscSFLink link, PetscInt n, PetscBool tofloat, char *buf, float *fbuf)
+{
+  PetscReal *rbuf = (PetscReal *)buf;
+  PetscInt   m    = n * link->nvec * (PetscInt)(link->unitbytes / sizeof(PetscReal));
+
+  PetscFunctionBegin;
+  if (tofloat) {
+    for (PetscInt i = 0; i < m; i++) fbuf[i] = (float)rbuf[i];
+  } else {
+    for (PetscInt i = 0; i < m; i++) rbuf[i] = (PetscReal)fbuf[i];
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* Start MPI requests. If use non-GPU aware MPI, we might need to copy data from device buf to host buf */
 static PetscErrorCode PetscSFLinkStartRequests_MPI(PetscSF sf, PetscSFLink link, PetscSFDirection direction)
 {
@@ -11,6 +26,7 @@ static PetscErrorCode PetscSFLinkStartRequests_MPI(PetscSF sf, PetscSFLink link,
   MPI_Request   *reqs = NULL;
   PetscSF_Basic *bas  = (PetscSF_Basic *)sf->data;
   PetscInt       buflen;
+  MPI_Datatype   unit = link->use_float ? link->floatunit : link->unit;
 
   PetscFunctionBegin;
   buflen = (direction == PETSCSF_ROOT2LEAF) ? sf->leafbuflen[PETSCSF_REMOTE] : bas->rootbuflen[PETSCSF_REMOTE];
@@ -22,7 +38,7 @@ static PetscErrorCode PetscSFLinkStartRequests_MPI(PetscSF sf, PetscSFLink link,
       nreqs = bas->nrootreqs;
       PetscCall(PetscSFLinkGetMPIBuffersAndRequests(sf, link, direction, NULL, NULL, &reqs, NULL));
     }
-    PetscCallMPI(MPI_Startall_irecv(buflen, link->unit, nreqs, reqs));
+    PetscCallMPI(MPI_Startall_irecv(buflen * link->nvec, unit, nreqs, reqs));
   }
 
   buflen = (direction == PETSCSF_ROOT2LEAF) ? bas->rootbuflen[PETSCSF_REMOTE] : sf->leafbuflen[PETSCSF_REMOTE];
@@ -37,7 +53,11 @@ static PetscErrorCode PetscSFLinkStartRequests_MPI(PetscSF sf, PetscSFLink link,
       PetscCall(PetscSFLinkGetMPIBuffersAndRequests(sf, link, direction, NULL, NULL, NULL, &reqs));
     }
     PetscCall(PetscSFLinkSyncStreamBeforeCallMPI(sf, link, direction));
-    PetscCallMPI(MPI_Startall_isend(buflen, link->unit, nreqs, reqs));
+    if (link->use_float) {
+      if (direction == PETSCSF_ROOT2LEAF) PetscCall(PetscSFLinkConvertFloatBuffer_Private(link, buflen, PETSC_TRUE, link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST], link->rootbuf_float));
+      else PetscCall(PetscSFLinkConvertFloatBuffer_Private(link, buflen, PETSC_TRUE, link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST], link->leafbuf_float));
+    }
+    PetscCallMPI(MPI_Startall_isend(buflen * link->nvec, unit, nreqs, reqs));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -52,8 +72,10 @@ static PetscErrorCode PetscSFLinkWaitRequests_MPI(PetscSF sf, PetscSFLink link,
   PetscCallMPI(MPI_Waitall(bas->nrootreqs, link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi], MPI_STATUSES_IGNORE));
   PetscCallMPI(MPI_Waitall(sf->nleafreqs, link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi], MPI_STATUSES_IGNORE));
   if (direction == PETSCSF_ROOT2LEAF) {
+    if (link->use_float && sf->leafbuflen[PETSCSF_REMOTE]) PetscCall(PetscSFLinkConvertFloatBuffer_Private(link, sf->leafbuflen[PETSCSF_REMOTE], PETSC_FALSE, link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST], link->leafbuf_float));
     PetscCall(PetscSFLinkCopyLeafBufferInCaseNotUseGpuAwareMPI(sf, link, PETSC_FALSE /* host2device after recving */));
   } else {
+    if (link->use_float && bas->rootbuflen[PETSCSF_REMOTE]) PetscCall(PetscSFLinkConvertFloatBuffer_Private(link, bas->rootbuflen[PETSCSF_REMOTE], PETSC_FALSE, link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST], link->rootbuf_float));
     PetscCall(PetscSFLinkCopyRootBufferInCaseNotUseGpuAwareMPI(sf, link, PETSC_FALSE));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -124,6 +146,19 @@ static PetscErrorCode PetscSFLinkWaitEnqueue_MPIX_Stream(PetscSF sf, PetscSFLink
 }
 #endif
 
+/* Does unit have no holes, so that derived datatypes built from it address root/leafdata the way SF does, with unitbytes? */
+static PetscErrorCode PetscSFUnitIsDense_Private(MPI_Datatype unit, PetscBool *dense)
+{
+  MPI_Aint    lb, extent;
+  PetscMPIInt size;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Type_get_extent(unit, &lb, &extent));
+  PetscCallMPI(MPI_Type_size(unit, &size));
+  *dense = (lb == 0 && extent == (MPI_Aint)size) ? PETSC_TRUE : PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
    The routine Creates a communication link for the given operation. It first looks up its link cache. If
    there is a free & suitable one, it uses it. Otherwise it creates a new one.
@@ -137,10 +172,20 @@ static PetscErrorCode PetscSFLinkWaitEnqueue_MPIX_Stream(PetscSF sf, PetscSFLink
 
    In SFBasic, MPI requests are persistent. They are init'ed until we try to get requests from a link.
 
+   With persistent requests, remote root/leafdata that is not contiguous but has a pack optimization plan (i.e., the indices of
+   each rank form a strided 3D submatrix) is also directly passed to MPI, with a derived datatype per rank, saving the pack and
+   unpack. The receiving side needs MPI_REPLACE and indices without dups, since MPI does not combine data nor allow overlapping
+   receive buffers. We only do it for host data, as the performance of derived datatypes on device memory varies a lot with MPI.
+
    The routine is shared by SFBasic and SFNeighbor based on the fact they all deal with sparse graphs and
    need pack/unpack data.
+
+   A link with nvec > 1 communicates nvec root/leafdata arrays at once, see PetscSFLinkCreateMulti_MPI().
+
+   With -sf_use_single_precision, SFBasic sends host PetscScalar data rounded to float. The remote data is then always packed, and the
+   link converts its remote buffers to/from separate float buffers around the MPI calls.
 */
-PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType xrootmtype, const void *rootdata, PetscMemType xleafmtype, const void *leafdata, MPI_Op op, PetscSFOperation sfop, PetscSFLink *mylink)
+static PetscErrorCode PetscSFLinkCreate_MPI_Private(PetscSF sf, MPI_Datatype unit, PetscInt nvec, PetscMemType xrootmtype, const void *rootdata, PetscMemType xleafmtype, const void *leafdata, MPI_Op op, PetscSFOperation sfop, PetscSFLink *mylink)
 {
   PetscSF_Basic   *bas = (PetscSF_Basic *)sf->data;
   PetscInt         i, j, k, nrootreqs, nleafreqs, nreqs;
@@ -152,8 +197,20 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
   PetscMemType     leafmtype = PetscMemTypeHost(xleafmtype) ? PETSC_MEMTYPE_HOST : PETSC_MEMTYPE_DEVICE;
   PetscMemType     rootmtype_mpi, leafmtype_mpi;   /* mtypes seen by MPI */
   PetscInt         rootdirect_mpi, leafdirect_mpi; /* root/leafdirect seen by MPI*/
+  PetscBool        use_float = PETSC_FALSE;
 
   PetscFunctionBegin;
+#if defined(PETSC_USE_REAL_DOUBLE)
+  /* Can the remote data be sent in single precision? */
+  if (sf->use_single_precision && sfop != PETSCSF_FETCH && PetscMemTypeHost(rootmtype) && PetscMemTypeHost(leafmtype)) {
+    PetscBool isbasic;
+    PetscInt  n;
+
+    PetscCall(PetscObjectTypeCompare((PetscObject)sf, PETSCSFBASIC, &isbasic));
+    PetscCall(MPIPetsc_Type_compare_contig(unit, MPIU_SCALAR, &n));
+    if (isbasic && n > 0) use_float = PETSC_TRUE;
+  }
+#endif
 
   /* Can we directly use root/leafdirect with the given sf, sfop and op? */
   for (i = PETSCSF_LOCAL; i <= PETSCSF_REMOTE; i++) {
@@ -167,6 +224,21 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
       rootdirect[i] = PETSC_FALSE;                                                          /* FETCH always need a separate rootbuf */
       leafdirect[i] = PETSC_FALSE;                                                          /* We also force allocating a separate leafbuf so that leafdata and leafupdate can share mpi requests */
     }
+    if (nvec > 1) rootdirect[i] = leafdirect[i] = PETSC_FALSE; /* The arrays are packed one after the other */
+  }
+  if (use_float) rootdirect[PETSCSF_REMOTE] = leafdirect[PETSCSF_REMOTE] = PETSC_FALSE; /* The data is rounded in the buffers */
+
+  /* Can non-contiguous remote root/leafdata be passed to MPI with derived datatypes? */
+  if (sf->use_mpi_datatypes && sf->persistent && sfop != PETSCSF_FETCH && nvec == 1 && !use_float) {
+    PetscBool dense, nodups = (sf->multi == sf) ? PETSC_FALSE : PETSC_TRUE; /* dups are not checked on the multi-SF */
+
+    PetscCall(PetscSFUnitIsDense_Private(unit, &dense));
+    if (dense && !rootdirect[PETSCSF_REMOTE] && bas->rootpackopt[PETSCSF_REMOTE] && PetscMemTypeHost(rootmtype)) {
+      if (sfop == PETSCSF_BCAST || (op == MPI_REPLACE && nodups && !bas->rootdups[PETSCSF_REMOTE])) rootdirect[PETSCSF_REMOTE] = PETSC_TRUE;
+    }
+    if (dense && !leafdirect[PETSCSF_REMOTE] && sf->leafpackopt[PETSCSF_REMOTE] && PetscMemTypeHost(leafmtype)) {
+      if (sfop == PETSCSF_REDUCE || (op == MPI_REPLACE && nodups && !sf->leafdups[PETSCSF_REMOTE])) leafdirect[PETSCSF_REMOTE] = PETSC_TRUE;
+    }
   }
 
   if (sf->use_gpu_aware_mpi) {
@@ -185,7 +257,7 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
 
   /* Look for free links in cache */
   for (p = &bas->avail; (link = *p); p = &link->next) {
-    if (!link->use_nvshmem) { /* Only check with MPI links */
+    if (!link->use_nvshmem && link->nvec == nvec && link->use_float == use_float) { /* Only check with MPI links */
       PetscCall(MPIPetsc_Type_compare(unit, link->unit, &match));
       if (match) {
         /* If root/leafdata will be directly passed to MPI, test if the data used to initialized the MPI requests matches with the current.
@@ -213,6 +285,17 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
 
   PetscCall(PetscNew(&link));
   PetscCall(PetscSFLinkSetUp_Host(sf, link, unit));
+  link->nvec = nvec;
+  if (use_float) {
+    PetscMPIInt nreal;
+
+    PetscCall(PetscMPIIntCast(link->unitbytes / sizeof(PetscReal), &nreal));
+    PetscCallMPI(MPI_Type_contiguous(nreal, MPI_FLOAT, &link->floatunit));
+    PetscCallMPI(MPI_Type_commit(&link->floatunit));
+    PetscCall(PetscMalloc1(bas->rootbuflen[PETSCSF_REMOTE] * nvec * nreal, &link->rootbuf_float));
+    PetscCall(PetscMalloc1(sf->leafbuflen[PETSCSF_REMOTE] * nvec * nreal, &link->leafbuf_float));
+    link->use_float = PETSC_TRUE;
+  }
   PetscCall(PetscCommGetNewTag(PetscObjectComm((PetscObject)sf), &link->tag)); /* One tag per link */
 
   nreqs = (nrootreqs + nleafreqs) * 8;
@@ -261,7 +344,7 @@ found:
       if (rootdirect[i]) { /* Aha, we disguise rootdata as rootbuf */
         link->rootbuf[i][rootmtype] = (char *)rootdata + bas->rootstart[i] * link->unitbytes;
       } else { /* Have to have a separate rootbuf */
-        if (!link->rootbuf_alloc[i][rootmtype]) PetscCall(PetscSFMalloc(sf, rootmtype, bas->rootbuflen[i] * link->unitbytes, (void **)&link->rootbuf_alloc[i][rootmtype]));
+        if (!link->rootbuf_alloc[i][rootmtype]) PetscCall(PetscSFMalloc(sf, rootmtype, bas->rootbuflen[i] * nvec * link->unitbytes, (void **)&link->rootbuf_alloc[i][rootmtype]));
         link->rootbuf[i][rootmtype] = link->rootbuf_alloc[i][rootmtype];
       }
     }
@@ -270,7 +353,7 @@ found:
       if (leafdirect[i]) {
         link->leafbuf[i][leafmtype] = (char *)leafdata + sf->leafstart[i] * link->unitbytes;
       } else {
-        if (!link->leafbuf_alloc[i][leafmtype]) PetscCall(PetscSFMalloc(sf, leafmtype, sf->leafbuflen[i] * link->unitbytes, (void **)&link->leafbuf_alloc[i][leafmtype]));
+        if (!link->leafbuf_alloc[i][leafmtype]) PetscCall(PetscSFMalloc(sf, leafmtype, sf->leafbuflen[i] * nvec * link->unitbytes, (void **)&link->leafbuf_alloc[i][leafmtype]));
         link->leafbuf[i][leafmtype] = link->leafbuf_alloc[i][leafmtype];
       }
     }
@@ -312,3 +395,25 @@ found:
   *mylink    = link;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType xrootmtype, const void *rootdata, PetscMemType xleafmtype, const void *leafdata, MPI_Op op, PetscSFOperation sfop, PetscSFLink *mylink)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkCreate_MPI_Private(sf, unit, 1, xrootmtype, rootdata, xleafmtype, leafdata, op, sfop, mylink));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Create a link broadcasting the nvec host arrays rootdata[] to the nvec host arrays leafdata[] with a single message per rank.
+   The message to a rank holds the nvec blocks of units for that rank, one array after the other, see PetscSFLinkPackRootDataMulti().
+   Only SFBasic uses it, since the persistent requests of the link are initialized with nvec times the count of units.
+
+   The arrays of pointers (not the data) are the keys to look up the link in PetscSFBcastMultiEnd().
+*/
+PetscErrorCode PetscSFLinkCreateMulti_MPI(PetscSF sf, MPI_Datatype unit, PetscInt nvec, const void *const rootdata[], void *const leafdata[], MPI_Op op, PetscSFLink *mylink)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSFSetErrorOnUnsupportedOverlap(sf, unit, rootdata, leafdata));
+  PetscCall(PetscSFLinkCreate_MPI_Private(sf, unit, nvec, PETSC_MEMTYPE_HOST, rootdata, PETSC_MEMTYPE_HOST, leafdata, op, PETSCSF_BCAST, mylink));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -408,6 +408,20 @@ DEF_DumbType(DumbInt, 1, 1) DEF_DumbType(DumbInt, 2, 1) DEF_DumbType(DumbInt, 4,
       if (link->reqs[i] != MPI_REQUEST_NULL) PetscCallMPI(MPI_Request_free(&link->reqs[i]));
     }
     PetscCall(PetscFree(link->reqs));
+    PetscCall(PetscFree(link->leafreqsdone));
+    if (link->rootunits) {
+      for (i = 0; i < bas->nrootreqs; i++) PetscCallMPI(MPI_Type_free(&link->rootunits[i]));
+      PetscCall(PetscFree(link->rootunits));
+    }
+    if (link->leafunits) {
+      for (i = 0; i < sf->nleafreqs; i++) PetscCallMPI(MPI_Type_free(&link->leafunits[i]));
+      PetscCall(PetscFree(link->leafunits));
+    }
+    if (link->use_float) {
+      PetscCallMPI(MPI_Type_free(&link->floatunit));
+      PetscCall(PetscFree(link->rootbuf_float));
+      PetscCall(PetscFree(link->leafbuf_float));
+    }
     for (i = PETSCSF_LOCAL; i <= PETSCSF_REMOTE; i++) {
       PetscCall(PetscFree(link->rootbuf_alloc[i][PETSC_MEMTYPE_HOST]));
       PetscCall(PetscFree(link->leafbuf_alloc[i][PETSC_MEMTYPE_HOST]));
@@ -435,8 +449,34 @@ PetscErrorCode PetscSFLinkCreate(PetscSF sf, MPI_Datatype unit, PetscMemType roo
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Create the derived datatypes of the indices of each rank described by opt, a [dx,dy,dz] submatrix of a [X,Y,Z] matrix of units */
+static PetscErrorCode PetscSFLinkCreateUnits_Private(PetscSFLink link, PetscSFPackOpt opt, MPI_Datatype **units)
+{
+  PetscInt     r;
+  PetscMPIInt  dx, dy, dz;
+  MPI_Datatype plane;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(opt->n, units));
+  for (r = 0; r < opt->n; r++) {
+    PetscCall(PetscMPIIntCast(opt->dx[r], &dx));
+    PetscCall(PetscMPIIntCast(opt->dy[r], &dy));
+    PetscCall(PetscMPIIntCast(opt->dz[r], &dz));
+    PetscCallMPI(MPI_Type_create_hvector(dy, dx, (MPI_Aint)(opt->X[r] * link->unitbytes), link->unit, &plane));
+    PetscCallMPI(MPI_Type_create_hvector(dz, 1, (MPI_Aint)(opt->X[r] * opt->Y[r] * link->unitbytes), plane, &(*units)[r]));
+    PetscCallMPI(MPI_Type_commit(&(*units)[r]));
+    PetscCallMPI(MPI_Type_free(&plane));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* Return root/leaf buffers and MPI requests attached to the link for MPI communication in the given direction.
    If the sf uses persistent requests and the requests have not been initialized, then initialize them.
+
+   When root/leafdata is directly passed to MPI but is not contiguous (see PetscSFLinkCreate_MPI()), each request sends/receives
+   one derived datatype of units built from the pack optimization plan, starting at the first index of the rank in root/leafdata.
+
+   When the link sends PetscScalar data rounded to float, the buffers passed to MPI are root/leafbuf_float, of floatunit.
 */
 PetscErrorCode PetscSFLinkGetMPIBuffersAndRequests(PetscSF sf, PetscSFLink link, PetscSFDirection direction, void **rootbuf, void **leafbuf, MPI_Request **rootreqs, MPI_Request **leafreqs)
 {
@@ -445,51 +485,59 @@ PetscErrorCode PetscSFLinkGetMPIBuffersAndRequests(PetscSF sf, PetscSFLink link,
   const PetscInt    *rootoffset, *leafoffset;
   MPI_Aint           disp;
   MPI_Comm           comm          = PetscObjectComm((PetscObject)sf);
-  MPI_Datatype       unit          = link->unit;
+  MPI_Datatype       unit          = link->use_float ? link->floatunit : link->unit, dtype;
+  const size_t       unitbytes     = link->use_float ? link->unitbytes / 2 : link->unitbytes; /* float is half of PetscReal */
   const PetscMemType rootmtype_mpi = link->rootmtype_mpi, leafmtype_mpi = link->leafmtype_mpi; /* Used to select buffers passed to MPI */
   const PetscInt     rootdirect_mpi = link->rootdirect_mpi, leafdirect_mpi = link->leafdirect_mpi;
+  char              *rbuf          = link->use_float ? (char *)link->rootbuf_float : link->rootbuf[PETSCSF_REMOTE][rootmtype_mpi];
+  char              *lbuf          = link->use_float ? (char *)link->leafbuf_float : link->leafbuf[PETSCSF_REMOTE][leafmtype_mpi];
+  PetscSFPackOpt     opt;
 
   PetscFunctionBegin;
   /* Init persistent MPI requests if not yet. Currently only SFBasic uses persistent MPI */
   if (sf->persistent) {
     if (rootreqs && bas->rootbuflen[PETSCSF_REMOTE] && !link->rootreqsinited[direction][rootmtype_mpi][rootdirect_mpi]) {
       PetscCall(PetscSFGetRootInfo_Basic(sf, &nrootranks, &ndrootranks, NULL, &rootoffset, NULL));
-      if (direction == PETSCSF_LEAF2ROOT) {
-        for (i = ndrootranks, j = 0; i < nrootranks; i++, j++) {
-          disp = (rootoffset[i] - rootoffset[ndrootranks]) * link->unitbytes;
-          cnt  = rootoffset[i + 1] - rootoffset[i];
-          PetscCallMPI(MPIU_Recv_init(link->rootbuf[PETSCSF_REMOTE][rootmtype_mpi] + disp, cnt, unit, bas->iranks[i], link->tag, comm, link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi] + j));
-        }
-      } else { /* PETSCSF_ROOT2LEAF */
-        for (i = ndrootranks, j = 0; i < nrootranks; i++, j++) {
-          disp = (rootoffset[i] - rootoffset[ndrootranks]) * link->unitbytes;
-          cnt  = rootoffset[i + 1] - rootoffset[i];
-          PetscCallMPI(MPIU_Send_init(link->rootbuf[PETSCSF_REMOTE][rootmtype_mpi] + disp, cnt, unit, bas->iranks[i], link->tag, comm, link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi] + j));
+      opt = (rootdirect_mpi && !bas->rootcontig[PETSCSF_REMOTE]) ? bas->rootpackopt[PETSCSF_REMOTE] : NULL;
+      if (opt && !link->rootunits) PetscCall(PetscSFLinkCreateUnits_Private(link, opt, &link->rootunits));
+      for (i = ndrootranks, j = 0; i < nrootranks; i++, j++) {
+        if (opt) {
+          disp  = (opt->start[j] - bas->rootstart[PETSCSF_REMOTE]) * (MPI_Aint)link->unitbytes;
+          cnt   = 1;
+          dtype = link->rootunits[j];
+        } else {
+          disp  = (rootoffset[i] - rootoffset[ndrootranks]) * link->nvec * unitbytes;
+          cnt   = (rootoffset[i + 1] - rootoffset[i]) * link->nvec;
+          dtype = unit;
         }
+        if (direction == PETSCSF_LEAF2ROOT) PetscCallMPI(MPIU_Recv_init(rbuf + disp, cnt, dtype, bas->iranks[i], link->tag, comm, link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi] + j));
+        else PetscCallMPI(MPIU_Send_init(rbuf + disp, cnt, dtype, bas->iranks[i], link->tag, comm, link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi] + j));
       }
       link->rootreqsinited[direction][rootmtype_mpi][rootdirect_mpi] = PETSC_TRUE;
     }
 
     if (leafreqs && sf->leafbuflen[PETSCSF_REMOTE] && !link->leafreqsinited[direction][leafmtype_mpi][leafdirect_mpi]) {
       PetscCall(PetscSFGetLeafInfo_Basic(sf, &nleafranks, &ndleafranks, NULL, &leafoffset, NULL, NULL));
-      if (direction == PETSCSF_LEAF2ROOT) {
-        for (i = ndleafranks, j = 0; i < nleafranks; i++, j++) {
-          disp = (leafoffset[i] - leafoffset[ndleafranks]) * link->unitbytes;
-          cnt  = leafoffset[i + 1] - leafoffset[i];
-          PetscCallMPI(MPIU_Send_init(link->leafbuf[PETSCSF_REMOTE][leafmtype_mpi] + disp, cnt, unit, sf->ranks[i], link->tag, comm, link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi] + j));
-        }
-      } else { /* PETSCSF_ROOT2LEAF */
-        for (i = ndleafranks, j = 0; i < nleafranks; i++, j++) {
-          disp = (leafoffset[i] - leafoffset[ndleafranks]) * link->unitbytes;
-          cnt  = leafoffset[i + 1] - leafoffset[i];
-          PetscCallMPI(MPIU_Recv_init(link->leafbuf[PETSCSF_REMOTE][leafmtype_mpi] + disp, cnt, unit, sf->ranks[i], link->tag, comm, link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi] + j));
+      opt = (leafdirect_mpi && !sf->leafcontig[PETSCSF_REMOTE]) ? sf->leafpackopt[PETSCSF_REMOTE] : NULL;
+      if (opt && !link->leafunits) PetscCall(PetscSFLinkCreateUnits_Private(link, opt, &link->leafunits));
+      for (i = ndleafranks, j = 0; i < nleafranks; i++, j++) {
+        if (opt) {
+          disp  = (opt->start[j] - sf->leafstart[PETSCSF_REMOTE]) * (MPI_Aint)link->unitbytes;
+          cnt   = 1;
+          dtype = link->leafunits[j];
+        } else {
+          disp  = (leafoffset[i] - leafoffset[ndleafranks]) * link->nvec * unitbytes;
+          cnt   = (leafoffset[i + 1] - leafoffset[i]) * link->nvec;
+          dtype = unit;
         }
+        if (direction == PETSCSF_LEAF2ROOT) PetscCallMPI(MPIU_Send_init(lbuf + disp, cnt, dtype, sf->ranks[i], link->tag, comm, link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi] + j));
+        else PetscCallMPI(MPIU_Recv_init(lbuf + disp, cnt, dtype, sf->ranks[i], link->tag, comm, link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi] + j));
       }
       link->leafreqsinited[direction][leafmtype_mpi][leafdirect_mpi] = PETSC_TRUE;
     }
   }
-  if (rootbuf) *rootbuf = link->rootbuf[PETSCSF_REMOTE][rootmtype_mpi];
-  if (leafbuf) *leafbuf = link->leafbuf[PETSCSF_REMOTE][leafmtype_mpi];
+  if (rootbuf) *rootbuf = rbuf;
+  if (leafbuf) *leafbuf = lbuf;
   if (rootreqs) *rootreqs = link->rootreqs[direction][rootmtype_mpi][rootdirect_mpi];
   if (leafreqs) *leafreqs = link->leafreqs[direction][leafmtype_mpi][leafdirect_mpi];
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -590,6 +638,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
   PetscCallMPI(MPI_Type_get_envelope(unit, &ni, &na, &nd, &combiner));
   link->isbuiltin = (combiner == MPI_COMBINER_NAMED) ? PETSC_TRUE : PETSC_FALSE; /* unit is MPI builtin */
   link->bs        = 1;                                                           /* default */
+  link->nvec      = 1;                                                           /* default */
 
   if (is2Int) {
     PackInit_PairType_int_int_1_1(link);
@@ -1091,6 +1140,81 @@ static PetscErrorCode PetscSFLinkUnpackLeafData_Private(PetscSF sf, PetscSFLink
   PetscCall(PetscSFLinkLogFlopsAfterUnpackLeafData(sf, link, scope, op));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/* Unpack the part of leafbuf received from the root rank sf->ranks[rank] to leafdata. Used by PetscSFBcastEndSome() on host memory */
+PetscErrorCode PetscSFLinkUnpackLeafDataOfRank(PetscSF sf, PetscSFLink link, PetscInt rank, void *leafdata, MPI_Op op)
+{
+  const PetscInt  offset  = sf->roffset[rank] - sf->roffset[sf->ndranks], count = sf->roffset[rank + 1] - sf->roffset[rank];
+  const char     *buf     = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + offset * link->unitbytes;
+  const PetscInt *indices = NULL;
+  PetscInt        start   = 0;
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, void *, const void *) = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(PETSCSF_Unpack, sf, 0, 0, 0));
+  if (!link->leafdirect[PETSCSF_REMOTE]) {
+    if (sf->leafcontig[PETSCSF_REMOTE]) start = sf->leafstart[PETSCSF_REMOTE] + offset;
+    else indices = sf->rmine + sf->roffset[rank];
+    PetscCall(PetscSFLinkGetUnpackAndOp(link, PETSC_MEMTYPE_HOST, op, sf->leafdups[PETSCSF_REMOTE], &UnpackAndOp));
+    if (UnpackAndOp) PetscCall((*UnpackAndOp)(link, count, start, NULL, indices, leafdata, buf));
+    else PetscCall(PetscSFLinkUnpackDataWithMPIReduceLocal(sf, link, count, start, indices, leafdata, buf, op));
+  }
+  if (op != MPI_REPLACE && link->basicunit == MPIU_SCALAR) PetscCall(PetscLogFlops(count * link->bs));
+  PetscCall(PetscLogEventEnd(PETSCSF_Unpack, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Pack the nvec host arrays rootdata[] to rootbuf. The message to a remote leaf rank holds the units of rootdata[0], then those of rootdata[1] etc. Used by PetscSFBcastMultiBegin() */
+PetscErrorCode PetscSFLinkPackRootDataMulti(PetscSF sf, PetscSFLink link, const void *const *rootdata)
+{
+  PetscSF_Basic  *bas     = (PetscSF_Basic *)sf->data;
+  char           *rootbuf = link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+  const PetscInt *indices = NULL;
+  PetscInt        offset, count, start = 0;
+  PetscErrorCode (*Pack)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, const void *, void *) = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(PETSCSF_Pack, sf, 0, 0, 0));
+  PetscCall(PetscSFLinkGetPack(link, PETSC_MEMTYPE_HOST, &Pack));
+  for (PetscMPIInt i = bas->ndiranks; i < bas->niranks; i++) {
+    offset = bas->ioffset[i] - bas->ioffset[bas->ndiranks];
+    count  = bas->ioffset[i + 1] - bas->ioffset[i];
+    if (bas->rootcontig[PETSCSF_REMOTE]) start = bas->rootstart[PETSCSF_REMOTE] + offset;
+    else indices = bas->irootloc + bas->ioffset[i];
+    for (PetscInt j = 0; j < link->nvec; j++) PetscCall((*Pack)(link, count, start, NULL, indices, rootdata[j], rootbuf + (offset * link->nvec + j * count) * link->unitbytes));
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Pack, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Unpack leafbuf, laid out as in PetscSFLinkPackRootDataMulti(), to the nvec host arrays leafdata[]. Used by PetscSFBcastMultiEnd() */
+PetscErrorCode PetscSFLinkUnpackLeafDataMulti(PetscSF sf, PetscSFLink link, void *const *leafdata, MPI_Op op)
+{
+  const char     *leafbuf = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+  const PetscInt *indices = NULL;
+  PetscInt        offset, count, start = 0;
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, void *, const void *) = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(PETSCSF_Unpack, sf, 0, 0, 0));
+  PetscCall(PetscSFLinkGetUnpackAndOp(link, PETSC_MEMTYPE_HOST, op, sf->leafdups[PETSCSF_REMOTE], &UnpackAndOp));
+  for (PetscMPIInt i = sf->ndranks; i < sf->nranks; i++) {
+    offset = sf->roffset[i] - sf->roffset[sf->ndranks];
+    count  = sf->roffset[i + 1] - sf->roffset[i];
+    if (sf->leafcontig[PETSCSF_REMOTE]) start = sf->leafstart[PETSCSF_REMOTE] + offset;
+    else indices = sf->rmine + sf->roffset[i];
+    for (PetscInt j = 0; j < link->nvec; j++) {
+      const char *buf = leafbuf + (offset * link->nvec + j * count) * link->unitbytes;
+
+      if (UnpackAndOp) PetscCall((*UnpackAndOp)(link, count, start, NULL, indices, leafdata[j], buf));
+      else PetscCall(PetscSFLinkUnpackDataWithMPIReduceLocal(sf, link, count, start, indices, leafdata[j], buf, op));
+    }
+  }
+  if (op != MPI_REPLACE && link->basicunit == MPIU_SCALAR) PetscCall(PetscLogFlops(sf->leafbuflen[PETSCSF_REMOTE] * link->nvec * link->bs));
+  PetscCall(PetscLogEventEnd(PETSCSF_Unpack, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /* Unpack rootbuf to rootdata, which are in the same memory space */
 PetscErrorCode PetscSFLinkUnpackRootData(PetscSF sf, PetscSFLink link, PetscSFScope scope, void *rootdata, MPI_Op op)
 {
@@ -1405,13 +1529,14 @@ PetscErrorCode PetscSFSetUpPackFields(PetscSF sf)
   if (!bas->rootcontig[0]) PetscCall(PetscSFCreatePackOpt(bas->ndiranks, bas->ioffset, bas->irootloc, &bas->rootpackopt[0]));
   if (!bas->rootcontig[1]) PetscCall(PetscSFCreatePackOpt(bas->niranks - bas->ndiranks, bas->ioffset + bas->ndiranks, bas->irootloc, &bas->rootpackopt[1]));
 
-  /* Check dups in indices so that CUDA unpacking kernels can use cheaper regular instructions instead of atomics when they know there are no data race chances */
-  if (PetscDefined(HAVE_DEVICE)) {
+  /* Check dups in indices so that CUDA unpacking kernels can use cheaper regular instructions instead of atomics when they know there are no data race chances.
+     Remote indices with a pack optimization plan are also checked on host since they can only be received with derived datatypes without dups */
+  {
     PetscBool ismulti = (sf->multi == sf) ? PETSC_TRUE : PETSC_FALSE;
-    if (!sf->leafcontig[0] && !ismulti) PetscCall(PetscCheckDupsInt(sf->leafbuflen[0], sf->rmine, &sf->leafdups[0]));
-    if (!sf->leafcontig[1] && !ismulti) PetscCall(PetscCheckDupsInt(sf->leafbuflen[1], sf->rmine + sf->roffset[sf->ndranks], &sf->leafdups[1]));
-    if (!bas->rootcontig[0] && !ismulti) PetscCall(PetscCheckDupsInt(bas->rootbuflen[0], bas->irootloc, &bas->rootdups[0]));
-    if (!bas->rootcontig[1] && !ismulti) PetscCall(PetscCheckDupsInt(bas->rootbuflen[1], bas->irootloc + bas->ioffset[bas->ndiranks], &bas->rootdups[1]));
+    if (PetscDefined(HAVE_DEVICE) && !sf->leafcontig[0] && !ismulti) PetscCall(PetscCheckDupsInt(sf->leafbuflen[0], sf->rmine, &sf->leafdups[0]));
+    if ((PetscDefined(HAVE_DEVICE) || sf->leafpackopt[1]) && !sf->leafcontig[1] && !ismulti) PetscCall(PetscCheckDupsInt(sf->leafbuflen[1], sf->rmine + sf->roffset[sf->ndranks], &sf->leafdups[1]));
+    if (PetscDefined(HAVE_DEVICE) && !bas->rootcontig[0] && !ismulti) PetscCall(PetscCheckDupsInt(bas->rootbuflen[0], bas->irootloc, &bas->rootdups[0]));
+    if ((PetscDefined(HAVE_DEVICE) || bas->rootpackopt[1]) && !bas->rootcontig[1] && !ismulti) PetscCall(PetscCheckDupsInt(bas->rootbuflen[1], bas->irootloc + bas->ioffset[bas->ndiranks], &bas->rootdups[1]));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -173,6 +173,7 @@ struct _n_PetscSFLink {
   PetscBool    isbuiltin;            /* Is unit an MPI/PETSc builtin datatype? If it is true, then bs=1 and basicunit is equivalent to unit */
   size_t       unitbytes;            /* Number of bytes in a unit */
   PetscInt     bs;                   /* Number of basic units in a unit */
+  PetscInt     nvec;                 /* Number of root/leafdata arrays the link communicates at once, see PetscSFBcastMultiBegin() */
   const void  *rootdata, *leafdata;  /* rootdata and leafdata the link is working on. They are used as keys for pending links. */
   PetscMemType rootmtype, leafmtype; /* root/leafdata's memory type */
 
@@ -192,6 +193,15 @@ struct _n_PetscSFLink {
   PetscBool    rootreqsinited[2][2][2]; /* Are root requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][rootdirect_mpi]*/
   PetscBool    leafreqsinited[2][2][2]; /* Are leaf requests initialized? Also in layout of [PETSCSF_DIRECTION][PETSC_MEMTYPE][leafdirect_mpi]*/
   MPI_Request *reqs;                    /* An array of length (nrootreqs+nleafreqs)*8. Pointers in rootreqs[][][] and leafreqs[][][] point here */
+
+  MPI_Datatype *rootunits, *leafunits; /* [nrootreqs], [nleafreqs] Derived datatypes of the remote roots/leaves of each rank, used when non-contiguous root/leafdata is directly passed to MPI */
+
+  PetscBool    use_float;                     /* Do remote messages carry the PetscScalar data rounded to float? See PetscSFSetUseSinglePrecision() */
+  MPI_Datatype floatunit;                     /* MPI_FLOAT repeated for each PetscReal of a unit, the unit of these messages */
+  float       *rootbuf_float, *leafbuf_float; /* Remote root/leaf buffers passed to MPI when use_float is true */
+
+  PetscInt     nleafranksdone;          /* Number of root ranks already returned by PetscSFBcastEndSome() for the ongoing bcast */
+  PetscMPIInt *leafreqsdone;            /* [nleafreqs] Indices of the completed leaf requests, lazily allocated by PetscSFBcastEndSome() */
   PetscSFLink  next;
 
   PetscBool use_nvshmem; /* Does this link use nvshem (vs. MPI) for communication? */
@@ -237,6 +247,9 @@ PETSC_INTERN PetscErrorCode PetscSFLinkPackRootData(PetscSF, PetscSFLink, PetscS
 PETSC_INTERN PetscErrorCode PetscSFLinkPackLeafData(PetscSF, PetscSFLink, PetscSFScope, const void *);
 PETSC_INTERN PetscErrorCode PetscSFLinkUnpackRootData(PetscSF, PetscSFLink, PetscSFScope, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFLinkUnpackLeafData(PetscSF, PetscSFLink, PetscSFScope, void *, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFLinkUnpackLeafDataOfRank(PetscSF, PetscSFLink, PetscInt, void *, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFLinkPackRootDataMulti(PetscSF, PetscSFLink, const void *const *);
+PETSC_INTERN PetscErrorCode PetscSFLinkUnpackLeafDataMulti(PetscSF, PetscSFLink, void *const *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFLinkFetchAndOpRemote(PetscSF, PetscSFLink, void *, MPI_Op);
 
 PETSC_INTERN PetscErrorCode PetscSFLinkScatterLocal(PetscSF, PetscSFLink, PetscSFDirection, void *, void *, MPI_Op);
@@ -245,6 +258,7 @@ PETSC_INTERN PetscErrorCode PetscSFLinkFetchAndOpLocal(PetscSF, PetscSFLink, voi
 PETSC_INTERN PetscErrorCode PetscSFSetUpPackFields(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFResetPackFields(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFLinkCreate_MPI(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, const void *, MPI_Op, PetscSFOperation, PetscSFLink *);
+PETSC_INTERN PetscErrorCode PetscSFLinkCreateMulti_MPI(PetscSF, MPI_Datatype, PetscInt, const void *const[], void *const[], MPI_Op, PetscSFLink *);
 
 #if defined(PETSC_HAVE_CUDA)
 PETSC_INTERN PetscErrorCode PetscSFLinkSetUp_CUDA(PetscSF, PetscSFLink, MPI_Datatype);
@@ -0,0 +1,426 @@
+#include <../src/vec/is/sf/impls/basic/sfpack.h>
+#include <../src/vec/is/sf/impls/basic/sfbasic.h>
+
+/* SFShm inherits from SFBasic. Remote ranks that share memory with this process (on-node ranks) exchange their data
+   through a MPI-3 shared memory window: each process packs the data for its on-node neighbors into its segment of the
+   window, and after a barrier of the node the neighbors unpack it directly from there. The other remote ranks use
+   the persistent MPI requests of SFBasic.
+
+   The segment of each process has two halves used alternately by the successive operations, so that a process can pack
+   the data of an operation while its neighbors may still unpack the data of the previous operation.
+*/
+typedef struct {
+  SFBASICHEADER;
+  PetscInt     nodesize;       /* Number of consecutive processes of a node that share memory, PETSC_DECIDE for all */
+  MPI_Comm     shmcomm;        /* Processes exchanging data through shared memory with this process */
+  PetscBool    useshm;         /* Does a process of shmcomm have a neighbor in shmcomm? */
+  PetscInt     shmlen;         /* Max over shmcomm of the number of units in a half segment */
+  PetscMPIInt *rootshmrank;    /* [niranks] Rank in shmcomm of iranks[i], or MPI_PROC_NULL if it is not an on-node remote rank */
+  PetscInt    *rootshmoffset;  /* [niranks] Offset in my half segment of the roots packed for iranks[i] */
+  PetscInt    *rootpeeroffset; /* [niranks] Offset in the half segment of iranks[i] of the leaves it packed for me */
+  char       **rootpeerbuf;    /* [niranks] Segment of iranks[i] */
+  PetscMPIInt *leafshmrank;    /* [nranks] Rank in shmcomm of ranks[i], or MPI_PROC_NULL if it is not an on-node remote rank */
+  PetscInt    *leafshmoffset;  /* [nranks] Offset in my half segment of the leaves packed for ranks[i] */
+  PetscInt    *leafpeeroffset; /* [nranks] Offset in the half segment of ranks[i] of the roots it packed for me */
+  char       **leafpeerbuf;    /* [nranks] Segment of ranks[i] */
+  MPI_Win      win;            /* Shared memory window made of the segments of the processes */
+  char        *buf;            /* My segment */
+  PetscInt     winunitbytes;   /* Size of the largest unit the window can hold */
+  PetscInt     phase;          /* Half segment used by the next operation */
+} PetscSF_Shm;
+
+/*===================================================================================*/
+/*              Internal routines                                                    */
+/*===================================================================================*/
+
+/* Can the operation with this link use shared memory? All the processes of shmcomm must take the same decision */
+static inline PetscErrorCode PetscSFShmUsable(PetscSF sf, PetscSFLink link, MPI_Op op, PetscBool *useshm)
+{
+  PetscSF_Shm *shm                                                                                                  = (PetscSF_Shm *)sf->data;
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, void *, const void *) = NULL;
+
+  PetscFunctionBegin;
+  *useshm = PETSC_FALSE;
+  if (!shm->useshm || PetscMemTypeDevice(link->rootmtype) || PetscMemTypeDevice(link->leafmtype)) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscSFLinkGetUnpackAndOp(link, PETSC_MEMTYPE_HOST, op, PETSC_FALSE, &UnpackAndOp));
+  if (UnpackAndOp) *useshm = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* (Re)allocate the shared memory window when it cannot hold the units of the link, this is collective on shmcomm */
+static PetscErrorCode PetscSFShmGetWindow(PetscSF sf, PetscSFLink link)
+{
+  PetscSF_Shm *shm = (PetscSF_Shm *)sf->data;
+  MPI_Info     info;
+  MPI_Aint     size;
+  PetscMPIInt  disp_unit;
+  PetscInt     i;
+
+  PetscFunctionBegin;
+  if (shm->win != MPI_WIN_NULL && link->unitbytes <= shm->winunitbytes) PetscFunctionReturn(PETSC_SUCCESS);
+  if (shm->win != MPI_WIN_NULL) {
+    PetscCallMPI(MPI_Win_unlock_all(shm->win));
+    PetscCallMPI(MPI_Win_free(&shm->win));
+  }
+  /* Let each segment be allocated near its process */
+  PetscCallMPI(MPI_Info_create(&info));
+  PetscCallMPI(MPI_Info_set(info, "alloc_shared_noncontig", "true"));
+  PetscCallMPI(MPI_Win_allocate_shared((MPI_Aint)(2 * shm->shmlen * link->unitbytes), 1, info, shm->shmcomm, &shm->buf, &shm->win));
+  PetscCallMPI(MPI_Info_free(&info));
+  PetscCallMPI(MPI_Win_lock_all(MPI_MODE_NOCHECK, shm->win));
+  for (i = shm->ndiranks; i < shm->niranks; i++) {
+    if (shm->rootshmrank[i] != MPI_PROC_NULL) PetscCallMPI(MPI_Win_shared_query(shm->win, shm->rootshmrank[i], &size, &disp_unit, &shm->rootpeerbuf[i]));
+  }
+  for (i = sf->ndranks; i < sf->nranks; i++) {
+    if (shm->leafshmrank[i] != MPI_PROC_NULL) PetscCallMPI(MPI_Win_shared_query(shm->win, shm->leafshmrank[i], &size, &disp_unit, &shm->leafpeerbuf[i]));
+  }
+  shm->winunitbytes = link->unitbytes;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Pack the data for the on-node ranks in my segment, then unpack the data the on-node ranks packed for me from their segments */
+static PetscErrorCode PetscSFShmExchangeOnNode(PetscSF sf, PetscSFLink link, PetscSFDirection direction, const void *data, void *update, MPI_Op op)
+{
+  PetscSF_Shm *shm = (PetscSF_Shm *)sf->data;
+  PetscInt     i, count;
+  size_t       half;
+  PetscErrorCode (*Pack)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, const void *, void *)        = NULL;
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, void *, const void *) = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFShmGetWindow(sf, link));
+  PetscCall(PetscSFLinkGetPack(link, PETSC_MEMTYPE_HOST, &Pack));
+  PetscCall(PetscSFLinkGetUnpackAndOp(link, PETSC_MEMTYPE_HOST, op, PETSC_FALSE, &UnpackAndOp));
+  half = (size_t)(shm->phase * shm->shmlen * link->unitbytes);
+
+  PetscCall(PetscLogEventBegin(PETSCSF_Pack, sf, 0, 0, 0));
+  if (direction == PETSCSF_ROOT2LEAF) {
+    for (i = shm->ndiranks; i < shm->niranks; i++) {
+      if (shm->rootshmrank[i] == MPI_PROC_NULL) continue;
+      count = shm->ioffset[i + 1] - shm->ioffset[i];
+      PetscCall((*Pack)(link, count, 0, NULL, shm->irootloc + shm->ioffset[i], data, shm->buf + half + shm->rootshmoffset[i] * link->unitbytes));
+    }
+  } else {
+    for (i = sf->ndranks; i < sf->nranks; i++) {
+      if (shm->leafshmrank[i] == MPI_PROC_NULL) continue;
+      count = sf->roffset[i + 1] - sf->roffset[i];
+      PetscCall((*Pack)(link, count, 0, NULL, sf->rmine + sf->roffset[i], data, shm->buf + half + shm->leafshmoffset[i] * link->unitbytes));
+    }
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Pack, sf, 0, 0, 0));
+
+  /* Make the packed data visible to the node */
+  PetscCallMPI(MPI_Win_sync(shm->win));
+  PetscCallMPI(MPI_Barrier(shm->shmcomm));
+  PetscCallMPI(MPI_Win_sync(shm->win));
+
+  PetscCall(PetscLogEventBegin(PETSCSF_Unpack, sf, 0, 0, 0));
+  if (direction == PETSCSF_ROOT2LEAF) {
+    for (i = sf->ndranks; i < sf->nranks; i++) {
+      if (shm->leafshmrank[i] == MPI_PROC_NULL) continue;
+      count = sf->roffset[i + 1] - sf->roffset[i];
+      PetscCall((*UnpackAndOp)(link, count, 0, NULL, sf->rmine + sf->roffset[i], update, shm->leafpeerbuf[i] + half + shm->leafpeeroffset[i] * link->unitbytes));
+    }
+  } else {
+    for (i = shm->ndiranks; i < shm->niranks; i++) {
+      if (shm->rootshmrank[i] == MPI_PROC_NULL) continue;
+      count = shm->ioffset[i + 1] - shm->ioffset[i];
+      PetscCall((*UnpackAndOp)(link, count, 0, NULL, shm->irootloc + shm->ioffset[i], update, shm->rootpeerbuf[i] + half + shm->rootpeeroffset[i] * link->unitbytes));
+    }
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Unpack, sf, 0, 0, 0));
+  shm->phase = 1 - shm->phase;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Pack the data for the off-node ranks in the MPI buffer of the link and start their MPI requests */
+static PetscErrorCode PetscSFShmStartOffNode(PetscSF sf, PetscSFLink link, PetscSFDirection direction, const void *data)
+{
+  PetscSF_Shm *shm = (PetscSF_Shm *)sf->data;
+  PetscInt     i, count;
+  MPI_Request *rootreqs = NULL, *leafreqs = NULL;
+  PetscErrorCode (*Pack)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, const void *, void *) = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetPack(link, PETSC_MEMTYPE_HOST, &Pack));
+  PetscCall(PetscLogEventBegin(PETSCSF_Pack, sf, 0, 0, 0));
+  if (direction == PETSCSF_ROOT2LEAF && !link->rootdirect[PETSCSF_REMOTE]) {
+    for (i = shm->ndiranks; i < shm->niranks; i++) {
+      if (shm->rootshmrank[i] != MPI_PROC_NULL) continue;
+      count = shm->ioffset[i + 1] - shm->ioffset[i];
+      PetscCall((*Pack)(link, count, 0, NULL, shm->irootloc + shm->ioffset[i], data, link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + (shm->ioffset[i] - shm->ioffset[shm->ndiranks]) * link->unitbytes));
+    }
+  } else if (direction == PETSCSF_LEAF2ROOT && !link->leafdirect[PETSCSF_REMOTE]) {
+    for (i = sf->ndranks; i < sf->nranks; i++) {
+      if (shm->leafshmrank[i] != MPI_PROC_NULL) continue;
+      count = sf->roffset[i + 1] - sf->roffset[i];
+      PetscCall((*Pack)(link, count, 0, NULL, sf->rmine + sf->roffset[i], data, link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + (sf->roffset[i] - sf->roffset[sf->ndranks]) * link->unitbytes));
+    }
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Pack, sf, 0, 0, 0));
+
+  /* The requests of the on-node ranks stay inactive, so that waiting for all the requests of the link is fine */
+  PetscCall(PetscSFLinkGetMPIBuffersAndRequests(sf, link, direction, NULL, NULL, &rootreqs, &leafreqs));
+  if (direction == PETSCSF_ROOT2LEAF) {
+    for (i = sf->ndranks; i < sf->nranks; i++) {
+      if (shm->leafshmrank[i] == MPI_PROC_NULL) PetscCallMPI(MPI_Startall_irecv(sf->roffset[i + 1] - sf->roffset[i], link->unit, 1, leafreqs + i - sf->ndranks));
+    }
+    for (i = shm->ndiranks; i < shm->niranks; i++) {
+      if (shm->rootshmrank[i] == MPI_PROC_NULL) PetscCallMPI(MPI_Start_isend(shm->ioffset[i + 1] - shm->ioffset[i], link->unit, rootreqs + i - shm->ndiranks));
+    }
+  } else {
+    for (i = shm->ndiranks; i < shm->niranks; i++) {
+      if (shm->rootshmrank[i] == MPI_PROC_NULL) PetscCallMPI(MPI_Startall_irecv(shm->ioffset[i + 1] - shm->ioffset[i], link->unit, 1, rootreqs + i - shm->ndiranks));
+    }
+    for (i = sf->ndranks; i < sf->nranks; i++) {
+      if (shm->leafshmrank[i] == MPI_PROC_NULL) PetscCallMPI(MPI_Start_isend(sf->roffset[i + 1] - sf->roffset[i], link->unit, leafreqs + i - sf->ndranks));
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Unpack the data received from the off-node ranks */
+static PetscErrorCode PetscSFShmUnpackOffNode(PetscSF sf, PetscSFLink link, PetscSFDirection direction, void *data, MPI_Op op)
+{
+  PetscSF_Shm *shm = (PetscSF_Shm *)sf->data;
+  PetscInt     i, count;
+  PetscErrorCode (*UnpackAndOp)(PetscSFLink, PetscInt, PetscInt, PetscSFPackOpt, const PetscInt *, void *, const void *) = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetUnpackAndOp(link, PETSC_MEMTYPE_HOST, op, PETSC_FALSE, &UnpackAndOp));
+  PetscCall(PetscLogEventBegin(PETSCSF_Unpack, sf, 0, 0, 0));
+  if (direction == PETSCSF_ROOT2LEAF && !link->leafdirect[PETSCSF_REMOTE]) {
+    for (i = sf->ndranks; i < sf->nranks; i++) {
+      if (shm->leafshmrank[i] != MPI_PROC_NULL) continue;
+      count = sf->roffset[i + 1] - sf->roffset[i];
+      PetscCall((*UnpackAndOp)(link, count, 0, NULL, sf->rmine + sf->roffset[i], data, link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + (sf->roffset[i] - sf->roffset[sf->ndranks]) * link->unitbytes));
+    }
+  } else if (direction == PETSCSF_LEAF2ROOT && !link->rootdirect[PETSCSF_REMOTE]) {
+    for (i = shm->ndiranks; i < shm->niranks; i++) {
+      if (shm->rootshmrank[i] != MPI_PROC_NULL) continue;
+      count = shm->ioffset[i + 1] - shm->ioffset[i];
+      PetscCall((*UnpackAndOp)(link, count, 0, NULL, shm->irootloc + shm->ioffset[i], data, link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] + (shm->ioffset[i] - shm->ioffset[shm->ndiranks]) * link->unitbytes));
+    }
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Unpack, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*===================================================================================*/
+/*              Implementations of SF public APIs                                    */
+/*===================================================================================*/
+static PetscErrorCode PetscSFSetUp_Shm(PetscSF sf)
+{
+  PetscSF_Shm *shm = (PetscSF_Shm *)sf->data;
+  MPI_Comm     comm, nodecomm;
+  MPI_Group    group, shmgroup;
+  PetscShmComm pshmcomm;
+  PetscMPIInt  noderank, tag[2], nreqs = 0;
+  MPI_Request *reqs;
+  PetscInt     i, len = 0;
+
+  PetscFunctionBegin;
+  /* SFShm inherits from Basic */
+  PetscCall(PetscSFSetUp_Basic(sf));
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  PetscCall(PetscShmCommGet(comm, &pshmcomm));
+  PetscCall(PetscShmCommGetMpiShmComm(pshmcomm, &nodecomm));
+  PetscCallMPI(MPI_Comm_rank(nodecomm, &noderank));
+  PetscCallMPI(MPI_Comm_split(nodecomm, shm->nodesize > 0 ? (PetscMPIInt)(noderank / shm->nodesize) : 0, noderank, &shm->shmcomm));
+
+  /* Find out which remote ranks are in shmcomm */
+  PetscCall(PetscMalloc4(shm->niranks, &shm->rootshmrank, shm->niranks, &shm->rootshmoffset, shm->niranks, &shm->rootpeeroffset, shm->niranks, &shm->rootpeerbuf));
+  PetscCall(PetscMalloc4(sf->nranks, &shm->leafshmrank, sf->nranks, &shm->leafshmoffset, sf->nranks, &shm->leafpeeroffset, sf->nranks, &shm->leafpeerbuf));
+  PetscCallMPI(MPI_Comm_group(comm, &group));
+  PetscCallMPI(MPI_Comm_group(shm->shmcomm, &shmgroup));
+  if (shm->niranks) PetscCallMPI(MPI_Group_translate_ranks(group, shm->niranks, shm->iranks, shmgroup, shm->rootshmrank));
+  if (sf->nranks) PetscCallMPI(MPI_Group_translate_ranks(group, (PetscMPIInt)sf->nranks, sf->ranks, shmgroup, shm->leafshmrank));
+  PetscCallMPI(MPI_Group_free(&group));
+  PetscCallMPI(MPI_Group_free(&shmgroup));
+
+  /* Lay out the half segment: the roots packed for the on-node leaf ranks, then the leaves packed for the on-node root ranks */
+  for (i = 0; i < shm->niranks; i++) {
+    if (i < shm->ndiranks || shm->rootshmrank[i] == MPI_UNDEFINED) shm->rootshmrank[i] = MPI_PROC_NULL;
+    if (shm->rootshmrank[i] == MPI_PROC_NULL) continue;
+    shm->rootshmoffset[i] = len;
+    len += shm->ioffset[i + 1] - shm->ioffset[i];
+  }
+  for (i = 0; i < sf->nranks; i++) {
+    if (i < sf->ndranks || shm->leafshmrank[i] == MPI_UNDEFINED) shm->leafshmrank[i] = MPI_PROC_NULL;
+    if (shm->leafshmrank[i] == MPI_PROC_NULL) continue;
+    shm->leafshmoffset[i] = len;
+    len += sf->roffset[i + 1] - sf->roffset[i];
+  }
+  PetscCallMPI(MPI_Allreduce(&len, &shm->shmlen, 1, MPIU_INT, MPI_MAX, shm->shmcomm));
+  shm->useshm = shm->shmlen ? PETSC_TRUE : PETSC_FALSE;
+
+  /* Tell the on-node ranks where their data is in my half segment */
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag[0]));
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag[1]));
+  PetscCall(PetscMalloc1(2 * (shm->niranks + sf->nranks), &reqs));
+  for (i = 0; i < shm->niranks; i++) {
+    if (shm->rootshmrank[i] == MPI_PROC_NULL) continue;
+    PetscCallMPI(MPI_Irecv(&shm->rootpeeroffset[i], 1, MPIU_INT, shm->iranks[i], tag[1], comm, &reqs[nreqs++]));
+    PetscCallMPI(MPI_Isend(&shm->rootshmoffset[i], 1, MPIU_INT, shm->iranks[i], tag[0], comm, &reqs[nreqs++]));
+  }
+  for (i = 0; i < sf->nranks; i++) {
+    if (shm->leafshmrank[i] == MPI_PROC_NULL) continue;
+    PetscCallMPI(MPI_Irecv(&shm->leafpeeroffset[i], 1, MPIU_INT, sf->ranks[i], tag[0], comm, &reqs[nreqs++]));
+    PetscCallMPI(MPI_Isend(&shm->leafshmoffset[i], 1, MPIU_INT, sf->ranks[i], tag[1], comm, &reqs[nreqs++]));
+  }
+  PetscCallMPI(MPI_Waitall(nreqs, reqs, MPI_STATUSES_IGNORE));
+  PetscCall(PetscFree(reqs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReset_Shm(PetscSF sf)
+{
+  PetscSF_Shm *shm = (PetscSF_Shm *)sf->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!shm->inuse, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding operation has not been completed");
+  if (shm->win != MPI_WIN_NULL) {
+    PetscCallMPI(MPI_Win_unlock_all(shm->win));
+    PetscCallMPI(MPI_Win_free(&shm->win));
+  }
+  if (shm->shmcomm != MPI_COMM_NULL) PetscCallMPI(MPI_Comm_free(&shm->shmcomm));
+  PetscCall(PetscFree4(shm->rootshmrank, shm->rootshmoffset, shm->rootpeeroffset, shm->rootpeerbuf));
+  PetscCall(PetscFree4(shm->leafshmrank, shm->leafshmoffset, shm->leafpeeroffset, shm->leafpeerbuf));
+  shm->buf          = NULL;
+  shm->useshm       = PETSC_FALSE;
+  shm->shmlen       = 0;
+  shm->winunitbytes = 0;
+  shm->phase        = 0;
+  PetscCall(PetscSFReset_Basic(sf)); /* Common part */
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDestroy_Shm(PetscSF sf)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSFReset_Shm(sf));
+  PetscCall(PetscFree(sf->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFSetFromOptions_Shm(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Shm *shm = (PetscSF_Shm *)sf->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Shm options");
+  PetscCall(PetscOptionsInt("-sf_shm_node_size", "Number of consecutive processes of a node that exchange data through shared memory", "PetscSFSetFromOptions", shm->nodesize, &shm->nodesize, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDuplicate_Shm(PetscSF sf, PetscSFDuplicateOption opt, PetscSF newsf)
+{
+  PetscSF_Shm *shm = (PetscSF_Shm *)sf->data, *newshm = (PetscSF_Shm *)newsf->data;
+
+  PetscFunctionBegin;
+  newshm->nodesize = shm->nodesize;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastBegin_Shm(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+  PetscBool   useshm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkCreate(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op, PETSCSF_BCAST, &link));
+  PetscCall(PetscSFShmUsable(sf, link, op, &useshm));
+  if (useshm) {
+    /* Start the communication with the off-node ranks, and overlap it with the exchange through shared memory */
+    PetscCall(PetscSFShmStartOffNode(sf, link, PETSCSF_ROOT2LEAF, rootdata));
+    PetscCall(PetscSFShmExchangeOnNode(sf, link, PETSCSF_ROOT2LEAF, rootdata, leafdata, op));
+  } else {
+    PetscCall(PetscSFLinkPackRootData(sf, link, PETSCSF_REMOTE, rootdata));
+    PetscCall(PetscSFLinkStartCommunication(sf, link, PETSCSF_ROOT2LEAF));
+  }
+  PetscCall(PetscSFLinkScatterLocal(sf, link, PETSCSF_ROOT2LEAF, (void *)rootdata, leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastEnd_Shm(PetscSF sf, MPI_Datatype unit, const void *rootdata, void *leafdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+  PetscBool   useshm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_OWN_POINTER, &link));
+  PetscCall(PetscSFShmUsable(sf, link, op, &useshm));
+  PetscCall(PetscSFLinkFinishCommunication(sf, link, PETSCSF_ROOT2LEAF));
+  if (useshm) PetscCall(PetscSFShmUnpackOffNode(sf, link, PETSCSF_ROOT2LEAF, leafdata, op));
+  else PetscCall(PetscSFLinkUnpackLeafData(sf, link, PETSCSF_REMOTE, leafdata, op));
+  PetscCall(PetscSFLinkReclaim(sf, &link));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Shm(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+  PetscBool   useshm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkCreate(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op, PETSCSF_REDUCE, &link));
+  PetscCall(PetscSFShmUsable(sf, link, op, &useshm));
+  if (useshm) {
+    PetscCall(PetscSFShmStartOffNode(sf, link, PETSCSF_LEAF2ROOT, leafdata));
+    PetscCall(PetscSFShmExchangeOnNode(sf, link, PETSCSF_LEAF2ROOT, leafdata, rootdata, op));
+  } else {
+    PetscCall(PetscSFLinkPackLeafData(sf, link, PETSCSF_REMOTE, leafdata));
+    PetscCall(PetscSFLinkStartCommunication(sf, link, PETSCSF_LEAF2ROOT));
+  }
+  PetscCall(PetscSFLinkScatterLocal(sf, link, PETSCSF_LEAF2ROOT, rootdata, (void *)leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Shm(PetscSF sf, MPI_Datatype unit, const void *leafdata, void *rootdata, MPI_Op op)
+{
+  PetscSFLink link = NULL;
+  PetscBool   useshm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFLinkGetInUse(sf, unit, rootdata, leafdata, PETSC_OWN_POINTER, &link));
+  PetscCall(PetscSFShmUsable(sf, link, op, &useshm));
+  PetscCall(PetscSFLinkFinishCommunication(sf, link, PETSCSF_LEAF2ROOT));
+  if (useshm) PetscCall(PetscSFShmUnpackOffNode(sf, link, PETSCSF_LEAF2ROOT, rootdata, op));
+  else PetscCall(PetscSFLinkUnpackRootData(sf, link, PETSCSF_REMOTE, rootdata, op));
+  PetscCall(PetscSFLinkReclaim(sf, &link));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   SFShm communicates host data with the remote ranks of the same node through shared memory. All the processes of a node
+   must call the communication routines, and with data of the same memory type. FetchAndOp and device data use SFBasic.
+*/
+PETSC_INTERN PetscErrorCode PetscSFCreate_Shm(PetscSF sf)
+{
+  PetscSF_Shm *dat;
+
+  PetscFunctionBegin;
+  sf->ops->CreateEmbeddedRootSF = PetscSFCreateEmbeddedRootSF_Basic;
+  sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
+  sf->ops->View                 = PetscSFView_Basic;
+  sf->ops->FetchAndOpBegin      = PetscSFFetchAndOpBegin_Basic;
+  sf->ops->FetchAndOpEnd        = PetscSFFetchAndOpEnd_Basic;
+
+  sf->ops->SetUp          = PetscSFSetUp_Shm;
+  sf->ops->SetFromOptions = PetscSFSetFromOptions_Shm;
+  sf->ops->Reset          = PetscSFReset_Shm;
+  sf->ops->Destroy        = PetscSFDestroy_Shm;
+  sf->ops->Duplicate      = PetscSFDuplicate_Shm;
+  sf->ops->BcastBegin     = PetscSFBcastBegin_Shm;
+  sf->ops->BcastEnd       = PetscSFBcastEnd_Shm;
+  sf->ops->ReduceBegin    = PetscSFReduceBegin_Shm;
+  sf->ops->ReduceEnd      = PetscSFReduceEnd_Shm;
+
+  PetscCall(PetscNew(&dat));
+  dat->nodesize = PETSC_DECIDE;
+  dat->shmcomm  = MPI_COMM_NULL;
+  dat->win      = MPI_WIN_NULL;
+  sf->data      = (void *)dat;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -44,6 +44,8 @@ const char *const PetscSFConcatenateRootModes[] = {"local", "shared", "global",
     basic     -Use MPI persistent Isend/Irecv for communication (Default)
     window    -Use MPI-3 one-sided window for communication
     neighbor  -Use MPI-3 neighborhood collectives for communication
+    shm       -Use MPI-3 shared memory windows with the ranks of the same node, and persistent Isend/Irecv with the others
+    hierarchical -Aggregate the messages between two nodes in a single message between the first ranks of the nodes
 .ve
 
   Level: intermediate
@@ -74,6 +76,8 @@ PetscErrorCode PetscSFCreate(MPI_Comm comm, PetscSF *sf)
   b->ingroup   = MPI_GROUP_NULL;
   b->outgroup  = MPI_GROUP_NULL;
   b->graphset  = PETSC_FALSE;
+
+  b->use_mpi_datatypes = PETSC_TRUE;
 #if defined(PETSC_HAVE_DEVICE)
   b->use_gpu_aware_mpi    = use_gpu_aware_mpi;
   b->use_stream_aware_mpi = PETSC_FALSE;
@@ -155,6 +159,8 @@ PetscErrorCode PetscSFReset(PetscSF sf)
 .vb
     PETSCSFWINDOW - MPI-2/3 one-sided
     PETSCSFBASIC - basic implementation using MPI-1 two-sided
+    PETSCSFSHM - MPI-3 shared memory with the ranks of the same node, MPI-1 two-sided with the others
+    PETSCSFHIERARCHICAL - MPI-1 two-sided through one leader rank per node, with one message between two nodes
 .ve
 
   Options Database Key:
@@ -327,6 +333,9 @@ PetscErrorCode PetscSFSetUp(PetscSF sf)
   Options Database Keys:
 + -sf_type                                                                                                         - implementation type, see `PetscSFSetType()`
 . -sf_rank_order                                                                                                   - sort composite points for gathers and scatters in rank order, gathers are non-deterministic otherwise
+. -sf_use_mpi_datatypes                                                                                            - Let `PETSCSFBASIC` pass non-contiguous host data with a regular (strided) pattern per rank directly to MPI, described by derived datatypes,
+                            instead of packing and unpacking it (default: true)
+. -sf_use_single_precision                                                                                         - Send `PetscScalar` data rounded to single precision, see `PetscSFSetUseSinglePrecision()` (default: false)
 . -sf_use_default_stream                                                                                           - Assume callers of `PetscSF` computed the input root/leafdata with the default CUDA stream. `PetscSF` will also
                             use the default stream to process data. Therefore, no stream synchronization is needed between `PetscSF` and its caller (default: true).
                             If true, this option only works with `-use_gpu_aware_mpi 1`.
@@ -354,6 +363,8 @@ PetscErrorCode PetscSFSetFromOptions(PetscSF sf)
   PetscCall(PetscOptionsFList("-sf_type", "PetscSF implementation type", "PetscSFSetType", PetscSFList, deft, type, sizeof(type), &flg));
   PetscCall(PetscSFSetType(sf, flg ? type : deft));
   PetscCall(PetscOptionsBool("-sf_rank_order", "sort composite points for gathers and scatters in rank order, gathers are non-deterministic otherwise", "PetscSFSetRankOrder", sf->rankorder, &sf->rankorder, NULL));
+  PetscCall(PetscOptionsBool("-sf_use_mpi_datatypes", "Pass strided data directly to MPI with derived datatypes instead of packing it", "PetscSFSetFromOptions", sf->use_mpi_datatypes, &sf->use_mpi_datatypes, NULL));
+  PetscCall(PetscOptionsBool("-sf_use_single_precision", "Send PetscScalar data rounded to single precision", "PetscSFSetUseSinglePrecision", sf->use_single_precision, &sf->use_single_precision, NULL));
 #if defined(PETSC_HAVE_DEVICE)
   {
     char      backendstr[32] = {0};
@@ -416,6 +427,39 @@ PetscErrorCode PetscSFSetRankOrder(PetscSF sf, PetscBool flg)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  PetscSFSetUseSinglePrecision - send `PetscScalar` data rounded to single precision to the other processes
+
+  Logically Collective
+
+  Input Parameters:
++ sf  - star forest
+- flg - `PETSC_TRUE` to halve the size of the messages, `PETSC_FALSE` to send the data unchanged
+
+  Options Database Key:
+. -sf_use_single_precision - send `PetscScalar` data rounded to single precision
+
+  Level: advanced
+
+  Notes:
+  The data is rounded to single precision in the messages only; the data exchanged between the roots and leaves of the same process
+  and the result of the reductions are still computed in `PetscScalar`. This trades accuracy for bandwidth, and is meant for data whose
+  accuracy matters little, such as the ghost values used by the overlapping subdomains of a preconditioner.
+
+  It is honored by `PETSCSFBASIC` for host data of `MPIU_SCALAR` or of contiguous datatypes made of it, when `PetscReal` is double,
+  except in `PetscSFFetchAndOpBegin()`. Other data is sent unchanged. Since a `VecScatter` is a `PetscSF`, it can be set on a `VecScatter`.
+
+.seealso: `PetscSF`, `PetscSFSetFromOptions()`, `PetscSFBcastBegin()`, `PetscSFReduceBegin()`
+@*/
+PetscErrorCode PetscSFSetUseSinglePrecision(PetscSF sf, PetscBool flg)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(sf, flg, 2);
+  sf->use_single_precision = flg;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   PetscSFSetGraph - Set a parallel star forest
 
@@ -750,6 +794,8 @@ PetscErrorCode PetscSFDuplicate(PetscSF sf, PetscSFDuplicateOption opt, PetscSF
   (*newsf)->vscat.to_n   = sf->vscat.to_n;
   (*newsf)->vscat.from_n = sf->vscat.from_n;
   /* Do not copy lsf. Build it on demand since it is rarely used */
+  (*newsf)->use_mpi_datatypes    = sf->use_mpi_datatypes;
+  (*newsf)->use_single_precision = sf->use_single_precision;
 
 #if defined(PETSC_HAVE_DEVICE)
   (*newsf)->backend              = sf->backend;
@@ -1503,6 +1549,160 @@ PetscErrorCode PetscSFBcastEnd(PetscSF sf, MPI_Datatype unit, const void *rootda
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+  PetscSFBcastEndSome - complete the part of a broadcast started with `PetscSFBcastBegin()` coming from some of the root ranks
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest
+. unit     - data type
+. rootdata - buffer to broadcast
+- op       - operation to use for reduction
+
+  Output Parameters:
++ leafdata - buffer to be reduced with values from each leaf's respective root
+. ndone    - number of root ranks whose leaves were updated by this call
+- done     - indices, in the list of root ranks given by `PetscSFGetRootRanks()`, of these root ranks. Must have room for all the root ranks
+
+  Level: advanced
+
+  Notes:
+  Instead of `PetscSFBcastEnd()`, one calls `PetscSFBcastEndSome()` repeatedly until all the root ranks have been returned; the call
+  returning the last ones completes the operation. With no root ranks, the first call returns `ndone` = 0 and completes the operation.
+  This lets one consume the leaves coming from a root rank as soon as its message arrives instead of waiting for all of them.
+
+  Each call returns at least one root rank unless the operation is complete. The leaves connected to the process itself are returned by the
+  first call. Types that cannot complete the messages separately complete the whole operation on the first call.
+
+.seealso: `PetscSF`, `PetscSFBcastBegin()`, `PetscSFBcastEnd()`, `PetscSFGetRootRanks()`
+@*/
+PetscErrorCode PetscSFBcastEndSome(PetscSF sf, MPI_Datatype unit, const void *rootdata, void *leafdata, MPI_Op op, PetscInt *ndone, PetscInt done[])
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscAssertPointer(ndone, 6);
+  if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_BcastEnd, sf, 0, 0, 0));
+  if (sf->ops->BcastEndSome) PetscUseTypeMethod(sf, BcastEndSome, unit, rootdata, leafdata, op, ndone, done);
+  else {
+    PetscInt nranks;
+
+    PetscUseTypeMethod(sf, BcastEnd, unit, rootdata, leafdata, op);
+    PetscCall(PetscSFGetRootRanks(sf, &nranks, NULL, NULL, NULL, NULL));
+    for (PetscInt i = 0; i < nranks; i++) done[i] = i;
+    *ndone = nranks;
+  }
+  if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_BcastEnd, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Can the type broadcast the k arrays with a single message per rank? Types do so only for host memory */
+static PetscErrorCode PetscSFBcastMultiUseType_Private(PetscSF sf, PetscInt k, const void *const rootdata[], void *const leafdata[], PetscBool *use)
+{
+  PetscMemType mtype;
+
+  PetscFunctionBegin;
+  *use = (sf->ops->BcastMultiBegin && k > 1) ? PETSC_TRUE : PETSC_FALSE;
+  for (PetscInt j = 0; j < k && *use; j++) {
+    PetscCall(PetscGetMemType(rootdata[j], &mtype));
+    if (!PetscMemTypeHost(mtype)) *use = PETSC_FALSE;
+    PetscCall(PetscGetMemType(leafdata[j], &mtype));
+    if (!PetscMemTypeHost(mtype)) *use = PETSC_FALSE;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFBcastMultiBegin - begin broadcasting several root arrays to several leaf arrays at once, to be concluded with call to `PetscSFBcastMultiEnd()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest on which to communicate
+. unit     - data type associated with each node
+. k        - number of arrays
+. rootdata - the `k` buffers to broadcast
+- op       - operation to use for reduction
+
+  Output Parameter:
+. leafdata - the `k` buffers to be reduced with values from each leaf's respective root, `leafdata[j]` receiving from `rootdata[j]`
+
+  Level: advanced
+
+  Notes:
+  This is equivalent to calling `PetscSFBcastBegin()` on each pair of arrays, but `PETSCSFBASIC` sends a single message per neighbor
+  rank carrying the `k` arrays, so the latency of the communication is paid once instead of `k` times. This is useful when the same
+  communication pattern is applied to a block of vectors, for example the columns of a dense matrix.
+
+  The arrays `rootdata` and `leafdata` (not only their entries) must be kept unchanged until the call to `PetscSFBcastMultiEnd()`.
+
+  Other types, and device memory, fall back to `k` separate broadcasts.
+
+.seealso: `PetscSF`, `PetscSFBcastMultiEnd()`, `PetscSFBcastBegin()`
+@*/
+PetscErrorCode PetscSFBcastMultiBegin(PetscSF sf, MPI_Datatype unit, PetscInt k, const void *const rootdata[], void *const leafdata[], MPI_Op op)
+{
+  PetscBool use;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscCheck(k >= 0, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_OUTOFRANGE, "Number of arrays %" PetscInt_FMT " cannot be negative", k);
+  if (k) {
+    PetscAssertPointer(rootdata, 4);
+    PetscAssertPointer(leafdata, 5);
+  }
+  PetscCall(PetscSFSetUp(sf));
+  if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_BcastBegin, sf, 0, 0, 0));
+  PetscCall(PetscSFBcastMultiUseType_Private(sf, k, rootdata, leafdata, &use));
+  if (use) PetscUseTypeMethod(sf, BcastMultiBegin, unit, k, rootdata, leafdata, op);
+  else {
+    for (PetscInt j = 0; j < k; j++) {
+      PetscMemType rootmtype, leafmtype;
+
+      PetscCall(PetscGetMemType(rootdata[j], &rootmtype));
+      PetscCall(PetscGetMemType(leafdata[j], &leafmtype));
+      PetscUseTypeMethod(sf, BcastBegin, unit, rootmtype, rootdata[j], leafmtype, leafdata[j], op);
+    }
+  }
+  if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_BcastBegin, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscSFBcastMultiEnd - end a broadcast of several arrays started with `PetscSFBcastMultiBegin()`
+
+  Collective
+
+  Input Parameters:
++ sf       - star forest
+. unit     - data type
+. k        - number of arrays
+. rootdata - the `k` buffers to broadcast, the same array as passed to `PetscSFBcastMultiBegin()`
+- op       - operation to use for reduction
+
+  Output Parameter:
+. leafdata - the `k` buffers to be reduced with values from each leaf's respective root, the same array as passed to `PetscSFBcastMultiBegin()`
+
+  Level: advanced
+
+.seealso: `PetscSF`, `PetscSFBcastMultiBegin()`, `PetscSFBcastEnd()`
+@*/
+PetscErrorCode PetscSFBcastMultiEnd(PetscSF sf, MPI_Datatype unit, PetscInt k, const void *const rootdata[], void *const leafdata[], MPI_Op op)
+{
+  PetscBool use;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  if (!sf->vscat.logging) PetscCall(PetscLogEventBegin(PETSCSF_BcastEnd, sf, 0, 0, 0));
+  PetscCall(PetscSFBcastMultiUseType_Private(sf, k, rootdata, leafdata, &use));
+  if (use) PetscUseTypeMethod(sf, BcastMultiEnd, unit, k, rootdata, leafdata, op);
+  else {
+    for (PetscInt j = 0; j < k; j++) PetscUseTypeMethod(sf, BcastEnd, unit, rootdata[j], leafdata[j], op);
+  }
+  if (!sf->vscat.logging) PetscCall(PetscLogEventEnd(PETSCSF_BcastEnd, sf, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   PetscSFReduceBegin - begin reduction of leafdata into rootdata, to be completed with call to `PetscSFReduceEnd()`
 
@@ -12,6 +12,10 @@ PETSC_INTERN PetscErrorCode PetscSFCreate_Alltoall(PetscSF);
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
 PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF);
 #endif
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+PETSC_INTERN PetscErrorCode PetscSFCreate_Shm(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFCreate_Hierarchical(PetscSF);
+#endif
 
 PetscFunctionList PetscSFList;
 PetscBool         PetscSFRegisterAllCalled;
@@ -42,6 +46,10 @@ PetscErrorCode PetscSFRegisterAll(void)
 #if defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
   PetscCall(PetscSFRegister(PETSCSFNEIGHBOR, PetscSFCreate_Neighbor));
 #endif
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+  PetscCall(PetscSFRegister(PETSCSFSHM, PetscSFCreate_Shm));
+#endif
+  PetscCall(PetscSFRegister(PETSCSFHIERARCHICAL, PetscSFCreate_Hierarchical));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -113,7 +113,7 @@ static PetscErrorCode VecScatterRemap_Internal(VecScatter sf, const PetscInt *to
 {
   PetscInt       i, bs = sf->vscat.bs;
   PetscMPIInt    size;
-  PetscBool      ident = PETSC_TRUE, isbasic, isneighbor;
+  PetscBool      ident = PETSC_TRUE, isbasic, isneighbor, isshm;
   PetscSFType    type;
   PetscSF_Basic *bas = NULL;
 
@@ -141,7 +141,8 @@ static PetscErrorCode VecScatterRemap_Internal(VecScatter sf, const PetscInt *to
   PetscCall(PetscSFGetType(sf, &type));
   PetscCall(PetscObjectTypeCompare((PetscObject)sf, PETSCSFBASIC, &isbasic));
   PetscCall(PetscObjectTypeCompare((PetscObject)sf, PETSCSFNEIGHBOR, &isneighbor));
-  PetscCheck(isbasic || isneighbor, PetscObjectComm((PetscObject)sf), PETSC_ERR_SUP, "VecScatterRemap on SF type %s is not supported", type);
+  PetscCall(PetscObjectTypeCompare((PetscObject)sf, PETSCSFSHM, &isshm));
+  PetscCheck(isbasic || isneighbor || isshm, PetscObjectComm((PetscObject)sf), PETSC_ERR_SUP, "VecScatterRemap on SF type %s is not supported", type);
 
   PetscCall(PetscSFSetUp(sf)); /* to build sf->irootloc if SetUp is not yet called */
 
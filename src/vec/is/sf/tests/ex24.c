@@ -0,0 +1,93 @@
+static const char help[] = "Test PetscSFBcastMultiBegin/End() against separate broadcasts\n\n";
+
+#include <petscsf.h>
+
+int main(int argc, char **argv)
+{
+  PetscSF      sf;
+  PetscSFNode *iremote;
+  PetscInt    *ilocal, nroots = 8, nleaves, nvec = 3, i, j;
+  PetscScalar *rootdata[8], *leafdata[8], *leafref[8];
+  PetscMPIInt  rank, size;
+  MPI_Op       op = MPI_REPLACE;
+  PetscBool    sum = PETSC_FALSE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+  PetscOptionsBegin(PETSC_COMM_WORLD, NULL, "PetscSF multi bcast test options", NULL);
+  PetscCall(PetscOptionsInt("-nvec", "Number of arrays to broadcast at once", NULL, nvec, &nvec, NULL));
+  PetscCall(PetscOptionsBool("-sum", "Add root values to leaves instead of replacing them", NULL, sum, &sum, NULL));
+  PetscOptionsEnd();
+  PetscCheck(nvec > 0 && nvec <= 8, PETSC_COMM_WORLD, PETSC_ERR_ARG_OUTOFRANGE, "-nvec must be in [1, 8]");
+  if (sum) op = MPI_SUM;
+
+  /* Each process has leaves on every root of the next process, every other root of the previous one and its first root,
+     in a leaf space with holes */
+  nleaves = nroots + nroots / 2 + 1;
+  PetscCall(PetscMalloc1(nleaves, &ilocal));
+  PetscCall(PetscMalloc1(nleaves, &iremote));
+  for (i = 0; i < nleaves; i++) ilocal[i] = 2 * (nleaves - 1 - i);
+  for (i = 0; i < nroots; i++) {
+    iremote[i].rank  = (rank + 1) % size;
+    iremote[i].index = i;
+  }
+  for (i = 0; i < nroots / 2; i++) {
+    iremote[nroots + i].rank  = (rank + size - 1) % size;
+    iremote[nroots + i].index = 2 * i + 1;
+  }
+  iremote[nleaves - 1].rank  = rank;
+  iremote[nleaves - 1].index = 0;
+  PetscCall(PetscSFCreate(PETSC_COMM_WORLD, &sf));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetGraph(sf, nroots, nleaves, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf));
+
+  for (j = 0; j < nvec; j++) {
+    PetscCall(PetscMalloc3(nroots, &rootdata[j], 2 * nleaves, &leafdata[j], 2 * nleaves, &leafref[j]));
+    for (i = 0; i < nroots; i++) rootdata[j][i] = 100 * j + 10 * rank + i;
+    for (i = 0; i < 2 * nleaves; i++) leafdata[j][i] = leafref[j][i] = -1 - j;
+  }
+
+  /* Do it twice to reuse the link */
+  for (PetscInt it = 0; it < 2; it++) {
+    PetscCall(PetscSFBcastMultiBegin(sf, MPIU_SCALAR, nvec, (const void *const *)rootdata, (void *const *)leafdata, op));
+    PetscCall(PetscSFBcastMultiEnd(sf, MPIU_SCALAR, nvec, (const void *const *)rootdata, (void *const *)leafdata, op));
+    for (j = 0; j < nvec; j++) {
+      PetscCall(PetscSFBcastBegin(sf, MPIU_SCALAR, rootdata[j], leafref[j], op));
+      PetscCall(PetscSFBcastEnd(sf, MPIU_SCALAR, rootdata[j], leafref[j], op));
+    }
+  }
+  for (j = 0; j < nvec; j++) {
+    for (i = 0; i < 2 * nleaves; i++) PetscCheck(leafdata[j][i] == leafref[j][i], PETSC_COMM_SELF, PETSC_ERR_PLIB, "Wrong leaf %" PetscInt_FMT " of array %" PetscInt_FMT, i, j);
+  }
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "Leaf arrays are correct\n"));
+
+  for (j = 0; j < nvec; j++) PetscCall(PetscFree3(rootdata[j], leafdata[j], leafref[j]));
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   testset:
+      nsize: {{1 3}}
+      output_file: output/ex24_1.out
+      args: -sum {{0 1}}
+
+      test:
+        suffix: 1
+        args: -sf_type basic -nvec {{1 3}} -sf_use_mpi_datatypes {{0 1}}
+
+      test:
+        suffix: 1_single
+        args: -sf_type basic -nvec {{1 3}} -sf_use_single_precision
+
+      test:
+        suffix: 1_neighbor
+        requires: defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+        args: -sf_type neighbor
+
+TEST*/
@@ -613,4 +613,36 @@ int main(int argc, char **argv)
       nsize: 4
       args: -sf_type basic -test_all -test_bcastop 0 -test_fetchandop 0
 
+   # Processes exchange through shared memory with none, one or all of the others
+   test:
+      suffix: 10_shm
+      output_file: output/ex1_10_basic.out
+      filter: sed -e "s/type: shm/type: basic/"
+      nsize: 4
+      args: -sf_type shm -sf_shm_node_size {{1 2 4}} -test_all -test_bcastop 0 -test_fetchandop 0
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      suffix: bcastop_shm
+      nsize: 4
+      filter: sed -e "s/type: shm/type: basic/"
+      args: -test_bcastop -sf_type shm -sf_shm_node_size {{2 4}}
+      output_file: output/ex1_bcastop_basic.out
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   # Nodes of one, two or four processes communicate through their first process
+   test:
+      suffix: 10_hierarchical
+      output_file: output/ex1_10_basic.out
+      filter: sed -e "s/type: hierarchical/type: basic/" | grep -v "On-node edges"
+      nsize: 4
+      args: -sf_type hierarchical -sf_hierarchical_node_size {{1 2 4}} -test_all -test_bcastop 0 -test_fetchandop 0
+
+   test:
+      suffix: bcastop_hierarchical
+      nsize: 4
+      filter: sed -e "s/type: hierarchical/type: basic/" | grep -v "On-node edges"
+      args: -test_bcastop -sf_type hierarchical -sf_hierarchical_node_size {{1 2}}
+      output_file: output/ex1_bcastop_basic.out
+
 TEST*/
@@ -40,6 +40,12 @@ PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDot_Seq(Vec, PetscInt, const Vec[
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMTDot_Seq(Vec, PetscInt, const Vec[], PetscScalar *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecSet_Seq(Vec, PetscScalar);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMAXPY_Seq(Vec, PetscInt, const PetscScalar *, Vec *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDot_Seq_GEMV(Vec, PetscInt, const Vec[], PetscScalar *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMTDot_Seq_GEMV(Vec, PetscInt, const Vec[], PetscScalar *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMAXPY_Seq_GEMV(Vec, PetscInt, const PetscScalar *, Vec *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecDuplicateVecs_Seq_GEMV(Vec, PetscInt, Vec *[]);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDotAndMAXPY_Seq(Vec, PetscInt, const PetscScalar *, Vec *, PetscScalar *, PetscReal *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDotAndMAXPYLocal_Seq(Vec, PetscInt, const PetscScalar *, Vec *, PetscScalar *, PetscReal *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecAYPX_Seq(Vec, PetscScalar, Vec);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecWAXPY_Seq(Vec, PetscScalar, Vec, Vec);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecAXPBYPCZ_Seq(Vec, PetscScalar, PetscScalar, PetscScalar, Vec, Vec);
@@ -177,6 +177,7 @@ static PetscErrorCode VecBindToCPU_MPIViennaCL(Vec vv, PetscBool bind)
     vv->ops->axpy                   = VecAXPY_Seq;
     vv->ops->axpby                  = VecAXPBY_Seq;
     vv->ops->maxpy                  = VecMAXPY_Seq;
+    vv->ops->mdotandmaxpy           = VecMDotAndMAXPY_MPI;
     vv->ops->aypx                   = VecAYPX_Seq;
     vv->ops->axpbypcz               = VecAXPBYPCZ_Seq;
     vv->ops->pointwisemult          = VecPointwiseMult_Seq;
@@ -209,6 +210,7 @@ static PetscErrorCode VecBindToCPU_MPIViennaCL(Vec vv, PetscBool bind)
     vv->ops->axpy            = VecAXPY_SeqViennaCL;
     vv->ops->axpby           = VecAXPBY_SeqViennaCL;
     vv->ops->maxpy           = VecMAXPY_SeqViennaCL;
+    vv->ops->mdotandmaxpy    = NULL;
     vv->ops->aypx            = VecAYPX_SeqViennaCL;
     vv->ops->axpbypcz        = VecAXPBYPCZ_SeqViennaCL;
     vv->ops->pointwisemult   = VecPointwiseMult_SeqViennaCL;
@@ -52,6 +52,40 @@ PetscErrorCode VecDuplicate_MPI(Vec win, Vec *v)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* see VecDuplicateVecs_Seq_GEMV(); vectors with ghost points keep separate arrays */
+PetscErrorCode VecDuplicateVecs_MPI_GEMV(Vec w, PetscInt m, Vec *V[])
+{
+  Vec_MPI       *wmpi = (Vec_MPI *)w->data;
+  const PetscInt n    = w->map->n;
+  PetscScalar   *array;
+  PetscBool      ismpi;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)w, VECMPI, &ismpi));
+  if (!ismpi || wmpi->nghost || wmpi->localrep) {
+    PetscCall(VecDuplicateVecs_Default(w, m, V));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCheck(m > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "m must be > 0: m = %" PetscInt_FMT, m);
+  PetscCall(PetscMalloc1(m, V));
+  PetscCall(PetscCalloc1(m * n, &array));
+  for (PetscInt i = 0; i < m; i++) {
+    Vec v;
+
+    PetscCall(VecCreateWithLayout_Private(w->map, &v));
+    PetscCall(VecCreate_MPI_Private(v, PETSC_FALSE, 0, array + i * n));
+    v->ops[0]             = w->ops[0];
+    v->stash.donotstash   = w->stash.donotstash;
+    v->stash.ignorenegidx = w->stash.ignorenegidx;
+    v->bstash.bs          = w->bstash.bs;
+    PetscCall(PetscObjectListDuplicate(((PetscObject)w)->olist, &((PetscObject)v)->olist));
+    PetscCall(PetscFunctionListDuplicate(((PetscObject)w)->qlist, &((PetscObject)v)->qlist));
+    (*V)[i] = v;
+  }
+  PetscCall(VecDuplicateVecsComposeArray_Private(m, *V, array));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode VecSetOption_MPI(Vec V, VecOption op, PetscBool flag)
 {
   Vec_MPI *v = (Vec_MPI *)V->data;
@@ -452,7 +486,9 @@ static struct _VecOps DvOps = {PetscDesignatedInitializer(duplicate, VecDuplicat
                                PetscDesignatedInitializer(sum, NULL),
                                PetscDesignatedInitializer(setpreallocationcoo, VecSetPreallocationCOO_MPI),
                                PetscDesignatedInitializer(setvaluescoo, VecSetValuesCOO_MPI),
-                               PetscDesignatedInitializer(errorwnorm, NULL)};
+                               PetscDesignatedInitializer(errorwnorm, NULL),
+                               PetscDesignatedInitializer(maxpby, NULL),
+                               PetscDesignatedInitializer(mdotandmaxpy, VecMDotAndMAXPY_MPI)};
 
 /*
     VecCreate_MPI_Private - Basic create routine called by VecCreate_MPI() (i.e. VecCreateMPI()),
@@ -464,7 +500,8 @@ static struct _VecOps DvOps = {PetscDesignatedInitializer(duplicate, VecDuplicat
 */
 PetscErrorCode VecCreate_MPI_Private(Vec v, PetscBool alloc, PetscInt nghost, const PetscScalar array[])
 {
-  Vec_MPI *s;
+  Vec_MPI  *s;
+  PetscBool mdot_use_gemv = PETSC_FALSE, maxpy_use_gemv = PETSC_FALSE;
 
   PetscFunctionBegin;
   PetscCall(PetscNew(&s));
@@ -473,6 +510,16 @@ PetscErrorCode VecCreate_MPI_Private(Vec v, PetscBool alloc, PetscInt nghost, co
   s->nghost      = nghost;
   v->petscnative = PETSC_TRUE;
   if (array) v->offloadmask = PETSC_OFFLOAD_CPU;
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-vec_mdot_use_gemv", &mdot_use_gemv, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-vec_maxpy_use_gemv", &maxpy_use_gemv, NULL));
+  if (mdot_use_gemv || maxpy_use_gemv) v->ops->duplicatevecs = VecDuplicateVecs_MPI_GEMV;
+  if (mdot_use_gemv) {
+    v->ops->mdot        = VecMDot_MPI_GEMV;
+    v->ops->mtdot       = VecMTDot_MPI_GEMV;
+    v->ops->mdot_local  = VecMDot_Seq_GEMV;
+    v->ops->mtdot_local = VecMTDot_Seq_GEMV;
+  }
+  if (maxpy_use_gemv) v->ops->maxpy = VecMAXPY_Seq_GEMV;
 
   PetscCall(PetscLayoutSetUp(v->map));
 
@@ -510,11 +557,17 @@ PetscErrorCode VecCreate_MPI_Private(Vec v, PetscBool alloc, PetscInt nghost, co
 /*MC
    VECMPI - VECMPI = "mpi" - The basic parallel vector
 
-   Options Database Key:
-. -vec_type mpi - sets the vector type to `VECMPI` during a call to `VecSetFromOptions()`
+   Options Database Keys:
++ -vec_type mpi              - sets the vector type to `VECMPI` during a call to `VecSetFromOptions()`
+. -vec_mdot_use_gemv <bool>  - `VecDuplicateVecs()` stores the local parts of the vectors as the consecutive columns of a single array and `VecMDot()` and `VecMTDot()` use BLAS gemv on them
+- -vec_maxpy_use_gemv <bool> - `VecDuplicateVecs()` stores the local parts of the vectors as the consecutive columns of a single array and `VecMAXPY()` uses BLAS gemv on them
 
   Level: beginner
 
+  Note:
+  The vectors of `VecDuplicateVecs()` with these options are the columns of a `MATDENSE` with the same row layout, whose
+  array is the one of the first vector. Vectors with ghost points are always stored separately.
+
 .seealso: [](ch_vectors), `Vec`, `VecType`, `VecCreate()`, `VecSetType()`, `VecSetFromOptions()`, `VecCreateMPIWithArray()`, `VECMPI`, `VecType`, `VecCreateMPI()`, `VecCreateMPI()`
 M*/
 
@@ -25,6 +25,37 @@ PetscErrorCode VecMDot_MPI(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+PetscErrorCode VecMDot_MPI_GEMV(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMXDot_MPI_Default(xin, nv, y, z, VecMDot_Seq_GEMV));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMTDot_MPI_GEMV(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMXDot_MPI_Default(xin, nv, y, z, VecMTDot_Seq_GEMV));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the local inner products and the square of the local norm are reduced together */
+PetscErrorCode VecMDotAndMAXPY_MPI(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec *y, PetscScalar *z, PetscReal *norm)
+{
+  PetscScalar *work;
+  PetscReal    nrm2 = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(nv + 1, &work));
+  PetscCall(VecMDotAndMAXPYLocal_Seq(xin, nv, alpha, y, work, norm ? &nrm2 : NULL));
+  work[nv] = nrm2;
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, work, nv + (norm ? 1 : 0), MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)xin)));
+  PetscCall(PetscArraycpy(z, work, nv));
+  if (norm) *norm = PetscSqrtReal(PetscRealPart(work[nv]));
+  PetscCall(PetscFree(work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode VecMTDot_MPI(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
 {
   PetscFunctionBegin;
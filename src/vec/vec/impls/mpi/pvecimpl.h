@@ -80,6 +80,10 @@ PETSC_INTERN PetscErrorCode VecSetValuesCOO_MPI(Vec, const PetscScalar[], Insert
 
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecDot_MPI(Vec, Vec, PetscScalar *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDot_MPI(Vec, PetscInt, const Vec[], PetscScalar *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDot_MPI_GEMV(Vec, PetscInt, const Vec[], PetscScalar *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMTDot_MPI_GEMV(Vec, PetscInt, const Vec[], PetscScalar *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecDuplicateVecs_MPI_GEMV(Vec, PetscInt, Vec *[]);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDotAndMAXPY_MPI(Vec, PetscInt, const PetscScalar *, Vec *, PetscScalar *, PetscReal *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecTDot_MPI(Vec, Vec, PetscScalar *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecNorm_MPI(Vec, NormType, PetscReal *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMax_MPI(Vec, PetscInt *, PetscReal *);
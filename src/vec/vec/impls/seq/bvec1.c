@@ -81,7 +81,13 @@ PetscErrorCode VecAXPY_Seq(Vec yin, PetscScalar alpha, Vec xin)
     PetscCall(PetscLogFlops(2.0 * bn));
     PetscCall(VecGetArrayRead(xin, &xarray));
     PetscCall(VecGetArray(yin, &yarray));
-    PetscCallBLAS("BLASaxpy", BLASaxpy_(&bn, &alpha, xarray, &one, yarray, &one));
+#if defined(PETSC_HAVE_OPENMP)
+    if (bn > PETSC_OMP_MIN_ITERATIONS) {
+      PetscPragmaOMP(parallel for schedule(static))
+      for (PetscBLASInt i = 0; i < bn; i++) yarray[i] += alpha * xarray[i];
+    } else
+#endif
+      PetscCallBLAS("BLASaxpy", BLASaxpy_(&bn, &alpha, xarray, &one, yarray, &one));
     PetscCall(VecRestoreArrayRead(xin, &xarray));
     PetscCall(VecRestoreArray(yin, &yarray));
   }
@@ -750,6 +750,41 @@ PetscErrorCode VecDuplicate_Seq(Vec win, Vec *V)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   With -vec_mdot_use_gemv or -vec_maxpy_use_gemv the vectors are consecutive columns of a single array, laid out as the
+   values of a MATDENSE, so that VecMDot() and VecMAXPY() can use BLAS gemv on them
+*/
+PetscErrorCode VecDuplicateVecs_Seq_GEMV(Vec w, PetscInt m, Vec *V[])
+{
+  const PetscInt n = w->map->n;
+  PetscScalar   *array;
+  PetscBool      isseq;
+
+  PetscFunctionBegin;
+  /* types that derive from VECSEQ keep their own storage */
+  PetscCall(PetscObjectTypeCompare((PetscObject)w, VECSEQ, &isseq));
+  if (!isseq) {
+    PetscCall(VecDuplicateVecs_Default(w, m, V));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCheck(m > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "m must be > 0: m = %" PetscInt_FMT, m);
+  PetscCall(PetscMalloc1(m, V));
+  PetscCall(PetscCalloc1(m * n, &array));
+  for (PetscInt i = 0; i < m; i++) {
+    Vec v;
+
+    PetscCall(VecCreateWithLayout_Private(w->map, &v));
+    PetscCall(VecCreate_Seq_Private(v, array + i * n));
+    PetscCall(PetscObjectListDuplicate(((PetscObject)w)->olist, &((PetscObject)v)->olist));
+    PetscCall(PetscFunctionListDuplicate(((PetscObject)w)->qlist, &((PetscObject)v)->qlist));
+    v->ops[0]             = w->ops[0];
+    v->stash.ignorenegidx = w->stash.ignorenegidx;
+    (*V)[i]               = v;
+  }
+  PetscCall(VecDuplicateVecsComposeArray_Private(m, *V, array));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static const struct _VecOps DvOps = {
   PetscDesignatedInitializer(duplicate, VecDuplicate_Seq), /* 1 */
   PetscDesignatedInitializer(duplicatevecs, VecDuplicateVecs_Default),
@@ -840,6 +875,8 @@ static const struct _VecOps DvOps = {
   PetscDesignatedInitializer(setpreallocationcoo, VecSetPreallocationCOO_Seq),
   PetscDesignatedInitializer(setvaluescoo, VecSetValuesCOO_Seq),
   PetscDesignatedInitializer(errorwnorm, NULL),
+  PetscDesignatedInitializer(maxpby, NULL),
+  PetscDesignatedInitializer(mdotandmaxpy, VecMDotAndMAXPY_Seq),
 };
 
 /*
@@ -849,9 +886,21 @@ PetscErrorCode VecCreate_Seq_Private(Vec v, const PetscScalar array[])
 {
   Vec_Seq *s;
 
+  PetscBool mdot_use_gemv = PETSC_FALSE, maxpy_use_gemv = PETSC_FALSE;
+
   PetscFunctionBegin;
   PetscCall(PetscNew(&s));
   v->ops[0] = DvOps;
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-vec_mdot_use_gemv", &mdot_use_gemv, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-vec_maxpy_use_gemv", &maxpy_use_gemv, NULL));
+  if (mdot_use_gemv || maxpy_use_gemv) v->ops->duplicatevecs = VecDuplicateVecs_Seq_GEMV;
+  if (mdot_use_gemv) {
+    v->ops->mdot        = VecMDot_Seq_GEMV;
+    v->ops->mtdot       = VecMTDot_Seq_GEMV;
+    v->ops->mdot_local  = VecMDot_Seq_GEMV;
+    v->ops->mtdot_local = VecMTDot_Seq_GEMV;
+  }
+  if (maxpy_use_gemv) v->ops->maxpy = VecMAXPY_Seq_GEMV;
 
   v->data            = (void *)s;
   v->petscnative     = PETSC_TRUE;
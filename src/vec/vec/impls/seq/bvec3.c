@@ -7,10 +7,16 @@
    VECSEQ - VECSEQ = "seq" - The basic sequential vector
 
    Options Database Keys:
-. -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
++ -vec_type seq              - sets the vector type to VECSEQ during a call to VecSetFromOptions()
+. -vec_mdot_use_gemv <bool>  - `VecDuplicateVecs()` stores the vectors as the consecutive columns of a single array and `VecMDot()` and `VecMTDot()` use BLAS gemv on them
+- -vec_maxpy_use_gemv <bool> - `VecDuplicateVecs()` stores the vectors as the consecutive columns of a single array and `VecMAXPY()` uses BLAS gemv on them
 
   Level: beginner
 
+  Note:
+  The array holding the vectors of `VecDuplicateVecs()` with these options is laid out as the values of a `MATDENSE` with the
+  local length of the vectors as leading dimension, so the array of the first vector can be passed to `MatCreateDense()`
+
 .seealso: `VecCreate()`, `VecSetType()`, `VecSetFromOptions()`, `VecCreateSeqWithArray()`, `VECMPI`, `VecType`, `VecCreateMPI()`, `VecCreateSeq()`
 M*/
 
@@ -30,7 +36,14 @@ PetscErrorCode VecCreate_Seq(Vec V)
   PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)V), &size));
   PetscCheck(size <= 1, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Cannot create VECSEQ on more than one process");
 #if !defined(PETSC_USE_MIXED_PRECISION)
+  #if defined(PETSC_HAVE_OPENMP)
+  /* first touch the entries by the threads that process them in the threaded kernels */
+  PetscCall(PetscMalloc1(n, &array));
+  PetscPragmaOMP(parallel for schedule(static) if (n > PETSC_OMP_MIN_ITERATIONS))
+  for (PetscInt i = 0; i < n; i++) array[i] = 0.0;
+  #else
   PetscCall(PetscCalloc1(n, &array));
+  #endif
   PetscCall(VecCreate_Seq_Private(V, array));
 
   s                  = (Vec_Seq *)V->data;
@@ -4,8 +4,160 @@
 */
 #include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/kernels/petscaxpy.h>
+#include <petscblaslapack.h>
+#if defined(PETSC_HAVE_OPENMP)
+  #include <omp.h>
+#endif
+
+/*
+   Number of entries of the vectors of a multiple vector operation handled together: a tile of each vector is used with
+   the tiles of all the others before moving to the next one, so each vector is read from memory only once
+*/
+#define VEC_SEQ_MULTI_TILE 1024
+
+/* z[k] += sum_i x[i] conj(yy[k][off + i]) for the nb entries of a tile, four vectors at a time */
+static inline void VecMDotTile_Private(PetscInt nb, const PetscScalar *x, PetscInt nv, const PetscScalar *const *yy, PetscInt off, PetscScalar *z)
+{
+  PetscInt k = 0;
+
+  for (; k + 4 <= nv; k += 4) {
+    const PetscScalar *y0 = yy[k] + off, *y1 = yy[k + 1] + off, *y2 = yy[k + 2] + off, *y3 = yy[k + 3] + off;
+    PetscScalar        s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+
+    for (PetscInt i = 0; i < nb; i++) {
+      const PetscScalar xi = x[i];
+
+      s0 += xi * PetscConj(y0[i]);
+      s1 += xi * PetscConj(y1[i]);
+      s2 += xi * PetscConj(y2[i]);
+      s3 += xi * PetscConj(y3[i]);
+    }
+    z[k] += s0;
+    z[k + 1] += s1;
+    z[k + 2] += s2;
+    z[k + 3] += s3;
+  }
+  for (; k < nv; k++) {
+    const PetscScalar *y0 = yy[k] + off;
+    PetscScalar        s0 = 0.0;
+
+    for (PetscInt i = 0; i < nb; i++) s0 += x[i] * PetscConj(y0[i]);
+    z[k] += s0;
+  }
+}
+
+/* x[i] += sum_k alpha[k] yy[k][off + i] for the nb entries of a tile, with the remaining vectors first and then four at a time */
+static inline PetscErrorCode VecMAXPYTile_Private(PetscInt nb, PetscScalar *x, PetscInt nv, const PetscScalar *alpha, const PetscScalar *const *yy, PetscInt off)
+{
+  const PetscInt j_rem = nv & 0x3;
+  PetscScalar   *xx    = x;
+  PetscInt       n     = nb;
+
+  PetscFunctionBegin;
+  switch (j_rem) {
+  case 3: {
+    const PetscScalar *p0 = yy[0] + off, *p1 = yy[1] + off, *p2 = yy[2] + off;
+
+    PetscKernelAXPY3(xx, alpha[0], alpha[1], alpha[2], p0, p1, p2, n);
+  } break;
+  case 2: {
+    const PetscScalar *p0 = yy[0] + off, *p1 = yy[1] + off;
+
+    PetscKernelAXPY2(xx, alpha[0], alpha[1], p0, p1, n);
+  } break;
+  case 1: {
+    const PetscScalar *p0 = yy[0] + off;
+
+    PetscKernelAXPY(xx, alpha[0], p0, n);
+  } break;
+  default:
+    break;
+  }
+  for (PetscInt j = j_rem; j < nv; j += 4) {
+    const PetscScalar *p0 = yy[j] + off, *p1 = yy[j + 1] + off, *p2 = yy[j + 2] + off, *p3 = yy[j + 3] + off;
+
+    xx = x;
+    n  = nb;
+    PetscKernelAXPY4(xx, alpha[j], alpha[j + 1], alpha[j + 2], alpha[j + 3], p0, p1, p2, p3, n);
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#if defined(PETSC_HAVE_OPENMP) || !defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
+static PetscErrorCode VecMDot_Seq_Tiled_Private(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z)
+{
+  const PetscInt      n = xin->map->n;
+  const PetscScalar  *x;
+  const PetscScalar **yy;
+
+  PetscFunctionBegin;
+  PetscCall(PetscArrayzero(z, nv));
+  if (n == 0) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc1(nv, &yy));
+  PetscCall(VecGetArrayRead(xin, &x));
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecGetArrayRead(yin[k], &yy[k]));
+  /* each tile of x is used with all the vectors while it is in cache, so x is only read once from memory */
+  for (PetscInt i = 0; i < n; i += VEC_SEQ_MULTI_TILE) VecMDotTile_Private(PetscMin(VEC_SEQ_MULTI_TILE, n - i), x + i, nv, yy, i, z);
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecRestoreArrayRead(yin[k], &yy[k]));
+  PetscCall(VecRestoreArrayRead(xin, &x));
+  PetscCall(PetscFree(yy));
+  PetscCall(PetscLogFlops(PetscMax(nv * (2.0 * n - 1), 0.0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
+#if defined(PETSC_HAVE_OPENMP)
+/* largest number of threads used by VecMDot_Seq(), whose partial sums are kept on the stack */
+  #define VEC_SEQ_MDOT_MAX_THREADS 256
+
+/*
+   Each thread accumulates the partial inner products of its static chunk of entries with four vectors at a time; the
+   partial sums are added in the order of the threads so the result does not depend on the scheduling. Short vectors,
+   or a single thread, use the serial tiled kernel.
+*/
+PetscErrorCode VecMDot_Seq(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z)
+{
+  const PetscInt     n  = xin->map->n;
+  const PetscInt     nt = PetscMin((PetscInt)omp_get_max_threads(), VEC_SEQ_MDOT_MAX_THREADS);
+  const PetscScalar *x, *yy[4];
+  PetscScalar        partial[4 * VEC_SEQ_MDOT_MAX_THREADS];
 
-#if defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
+  PetscFunctionBegin;
+  if (n <= PETSC_OMP_MIN_ITERATIONS || nt == 1) {
+    PetscCall(VecMDot_Seq_Tiled_Private(xin, nv, yin, z));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecGetArrayRead(xin, &x));
+  for (PetscInt j = 0; j < nv; j += 4) {
+    const PetscInt nj = PetscMin(4, nv - j);
+
+    for (PetscInt k = 0; k < nj; k++) PetscCall(VecGetArrayRead(yin[j + k], &yy[k]));
+    PetscCall(PetscArrayzero(partial, 4 * nt));
+    PetscPragmaOMP(parallel num_threads((int)nt))
+    {
+      PetscScalar sum[4] = {0.0, 0.0, 0.0, 0.0};
+      PetscInt    t      = (PetscInt)omp_get_thread_num();
+
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt i = 0; i < n; i++) {
+        const PetscScalar xi = x[i];
+
+        for (PetscInt k = 0; k < nj; k++) sum[k] += xi * PetscConj(yy[k][i]);
+      }
+      for (PetscInt k = 0; k < nj; k++) partial[4 * t + k] = sum[k];
+    }
+    for (PetscInt k = 0; k < nj; k++) {
+      z[j + k] = 0.0;
+      for (PetscInt t = 0; t < nt; t++) z[j + k] += partial[4 * t + k];
+      PetscCall(VecRestoreArrayRead(yin[j + k], &yy[k]));
+    }
+  }
+  PetscCall(VecRestoreArrayRead(xin, &x));
+  PetscCall(PetscLogFlops(PetscMax(nv * (2.0 * n - 1), 0.0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#elif defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
   #include <../src/vec/vec/impls/seq/ftn-kernels/fmdot.h>
 PetscErrorCode VecMDot_Seq(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z)
 {
@@ -82,218 +234,8 @@ PetscErrorCode VecMDot_Seq(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z
 #else
 PetscErrorCode VecMDot_Seq(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z)
 {
-  const PetscInt     n = xin->map->n;
-  PetscInt           i = nv, j = n, nv_rem = nv & 0x3, j_rem;
-  PetscScalar        sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3, x0, x1, x2, x3;
-  const PetscScalar *yy0, *yy1, *yy2, *yy3, *x, *xbase;
-  const Vec         *yy = (Vec *)yin;
-
   PetscFunctionBegin;
-  if (n == 0) {
-    PetscCall(PetscArrayzero(z, nv));
-    PetscFunctionReturn(PETSC_SUCCESS);
-  }
-  PetscCall(VecGetArrayRead(xin, &xbase));
-  x = xbase;
-  switch (nv_rem) {
-  case 3:
-    PetscCall(VecGetArrayRead(yy[0], &yy0));
-    PetscCall(VecGetArrayRead(yy[1], &yy1));
-    PetscCall(VecGetArrayRead(yy[2], &yy2));
-    switch (j_rem = j & 0x3) {
-    case 3:
-      x2 = x[2];
-      sum0 += x2 * PetscConj(yy0[2]);
-      sum1 += x2 * PetscConj(yy1[2]);
-      sum2 += x2 * PetscConj(yy2[2]); /* fall through */
-    case 2:
-      x1 = x[1];
-      sum0 += x1 * PetscConj(yy0[1]);
-      sum1 += x1 * PetscConj(yy1[1]);
-      sum2 += x1 * PetscConj(yy2[1]); /* fall through */
-    case 1:
-      x0 = x[0];
-      sum0 += x0 * PetscConj(yy0[0]);
-      sum1 += x0 * PetscConj(yy1[0]);
-      sum2 += x0 * PetscConj(yy2[0]); /* fall through */
-    case 0:
-      x += j_rem;
-      yy0 += j_rem;
-      yy1 += j_rem;
-      yy2 += j_rem;
-      j -= j_rem;
-      break;
-    }
-    while (j > 0) {
-      x0 = x[0];
-      x1 = x[1];
-      x2 = x[2];
-      x3 = x[3];
-      x += 4;
-
-      sum0 += x0 * PetscConj(yy0[0]) + x1 * PetscConj(yy0[1]) + x2 * PetscConj(yy0[2]) + x3 * PetscConj(yy0[3]);
-      yy0 += 4;
-      sum1 += x0 * PetscConj(yy1[0]) + x1 * PetscConj(yy1[1]) + x2 * PetscConj(yy1[2]) + x3 * PetscConj(yy1[3]);
-      yy1 += 4;
-      sum2 += x0 * PetscConj(yy2[0]) + x1 * PetscConj(yy2[1]) + x2 * PetscConj(yy2[2]) + x3 * PetscConj(yy2[3]);
-      yy2 += 4;
-      j -= 4;
-    }
-    z[0] = sum0;
-    z[1] = sum1;
-    z[2] = sum2;
-    PetscCall(VecRestoreArrayRead(yy[0], &yy0));
-    PetscCall(VecRestoreArrayRead(yy[1], &yy1));
-    PetscCall(VecRestoreArrayRead(yy[2], &yy2));
-    break;
-  case 2:
-    PetscCall(VecGetArrayRead(yy[0], &yy0));
-    PetscCall(VecGetArrayRead(yy[1], &yy1));
-    switch (j_rem = j & 0x3) {
-    case 3:
-      x2 = x[2];
-      sum0 += x2 * PetscConj(yy0[2]);
-      sum1 += x2 * PetscConj(yy1[2]); /* fall through */
-    case 2:
-      x1 = x[1];
-      sum0 += x1 * PetscConj(yy0[1]);
-      sum1 += x1 * PetscConj(yy1[1]); /* fall through */
-    case 1:
-      x0 = x[0];
-      sum0 += x0 * PetscConj(yy0[0]);
-      sum1 += x0 * PetscConj(yy1[0]); /* fall through */
-    case 0:
-      x += j_rem;
-      yy0 += j_rem;
-      yy1 += j_rem;
-      j -= j_rem;
-      break;
-    }
-    while (j > 0) {
-      x0 = x[0];
-      x1 = x[1];
-      x2 = x[2];
-      x3 = x[3];
-      x += 4;
-
-      sum0 += x0 * PetscConj(yy0[0]) + x1 * PetscConj(yy0[1]) + x2 * PetscConj(yy0[2]) + x3 * PetscConj(yy0[3]);
-      yy0 += 4;
-      sum1 += x0 * PetscConj(yy1[0]) + x1 * PetscConj(yy1[1]) + x2 * PetscConj(yy1[2]) + x3 * PetscConj(yy1[3]);
-      yy1 += 4;
-      j -= 4;
-    }
-    z[0] = sum0;
-    z[1] = sum1;
-
-    PetscCall(VecRestoreArrayRead(yy[0], &yy0));
-    PetscCall(VecRestoreArrayRead(yy[1], &yy1));
-    break;
-  case 1:
-    PetscCall(VecGetArrayRead(yy[0], &yy0));
-    switch (j_rem = j & 0x3) {
-    case 3:
-      x2 = x[2];
-      sum0 += x2 * PetscConj(yy0[2]); /* fall through */
-    case 2:
-      x1 = x[1];
-      sum0 += x1 * PetscConj(yy0[1]); /* fall through */
-    case 1:
-      x0 = x[0];
-      sum0 += x0 * PetscConj(yy0[0]); /* fall through */
-    case 0:
-      x += j_rem;
-      yy0 += j_rem;
-      j -= j_rem;
-      break;
-    }
-    while (j > 0) {
-      sum0 += x[0] * PetscConj(yy0[0]) + x[1] * PetscConj(yy0[1]) + x[2] * PetscConj(yy0[2]) + x[3] * PetscConj(yy0[3]);
-      yy0 += 4;
-      j -= 4;
-      x += 4;
-    }
-    z[0] = sum0;
-
-    PetscCall(VecRestoreArrayRead(yy[0], &yy0));
-    break;
-  case 0:
-    break;
-  }
-  z += nv_rem;
-  i -= nv_rem;
-  yy += nv_rem;
-
-  while (i > 0) {
-    sum0 = 0.;
-    sum1 = 0.;
-    sum2 = 0.;
-    sum3 = 0.;
-    PetscCall(VecGetArrayRead(yy[0], &yy0));
-    PetscCall(VecGetArrayRead(yy[1], &yy1));
-    PetscCall(VecGetArrayRead(yy[2], &yy2));
-    PetscCall(VecGetArrayRead(yy[3], &yy3));
-
-    j = n;
-    x = xbase;
-    switch (j_rem = j & 0x3) {
-    case 3:
-      x2 = x[2];
-      sum0 += x2 * PetscConj(yy0[2]);
-      sum1 += x2 * PetscConj(yy1[2]);
-      sum2 += x2 * PetscConj(yy2[2]);
-      sum3 += x2 * PetscConj(yy3[2]); /* fall through */
-    case 2:
-      x1 = x[1];
-      sum0 += x1 * PetscConj(yy0[1]);
-      sum1 += x1 * PetscConj(yy1[1]);
-      sum2 += x1 * PetscConj(yy2[1]);
-      sum3 += x1 * PetscConj(yy3[1]); /* fall through */
-    case 1:
-      x0 = x[0];
-      sum0 += x0 * PetscConj(yy0[0]);
-      sum1 += x0 * PetscConj(yy1[0]);
-      sum2 += x0 * PetscConj(yy2[0]);
-      sum3 += x0 * PetscConj(yy3[0]); /* fall through */
-    case 0:
-      x += j_rem;
-      yy0 += j_rem;
-      yy1 += j_rem;
-      yy2 += j_rem;
-      yy3 += j_rem;
-      j -= j_rem;
-      break;
-    }
-    while (j > 0) {
-      x0 = x[0];
-      x1 = x[1];
-      x2 = x[2];
-      x3 = x[3];
-      x += 4;
-
-      sum0 += x0 * PetscConj(yy0[0]) + x1 * PetscConj(yy0[1]) + x2 * PetscConj(yy0[2]) + x3 * PetscConj(yy0[3]);
-      yy0 += 4;
-      sum1 += x0 * PetscConj(yy1[0]) + x1 * PetscConj(yy1[1]) + x2 * PetscConj(yy1[2]) + x3 * PetscConj(yy1[3]);
-      yy1 += 4;
-      sum2 += x0 * PetscConj(yy2[0]) + x1 * PetscConj(yy2[1]) + x2 * PetscConj(yy2[2]) + x3 * PetscConj(yy2[3]);
-      yy2 += 4;
-      sum3 += x0 * PetscConj(yy3[0]) + x1 * PetscConj(yy3[1]) + x2 * PetscConj(yy3[2]) + x3 * PetscConj(yy3[3]);
-      yy3 += 4;
-      j -= 4;
-    }
-    z[0] = sum0;
-    z[1] = sum1;
-    z[2] = sum2;
-    z[3] = sum3;
-    z += 4;
-    i -= 4;
-    PetscCall(VecRestoreArrayRead(yy[0], &yy0));
-    PetscCall(VecRestoreArrayRead(yy[1], &yy1));
-    PetscCall(VecRestoreArrayRead(yy[2], &yy2));
-    PetscCall(VecRestoreArrayRead(yy[3], &yy3));
-    yy += 4;
-  }
-  PetscCall(VecRestoreArrayRead(xin, &xbase));
-  PetscCall(PetscLogFlops(PetscMax(nv * (2.0 * n - 1), 0.0)));
+  PetscCall(VecMDot_Seq_Tiled_Private(xin, nv, yin, z));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 #endif
@@ -581,38 +523,158 @@ PetscErrorCode VecSet_Seq(Vec xin, PetscScalar alpha)
 
 PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec *y)
 {
-  const PetscInt     j_rem = nv & 0x3, n = xin->map->n;
-  const PetscScalar *yptr[4];
-  PetscScalar       *xx;
-#if defined(PETSC_HAVE_PRAGMA_DISJOINT)
-  #pragma disjoint(*xx, **yptr, *aptr)
-#endif
+  const PetscInt      n = xin->map->n;
+  const PetscScalar **yptr;
+  PetscScalar        *xx;
 
   PetscFunctionBegin;
   PetscCall(PetscLogFlops(nv * 2.0 * n));
+  PetscCall(PetscMalloc1(nv, &yptr));
   PetscCall(VecGetArray(xin, &xx));
-  for (PetscInt i = 0; i < j_rem; ++i) PetscCall(VecGetArrayRead(y[i], yptr + i));
-  switch (j_rem) {
-  case 3:
-    PetscKernelAXPY3(xx, alpha[0], alpha[1], alpha[2], yptr[0], yptr[1], yptr[2], n);
-    break;
-  case 2:
-    PetscKernelAXPY2(xx, alpha[0], alpha[1], yptr[0], yptr[1], n);
-    break;
-  case 1:
-    PetscKernelAXPY(xx, alpha[0], yptr[0], n);
-  default:
-    break;
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecGetArrayRead(y[k], &yptr[k]));
+#if defined(PETSC_HAVE_OPENMP)
+  if (n > PETSC_OMP_MIN_ITERATIONS) {
+    for (PetscInt j = 0; j < nv; j += 4) {
+      const PetscInt nj = PetscMin(4, nv - j);
+
+      PetscPragmaOMP(parallel for schedule(static))
+      for (PetscInt i = 0; i < n; i++) {
+        PetscScalar s = xx[i];
+
+        for (PetscInt k = 0; k < nj; k++) s += alpha[j + k] * yptr[j + k][i];
+        xx[i] = s;
+      }
+    }
+  } else
+#endif
+  {
+    /* each tile of x is updated with all the vectors while it is in cache, so x is only read and written once */
+    for (PetscInt i = 0; i < n; i += VEC_SEQ_MULTI_TILE) PetscCall(VecMAXPYTile_Private(PetscMin(VEC_SEQ_MULTI_TILE, n - i), xx + i, nv, alpha, yptr, i));
   }
-  for (PetscInt i = 0; i < j_rem; ++i) PetscCall(VecRestoreArrayRead(y[i], yptr + i));
-  alpha += j_rem;
-  y += j_rem;
-  for (PetscInt j = j_rem, inc = 4; j < nv; j += inc, alpha += inc, y += inc) {
-    for (PetscInt i = 0; i < inc; ++i) PetscCall(VecGetArrayRead(y[i], yptr + i));
-    PetscKernelAXPY4(xx, alpha[0], alpha[1], alpha[2], alpha[3], yptr[0], yptr[1], yptr[2], yptr[3], n);
-    for (PetscInt i = 0; i < inc; ++i) PetscCall(VecRestoreArrayRead(y[i], yptr + i));
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecRestoreArrayRead(y[k], &yptr[k]));
+  PetscCall(VecRestoreArray(xin, &xx));
+  PetscCall(PetscFree(yptr));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes the local parts of VecMDotAndMAXPY(): after a tile of x has been updated with the tiles of all the vectors,
+   its inner products with them are accumulated while they are all still in cache. Returns the square of the local
+   2-norm of the updated x in nrm2 if it is not NULL
+*/
+PetscErrorCode VecMDotAndMAXPYLocal_Seq(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec *y, PetscScalar *z, PetscReal *nrm2)
+{
+  const PetscInt      n   = xin->map->n;
+  PetscReal           sum = 0.0;
+  const PetscScalar **yptr;
+  PetscScalar        *xx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscArrayzero(z, nv));
+  PetscCall(PetscMalloc1(nv, &yptr));
+  PetscCall(VecGetArray(xin, &xx));
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecGetArrayRead(y[k], &yptr[k]));
+  for (PetscInt i = 0; i < n; i += VEC_SEQ_MULTI_TILE) {
+    const PetscInt nb = PetscMin(VEC_SEQ_MULTI_TILE, n - i);
+
+    PetscCall(VecMAXPYTile_Private(nb, xx + i, nv, alpha, yptr, i));
+    VecMDotTile_Private(nb, xx + i, nv, yptr, i, z);
+    if (nrm2) {
+      for (PetscInt j = i; j < i + nb; j++) sum += PetscRealPart(xx[j] * PetscConj(xx[j]));
+    }
   }
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecRestoreArrayRead(y[k], &yptr[k]));
   PetscCall(VecRestoreArray(xin, &xx));
+  PetscCall(PetscFree(yptr));
+  if (nrm2) *nrm2 = sum;
+  PetscCall(PetscLogFlops(nv * 2.0 * n + PetscMax(nv * (2.0 * n - 1), 0.0) + (nrm2 ? 2.0 * n : 0.0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMDotAndMAXPY_Seq(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec *y, PetscScalar *z, PetscReal *norm)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMDotAndMAXPYLocal_Seq(xin, nv, alpha, y, z, norm));
+  if (norm) *norm = PetscSqrtReal(*norm);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Versions of VecMDot(), VecMTDot(), and VecMAXPY() for the vectors obtained with VecDuplicateVecs_Seq_GEMV(), which are
+   consecutive columns of one array. Each run of vectors whose arrays follow each other is handled as the columns of a
+   MATDENSE with a single call to BLAS gemv, so any set of vectors is accepted
+*/
+static PetscErrorCode VecMXDot_Seq_GEMV(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z, const char *trans)
+{
+  const PetscInt      n   = xin->map->n;
+  const PetscScalar   one = 1.0, zero = 0.0;
+  const PetscScalar  *x, **yy;
+  PetscBLASInt        bn, ione = 1;
+
+  PetscFunctionBegin;
+  if (n == 0) {
+    PetscCall(PetscArrayzero(z, nv));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscBLASIntCast(n, &bn));
+  PetscCall(PetscMalloc1(nv, &yy));
+  PetscCall(VecGetArrayRead(xin, &x));
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecGetArrayRead(yin[k], &yy[k]));
+  for (PetscInt i = 0, j; i < nv; i = j) {
+    PetscBLASInt m;
+
+    j = i + 1;
+    while (j < nv && yy[j] == yy[j - 1] + n) j++;
+    PetscCall(PetscBLASIntCast(j - i, &m));
+    PetscCallBLAS("BLASgemv", BLASgemv_(trans, &bn, &m, &one, yy[i], &bn, x, &ione, &zero, z + i, &ione));
+  }
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecRestoreArrayRead(yin[k], &yy[k]));
+  PetscCall(VecRestoreArrayRead(xin, &x));
+  PetscCall(PetscFree(yy));
+  PetscCall(PetscLogFlops(PetscMax(nv * (2.0 * n - 1), 0.0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMDot_Seq_GEMV(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMXDot_Seq_GEMV(xin, nv, yin, z, "C"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMTDot_Seq_GEMV(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMXDot_Seq_GEMV(xin, nv, yin, z, "T"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMAXPY_Seq_GEMV(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec *y)
+{
+  const PetscInt      n   = xin->map->n;
+  const PetscScalar   one = 1.0;
+  const PetscScalar **yy;
+  PetscScalar        *x;
+  PetscBLASInt        bn, ione = 1;
+
+  PetscFunctionBegin;
+  if (n == 0) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscBLASIntCast(n, &bn));
+  PetscCall(PetscMalloc1(nv, &yy));
+  PetscCall(VecGetArray(xin, &x));
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecGetArrayRead(y[k], &yy[k]));
+  for (PetscInt i = 0, j; i < nv; i = j) {
+    PetscBLASInt m;
+
+    j = i + 1;
+    while (j < nv && yy[j] == yy[j - 1] + n) j++;
+    PetscCall(PetscBLASIntCast(j - i, &m));
+    PetscCallBLAS("BLASgemv", BLASgemv_("N", &bn, &m, &one, yy[i], &bn, alpha + i, &ione, &one, x, &ione));
+  }
+  for (PetscInt k = 0; k < nv; k++) PetscCall(VecRestoreArrayRead(y[k], &yy[k]));
+  PetscCall(VecRestoreArray(xin, &x));
+  PetscCall(PetscFree(yy));
+  PetscCall(PetscLogFlops(nv * 2.0 * n));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -1445,6 +1445,7 @@ static PetscErrorCode VecSetOps_SeqKokkos(Vec v)
 
   v->ops->norm_local             = VecNorm_SeqKokkos;
   v->ops->maxpy                  = VecMAXPY_SeqKokkos;
+  v->ops->mdotandmaxpy           = NULL;
   v->ops->aypx                   = VecAYPX_SeqKokkos;
   v->ops->waxpy                  = VecWAXPY_SeqKokkos;
   v->ops->dotnorm2               = VecDotNorm2_SeqKokkos;
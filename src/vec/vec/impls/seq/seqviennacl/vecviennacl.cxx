@@ -1199,6 +1199,7 @@ static PetscErrorCode VecBindToCPU_SeqAIJViennaCL(Vec V, PetscBool flg)
     V->ops->mdot_local      = VecMDot_Seq;
     V->ops->mtdot_local     = VecMTDot_Seq;
     V->ops->maxpy           = VecMAXPY_Seq;
+    V->ops->mdotandmaxpy    = VecMDotAndMAXPY_Seq;
     V->ops->mdot            = VecMDot_Seq;
     V->ops->mtdot           = VecMTDot_Seq;
     V->ops->aypx            = VecAYPX_Seq;
@@ -1228,6 +1229,7 @@ static PetscErrorCode VecBindToCPU_SeqAIJViennaCL(Vec V, PetscBool flg)
     V->ops->mdot_local      = VecMDot_SeqViennaCL;
     V->ops->mtdot_local     = VecMTDot_SeqViennaCL;
     V->ops->maxpy           = VecMAXPY_SeqViennaCL;
+    V->ops->mdotandmaxpy    = NULL;
     V->ops->mdot            = VecMDot_SeqViennaCL;
     V->ops->mtdot           = VecMTDot_SeqViennaCL;
     V->ops->aypx            = VecAYPX_SeqViennaCL;
@@ -1342,6 +1342,69 @@ PetscErrorCode VecMAXPBY(Vec y, PetscInt nv, const PetscScalar alpha[], PetscSca
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+  VecMDotAndMAXPY - Computes `y = y + sum alpha[i] x[i]` followed by the dot products of the updated `y` with the `x[i]` and, optionally, its 2-norm
+
+  Collective
+
+  Input Parameters:
++ y     - one vector
+. nv    - number of scalars and x-vectors
+. alpha - array of scalars
+- x     - array of vectors
+
+  Output Parameters:
++ val  - array of the dot products `(y, x[i])`, as computed by `VecMDot()` (does not allocate the array)
+- norm - the 2-norm of the updated `y`, pass `NULL` if it is not needed
+
+  Level: advanced
+
+  Notes:
+  This is the projection of one pass of classical Gram-Schmidt fused with the inner products of the next one. Implementations
+  can update each piece of `y` and compute its inner products while it and the corresponding pieces of the `x[i]` are in cache,
+  so all the vectors are read from memory only once, and do all the reductions with a single message.
+
+  `y` cannot be any of the `x` vectors
+
+.seealso: [](ch_vectors), `Vec`, `VecMAXPY()`, `VecMDot()`, `VecNorm()`, `KSPGMRESClassicalGramSchmidtOrthogonalization()`
+@*/
+PetscErrorCode VecMDotAndMAXPY(Vec y, PetscInt nv, const PetscScalar alpha[], Vec x[], PetscScalar val[], PetscReal *norm)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y, VEC_CLASSID, 1);
+  PetscValidType(y, 1);
+  VecCheckAssembled(y);
+  PetscValidLogicalCollectiveInt(y, nv, 2);
+  PetscCheck(nv >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of vectors (given %" PetscInt_FMT ") cannot be negative", nv);
+  if (nv) PetscAssertPointer(val, 5);
+  if (!nv || !y->ops->mdotandmaxpy) {
+    PetscCall(VecMAXPY(y, nv, alpha, x));
+    PetscCall(VecMDot(y, nv, x, val));
+    if (norm) PetscCall(VecNorm(y, NORM_2, norm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecSetErrorIfLocked(y, 1));
+  PetscAssertPointer(alpha, 3);
+  PetscAssertPointer(x, 4);
+  for (PetscInt i = 0; i < nv; ++i) {
+    PetscValidLogicalCollectiveScalar(y, alpha[i], 3);
+    PetscValidHeaderSpecific(x[i], VEC_CLASSID, 4);
+    PetscValidType(x[i], 4);
+    PetscCheckSameTypeAndComm(y, 1, x[i], 4);
+    VecCheckSameSize(y, 1, x[i], 4);
+    PetscCheck(y != x[i], PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Array of vectors 'x' cannot contain y, found x[%" PetscInt_FMT "] == y", i);
+    VecCheckAssembled(x[i]);
+    PetscCall(VecLockReadPush(x[i]));
+  }
+  PetscCall(PetscLogEventBegin(VEC_MDotAndMAXPY, y, *x, 0, 0));
+  PetscUseTypeMethod(y, mdotandmaxpy, nv, alpha, x, val, norm);
+  PetscCall(PetscLogEventEnd(VEC_MDotAndMAXPY, y, *x, 0, 0));
+  PetscCall(PetscObjectStateIncrease((PetscObject)y));
+  if (norm) PetscCall(PetscObjectComposedDataSetReal((PetscObject)y, NormIds[NORM_2], *norm));
+  for (PetscInt i = 0; i < nv; ++i) PetscCall(VecLockReadPop(x[i]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
   VecConcatenate - Creates a new vector that is a vertical concatenation of all the given array of vectors
   in the order they appear in the array. The concatenated vector resides on the same
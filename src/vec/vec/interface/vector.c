@@ -9,7 +9,7 @@
 PetscClassId  VEC_CLASSID;
 PetscLogEvent VEC_View, VEC_Max, VEC_Min, VEC_Dot, VEC_MDot, VEC_TDot;
 PetscLogEvent VEC_Norm, VEC_Normalize, VEC_Scale, VEC_Copy, VEC_Set, VEC_AXPY, VEC_AYPX, VEC_WAXPY;
-PetscLogEvent VEC_MTDot, VEC_MAXPY, VEC_Swap, VEC_AssemblyBegin, VEC_ScatterBegin, VEC_ScatterEnd;
+PetscLogEvent VEC_MTDot, VEC_MAXPY, VEC_MDotAndMAXPY, VEC_Swap, VEC_AssemblyBegin, VEC_ScatterBegin, VEC_ScatterEnd;
 PetscLogEvent VEC_AssemblyEnd, VEC_PointwiseMult, VEC_SetValues, VEC_Load, VEC_SetPreallocateCOO, VEC_SetValuesCOO;
 PetscLogEvent VEC_SetRandom, VEC_ReduceArithmetic, VEC_ReduceCommunication, VEC_ReduceBegin, VEC_ReduceEnd, VEC_Ops;
 PetscLogEvent VEC_DotNorm2, VEC_AXPBYPCZ;
@@ -1039,6 +1039,23 @@ PetscErrorCode VecDuplicateVecs_Default(Vec w, PetscInt m, Vec *V[])
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Gives the m vectors a shared reference to array, which holds all of them and is freed with the last one, so they can
+   be destroyed in any order
+*/
+PetscErrorCode VecDuplicateVecsComposeArray_Private(PetscInt m, Vec V[], PetscScalar *array)
+{
+  PetscContainer container;
+
+  PetscFunctionBegin;
+  PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &container));
+  PetscCall(PetscContainerSetPointer(container, array));
+  PetscCall(PetscContainerSetUserDestroy(container, PetscContainerUserDestroyDefault));
+  for (PetscInt i = 0; i < m; i++) PetscCall(PetscObjectCompose((PetscObject)V[i], "__PETSc_VecDuplicateVecs_array", (PetscObject)container));
+  PetscCall(PetscContainerDestroy(&container));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode VecDestroyVecs_Default(PetscInt m, Vec v[])
 {
   PetscInt i;
@@ -0,0 +1,117 @@
+static char help[] = "Tests VecMDotAndMAXPY() against VecMAXPY(), VecMDot(), and VecNorm(), and VecMDot() and VecMAXPY() against VecDot() and VecAXPY().\n\n";
+
+#include <petscvec.h>
+
+static PetscErrorCode CheckClose(PetscScalar lhs, PetscScalar rhs, const char *name, PetscInt i)
+{
+  const PetscReal rtol = 1e-10, atol = PETSC_SMALL;
+
+  PetscFunctionBegin;
+  PetscCheck(PetscIsCloseAtTolScalar(lhs, rhs, rtol, atol), PETSC_COMM_SELF, PETSC_ERR_PLIB, "%s[%" PetscInt_FMT "] %g != expected %g", name, i, (double)PetscAbsScalar(lhs), (double)PetscAbsScalar(rhs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  Vec                w, wref, *x, *xrev;
+  PetscInt           n = 2500, nv = 5;
+  PetscScalar       *alpha, *val, *valref;
+  PetscReal          norm, normref;
+  PetscRandom        rnd;
+  const PetscScalar *a, *aref;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nv", &nv, NULL));
+
+  PetscCall(PetscRandomCreate(PETSC_COMM_WORLD, &rnd));
+  PetscCall(PetscRandomSetFromOptions(rnd));
+  PetscCall(VecCreate(PETSC_COMM_WORLD, &w));
+  PetscCall(VecSetSizes(w, n, PETSC_DECIDE));
+  PetscCall(VecSetFromOptions(w));
+  PetscCall(VecSetRandom(w, rnd));
+  PetscCall(VecDuplicate(w, &wref));
+  PetscCall(VecCopy(w, wref));
+  PetscCall(VecDuplicateVecs(w, nv, &x));
+  for (PetscInt i = 0; i < nv; i++) PetscCall(VecSetRandom(x[i], rnd));
+  PetscCall(PetscMalloc3(nv, &alpha, nv, &val, nv, &valref));
+  PetscCall(PetscMalloc1(nv, &xrev));
+  for (PetscInt i = 0; i < nv; i++) xrev[i] = x[nv - 1 - i];
+  for (PetscInt i = 0; i < nv; i++) alpha[i] = -0.5 + 0.25 * i;
+
+  PetscCall(VecMDot(w, nv, x, val));
+  for (PetscInt i = 0; i < nv; i++) {
+    PetscCall(VecDot(w, x[i], &valref[i]));
+    PetscCall(CheckClose(val[i], valref[i], "VecMDot", i));
+  }
+  /* vectors out of order */
+  PetscCall(VecMDot(w, nv, xrev, val));
+  for (PetscInt i = 0; i < nv; i++) PetscCall(CheckClose(val[i], valref[nv - 1 - i], "VecMDot", i));
+
+  PetscCall(VecMDotAndMAXPY(w, nv, alpha, x, val, &norm));
+  PetscCall(VecMAXPY(wref, nv, alpha, x));
+  PetscCall(VecMDot(wref, nv, x, valref));
+  PetscCall(VecNorm(wref, NORM_2, &normref));
+  for (PetscInt i = 0; i < nv; i++) PetscCall(CheckClose(val[i], valref[i], "VecMDotAndMAXPY", i));
+  PetscCall(CheckClose(norm, normref, "norm", 0));
+  PetscCall(VecGetArrayRead(w, &a));
+  PetscCall(VecGetArrayRead(wref, &aref));
+  for (PetscInt i = 0; i < n; i++) PetscCall(CheckClose(a[i], aref[i], "y", i));
+  PetscCall(VecRestoreArrayRead(w, &a));
+  PetscCall(VecRestoreArrayRead(wref, &aref));
+
+  /* the norm is optional */
+  PetscCall(VecMDotAndMAXPY(w, nv, alpha, x, val, NULL));
+  PetscCall(VecMAXPY(wref, nv, alpha, x));
+  PetscCall(VecMDot(wref, nv, x, valref));
+  for (PetscInt i = 0; i < nv; i++) PetscCall(CheckClose(val[i], valref[i], "VecMDotAndMAXPY", i));
+
+  /* vectors out of order */
+  PetscCall(VecMAXPY(w, nv, alpha, xrev));
+  for (PetscInt i = 0; i < nv; i++) PetscCall(VecAXPY(wref, alpha[i], xrev[i]));
+  PetscCall(VecGetArrayRead(w, &a));
+  PetscCall(VecGetArrayRead(wref, &aref));
+  for (PetscInt i = 0; i < n; i++) PetscCall(CheckClose(a[i], aref[i], "y", i));
+  PetscCall(VecRestoreArrayRead(w, &a));
+  PetscCall(VecRestoreArrayRead(wref, &aref));
+
+  PetscCall(PetscFree(xrev));
+  PetscCall(PetscFree3(alpha, val, valref));
+  PetscCall(VecDestroyVecs(nv, &x));
+  PetscCall(VecDestroy(&wref));
+  PetscCall(VecDestroy(&w));
+  PetscCall(PetscRandomDestroy(&rnd));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+  testset:
+    output_file: ./output/empty.out
+    nsize: {{1 2}}
+    args: -nv {{1 5 8}} -n {{100 2500}}
+    test:
+      suffix: standard
+      args: -vec_type standard
+    test:
+      suffix: gemv
+      args: -vec_type standard -vec_mdot_use_gemv -vec_maxpy_use_gemv
+    test:
+      suffix: cuda
+      requires: cuda
+      args: -vec_type cuda
+    test:
+      suffix: kokkos
+      requires: kokkos_kernels
+      args: -vec_type kokkos
+
+  test:
+    suffix: openmp
+    requires: openmp
+    output_file: ./output/empty.out
+    env: OMP_NUM_THREADS=3
+    args: -vec_type standard -nv {{1 5 8}} -n {{100 40000}}
+
+TEST*/